@@ -196,7 +196,7 @@ class Array
     EIGEN_STRONG_INLINE Array(const ReturnByValue<OtherDerived>& other)
     {
       Base::_check_template_params();
-      Base::resize(other.rows(), other.cols());
+      Base::resizeLike(other);
       other.evalTo(*this);
     }
 
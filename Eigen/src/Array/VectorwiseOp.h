@@ -155,6 +155,68 @@ struct ei_member_redux {
   const BinaryOp m_functor;
 };
 
+template<typename ExpressionType, int Direction,
+         bool StridedVectorizable = ((Direction==Vertical) == bool(int(ExpressionType::Flags)&RowMajorBit))
+                                 && bool(int(ExpressionType::Flags)&PacketAccessBit)
+                                 && !NumTraits<typename ExpressionType::Scalar>::IsComplex
+                                 && (int(ei_packet_traits<typename ExpressionType::Scalar>::size)>1)>
+struct ei_partial_blue_norm_impl
+{
+  template<typename Dest> static void run(const ExpressionType& mat, Dest& dst)
+  {
+    enum { ParallelThreshold = 1<<16 };
+    typedef PartialReduxExpr<ExpressionType, ei_member_blueNorm<typename ExpressionType::Scalar>, Direction> ReduxType;
+    ReduxType redux(mat);
+    const int lines = dst.size();
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(static) if(lines>1 && mat.size()>=ParallelThreshold && omp_get_num_threads()==1)
+#endif
+    for(int i = 0; i < lines; ++i)
+      dst.coeffRef(i) = redux.coeff(i);
+  }
+};
+
+/* when the lines are strided in memory, all of them are processed in a single pass over the matrix */
+template<typename ExpressionType, int Direction>
+struct ei_partial_blue_norm_impl<ExpressionType, Direction, true>
+{
+  template<typename Dest> static void run(const ExpressionType& mat, Dest& dst)
+  { ei_blue_norm_strided_lines(mat, dst); }
+};
+
+template<typename ExpressionType, int Direction> struct ei_partial_blue_norm_retval;
+
+template<typename ExpressionType, int Direction>
+struct ei_traits<ei_partial_blue_norm_retval<ExpressionType, Direction> >
+{
+  typedef typename PartialReduxExpr<ExpressionType,
+                                    ei_member_blueNorm<typename ei_traits<ExpressionType>::Scalar>,
+                                    Direction>::PlainObject ReturnType;
+};
+
+/** \internal
+  * Expression of the norms of the columns (or rows) of a matrix computed with the Blue's algorithm.
+  * \sa VectorwiseOp::blueNorm()
+  */
+template<typename ExpressionType, int Direction>
+struct ei_partial_blue_norm_retval
+  : public ReturnByValue<ei_partial_blue_norm_retval<ExpressionType, Direction> >
+{
+    typedef typename ei_nested<ExpressionType>::type ExpressionTypeNested;
+    typedef typename ei_cleantype<ExpressionTypeNested>::type _ExpressionTypeNested;
+
+    ei_partial_blue_norm_retval(const ExpressionType& mat) : m_matrix(mat) {}
+
+    inline int rows() const { return Direction==Vertical   ? 1 : m_matrix.rows(); }
+    inline int cols() const { return Direction==Horizontal ? 1 : m_matrix.cols(); }
+
+    template<typename Dest> inline void evalTo(Dest& dst) const
+    { ei_partial_blue_norm_impl<_ExpressionTypeNested, Direction>::run(m_matrix, dst); }
+
+  protected:
+    const ExpressionTypeNested m_matrix;
+};
+
 /** \array_module \ingroup Array_Module
   *
   * \class VectorwiseOp
@@ -302,9 +364,12 @@ template<typename ExpressionType, int Direction> class VectorwiseOp
       * of each column (or row) of the referenced expression, using
       * blue's algorithm.
       *
+      * When the columns (or rows) are strided in memory, they are all
+      * processed in a single pass over the referenced expression.
+      *
       * \sa DenseBase::blueNorm() */
-    const typename ReturnType<ei_member_blueNorm>::Type blueNorm() const
-    { return _expression(); }
+    const ei_partial_blue_norm_retval<ExpressionType, Direction> blueNorm() const
+    { return ei_partial_blue_norm_retval<ExpressionType, Direction>(_expression()); }
 
 
     /** \returns a row (or column) vector expression of the norm
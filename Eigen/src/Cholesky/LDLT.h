@@ -156,6 +156,9 @@ template<typename _MatrixType> class LDLT
 
     LDLT& compute(const MatrixType& matrix);
 
+    template<typename VectorType>
+    LDLT& rankUpdate(const VectorType& w, const RealScalar& sigma = 1);
+
     /** \returns the LDLT decomposition matrix
       *
       * TODO: document the storage layout
@@ -186,6 +189,162 @@ template<typename _MatrixType> class LDLT
     bool m_isInitialized;
 };
 
+/** \internal
+  * Computes in place the LDLT decomposition of \a mat, storing the pivots in \a transpositions and the
+  * sign of the matrix in \a sign.
+  */
+template<typename MatrixType, int Unrolling = ei_decomposition_unrolling<MatrixType>::ret>
+struct ei_ldlt_inplace
+{
+  template<typename IntVector, typename TmpVector>
+  static void run(MatrixType& mat, IntVector& transpositions, TmpVector& temporary, int& sign)
+  {
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    const int size = mat.rows();
+
+    RealScalar cutoff = 0, biggest_in_corner;
+
+    for (int j = 0; j < size; ++j)
+    {
+      // Find largest diagonal element
+      int index_of_biggest_in_corner;
+      biggest_in_corner = mat.diagonal().tail(size-j).cwiseAbs()
+                         .maxCoeff(&index_of_biggest_in_corner);
+      index_of_biggest_in_corner += j;
+
+      if(j == 0)
+      {
+        // The biggest overall is the point of reference to which further diagonals
+        // are compared; if any diagonal is negligible compared
+        // to the largest overall, the algorithm bails.
+        cutoff = ei_abs(NumTraits<Scalar>::epsilon() * biggest_in_corner);
+
+        sign = ei_real(mat.diagonal().coeff(index_of_biggest_in_corner)) > 0 ? 1 : -1;
+      }
+
+      // Finish early if the matrix is not full rank.
+      if(biggest_in_corner < cutoff)
+      {
+        for(int i = j; i < size; i++) transpositions.coeffRef(i) = i;
+        return;
+      }
+
+      transpositions.coeffRef(j) = index_of_biggest_in_corner;
+      if(j != index_of_biggest_in_corner)
+      {
+        mat.row(j).swap(mat.row(index_of_biggest_in_corner));
+        mat.col(j).swap(mat.col(index_of_biggest_in_corner));
+      }
+
+      if (j == 0) {
+        mat.row(0) = mat.row(0).conjugate();
+        mat.col(0).tail(size-1) = mat.row(0).tail(size-1) / mat.coeff(0,0);
+        continue;
+      }
+
+      RealScalar Djj = ei_real(mat.coeff(j,j) -  mat.row(j).head(j).dot(mat.col(j).head(j)));
+      mat.coeffRef(j,j) = Djj;
+
+      int endSize = size - j - 1;
+      if (endSize > 0) {
+        temporary.tail(endSize).noalias() = mat.block(j+1,0, endSize, j)
+                                  * mat.col(j).head(j).conjugate();
+
+        mat.row(j).tail(endSize) = mat.row(j).tail(endSize).conjugate()
+                                      - temporary.tail(endSize).transpose();
+
+        if(ei_abs(Djj) > cutoff)
+        {
+          mat.col(j).tail(endSize) = mat.row(j).tail(endSize) / Djj;
+        }
+      }
+    }
+  }
+};
+
+/** \internal
+  * Fully unrolled version of ei_ldlt_inplace for small fixed size matrices: the step \a Index computes
+  * the column \a Index of L with fixed size blocks.
+  */
+template<typename MatrixType, int Index, int Size = MatrixType::RowsAtCompileTime, bool Stop = Index==Size>
+struct ei_ldlt_unroller
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  enum { RemainingSize = Size-Index-1 };
+
+  template<typename IntVector>
+  static EIGEN_STRONG_INLINE void run(MatrixType& mat, IntVector& transpositions, RealScalar& cutoff, int& sign)
+  {
+    int index_of_biggest_in_corner;
+    RealScalar biggest_in_corner = mat.diagonal().template tail<Size-Index>().cwiseAbs()
+                                   .maxCoeff(&index_of_biggest_in_corner);
+    index_of_biggest_in_corner += Index;
+
+    if(Index == 0)
+    {
+      cutoff = ei_abs(NumTraits<Scalar>::epsilon() * biggest_in_corner);
+      sign = ei_real(mat.diagonal().coeff(index_of_biggest_in_corner)) > 0 ? 1 : -1;
+    }
+
+    if(biggest_in_corner < cutoff)
+    {
+      for(int i = Index; i < Size; i++) transpositions.coeffRef(i) = i;
+      return;
+    }
+
+    transpositions.coeffRef(Index) = index_of_biggest_in_corner;
+    if(Index != index_of_biggest_in_corner)
+    {
+      mat.row(Index).swap(mat.row(index_of_biggest_in_corner));
+      mat.col(Index).swap(mat.col(index_of_biggest_in_corner));
+    }
+
+    Block<MatrixType,1,RemainingSize> rowTail(mat,Index,Index+1,1,RemainingSize);
+    Block<MatrixType,RemainingSize,1> colTail(mat,Index+1,Index,RemainingSize,1);
+    if(Index == 0)
+    {
+      mat.row(0) = mat.row(0).conjugate();
+      colTail = rowTail.transpose() / mat.coeff(0,0);
+    }
+    else
+    {
+      Block<MatrixType,Index,1> colHead(mat,0,Index,Index,1);
+      RealScalar Djj = ei_real(mat.coeff(Index,Index) - Block<MatrixType,1,Index>(mat,Index,0,1,Index).dot(colHead));
+      mat.coeffRef(Index,Index) = Djj;
+
+      if(RemainingSize > 0)
+      {
+        const Matrix<Scalar,1,RemainingSize> temporary
+          = (Block<MatrixType,RemainingSize,Index>(mat,Index+1,0,RemainingSize,Index) * colHead.conjugate()).transpose();
+        rowTail = rowTail.conjugate() - temporary;
+        if(ei_abs(Djj) > cutoff)
+          colTail = rowTail.transpose() / Djj;
+      }
+    }
+    ei_ldlt_unroller<MatrixType,Index+1,Size>::run(mat, transpositions, cutoff, sign);
+  }
+};
+
+template<typename MatrixType, int Index, int Size>
+struct ei_ldlt_unroller<MatrixType,Index,Size,true>
+{
+  template<typename IntVector>
+  static EIGEN_STRONG_INLINE void run(MatrixType&, IntVector&, typename MatrixType::RealScalar&, int&) {}
+};
+
+template<typename MatrixType>
+struct ei_ldlt_inplace<MatrixType,CompleteUnrolling>
+{
+  template<typename IntVector, typename TmpVector>
+  static void run(MatrixType& mat, IntVector& transpositions, TmpVector&, int& sign)
+  {
+    typename MatrixType::RealScalar cutoff = 0;
+    ei_ldlt_unroller<MatrixType,0>::run(mat, transpositions, cutoff, sign);
+  }
+};
+
 /** Compute / recompute the LDLT decomposition A = L D L^* = U^* D U of \a matrix
   */
 template<typename MatrixType>
@@ -208,76 +367,68 @@ LDLT<MatrixType>& LDLT<MatrixType>::compute(const MatrixType& a)
     return *this;
   }
 
-  RealScalar cutoff = 0, biggest_in_corner;
-
   // By using a temorary, packet-aligned products are guarenteed. In the LLT
   // case this is unnecessary because the diagonal is included and will always
   // have optimal alignment.
   m_temporary.resize(size);
 
-  for (int j = 0; j < size; ++j)
-  {
-    // Find largest diagonal element
-    int index_of_biggest_in_corner;
-    biggest_in_corner = m_matrix.diagonal().tail(size-j).cwiseAbs()
-                       .maxCoeff(&index_of_biggest_in_corner);
-    index_of_biggest_in_corner += j;
+  ei_ldlt_inplace<MatrixType>::run(m_matrix, m_transpositions, m_temporary, m_sign);
 
-    if(j == 0)
-    {
-      // The biggest overall is the point of reference to which further diagonals
-      // are compared; if any diagonal is negligible compared
-      // to the largest overall, the algorithm bails.
-      cutoff = ei_abs(NumTraits<Scalar>::epsilon() * biggest_in_corner);
+  // Reverse applied swaps to get P matrix.
+  for(int k = 0; k < size; ++k) m_p.coeffRef(k) = k;
+  for(int k = size-1; k >= 0; --k) {
+    std::swap(m_p.coeffRef(k), m_p.coeffRef(m_transpositions.coeff(k)));
+  }
 
-      m_sign = ei_real(m_matrix.diagonal().coeff(index_of_biggest_in_corner)) > 0 ? 1 : -1;
-    }
+  m_isInitialized = true;
+  return *this;
+}
 
-    // Finish early if the matrix is not full rank.
-    if(biggest_in_corner < cutoff)
-    {
-      for(int i = j; i < size; i++) m_transpositions.coeffRef(i) = i;
-      break;
-    }
+/** Performs a rank one update (or downdate) of the current decomposition:
+  * if the decomposition is the one of \f$ A \f$, it becomes the one of \f$ A + \sigma w w^* \f$,
+  * at the cost of \f$ O(n^2) \f$ operations instead of the \f$ O(n^3) \f$ of a new decomposition.
+  *
+  * The permutation P of the decomposition is kept, and the factors are updated with the method
+  * C1 of Gill, Golub, Murray and Saunders, Methods for modifying matrix factorizations,
+  * Math. Comp. 28 (1974), pp. 505-535. The pivots of the null space of a semidefinite
+  * matrix, which are zero, are left unchanged.
+  *
+  * \returns a reference to *this
+  */
+template<typename MatrixType>
+template<typename VectorType>
+LDLT<MatrixType>& LDLT<MatrixType>::rankUpdate(const VectorType& w, const RealScalar& sigma)
+{
+  ei_assert(m_isInitialized && "LDLT is not initialized.");
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(VectorType)
+  const int size = m_matrix.rows();
+  ei_assert(w.size()==size);
 
-    m_transpositions.coeffRef(j) = index_of_biggest_in_corner;
-    if(j != index_of_biggest_in_corner)
-    {
-      m_matrix.row(j).swap(m_matrix.row(index_of_biggest_in_corner));
-      m_matrix.col(j).swap(m_matrix.col(index_of_biggest_in_corner));
-    }
+  // m_temporary = P w
+  m_temporary = w;
+  for(int i = 0; i < size; ++i) std::swap(m_temporary.coeffRef(m_transpositions.coeff(i)), m_temporary.coeffRef(i));
 
-    if (j == 0) {
-      m_matrix.row(0) = m_matrix.row(0).conjugate();
-      m_matrix.col(0).tail(size-1) = m_matrix.row(0).tail(size-1) / m_matrix.coeff(0,0);
+  RealScalar alpha = 1;
+  for(int j = 0; j < size; ++j)
+  {
+    const RealScalar dj = ei_real(m_matrix.coeff(j,j));
+    if (dj == RealScalar(0))
       continue;
-    }
+    const Scalar wj = m_temporary.coeff(j);
+    const RealScalar swj2 = sigma*ei_abs2(wj);
+    const RealScalar gamma = dj*alpha + swj2;
 
-    RealScalar Djj = ei_real(m_matrix.coeff(j,j) -  m_matrix.row(j).head(j).dot(m_matrix.col(j).head(j)));
-    m_matrix.coeffRef(j,j) = Djj;
+    m_matrix.coeffRef(j,j) += swj2/alpha;
+    alpha += swj2/dj;
 
     int endSize = size - j - 1;
-    if (endSize > 0) {
-      m_temporary.tail(endSize).noalias() = m_matrix.block(j+1,0, endSize, j)
-                                * m_matrix.col(j).head(j).conjugate();
-
-      m_matrix.row(j).tail(endSize) = m_matrix.row(j).tail(endSize).conjugate()
-                                    - m_temporary.tail(endSize).transpose();
-
-      if(ei_abs(Djj) > cutoff)
-      {
-        m_matrix.col(j).tail(endSize) = m_matrix.row(j).tail(endSize) / Djj;
-      }
+    if (endSize > 0)
+    {
+      m_temporary.tail(endSize) -= wj * m_matrix.col(j).tail(endSize);
+      if (gamma != RealScalar(0))
+        m_matrix.col(j).tail(endSize) += (sigma*ei_conj(wj)/gamma) * m_temporary.tail(endSize);
     }
   }
-
-  // Reverse applied swaps to get P matrix.
-  for(int k = 0; k < size; ++k) m_p.coeffRef(k) = k;
-  for(int k = size-1; k >= 0; --k) {
-    std::swap(m_p.coeffRef(k), m_p.coeffRef(m_transpositions.coeff(k)));
-  }
-
-  m_isInitialized = true;
   return *this;
 }
 
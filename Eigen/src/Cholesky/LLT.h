@@ -137,6 +137,9 @@ template<typename _MatrixType, int _UpLo> class LLT
 
     LLT& compute(const MatrixType& matrix);
 
+    template<typename VectorType>
+    LLT& rankUpdate(const VectorType& vec, const RealScalar& sigma = 1);
+
     /** \returns the LLT decomposition matrix
       *
       * TODO: document the storage layout
@@ -153,6 +156,8 @@ template<typename _MatrixType, int _UpLo> class LLT
     inline int cols() const { return m_matrix.cols(); }
 
   protected:
+    template<typename T> friend struct ei_binary_serializer;
+
     /** \internal
       * Used to compute and store L
       * The strict upper part is not used and even not initialized.
@@ -219,6 +224,48 @@ template<> struct ei_llt_inplace<Lower>
     }
     return true;
   }
+
+  /** \internal
+    * Updates \a mat, holding L in its lower part, so that \f$ L L^* \f$ becomes
+    * \f$ L L^* + \sigma v v^* \f$, following the method C1 of Gill, Golub, Murray and Saunders,
+    * Methods for modifying matrix factorizations, Math. Comp. 28 (1974), pp. 505-535.
+    * \returns false if the modified matrix is not positive definite.
+    */
+  template<typename MatrixType, typename VectorType>
+  static bool rankUpdate(MatrixType& mat, const VectorType& vec, const typename MatrixType::RealScalar& sigma)
+  {
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef Matrix<Scalar,MatrixType::RowsAtCompileTime,1,0,MatrixType::MaxRowsAtCompileTime,1> TempVectorType;
+    ei_assert(mat.rows()==mat.cols() && mat.rows()==vec.size());
+    const int size = mat.rows();
+    TempVectorType temp(vec);
+    RealScalar beta = 1;
+    for(int j = 0; j < size; ++j)
+    {
+      const RealScalar Ljj = ei_real(mat.coeff(j,j));
+      const RealScalar dj = ei_abs2(Ljj);
+      const Scalar wj = temp.coeff(j);
+      const RealScalar swj2 = sigma*ei_abs2(wj);
+      const RealScalar gamma = dj*beta + swj2;
+
+      const RealScalar x = dj + swj2/beta;
+      if (x<=RealScalar(0))
+        return false;
+      const RealScalar nLjj = ei_sqrt(x);
+      mat.coeffRef(j,j) = nLjj;
+      beta += swj2/dj;
+
+      int rs = size-j-1; // remaining size
+      if (rs>0)
+      {
+        temp.tail(rs) -= (wj/Ljj) * mat.col(j).tail(rs);
+        if (gamma != RealScalar(0))
+          mat.col(j).tail(rs) = (nLjj/Ljj) * mat.col(j).tail(rs) + (nLjj*sigma*ei_conj(wj)/gamma) * temp.tail(rs);
+      }
+    }
+    return true;
+  }
 };
 
 template<> struct ei_llt_inplace<Upper>
@@ -235,6 +282,58 @@ template<> struct ei_llt_inplace<Upper>
     Transpose<MatrixType> matt(mat);
     return ei_llt_inplace<Lower>::blocked(matt);
   }
+  template<typename MatrixType, typename VectorType>
+  static bool rankUpdate(MatrixType& mat, const VectorType& vec, const typename MatrixType::RealScalar& sigma)
+  {
+    Transpose<MatrixType> matt(mat);
+    return ei_llt_inplace<Lower>::rankUpdate(matt, vec.conjugate(), sigma);
+  }
+};
+
+/** \internal
+  * Fully unrolled version of ei_llt_inplace<Lower>::unblocked() for small fixed size matrices: the step
+  * \a Index computes the column \a Index of L with fixed size blocks.
+  */
+template<typename MatrixType, int Index, int Size = MatrixType::RowsAtCompileTime, bool Stop = Index==Size>
+struct ei_llt_unroller
+{
+  typedef typename MatrixType::RealScalar RealScalar;
+  enum { RemainingSize = Size-Index-1 };
+
+  static EIGEN_STRONG_INLINE bool run(MatrixType& mat)
+  {
+    Block<MatrixType,1,Index> A10(mat,Index,0,1,Index);
+    Block<MatrixType,RemainingSize,1> A21(mat,Index+1,Index,RemainingSize,1);
+    Block<MatrixType,RemainingSize,Index> A20(mat,Index+1,0,RemainingSize,Index);
+
+    RealScalar x = ei_real(mat.coeff(Index,Index));
+    if (Index>0) x -= A10.squaredNorm();
+    if (x<=RealScalar(0))
+      return false;
+    mat.coeffRef(Index,Index) = x = ei_sqrt(x);
+    if (Index>0 && RemainingSize>0) A21.noalias() -= A20 * A10.adjoint();
+    if (RemainingSize>0) A21 *= RealScalar(1)/x;
+    return ei_llt_unroller<MatrixType,Index+1,Size>::run(mat);
+  }
+};
+
+template<typename MatrixType, int Index, int Size>
+struct ei_llt_unroller<MatrixType,Index,Size,true>
+{
+  static EIGEN_STRONG_INLINE bool run(MatrixType&) { return true; }
+};
+
+/** \internal factorizes \a m in place, its lower triangular part becoming L */
+template<typename MatrixType, int Unrolling = ei_decomposition_unrolling<MatrixType>::ret>
+struct ei_llt_lower_selector
+{
+  static bool run(MatrixType& m) { return ei_llt_inplace<Lower>::blocked(m); }
+};
+
+template<typename MatrixType>
+struct ei_llt_lower_selector<MatrixType,CompleteUnrolling>
+{
+  static bool run(MatrixType& m) { return ei_llt_unroller<MatrixType,0>::run(m); }
 };
 
 template<typename MatrixType> struct LLT_Traits<MatrixType,Lower>
@@ -244,7 +343,7 @@ template<typename MatrixType> struct LLT_Traits<MatrixType,Lower>
   inline static MatrixL getL(const MatrixType& m) { return m; }
   inline static MatrixU getU(const MatrixType& m) { return m.adjoint(); }
   static bool inplace_decomposition(MatrixType& m)
-  { return ei_llt_inplace<Lower>::blocked(m); }
+  { return ei_llt_lower_selector<MatrixType>::run(m); }
 };
 
 template<typename MatrixType> struct LLT_Traits<MatrixType,Upper>
@@ -254,7 +353,10 @@ template<typename MatrixType> struct LLT_Traits<MatrixType,Upper>
   inline static MatrixL getL(const MatrixType& m) { return m.adjoint(); }
   inline static MatrixU getU(const MatrixType& m) { return m; }
   static bool inplace_decomposition(MatrixType& m)
-  { return ei_llt_inplace<Upper>::blocked(m); }
+  {
+    Transpose<MatrixType> mt(m);
+    return ei_llt_lower_selector<Transpose<MatrixType> >::run(mt);
+  }
 };
 
 /** Computes / recomputes the Cholesky decomposition A = LL^* = U^*U of \a matrix
@@ -274,6 +376,27 @@ LLT<MatrixType,_UpLo>& LLT<MatrixType,_UpLo>::compute(const MatrixType& a)
   return *this;
 }
 
+/** Performs a rank one update (or downdate) of the current decomposition:
+  * if the decomposition is the one of \f$ A \f$, it becomes the one of \f$ A + \sigma v v^* \f$,
+  * where \a vec is \f$ v \f$ and \a sigma is \f$ \sigma \f$, at the cost of \f$ O(n^2) \f$
+  * operations instead of the \f$ O(n^3) \f$ of a new decomposition.
+  *
+  * A negative \a sigma downdates the decomposition. If the downdated matrix is not positive
+  * definite, the decomposition is left uninitialized.
+  *
+  * \returns a reference to *this
+  */
+template<typename MatrixType, int _UpLo>
+template<typename VectorType>
+LLT<MatrixType,_UpLo>& LLT<MatrixType,_UpLo>::rankUpdate(const VectorType& vec, const RealScalar& sigma)
+{
+  ei_assert(m_isInitialized && "LLT is not initialized.");
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(VectorType)
+  ei_assert(vec.size()==m_matrix.cols());
+  m_isInitialized = ei_llt_inplace<UpLo>::rankUpdate(m_matrix, vec, sigma);
+  return *this;
+}
+
 template<typename _MatrixType, int UpLo, typename Rhs>
 struct ei_solve_retval<LLT<_MatrixType, UpLo>, Rhs>
   : ei_solve_retval_base<LLT<_MatrixType, UpLo>, Rhs>
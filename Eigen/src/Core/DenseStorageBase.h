@@ -309,7 +309,7 @@ class DenseStorageBase : public ei_dense_xpr_base<Derived>::type
     template<typename OtherDerived>
     EIGEN_STRONG_INLINE Derived& operator=(const ReturnByValue<OtherDerived>& func)
     {
-      resize(func.rows(), func.cols());
+      resizeLike(func);
       return Base::operator=(func);
     }
 
@@ -145,6 +145,10 @@ ei_pxor(const Packet& a, const Packet& b) { return a ^ b; }
 template<typename Packet> inline Packet
 ei_pandnot(const Packet& a, const Packet& b) { return a & (!b); }
 
+/** \internal \returns a mask whose bits are all set in the coefficients where \a a < \a b, and cleared elsewhere */
+template<typename Packet> inline Packet
+ei_pcmp_lt(const Packet& a, const Packet& b) { return a<b ? ~Packet(0) : Packet(0); }
+
 /** \internal \returns a packet version of \a *from, from must be 16 bytes aligned */
 template<typename Scalar> inline typename ei_packet_traits<Scalar>::type
 ei_pload(const Scalar* from) { return *from; }
@@ -126,7 +126,7 @@ DenseBase<Derived>::format(const IOFormat& fmt) const
   return WithFormat<Derived>(derived(), fmt);
 }
 
-template<typename Scalar>
+template<typename Scalar, bool IsInteger = NumTraits<Scalar>::IsInteger>
 struct ei_significant_decimals_impl
 {
   typedef typename NumTraits<Scalar>::Real RealScalar;
@@ -136,6 +136,15 @@ struct ei_significant_decimals_impl
   }
 };
 
+template<typename Scalar>
+struct ei_significant_decimals_impl<Scalar, true>
+{
+  static inline int run()
+  {
+    return 0;
+  }
+};
+
 /** \internal
   * print the matrix \a _m to the output stream \a s using the output format \a fmt */
 template<typename Derived>
@@ -170,12 +179,13 @@ std::ostream & ei_print_matrix(std::ostream & s, const Derived& _m, const IOForm
   bool align_cols = !(fmt.flags & DontAlignCols);
   if(align_cols)
   {
-    // compute the largest width
-    for(int j = 1; j < m.cols(); ++j)
+    // compute the largest width, reusing the same stream as constructing one per coefficient dominates
+    std::stringstream sstr;
+    if(explicit_precision) sstr.precision(explicit_precision);
+    for(int j = 0; j < m.cols(); ++j)
       for(int i = 0; i < m.rows(); ++i)
       {
-        std::stringstream sstr;
-        if(explicit_precision) sstr.precision(explicit_precision);
+        sstr.str(std::string());
         sstr << m.coeff(i,j);
         width = std::max<int>(width, int(sstr.str().length()));
       }
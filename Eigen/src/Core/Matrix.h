@@ -295,7 +295,7 @@ class Matrix
     EIGEN_STRONG_INLINE Matrix(const ReturnByValue<OtherDerived>& other)
     {
       Base::_check_template_params();
-      Base::resize(other.rows(), other.cols());
+      Base::resizeLike(other);
       other.evalTo(*this);
     }
 
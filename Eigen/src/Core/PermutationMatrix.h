@@ -315,6 +315,13 @@ struct ei_permut_matrix_product_retval
  : public ReturnByValue<ei_permut_matrix_product_retval<PermutationType, MatrixType, Side, Transposed> >
 {
     typedef typename ei_cleantype<typename MatrixType::Nested>::type MatrixTypeNestedCleaned;
+    typedef typename MatrixType::Scalar Scalar;
+
+    enum {
+      // true if dst.row(k) (resp. dst.col(k)) receives the row (resp. column) indices[k] of the matrix,
+      // false if the row (resp. column) k of the matrix is sent to dst.row(indices[k]) (resp. dst.col(indices[k]))
+      Gather = (Side==OnTheRight) ^ Transposed
+    };
 
     ei_permut_matrix_product_retval(const PermutationType& perm, const MatrixType& matrix)
       : m_permutation(perm), m_matrix(matrix)
@@ -325,55 +332,184 @@ struct ei_permut_matrix_product_retval
 
     template<typename Dest> inline void evalTo(Dest& dst) const
     {
+      enum {
+        // true if the permuted rows (resp. columns) are strided in memory, in which case the permutation
+        // is applied to one column (resp. row) at a time, so that each pass stays within a contiguous line
+        PermuteInner = (Side==OnTheLeft) ^ bool(int(Dest::Flags)&RowMajorBit)
+      };
+      typedef Block<Dest, Side==OnTheLeft ? 1 : Dest::RowsAtCompileTime, Side==OnTheRight ? 1 : Dest::ColsAtCompileTime> DestLine;
+
       const int n = Side==OnTheLeft ? rows() : cols();
+      const int outerSize = Side==OnTheLeft ? cols() : rows();
+      if(n==0)
+        return;
+      const int* indices = &m_permutation.indices().coeff(0);
 
       if(ei_is_same_type<MatrixTypeNestedCleaned,Dest>::ret && ei_extract_data(dst) == ei_extract_data(m_matrix))
       {
-        // apply the permutation inplace
-        Matrix<bool,PermutationType::RowsAtCompileTime,1,0,PermutationType::MaxRowsAtCompileTime> mask(m_permutation.size());
+        Matrix<bool,PermutationType::RowsAtCompileTime,1,0,PermutationType::MaxRowsAtCompileTime> mask(n);
         mask.fill(false);
-        int r = 0;
-        while(r < m_permutation.size())
+
+        if(PermuteInner && outerSize==1)
         {
-          // search for the next seed
-          while(r<m_permutation.size() && mask[r]) r++;
-          if(r>=m_permutation.size())
-            break;
-          // we got one, let's follow it until we are back to the seed
-          int k0 = r++;
-          int kPrev = k0;
-          mask.coeffRef(k0) = true;
-          for(int k=m_permutation.indices().coeff(k0); k!=k0; k=m_permutation.indices().coeff(k))
+          // a single vector: rotate each cycle while following it
+          for(int r = 0; r < n; ++r)
           {
-                  Block<Dest, Side==OnTheLeft ? 1 : Dest::RowsAtCompileTime, Side==OnTheRight ? 1 : Dest::ColsAtCompileTime>(dst, k)
-            .swap(Block<Dest, Side==OnTheLeft ? 1 : Dest::RowsAtCompileTime, Side==OnTheRight ? 1 : Dest::ColsAtCompileTime>
-                       (dst,((Side==OnTheLeft) ^ Transposed) ? k0 : kPrev));
+            if(mask.coeff(r))
+              continue;
+            mask.coeffRef(r) = true;
+            Scalar tmp = coeffRef(dst,r,0);
+            int k = r;
+            if(Gather)
+            {
+              for(; indices[k]!=r; k=indices[k])
+              {
+                coeffRef(dst,k,0) = coeffRef(dst,indices[k],0);
+                mask.coeffRef(indices[k]) = true;
+              }
+              coeffRef(dst,k,0) = tmp;
+            }
+            else
+            {
+              for(k=indices[r]; k!=r; k=indices[k])
+              {
+                std::swap(tmp, coeffRef(dst,k,0));
+                mask.coeffRef(k) = true;
+              }
+              coeffRef(dst,r,0) = tmp;
+            }
+          }
+          return;
+        }
 
+        // apply the permutation inplace: the non trivial cycles are collected once into cycles[] where the
+        // cycle c spans the positions starts[c] to starts[c+1]-1, then each of them is rotated through a
+        // single temporary coefficient or line
+        typedef Matrix<int,PermutationType::RowsAtCompileTime,1,0,PermutationType::MaxRowsAtCompileTime> IndexVector;
+        IndexVector cycles(n), starts(n); // there are at most n/2 non trivial cycles
+        int nbCycles = 0, size = 0;
+        for(int r = 0; r < n; ++r)
+        {
+          if(mask.coeff(r) || indices[r]==r)
+            continue;
+          starts.coeffRef(nbCycles++) = size;
+          for(int k=r; !mask.coeff(k); k=indices[k])
+          {
             mask.coeffRef(k) = true;
-            kPrev = k;
+            cycles.coeffRef(size++) = k;
+          }
+        }
+        starts.coeffRef(nbCycles) = size;
+
+        if(PermuteInner)
+        {
+          for(int j = 0; j < outerSize; ++j)
+            for(int c = 0; c < nbCycles; ++c)
+              rotate(dst, j, &cycles.coeffRef(starts.coeff(c)), starts.coeff(c+1)-starts.coeff(c));
+        }
+        else
+        {
+          typename DestLine::PlainObject tmp;
+          for(int c = 0; c < nbCycles; ++c)
+          {
+            const int* cycle = &cycles.coeffRef(starts.coeff(c));
+            const int last = starts.coeff(c+1)-starts.coeff(c)-1;
+            if(Gather)
+            {
+              tmp = DestLine(dst,cycle[0]);
+              for(int i = 0; i < last; ++i)
+                DestLine(dst,cycle[i]) = DestLine(dst,cycle[i+1]);
+              DestLine(dst,cycle[last]) = tmp;
+            }
+            else
+            {
+              tmp = DestLine(dst,cycle[last]);
+              for(int i = last; i > 0; --i)
+                DestLine(dst,cycle[i]) = DestLine(dst,cycle[i-1]);
+              DestLine(dst,cycle[0]) = tmp;
+            }
           }
         }
       }
+      else if(PermuteInner)
+      {
+        for(int j = 0; j < outerSize; ++j)
+          for(int i = 0; i < n; ++i)
+          {
+            if(Gather) coeffRef(dst,i,j) = coeff(m_matrix,indices[i],j);
+            else       coeffRef(dst,indices[i],j) = coeff(m_matrix,i,j);
+          }
+      }
       else
       {
         for(int i = 0; i < n; ++i)
         {
-          Block<Dest, Side==OnTheLeft ? 1 : Dest::RowsAtCompileTime, Side==OnTheRight ? 1 : Dest::ColsAtCompileTime>
-               (dst, ((Side==OnTheLeft) ^ Transposed) ? m_permutation.indices().coeff(i) : i)
+          DestLine(dst, Gather ? i : indices[i])
 
           =
 
           Block<MatrixTypeNestedCleaned,Side==OnTheLeft ? 1 : MatrixType::RowsAtCompileTime,Side==OnTheRight ? 1 : MatrixType::ColsAtCompileTime>
-               (m_matrix, ((Side==OnTheRight) ^ Transposed) ? m_permutation.indices().coeff(i) : i);
+               (m_matrix, Gather ? indices[i] : i);
         }
       }
     }
 
   protected:
+    /* access to the coefficient \a k of the line \a j, where the lines are the columns (resp. rows) of the
+     * matrices when the permutation is applied on the left (resp. right) */
+    template<typename Dest> static inline typename Dest::Scalar& coeffRef(Dest& dst, int k, int j)
+    { return Side==OnTheLeft ? dst.coeffRef(k,j) : dst.coeffRef(j,k); }
+    template<typename Other> static inline typename Other::CoeffReturnType coeff(const Other& other, int k, int j)
+    { return Side==OnTheLeft ? other.coeff(k,j) : other.coeff(j,k); }
+
+    /* rotates the coefficients of the line \a j along the cycle \a cycle of length \a size */
+    template<typename Dest> static inline void rotate(Dest& dst, int j, const int* cycle, int size)
+    {
+      const int last = size-1;
+      if(Gather)
+      {
+        Scalar tmp = coeffRef(dst,cycle[0],j);
+        for(int i = 0; i < last; ++i)
+          coeffRef(dst,cycle[i],j) = coeffRef(dst,cycle[i+1],j);
+        coeffRef(dst,cycle[last],j) = tmp;
+      }
+      else
+      {
+        Scalar tmp = coeffRef(dst,cycle[last],j);
+        for(int i = last; i > 0; --i)
+          coeffRef(dst,cycle[i],j) = coeffRef(dst,cycle[i-1],j);
+        coeffRef(dst,cycle[0],j) = tmp;
+      }
+    }
+
     const PermutationType& m_permutation;
     const typename MatrixType::Nested m_matrix;
 };
 
+/** \internal
+  * Applies to the rows of \a mat the sequence of transpositions \f$ (i, transpositions[i]) \f$ for \a i
+  * from \a first to \a last-1, in this order, as LAPACK's xLASWP does.
+  *
+  * For a column major matrix, the whole sequence is applied to one column at a time rather than
+  * swapping full rows, so that the matrix is traversed only once whatever the number of transpositions.
+  */
+template<typename MatrixType>
+void ei_apply_row_transpositions(MatrixType& mat, const int* transpositions, int first, int last)
+{
+  if(int(MatrixType::Flags)&RowMajorBit)
+  {
+    for(int i = first; i < last; ++i)
+      if(transpositions[i]!=i)
+        mat.row(i).swap(mat.row(transpositions[i]));
+  }
+  else
+  {
+    for(int j = 0; j < mat.cols(); ++j)
+      for(int i = first; i < last; ++i)
+        std::swap(mat.coeffRef(i,j), mat.coeffRef(transpositions[i],j));
+  }
+}
+
 /* Template partial specialization for transposed/inverse permutations */
 
 template<int SizeAtCompileTime, int MaxSizeAtCompileTime>
@@ -45,9 +45,6 @@ inline void ei_stable_norm_kernel(const ExpressionType& bl, Scalar& ssq, Scalar&
   *  1 - find the absolute largest coefficient \c s
   *  2 - compute \f$ s \Vert \frac{*this}{s} \Vert \f$ in a standard way
   *
-  * For architecture/scalar types supporting vectorization, this version
-  * is faster than blueNorm(). Otherwise the blueNorm() is much faster.
-  *
   * \sa norm(), blueNorm(), hypotNorm()
   */
 template<typename Derived>
@@ -74,34 +71,26 @@ MatrixBase<Derived>::stableNorm() const
   return scale * ei_sqrt(ssq);
 }
 
-/** \returns the \em l2 norm of \c *this using the Blue's algorithm.
-  * A Portable Fortran Program to Find the Euclidean Norm of a Vector,
-  * ACM TOMS, Vol 4, Issue 1, 1978.
-  *
-  * For architecture/scalar types without vectorization, this version
-  * is much faster than stableNorm(). Otherwise the stableNorm() is faster.
-  *
-  * \sa norm(), stableNorm(), hypotNorm()
+/** \internal
+  * Machine dependent constants of the Blue's algorithm. They are computed once per scalar type.
   */
-template<typename Derived>
-inline typename NumTraits<typename ei_traits<Derived>::Scalar>::Real
-MatrixBase<Derived>::blueNorm() const
+template<typename RealScalar>
+struct ei_blue_norm_constants
 {
-  static int nmax = -1;
-  static RealScalar b1, b2, s1m, s2m, overfl, rbig, relerr;
-  if(nmax <= 0)
+  RealScalar b1, b2, s1m, s2m, overfl, rbig, relerr;
+
+  ei_blue_norm_constants()
   {
-    int nbig, ibeta, it, iemin, iemax, iexp;
-    RealScalar abig, eps;
+    int ibeta, it, iemin, iemax, iexp;
+    RealScalar eps;
     // This program calculates the machine-dependent constants
-    // bl, b2, slm, s2m, relerr overfl, nmax
+    // bl, b2, slm, s2m, relerr overfl
     // from the "basic" machine-dependent numbers
-    // nbig, ibeta, it, iemin, iemax, rbig.
+    // ibeta, it, iemin, iemax, rbig.
     // The following define the basic machine-dependent constants.
     // For portability, the PORT subprograms "ilmaeh" and "rlmach"
     // are used. For any specific computer, each of the assignment
     // statements can be replaced
-    nbig  = std::numeric_limits<int>::max();            // largest integer
     ibeta = std::numeric_limits<RealScalar>::radix;         // base for floating-point numbers
     it    = std::numeric_limits<RealScalar>::digits;        // number of base-beta digits in mantissa
     iemin = std::numeric_limits<RealScalar>::min_exponent;  // minimum exponent
@@ -121,58 +110,226 @@ MatrixBase<Derived>::blueNorm() const
     overfl  = rbig*s2m;             // overflow boundary for abig
     eps     = RealScalar(std::pow(double(ibeta), 1-it));
     relerr  = ei_sqrt(eps);         // tolerance for neglecting asml
-    abig    = RealScalar(1.0/eps - 1.0);
-    if (RealScalar(nbig)>abig)  nmax = int(abig);  // largest safe n
-    else                        nmax = nbig;
   }
-  int n = size();
-  RealScalar ab2 = b2 / RealScalar(n);
-  RealScalar asml = RealScalar(0);
-  RealScalar amed = RealScalar(0);
-  RealScalar abig = RealScalar(0);
-  for(int j=0; j<n; ++j)
+
+  static const ei_blue_norm_constants& get()
   {
-    RealScalar ax = ei_abs(coeff(j));
-    if(ax > ab2)     abig += ei_abs2(ax*s2m);
-    else if(ax < b1) asml += ei_abs2(ax*s1m);
-    else             amed += ei_abs2(ax);
+    static const ei_blue_norm_constants constants;
+    return constants;
+  }
+};
+
+/** \internal
+  * Adds the squares of the coefficients \a start to \a end-1 of \a vec to the three accumulators of
+  * the Blue's algorithm: the small coefficients are scaled by s1m into \a asml, the big ones (larger
+  * than \a ab2) by s2m into \a abig, and the others go unscaled into \a amed.
+  *
+  * The vectorized version keeps the three accumulators per lane: each packet is split into its small,
+  * medium and big coefficients by comparison masks, so that the whole range is processed in a single pass.
+  */
+template<typename Derived, bool Vectorize = bool(int(Derived::Flags)&PacketAccessBit)
+                                         && bool(int(Derived::Flags)&LinearAccessBit)
+                                         && !NumTraits<typename Derived::Scalar>::IsComplex
+                                         && (int(ei_packet_traits<typename Derived::Scalar>::size)>1)>
+struct ei_blue_norm_accumulate
+{
+  typedef typename NumTraits<typename Derived::Scalar>::Real RealScalar;
+
+  static void run(const Derived& vec, int start, int end, RealScalar ab2, const ei_blue_norm_constants<RealScalar>& c,
+                  RealScalar& asml, RealScalar& amed, RealScalar& abig)
+  {
+    for(int j=start; j<end; ++j)
+    {
+      RealScalar ax = ei_abs(vec.coeff(j));
+      if(ax > ab2)       abig += ei_abs2(ax*c.s2m);
+      else if(ax < c.b1) asml += ei_abs2(ax*c.s1m);
+      else               amed += ei_abs2(ax);
+    }
+  }
+};
+
+template<typename Derived>
+struct ei_blue_norm_accumulate<Derived, true>
+{
+  typedef typename Derived::Scalar RealScalar;
+  typedef typename ei_packet_traits<RealScalar>::type Packet;
+  enum {
+    PacketSize = ei_packet_traits<RealScalar>::size,
+    Alignment = (int(Derived::Flags)&DirectAccessBit) || (int(Derived::Flags)&AlignedBit) ? Aligned : Unaligned
+  };
+
+  static void run(const Derived& vec, int start, int end, RealScalar ab2, const ei_blue_norm_constants<RealScalar>& c,
+                  RealScalar& asml, RealScalar& amed, RealScalar& abig)
+  {
+    int alignedStart = start;
+    if(int(Derived::Flags)&DirectAccessBit)
+      alignedStart += ei_first_aligned(&vec.const_cast_derived().coeffRef(start), end-start);
+    else if(int(Derived::Flags)&AlignedBit)
+      alignedStart = std::min(end, ((start+PacketSize-1)/PacketSize)*PacketSize);
+    const int alignedEnd = alignedStart + ((end-alignedStart)/PacketSize)*PacketSize;
+
+    ei_blue_norm_accumulate<Derived,false>::run(vec, start, alignedStart, ab2, c, asml, amed, abig);
+    if(alignedEnd>alignedStart)
+    {
+      const Packet pab2 = ei_pset1(ab2), pb1 = ei_pset1(c.b1), ps1m = ei_pset1(c.s1m), ps2m = ei_pset1(c.s2m);
+      Packet psml = ei_pset1(RealScalar(0)), pmed = psml, pbig = psml;
+      for(int j=alignedStart; j<alignedEnd; j+=PacketSize)
+      {
+        Packet ax  = ei_pabs(vec.template packet<Alignment>(j));
+        Packet big = ei_pand(ax, ei_pcmp_lt(pab2, ax));
+        Packet sml = ei_pand(ax, ei_pcmp_lt(ax, pb1));
+        Packet med = ei_psub(ei_psub(ax, big), sml);
+        big = ei_pmul(big, ps2m);
+        sml = ei_pmul(sml, ps1m);
+        pbig = ei_pmadd(big, big, pbig);
+        psml = ei_pmadd(sml, sml, psml);
+        pmed = ei_pmadd(med, med, pmed);
+      }
+      asml += ei_predux(psml);
+      amed += ei_predux(pmed);
+      abig += ei_predux(pbig);
+    }
+    ei_blue_norm_accumulate<Derived,false>::run(vec, alignedEnd, end, ab2, c, asml, amed, abig);
   }
+};
+
+/** \internal \returns the norm from the three accumulators of the Blue's algorithm */
+template<typename RealScalar>
+RealScalar ei_blue_norm_finalize(RealScalar asml, RealScalar amed, RealScalar abig, const ei_blue_norm_constants<RealScalar>& c)
+{
   if(abig > RealScalar(0))
   {
     abig = ei_sqrt(abig);
-    if(abig > overfl)
+    if(abig > c.overfl)
     {
       ei_assert(false && "overflow");
-      return rbig;
+      return c.rbig;
     }
     if(amed > RealScalar(0))
     {
-      abig = abig/s2m;
+      abig = abig/c.s2m;
       amed = ei_sqrt(amed);
     }
     else
-      return abig/s2m;
+      return abig/c.s2m;
   }
   else if(asml > RealScalar(0))
   {
     if (amed > RealScalar(0))
     {
       abig = ei_sqrt(amed);
-      amed = ei_sqrt(asml) / s1m;
+      amed = ei_sqrt(asml) / c.s1m;
     }
     else
-      return ei_sqrt(asml)/s1m;
+      return ei_sqrt(asml)/c.s1m;
   }
   else
     return ei_sqrt(amed);
   asml = std::min(abig, amed);
   abig = std::max(abig, amed);
-  if(asml <= abig*relerr)
+  if(asml <= abig*c.relerr)
     return abig;
   else
     return abig * ei_sqrt(RealScalar(1) + ei_abs2(asml/abig));
 }
 
+/** \internal
+  * Computes the Blue's norm of each of the lines of \a mat which are strided in memory, i.e., the columns
+  * of a row major matrix or the rows of a column major one, and stores them into \a dst.
+  * The matrix is traversed once along its storage order while the accumulators of a block of lines
+  * are updated by packets.
+  */
+template<typename MatrixType, typename Dest>
+void ei_blue_norm_strided_lines(const MatrixType& mat, Dest& dst)
+{
+  typedef typename MatrixType::Scalar RealScalar;
+  typedef typename ei_packet_traits<RealScalar>::type Packet;
+  typedef Matrix<RealScalar,Dynamic,1> AccumulatorType;
+  enum {
+    PacketSize = ei_packet_traits<RealScalar>::size,
+    IsRowMajor = bool(int(MatrixType::Flags)&RowMajorBit),
+    BlockSize = 512
+  };
+  const ei_blue_norm_constants<RealScalar>& c = ei_blue_norm_constants<RealScalar>::get();
+  const int lines = IsRowMajor ? mat.cols() : mat.rows();
+  const int size  = IsRowMajor ? mat.rows() : mat.cols();
+  const RealScalar ab2 = c.b2 / RealScalar(size);
+  const Packet pab2 = ei_pset1(ab2), pb1 = ei_pset1(c.b1), ps1m = ei_pset1(c.s1m), ps2m = ei_pset1(c.s2m);
+
+  AccumulatorType asml(std::min<int>(lines,BlockSize)), amed(asml.size()), abig(asml.size());
+  for(int i0 = 0; i0 < lines; i0 += BlockSize)
+  {
+    const int bs = std::min<int>(lines-i0, BlockSize);
+    const int packetEnd = (bs/PacketSize)*PacketSize;
+    asml.setZero(); amed.setZero(); abig.setZero();
+    for(int j = 0; j < size; ++j)
+    {
+      for(int i = 0; i < packetEnd; i += PacketSize)
+      {
+        Packet ax  = ei_pabs(IsRowMajor ? mat.template packet<Unaligned>(j, i0+i) : mat.template packet<Unaligned>(i0+i, j));
+        Packet big = ei_pand(ax, ei_pcmp_lt(pab2, ax));
+        Packet sml = ei_pand(ax, ei_pcmp_lt(ax, pb1));
+        Packet med = ei_psub(ei_psub(ax, big), sml);
+        big = ei_pmul(big, ps2m);
+        sml = ei_pmul(sml, ps1m);
+        ei_pstore(&abig.coeffRef(i), ei_pmadd(big, big, ei_pload(&abig.coeff(i))));
+        ei_pstore(&asml.coeffRef(i), ei_pmadd(sml, sml, ei_pload(&asml.coeff(i))));
+        ei_pstore(&amed.coeffRef(i), ei_pmadd(med, med, ei_pload(&amed.coeff(i))));
+      }
+      for(int i = packetEnd; i < bs; ++i)
+      {
+        RealScalar ax = ei_abs(IsRowMajor ? mat.coeff(j, i0+i) : mat.coeff(i0+i, j));
+        if(ax > ab2)       abig.coeffRef(i) += ei_abs2(ax*c.s2m);
+        else if(ax < c.b1) asml.coeffRef(i) += ei_abs2(ax*c.s1m);
+        else               amed.coeffRef(i) += ei_abs2(ax);
+      }
+    }
+    for(int i = 0; i < bs; ++i)
+      dst.coeffRef(i0+i) = ei_blue_norm_finalize(asml.coeff(i), amed.coeff(i), abig.coeff(i), c);
+  }
+}
+
+/** \returns the \em l2 norm of \c *this using the Blue's algorithm.
+  * A Portable Fortran Program to Find the Euclidean Norm of a Vector,
+  * ACM TOMS, Vol 4, Issue 1, 1978.
+  *
+  * The coefficients are processed in a single pass which is vectorized for real scalar types.
+  * When OpenMP is enabled, large vectors are split among the threads.
+  *
+  * \sa norm(), stableNorm(), hypotNorm()
+  */
+template<typename Derived>
+inline typename NumTraits<typename ei_traits<Derived>::Scalar>::Real
+MatrixBase<Derived>::blueNorm() const
+{
+  enum { ParallelThreshold = 1<<16 }; // minimal number of coefficients per thread
+  const ei_blue_norm_constants<RealScalar>& c = ei_blue_norm_constants<RealScalar>::get();
+  const int n = size();
+  const RealScalar ab2 = c.b2 / RealScalar(n);
+  RealScalar asml = RealScalar(0);
+  RealScalar amed = RealScalar(0);
+  RealScalar abig = RealScalar(0);
+#ifdef EIGEN_HAS_OPENMP
+  const int threads = omp_get_num_threads()==1 ? std::min(omp_get_max_threads(), n/ParallelThreshold) : 1;
+  if(threads > 1)
+  {
+    #pragma omp parallel for reduction(+:asml,amed,abig) schedule(static) num_threads(threads)
+    for(int t = 0; t < threads; ++t)
+    {
+      const int chunk = n/threads, start = t*chunk, end = t+1==threads ? n : start+chunk;
+      RealScalar tsml(0), tmed(0), tbig(0);
+      ei_blue_norm_accumulate<Derived>::run(derived(), start, end, ab2, c, tsml, tmed, tbig);
+      asml += tsml;
+      amed += tmed;
+      abig += tbig;
+    }
+  }
+  else
+#endif
+  ei_blue_norm_accumulate<Derived>::run(derived(), 0, n, ab2, c, asml, amed, abig);
+  return ei_blue_norm_finalize(asml, amed, abig, c);
+}
+
 /** \returns the \em l2 norm of \c *this avoiding undeflow and overflow.
   * This version use a concatenation of hypot() calls, and it is very slow.
   *
@@ -379,4 +379,11 @@ static EIGEN_UNUSED Packet4f ei_psqrt(Packet4f _x)
 	return ei_pmul(_x,x);
 }
 
+// In double precision there is no fast approximation, but the IEEE square root
+// instruction still processes two coefficients at once.
+static EIGEN_UNUSED Packet2d ei_psqrt(Packet2d x)
+{
+  return _mm_sqrt_pd(x);
+}
+
 #endif // EIGEN_MATH_FUNCTIONS_SSE_H
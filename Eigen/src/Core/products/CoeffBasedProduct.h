@@ -89,10 +89,15 @@ struct ei_traits<CoeffBasedProduct<LhsNested,RhsNested,NestingFlags> >
                      : (MaxColsAtCompileTime==1&&MaxRowsAtCompileTime!=1) ? 0
                      : (RhsRowMajor && !CanVectorizeLhs),
 
+      /* When the lhs (resp. rhs) is vectorized, the packets of the product are read from aligned
+       * columns (resp. rows) of the lhs (resp. rhs), so that the product inherits its alignment. This
+       * is what allows the small fixed size products to be evaluated by packets. */
       Flags = ((unsigned int)(LhsFlags | RhsFlags) & HereditaryBits & ~RowMajorBit)
             | (EvalToRowMajor ? RowMajorBit : 0)
             | NestingFlags
-            | (CanVectorizeLhs || CanVectorizeRhs ? PacketAccessBit : 0),
+            | (CanVectorizeLhs || CanVectorizeRhs ? PacketAccessBit : 0)
+            | (CanVectorizeLhs && !EvalToRowMajor ? (LhsFlags & AlignedBit) : 0)
+            | (CanVectorizeRhs && EvalToRowMajor ? (RhsFlags & AlignedBit) : 0),
 
       CoeffReadCost = InnerSize == Dynamic ? Dynamic
                     : InnerSize * (NumTraits<Scalar>::MulCost + LhsCoeffReadCost + RhsCoeffReadCost)
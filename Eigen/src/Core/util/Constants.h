@@ -215,7 +215,8 @@ enum {
   SkipV = 0x2,
   AtLeastAsManyRowsAsCols = 0x4,
   AtLeastAsManyColsAsRows = 0x8,
-  Square = AtLeastAsManyRowsAsCols | AtLeastAsManyColsAsRows
+  Square = AtLeastAsManyRowsAsCols | AtLeastAsManyColsAsRows,
+  OneSidedJacobi = 0x10
 };
 
 /* the following could as well be written:
@@ -179,6 +179,11 @@ template<typename MatrixType,int Direction> class Homogeneous;
 // MatrixFunctions module
 template<typename Derived> struct MatrixExponentialReturnValue;
 template<typename Derived> class MatrixFunctionReturnValue;
+template<typename Derived> class MatrixSquareRootReturnValue;
+template<typename Derived> class MatrixLogarithmReturnValue;
+
+// Serialization module
+template<typename T> struct ei_binary_serializer;
 template <typename Scalar>
 struct ei_stem_function
 {
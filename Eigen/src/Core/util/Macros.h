@@ -211,6 +211,11 @@
 #define EIGEN_STACK_ALLOCATION_LIMIT 20000
 #endif
 
+// the maximal sizes of the fixed size matrices whose decompositions are fully unrolled
+#ifndef EIGEN_DECOMPOSITION_UNROLLING_LIMIT
+#define EIGEN_DECOMPOSITION_UNROLLING_LIMIT 8
+#endif
+
 #ifndef EIGEN_DEFAULT_IO_FORMAT
 #define EIGEN_DEFAULT_IO_FORMAT Eigen::IOFormat()
 #endif
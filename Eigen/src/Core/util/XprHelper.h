@@ -402,4 +402,17 @@ struct ei_plain_diag_type
   typedef Matrix<Scalar, diag_size, 1, MatrixType::PlainObject::Options & ~RowMajor, max_diag_size, 1> type;
 };
 
+/** \internal tells whether the decompositions of a matrix type are fully unrolled at compile time,
+  * that is whether it has fixed sizes not larger than EIGEN_DECOMPOSITION_UNROLLING_LIMIT.
+  * \returns CompleteUnrolling or NoUnrolling
+  */
+template<typename MatrixType>
+struct ei_decomposition_unrolling
+{
+  enum { ret = MatrixType::RowsAtCompileTime != Dynamic && MatrixType::ColsAtCompileTime != Dynamic
+            && MatrixType::RowsAtCompileTime <= EIGEN_DECOMPOSITION_UNROLLING_LIMIT
+            && MatrixType::ColsAtCompileTime <= EIGEN_DECOMPOSITION_UNROLLING_LIMIT
+             ? CompleteUnrolling : NoUnrolling };
+};
+
 #endif // EIGEN_XPRHELPER_H
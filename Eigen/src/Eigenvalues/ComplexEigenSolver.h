@@ -99,7 +99,8 @@ template<typename _MatrixType> class ComplexEigenSolver
             : m_eivec(),
               m_eivalues(),
               m_schur(),
-              m_isInitialized(false)
+              m_isInitialized(false),
+              m_eigenvectorsOk(false)
     {}
     
     /** \brief Default Constructor with memory preallocation
@@ -112,22 +113,27 @@ template<typename _MatrixType> class ComplexEigenSolver
             : m_eivec(size, size),
               m_eivalues(size),
               m_schur(size),
-              m_isInitialized(false)
+              m_isInitialized(false),
+              m_eigenvectorsOk(false)
     {}
 
     /** \brief Constructor; computes eigendecomposition of given matrix. 
       * 
       * \param[in]  matrix  Square matrix whose eigendecomposition is to be computed.
+      * \param[in]  computeEigenvectors  If true, both the eigenvectors and the
+      *    eigenvalues are computed; if false, only the eigenvalues are
+      *    computed.
       *
       * This constructor calls compute() to compute the eigendecomposition.
       */
-    ComplexEigenSolver(const MatrixType& matrix)
+    ComplexEigenSolver(const MatrixType& matrix, bool computeEigenvectors = true)
             : m_eivec(matrix.rows(),matrix.cols()),
               m_eivalues(matrix.cols()),
               m_schur(matrix.rows()),
-              m_isInitialized(false)
+              m_isInitialized(false),
+              m_eigenvectorsOk(false)
     {
-      compute(matrix);
+      compute(matrix, computeEigenvectors);
     }
 
     /** \brief Returns the eigenvectors of given matrix. 
@@ -150,6 +156,7 @@ template<typename _MatrixType> class ComplexEigenSolver
     EigenvectorType eigenvectors() const
     {
       ei_assert(m_isInitialized && "ComplexEigenSolver is not initialized.");
+      ei_assert(m_eigenvectorsOk && "The eigenvectors have not been computed together with the eigenvalues.");
       return m_eivec;
     }
 
@@ -176,10 +183,14 @@ template<typename _MatrixType> class ComplexEigenSolver
     /** \brief Computes eigendecomposition of given matrix. 
       * 
       * \param[in]  matrix  Square matrix whose eigendecomposition is to be computed.
+      * \param[in]  computeEigenvectors  If true, both the eigenvectors and the
+      *    eigenvalues are computed; if false, only the eigenvalues are
+      *    computed.
       *
-      * This function computes the eigenvalues and eigenvectors of \p
-      * matrix.  The eigenvalues() and eigenvectors() functions can be
-      * used to retrieve the computed eigendecomposition.
+      * This function computes the eigenvalues of \p matrix, and its
+      * eigenvectors if \p computeEigenvectors is true. The eigenvalues()
+      * and eigenvectors() functions can be used to retrieve the computed
+      * eigendecomposition.
       *
       * The matrix is first reduced to Schur form using the
       * ComplexSchur class. The Schur decomposition is then used to
@@ -192,18 +203,19 @@ template<typename _MatrixType> class ComplexEigenSolver
       * Example: \include ComplexEigenSolver_compute.cpp
       * Output: \verbinclude ComplexEigenSolver_compute.out
       */
-    void compute(const MatrixType& matrix);
+    void compute(const MatrixType& matrix, bool computeEigenvectors = true);
 
   protected:
     EigenvectorType m_eivec;
     EigenvalueType m_eivalues;
     ComplexSchur<MatrixType> m_schur;
     bool m_isInitialized;
+    bool m_eigenvectorsOk;
 };
 
 
 template<typename MatrixType>
-void ComplexEigenSolver<MatrixType>::compute(const MatrixType& matrix)
+void ComplexEigenSolver<MatrixType>::compute(const MatrixType& matrix, bool computeEigenvectors)
 {
   // this code is inspired from Jampack
   assert(matrix.cols() == matrix.rows());
@@ -212,40 +224,44 @@ void ComplexEigenSolver<MatrixType>::compute(const MatrixType& matrix)
 
   // Step 1: Do a complex Schur decomposition, A = U T U^*
   // The eigenvalues are on the diagonal of T.
-  m_schur.compute(matrix);
+  m_schur.compute(matrix, !computeEigenvectors);
   m_eivalues = m_schur.matrixT().diagonal();
 
-  // Step 2: Compute X such that T = X D X^(-1), where D is the diagonal of T.
-  // The matrix X is unit triangular.
-  EigenvectorType X = EigenvectorType::Zero(n, n);
-  for(int k=n-1 ; k>=0 ; k--)
+  if(computeEigenvectors)
   {
-    X.coeffRef(k,k) = ComplexScalar(1.0,0.0);
-    // Compute X(i,k) using the (i,k) entry of the equation X T = D X
-    for(int i=k-1 ; i>=0 ; i--)
+    // Step 2: Compute X such that T = X D X^(-1), where D is the diagonal of T.
+    // The matrix X is unit triangular.
+    EigenvectorType X = EigenvectorType::Zero(n, n);
+    for(int k=n-1 ; k>=0 ; k--)
     {
-      X.coeffRef(i,k) = -m_schur.matrixT().coeff(i,k);
-      if(k-i-1>0)
-        X.coeffRef(i,k) -= (m_schur.matrixT().row(i).segment(i+1,k-i-1) * X.col(k).segment(i+1,k-i-1)).value();
-      ComplexScalar z = m_schur.matrixT().coeff(i,i) - m_schur.matrixT().coeff(k,k);
-      if(z==ComplexScalar(0))
+      X.coeffRef(k,k) = ComplexScalar(1.0,0.0);
+      // Compute X(i,k) using the (i,k) entry of the equation X T = D X
+      for(int i=k-1 ; i>=0 ; i--)
       {
-	// If the i-th and k-th eigenvalue are equal, then z equals 0. 
-	// Use a small value instead, to prevent division by zero.
-        ei_real_ref(z) = NumTraits<RealScalar>::epsilon() * matrixnorm;
+        X.coeffRef(i,k) = -m_schur.matrixT().coeff(i,k);
+        if(k-i-1>0)
+          X.coeffRef(i,k) -= (m_schur.matrixT().row(i).segment(i+1,k-i-1) * X.col(k).segment(i+1,k-i-1)).value();
+        ComplexScalar z = m_schur.matrixT().coeff(i,i) - m_schur.matrixT().coeff(k,k);
+        if(z==ComplexScalar(0))
+        {
+          // If the i-th and k-th eigenvalue are equal, then z equals 0. 
+          // Use a small value instead, to prevent division by zero.
+          ei_real_ref(z) = NumTraits<RealScalar>::epsilon() * matrixnorm;
+        }
+        X.coeffRef(i,k) = X.coeff(i,k) / z;
       }
-      X.coeffRef(i,k) = X.coeff(i,k) / z;
     }
-  }
 
-  // Step 3: Compute V as V = U X; now A = U T U^* = U X D X^(-1) U^* = V D V^(-1)
-  m_eivec = m_schur.matrixU() * X;
-  // .. and normalize the eigenvectors
-  for(int k=0 ; k<n ; k++)
-  {
-    m_eivec.col(k).normalize();
+    // Step 3: Compute V as V = U X; now A = U T U^* = U X D X^(-1) U^* = V D V^(-1)
+    m_eivec = m_schur.matrixU() * X;
+    // .. and normalize the eigenvectors
+    for(int k=0 ; k<n ; k++)
+    {
+      m_eivec.col(k).normalize();
+    }
   }
   m_isInitialized = true;
+  m_eigenvectorsOk = computeEigenvectors;
 
   // Step 4: Sort the eigenvalues
   for (int i=0; i<n; i++)
@@ -256,7 +272,8 @@ void ComplexEigenSolver<MatrixType>::compute(const MatrixType& matrix)
     {
       k += i;
       std::swap(m_eivalues[k],m_eivalues[i]);
-      m_eivec.col(i).swap(m_eivec.col(k));
+      if(computeEigenvectors)
+        m_eivec.col(i).swap(m_eivec.col(k));
     }
   }
 }
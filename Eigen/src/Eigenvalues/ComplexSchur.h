@@ -297,15 +297,14 @@ void ComplexSchur<MatrixType>::compute(const MatrixType& matrix, bool skipU)
 
   if(n==1)
   {
-    m_matU = ComplexMatrixType::Identity(1,1);
-    if(!skipU) m_matT = matrix.template cast<ComplexScalar>();
+    m_matT = matrix.template cast<ComplexScalar>();
+    if(!skipU) m_matU = ComplexMatrixType::Identity(1,1);
     m_isInitialized = true;
     m_matUisUptodate = !skipU;
     return;
   }
 
   // Reduce to Hessenberg form
-  // TODO skip Q if skipU = true
   m_hess.compute(matrix);
 
   m_matT = m_hess.matrixH().template cast<ComplexScalar>();
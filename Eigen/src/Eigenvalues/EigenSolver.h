@@ -120,7 +120,7 @@ template<typename _MatrixType> class EigenSolver
       *
       * \sa compute() for an example.
       */
-    EigenSolver() : m_eivec(), m_eivalues(), m_isInitialized(false) {}
+    EigenSolver() : m_eivec(), m_eivalues(), m_isInitialized(false), m_eigenvectorsOk(false) {}
 
     /** \brief Default Constructor with memory preallocation
       *
@@ -131,11 +131,15 @@ template<typename _MatrixType> class EigenSolver
     EigenSolver(int size)
       : m_eivec(size, size),
         m_eivalues(size),
-        m_isInitialized(false) {}
+        m_isInitialized(false),
+        m_eigenvectorsOk(false) {}
 
     /** \brief Constructor; computes eigendecomposition of given matrix. 
       * 
       * \param[in]  matrix  Square matrix whose eigendecomposition is to be computed.
+      * \param[in]  computeEigenvectors  If true, both the eigenvectors and the
+      *    eigenvalues are computed; if false, only the eigenvalues are
+      *    computed. 
       *
       * This constructor calls compute() to compute the eigenvalues
       * and eigenvectors.
@@ -145,12 +149,13 @@ template<typename _MatrixType> class EigenSolver
       *
       * \sa compute()
       */
-    EigenSolver(const MatrixType& matrix)
+    EigenSolver(const MatrixType& matrix, bool computeEigenvectors = true)
       : m_eivec(matrix.rows(), matrix.cols()),
         m_eivalues(matrix.cols()),
-        m_isInitialized(false)
+        m_isInitialized(false),
+        m_eigenvectorsOk(false)
     {
-      compute(matrix);
+      compute(matrix, computeEigenvectors);
     }
 
     /** \brief Returns the eigenvectors of given matrix. 
@@ -193,6 +198,7 @@ template<typename _MatrixType> class EigenSolver
     const MatrixType& pseudoEigenvectors() const
     {
       ei_assert(m_isInitialized && "EigenSolver is not initialized.");
+      ei_assert(m_eigenvectorsOk && "The eigenvectors have not been computed together with the eigenvalues.");
       return m_eivec;
     }
 
@@ -239,11 +245,15 @@ template<typename _MatrixType> class EigenSolver
     /** \brief Computes eigendecomposition of given matrix. 
       * 
       * \param[in]  matrix  Square matrix whose eigendecomposition is to be computed.
+      * \param[in]  computeEigenvectors  If true, both the eigenvectors and the
+      *    eigenvalues are computed; if false, only the eigenvalues are
+      *    computed. 
       * \returns    Reference to \c *this
       *
-      * This function computes the eigenvalues and eigenvectors of \p matrix.
-      * The eigenvalues() and eigenvectors() functions can be used to retrieve
-      * the computed eigendecomposition.
+      * This function computes the eigenvalues of \p matrix, and its
+      * eigenvectors if \p computeEigenvectors is true. The eigenvalues() and
+      * eigenvectors() functions can be used to retrieve the computed
+      * eigendecomposition.
       *
       * The matrix is first reduced to real Schur form using the RealSchur
       * class. The Schur decomposition is then used to compute the eigenvalues
@@ -251,14 +261,15 @@ template<typename _MatrixType> class EigenSolver
       *
       * The cost of the computation is dominated by the cost of the Schur
       * decomposition, which is very approximately \f$ 25n^3 \f$ where 
-      * \f$ n \f$ is the size of the matrix.
+      * \f$ n \f$ is the size of the matrix, and about \f$ 10n^3 \f$ if
+      * only the eigenvalues are computed.
       *
       * This method reuses of the allocated data in the EigenSolver object.
       *
       * Example: \include EigenSolver_compute.cpp
       * Output: \verbinclude EigenSolver_compute.out
       */
-    EigenSolver& compute(const MatrixType& matrix);
+    EigenSolver& compute(const MatrixType& matrix, bool computeEigenvectors = true);
 
   private:
     void hqr2_step2(MatrixType& matH);
@@ -267,13 +278,14 @@ template<typename _MatrixType> class EigenSolver
     MatrixType m_eivec;
     EigenvalueType m_eivalues;
     bool m_isInitialized;
+    bool m_eigenvectorsOk;
 };
 
 template<typename MatrixType>
 MatrixType EigenSolver<MatrixType>::pseudoEigenvalueMatrix() const
 {
   ei_assert(m_isInitialized && "EigenSolver is not initialized.");
-  int n = m_eivec.cols();
+  int n = m_eivalues.rows();
   MatrixType matD = MatrixType::Zero(n,n);
   for (int i=0; i<n; ++i)
   {
@@ -293,6 +305,7 @@ template<typename MatrixType>
 typename EigenSolver<MatrixType>::EigenvectorsType EigenSolver<MatrixType>::eigenvectors() const
 {
   ei_assert(m_isInitialized && "EigenSolver is not initialized.");
+  ei_assert(m_eigenvectorsOk && "The eigenvectors have not been computed together with the eigenvalues.");
   int n = m_eivec.cols();
   EigenvectorsType matV(n,n);
   for (int j=0; j<n; ++j)
@@ -319,14 +332,15 @@ typename EigenSolver<MatrixType>::EigenvectorsType EigenSolver<MatrixType>::eige
 }
 
 template<typename MatrixType>
-EigenSolver<MatrixType>& EigenSolver<MatrixType>::compute(const MatrixType& matrix)
+EigenSolver<MatrixType>& EigenSolver<MatrixType>::compute(const MatrixType& matrix, bool computeEigenvectors)
 {
   assert(matrix.cols() == matrix.rows());
 
   // Reduce to real Schur form.
-  RealSchur<MatrixType> rs(matrix);
+  RealSchur<MatrixType> rs(matrix, computeEigenvectors);
   MatrixType matT = rs.matrixT();
-  m_eivec = rs.matrixU();
+  if (computeEigenvectors)
+    m_eivec = rs.matrixU();
 
   // Compute eigenvalues from matT
   m_eivalues.resize(matrix.cols());
@@ -349,9 +363,11 @@ EigenSolver<MatrixType>& EigenSolver<MatrixType>::compute(const MatrixType& matr
   }
   
   // Compute eigenvectors.
-  hqr2_step2(matT);
+  if (computeEigenvectors)
+    hqr2_step2(matT);
 
   m_isInitialized = true;
+  m_eigenvectorsOk = computeEigenvectors;
   return *this;
 }
 
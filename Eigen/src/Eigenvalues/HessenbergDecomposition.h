@@ -125,7 +125,9 @@ template<typename _MatrixType> class HessenbergDecomposition
       * matrix successively in the required form using Householder reflections
       * (see, e.g., Algorithm 7.4.2 in Golub \& Van Loan, <i>%Matrix
       * Computations</i>). The cost is \f$ 10n^3/3 \f$ flops, where \f$ n \f$
-      * denotes the size of the given matrix.
+      * denotes the size of the given matrix. For large matrices, the reflectors
+      * are gathered in panels, so that most of the work is done by matrix-matrix
+      * products (as in LAPACK's xGEHRD).
       *
       * This method reuses of the allocated data in the HessenbergDecomposition
       * object.
@@ -198,7 +200,8 @@ template<typename _MatrixType> class HessenbergDecomposition
       *
       * This function reconstructs the matrix Q from the Householder
       * coefficients and the packed matrix stored internally. This
-      * reconstruction requires \f$ 4n^3 / 3 \f$ flops.
+      * reconstruction requires \f$ 4n^3 / 3 \f$ flops, mostly spent in
+      * matrix-matrix products for large matrices.
       *
       * \sa matrixH() for an example
       */
@@ -230,7 +233,12 @@ template<typename _MatrixType> class HessenbergDecomposition
 
     typedef Matrix<Scalar, 1, Size, Options | RowMajor, 1, MaxSize> VectorType;
     typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef Matrix<Scalar, Dynamic, Dynamic> BlockType;
+    // the reduction works by panels of BlockSize columns while the trailing matrix is larger than BlockingCrossover
+    enum { BlockSize = 32, BlockingCrossover = 128 };
     static void _compute(MatrixType& matA, CoeffVectorType& hCoeffs, VectorType& temp);
+    static void _reducePanel(MatrixType& matA, CoeffVectorType& hCoeffs, int k, int blockSize);
+    static int _unblockedStart(int n);
     
   protected:
     MatrixType m_matrix;
@@ -258,7 +266,13 @@ void HessenbergDecomposition<MatrixType>::_compute(MatrixType& matA, CoeffVector
   assert(matA.rows()==matA.cols());
   int n = matA.rows();
   temp.resize(n);
-  for (int i = 0; i<n-1; ++i)
+
+  // the leading columns are reduced by panels, see _reducePanel()
+  const int unblockedStart = _unblockedStart(n);
+  for (int k = 0; k < unblockedStart; k += BlockSize)
+    _reducePanel(matA, hCoeffs, k, BlockSize);
+
+  for (int i = unblockedStart; i<n-1; ++i)
   {
     // let's consider the vector v = i-th column starting at position i+1
     int remainingSize = n-i-1;
@@ -281,6 +295,86 @@ void HessenbergDecomposition<MatrixType>::_compute(MatrixType& matA, CoeffVector
   }
 }
 
+/** \internal
+  * \returns the index of the first column which is reduced one reflector at a time: the columns
+  * before it are reduced by panels of BlockSize columns, as long as the trailing
+  * matrix is larger than BlockingCrossover.
+  */
+template<typename MatrixType>
+inline int HessenbergDecomposition<MatrixType>::_unblockedStart(int n)
+{
+  int k = 0;
+  while (n-k-1 > BlockingCrossover)
+    k += BlockSize;
+  return k;
+}
+
+/** \internal
+  * Reduces the columns \a k, ..., \a k + \a blockSize - 1 of \a matA, and applies the
+  * corresponding reflectors to the rest of the matrix.
+  *
+  * The reflectors \f$ G_j = I - \bar h_j v_j v_j^* \f$ of the panel are gathered in the
+  * block reflector \f$ G_k \cdots G_{k+b-1} = I - V T V^* \f$, where T is upper triangular,
+  * while the product \f$ Y = A V T \f$ is built along. The columns of the panel are updated
+  * just before their reduction, and the rest of the matrix is updated at the end by the
+  * matrix-matrix products \f$ A \leftarrow (I - V T V^*)^* (A - Y V^*) \f$.
+  *
+  * This is LAPACK's xLAHR2 followed by the trailing update of xGEHRD.
+  */
+template<typename MatrixType>
+void HessenbergDecomposition<MatrixType>::_reducePanel(MatrixType& matA, CoeffVectorType& hCoeffs, int k, int blockSize)
+{
+  const int n = matA.rows();
+  const int r = n-k-1; // size of the reflectors
+  BlockType V = BlockType::Zero(r, blockSize);
+  BlockType T = BlockType::Zero(blockSize, blockSize);
+  BlockType Y(n, blockSize);
+  Matrix<Scalar, Dynamic, 1> w(blockSize);
+
+  for (int j = 0; j < blockSize; ++j)
+  {
+    const int c = k+j;
+    if (j > 0)
+    {
+      // apply the previous reflectors of the panel to the column c, on the right ...
+      matA.col(c).tail(r).noalias() -= Y.block(k+1, 0, r, j) * V.row(j-1).head(j).adjoint();
+      // ... and on the left
+      w.head(j).noalias() = V.leftCols(j).adjoint() * matA.col(c).tail(r);
+      w.head(j) = T.topLeftCorner(j, j).adjoint() * w.head(j);
+      matA.col(c).tail(r).noalias() -= V.leftCols(j) * w.head(j);
+    }
+
+    RealScalar beta;
+    Scalar h;
+    matA.col(c).tail(r-j).makeHouseholderInPlace(h, beta);
+    matA.coeffRef(c+1, c) = beta;
+    hCoeffs.coeffRef(c) = h;
+    V.coeffRef(j, j) = Scalar(1);
+    V.col(j).tail(r-j-1) = matA.col(c).tail(r-j-1);
+
+    // the columns c+1,... are not updated yet, so that A V is read from them
+    const Scalar tau = ei_conj(h);
+    Y.col(j).tail(r).noalias() = matA.block(k+1, c+1, r, r-j) * V.col(j).tail(r-j);
+    T.col(j).head(j).noalias() = V.leftCols(j).adjoint() * V.col(j);
+    Y.col(j).tail(r).noalias() -= Y.block(k+1, 0, r, j) * T.col(j).head(j);
+    Y.col(j).tail(r) *= tau;
+    T.col(j).head(j) = -tau * (T.topLeftCorner(j, j) * T.col(j).head(j));
+    T.coeffRef(j, j) = tau;
+  }
+  Y.topRows(k+1).noalias() = matA.block(0, k+1, k+1, r) * V;
+  Y.topRows(k+1) = Y.topRows(k+1) * T;
+
+  // A = A (I - V T V^*) on the columns k+1,... which are not in the panel yet ...
+  const int trailing = n-k-blockSize;
+  matA.rightCols(trailing).noalias() -= Y * V.bottomRows(trailing).adjoint();
+  matA.block(0, k+1, k+1, blockSize-1).noalias() -= Y.topLeftCorner(k+1, blockSize-1) * V.topLeftCorner(blockSize-1, blockSize-1).adjoint();
+
+  // ... and A = (I - V T V^*)^* A
+  BlockType tmp = V.adjoint() * matA.bottomRightCorner(r, trailing);
+  tmp = T.adjoint() * tmp;
+  matA.bottomRightCorner(r, trailing).noalias() -= V * tmp;
+}
+
 template<typename MatrixType>
 typename HessenbergDecomposition<MatrixType>::MatrixType
 HessenbergDecomposition<MatrixType>::matrixQ() const
@@ -288,11 +382,32 @@ HessenbergDecomposition<MatrixType>::matrixQ() const
   int n = m_matrix.rows();
   MatrixType matQ = MatrixType::Identity(n,n);
   VectorType temp(n);
-  for (int i = n-2; i>=0; i--)
+  const int unblockedStart = _unblockedStart(n);
+  for (int i = n-2; i>=unblockedStart; i--)
   {
     matQ.bottomRightCorner(n-i-1,n-i-1)
         .applyHouseholderOnTheLeft(m_matrix.col(i).tail(n-i-2), ei_conj(m_hCoeffs.coeff(i)), &temp.coeffRef(0,0));
   }
+
+  // apply the panels of reflectors as block reflectors I - V T V^*
+  for (int k = unblockedStart-BlockSize; k >= 0; k -= BlockSize)
+  {
+    const int r = n-k-1;
+    BlockType V = BlockType::Zero(r, BlockSize);
+    BlockType T = BlockType::Zero(BlockSize, BlockSize);
+    for (int j = 0; j < BlockSize; ++j)
+    {
+      const Scalar tau = ei_conj(m_hCoeffs.coeff(k+j));
+      V.coeffRef(j, j) = Scalar(1);
+      V.col(j).tail(r-j-1) = m_matrix.col(k+j).tail(r-j-1);
+      T.col(j).head(j).noalias() = V.leftCols(j).adjoint() * V.col(j);
+      T.col(j).head(j) = -tau * (T.topLeftCorner(j, j) * T.col(j).head(j));
+      T.coeffRef(j, j) = tau;
+    }
+    BlockType tmp = V.adjoint() * matQ.bottomRightCorner(r, r);
+    tmp = T * tmp;
+    matQ.bottomRightCorner(r, r).noalias() -= V * tmp;
+  }
   return matQ;
 }
 
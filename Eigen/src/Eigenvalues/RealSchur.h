@@ -58,9 +58,11 @@
   * The documentation of RealSchur(const MatrixType&) contains an example of
   * the typical use of this class.
   *
-  * \note The implementation is adapted from
+  * \note The implementation of the double-shift iteration is adapted from
   * <a href="http://math.nist.gov/javanumerics/jama/">JAMA</a> (public domain).
-  * Their code is based on EISPACK.
+  * Their code is based on EISPACK. Large matrices are handled by the
+  * small-bulge multishift QR algorithm with aggressive early deflation, as in
+  * LAPACK's xHSEQR.
   *
   * \sa class ComplexSchur, class EigenSolver, class ComplexEigenSolver
   */
@@ -96,41 +98,46 @@ template<typename _MatrixType> class RealSchur
               m_matU(size, size),
               m_workspaceVector(size),
               m_hess(size),
-              m_isInitialized(false)
+              m_isInitialized(false),
+              m_matUisUptodate(false)
     { }
 
     /** \brief Constructor; computes real Schur decomposition of given matrix. 
       * 
-      * \param[in]  matrix  Square matrix whose Schur decomposition is to be computed.
+      * \param[in]  matrix    Square matrix whose Schur decomposition is to be computed.
+      * \param[in]  computeU  If true, both T and U are computed; if false, only T is computed.
       *
       * This constructor calls compute() to compute the Schur decomposition.
       *
       * Example: \include RealSchur_RealSchur_MatrixType.cpp
       * Output: \verbinclude RealSchur_RealSchur_MatrixType.out
       */
-    RealSchur(const MatrixType& matrix)
+    RealSchur(const MatrixType& matrix, bool computeU = true)
             : m_matT(matrix.rows(),matrix.cols()),
               m_matU(matrix.rows(),matrix.cols()),
               m_workspaceVector(matrix.rows()),
               m_hess(matrix.rows()),
-              m_isInitialized(false)
+              m_isInitialized(false),
+              m_matUisUptodate(false)
     {
-      compute(matrix);
+      compute(matrix, computeU);
     }
 
     /** \brief Returns the orthogonal matrix in the Schur decomposition. 
       *
       * \returns A const reference to the matrix U.
       *
-      * \pre Either the constructor RealSchur(const MatrixType&) or the member
-      * function compute(const MatrixType&) has been called before to compute
-      * the Schur decomposition of a matrix.
+      * \pre Either the constructor RealSchur(const MatrixType&, bool) or the
+      * member function compute(const MatrixType&, bool) has been called before
+      * to compute the Schur decomposition of a matrix, and \p computeU was set
+      * to true (the default value).
       *
-      * \sa RealSchur(const MatrixType&) for an example
+      * \sa RealSchur(const MatrixType&, bool) for an example
       */
     const MatrixType& matrixU() const
     {
       ei_assert(m_isInitialized && "RealSchur is not initialized.");
+      ei_assert(m_matUisUptodate && "The matrix U has not been computed during the RealSchur decomposition.");
       return m_matU;
     }
 
@@ -138,11 +145,11 @@ template<typename _MatrixType> class RealSchur
       *
       * \returns A const reference to the matrix T.
       *
-      * \pre Either the constructor RealSchur(const MatrixType&) or the member
-      * function compute(const MatrixType&) has been called before to compute
-      * the Schur decomposition of a matrix.
+      * \pre Either the constructor RealSchur(const MatrixType&, bool) or the
+      * member function compute(const MatrixType&, bool) has been called before
+      * to compute the Schur decomposition of a matrix.
       *
-      * \sa RealSchur(const MatrixType&) for an example
+      * \sa RealSchur(const MatrixType&, bool) for an example
       */
     const MatrixType& matrixT() const
     {
@@ -152,19 +159,44 @@ template<typename _MatrixType> class RealSchur
   
     /** \brief Computes Schur decomposition of given matrix. 
       * 
-      * \param[in]  matrix  Square matrix whose Schur decomposition is to be computed.
+      * \param[in]  matrix    Square matrix whose Schur decomposition is to be computed.
+      * \param[in]  computeU  If true, both T and U are computed; if false, only T is computed.
       *
       * The Schur decomposition is computed by first reducing the matrix to
       * Hessenberg form using the class HessenbergDecomposition. The Hessenberg
       * matrix is then reduced to triangular form by performing Francis QR
       * iterations with implicit double shift. The cost of computing the Schur
       * decomposition depends on the number of iterations; as a rough guide, it
-      * may be taken to be \f$25n^3\f$ flops.
+      * may be taken to be \f$25n^3\f$ flops if \a computeU is true and
+      * \f$10n^3\f$ flops if \a computeU is false.
+      *
+      * When the active part of the Hessenberg matrix is large, aggressive early
+      * deflation is applied to a window at its bottom right corner, and the
+      * iteration chases a chain of small bulges built from many shifts at once;
+      * the transformations are accumulated so that they are applied to the rest
+      * of the matrix by matrix-matrix products.
+      *
+      * See: K. Braman, R. Byers and R. Mathias, The multishift QR algorithm,
+      * Part I: Maintaining well-focused shifts and level 3 performance, and
+      * Part II: Aggressive early deflation, SIAM J. Matrix Anal. Appl. 23 (2002).
       *
       * Example: \include RealSchur_compute.cpp
       * Output: \verbinclude RealSchur_compute.out
       */
-    void compute(const MatrixType& matrix);
+    void compute(const MatrixType& matrix, bool computeU = true);
+
+    /** \brief Computes Schur decomposition of a Hessenberg matrix H = Q T Q^T
+      *
+      * \param[in]  matrixH   Upper Hessenberg matrix, for instance given by HessenbergDecomposition::matrixH().
+      * \param[in]  matrixQ   Orthogonal matrix Q, for instance given by HessenbergDecomposition::matrixQ().
+      * \param[in]  computeU  If true, both T and U are computed; if false, only T is computed.
+      *
+      * This is the second step of compute(), U being the product of \a matrixQ by the
+      * transformations applied to \a matrixH. The matrix \a matrixQ is only read if
+      * \a computeU is true.
+      */
+    template<typename HessMatrixType, typename OrthMatrixType>
+    void computeFromHessenberg(const HessMatrixType& matrixH, const OrthMatrixType& matrixQ, bool computeU = true);
 
   private:
     
@@ -173,41 +205,74 @@ template<typename _MatrixType> class RealSchur
     ColumnVectorType m_workspaceVector;
     HessenbergDecomposition<MatrixType> m_hess;
     bool m_isInitialized;
+    bool m_matUisUptodate;
 
     typedef Matrix<Scalar,3,1> Vector3s;
+    typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+    typedef Matrix<ComplexScalar,Dynamic,1> ShiftVectorType;
 
+    // active windows of at least MultishiftCrossover rows go through the multishift iteration
+    enum { MultishiftCrossover = 75 };
+
+    void reduceToRealSchur(bool computeU);
     Scalar computeNormOfT();
     int findSmallSubdiagEntry(int iu, Scalar norm);
-    void splitOffTwoRows(int iu, Scalar exshift);
+    void splitOffTwoRows(int iu, bool computeU, Scalar exshift);
     void computeShift(int iu, int iter, Scalar& exshift, Vector3s& shiftInfo);
     void initFrancisQRStep(int il, int iu, const Vector3s& shiftInfo, int& im, Vector3s& firstHouseholderVector);
-    void performFrancisQRStep(int il, int im, int iu, const Vector3s& firstHouseholderVector, Scalar* workspace);
+    void performFrancisQRStep(int il, int im, int iu, bool computeU, const Vector3s& firstHouseholderVector, Scalar* workspace);
+    int aggressiveEarlyDeflation(int il, int iu, int nw, Scalar exshift, bool computeU, ShiftVectorType& shifts);
+    void performMultishiftQRSweep(int il, int iu, const Matrix<ComplexScalar,2,Dynamic>& shiftPairs, bool computeU, Scalar* workspace);
+    static void multishiftParameters(int activeSize, int& numShifts, int& windowSize);
+    static void pairShifts(const ShiftVectorType& shifts, int numShifts, Matrix<ComplexScalar,2,Dynamic>& shiftPairs);
+    static void quasiTriangularEigenvalues(const WorkMatrixType& T, int size, ShiftVectorType& eivals);
+    static bool swapSchurBlocks(WorkMatrixType& T, WorkMatrixType& V, int j, int p, int q);
+    static void moveSchurBlockUp(WorkMatrixType& T, WorkMatrixType& V, int ifst, int ilst);
 };
 
 
 template<typename MatrixType>
-void RealSchur<MatrixType>::compute(const MatrixType& matrix)
+void RealSchur<MatrixType>::compute(const MatrixType& matrix, bool computeU)
 {
   assert(matrix.cols() == matrix.rows());
 
   // Step 1. Reduce to Hessenberg form
-  // TODO skip Q if skipU = true
   m_hess.compute(matrix);
   m_matT = m_hess.matrixH();
-  m_matU = m_hess.matrixQ();
+  if (computeU)
+    m_matU = m_hess.matrixQ();
 
   // Step 2. Reduce to real Schur form  
-  m_workspaceVector.resize(m_matU.cols());
+  reduceToRealSchur(computeU);
+}
+
+template<typename MatrixType>
+template<typename HessMatrixType, typename OrthMatrixType>
+void RealSchur<MatrixType>::computeFromHessenberg(const HessMatrixType& matrixH, const OrthMatrixType& matrixQ, bool computeU)
+{
+  m_matT = matrixH;
+  if (computeU)
+    m_matU = matrixQ;
+  reduceToRealSchur(computeU);
+}
+
+/** \internal Reduces the Hessenberg matrix m_matT to real Schur form, accumulating the transformations in m_matU if \a computeU is true. */
+template<typename MatrixType>
+void RealSchur<MatrixType>::reduceToRealSchur(bool computeU)
+{
+  const int size = m_matT.cols();
+  m_workspaceVector.resize(size);
   Scalar* workspace = &m_workspaceVector.coeffRef(0);
 
   // The matrix m_matT is divided in three parts. 
   // Rows 0,...,il-1 are decoupled from the rest because m_matT(il,il-1) is zero. 
   // Rows il,...,iu is the part we are working on (the active window).
   // Rows iu+1,...,end are already brought in triangular form.
-  int iu = m_matU.cols() - 1;
+  int iu = size - 1;
   int iter = 0; // iteration count
   Scalar exshift = 0.0; // sum of exceptional shifts
   Scalar norm = computeNormOfT();
+  bool multishift = false;
 
   while (iu >= 0)
   {
@@ -224,29 +289,88 @@ void RealSchur<MatrixType>::compute(const MatrixType& matrix)
     }
     else if (il == iu-1) // Two roots found
     {
-      splitOffTwoRows(iu, exshift);
+      splitOffTwoRows(iu, computeU, exshift);
       iu -= 2;
       iter = 0;
     }
-    else // No convergence yet
+    else if (iu-il+1 < MultishiftCrossover) // No convergence yet
     {
       Vector3s firstHouseholderVector, shiftInfo;
       computeShift(iu, iter, exshift, shiftInfo);
       iter = iter + 1;   // (Could check iteration count here.)
       int im;
       initFrancisQRStep(il, iu, shiftInfo, im, firstHouseholderVector);
-      performFrancisQRStep(il, im, iu, firstHouseholderVector, workspace);
+      performFrancisQRStep(il, im, iu, computeU, firstHouseholderVector, workspace);
+    }
+    else // No convergence yet, large active window
+    {
+      multishift = true;
+      if (il > 0)
+        m_matT.coeffRef(il, il-1) = Scalar(0);
+
+      int numShifts, windowSize;
+      multishiftParameters(iu-il+1, numShifts, windowSize);
+      if (iter >= 5) // enlarge the deflation window when it does not work well
+        windowSize = std::min(2*windowSize, (iu-il+1)/2);
+
+      ShiftVectorType shifts;
+      const int deflated = aggressiveEarlyDeflation(il, iu, windowSize, exshift, computeU, shifts);
+      iu -= deflated;
+      iter = deflated > 0 ? 0 : iter + 1;
+
+      // skip the sweep if the deflation window has converged enough
+      if (iu-il+1 >= MultishiftCrossover && 100*deflated <= 14*windowSize)
+      {
+        if (iter > 0 && iter % 6 == 0)
+        {
+          // exceptional shifts
+          shifts.resize(numShifts);
+          for (int i = 0; i < numShifts; i += 2)
+          {
+            const Scalar s = ei_abs(m_matT.coeff(iu-i,iu-i-1)) + ei_abs(m_matT.coeff(iu-i-1,iu-i-2));
+            shifts.coeffRef(i) = ComplexScalar(m_matT.coeff(iu-i,iu-i) + Scalar(0.75)*s, Scalar(0.6614378)*s);
+            shifts.coeffRef(i+1) = ei_conj(shifts.coeff(i));
+          }
+        }
+        else if (shifts.size() < 2)
+        {
+          // the eigenvalues of the bottom right corner
+          const int ns = std::min(numShifts, iu-il-1);
+          RealSchur<WorkMatrixType> cornerSchur(ns);
+          cornerSchur.computeFromHessenberg(m_matT.block(iu-ns+1, iu-ns+1, ns, ns), WorkMatrixType(), false);
+          quasiTriangularEigenvalues(cornerSchur.matrixT(), ns, shifts);
+        }
+
+        Matrix<ComplexScalar,2,Dynamic> shiftPairs;
+        pairShifts(shifts, std::min(numShifts, (iu-il-1)/3*2), shiftPairs);
+        if (shiftPairs.cols() > 0)
+          performMultishiftQRSweep(il, iu, shiftPairs, computeU, workspace);
+      }
     }
   } 
 
+  // the 2x2 blocks moved by the aggressive early deflation may have real eigenvalues
+  if (multishift)
+  {
+    for (int i = 1; i < size; ++i)
+    {
+      if (m_matT.coeff(i, i-1) != Scalar(0))
+      {
+        splitOffTwoRows(i, computeU, Scalar(0));
+        ++i;
+      }
+    }
+  }
+
   m_isInitialized = true;
+  m_matUisUptodate = computeU;
 }
 
 /** \internal Computes and returns vector L1 norm of T */
 template<typename MatrixType>
 inline typename MatrixType::Scalar RealSchur<MatrixType>::computeNormOfT()
 {
-  const int size = m_matU.cols();
+  const int size = m_matT.cols();
   // FIXME to be efficient the following would requires a triangular reduxion code
   // Scalar norm = m_matT.upper().cwiseAbs().sum() 
   //               + m_matT.bottomLeftCorner(size-1,size-1).diagonal().cwiseAbs().sum();
@@ -275,9 +399,9 @@ inline int RealSchur<MatrixType>::findSmallSubdiagEntry(int iu, Scalar norm)
 
 /** \internal Update T given that rows iu-1 and iu decouple from the rest. */
 template<typename MatrixType>
-inline void RealSchur<MatrixType>::splitOffTwoRows(int iu, Scalar exshift)
+inline void RealSchur<MatrixType>::splitOffTwoRows(int iu, bool computeU, Scalar exshift)
 {
-  const int size = m_matU.cols();
+  const int size = m_matT.cols();
 
   // The eigenvalues of the 2x2 matrix [a b; c d] are 
   // trace +/- sqrt(discr/4) where discr = tr^2 - 4*det, tr = a + d, det = ad - bc
@@ -298,7 +422,8 @@ inline void RealSchur<MatrixType>::splitOffTwoRows(int iu, Scalar exshift)
     m_matT.block(0, iu-1, size, size-iu+1).applyOnTheLeft(iu-1, iu, rot.adjoint());
     m_matT.block(0, 0, iu+1, size).applyOnTheRight(iu-1, iu, rot);
     m_matT.coeffRef(iu, iu-1) = Scalar(0); 
-    m_matU.applyOnTheRight(iu-1, iu, rot);
+    if (computeU)
+      m_matU.applyOnTheRight(iu-1, iu, rot);
   }
 
   if (iu > 1) 
@@ -373,12 +498,12 @@ inline void RealSchur<MatrixType>::initFrancisQRStep(int il, int iu, const Vecto
 
 /** \internal Perform a Francis QR step involving rows il:iu and columns im:iu. */
 template<typename MatrixType>
-inline void RealSchur<MatrixType>::performFrancisQRStep(int il, int im, int iu, const Vector3s& firstHouseholderVector, Scalar* workspace)
+inline void RealSchur<MatrixType>::performFrancisQRStep(int il, int im, int iu, bool computeU, const Vector3s& firstHouseholderVector, Scalar* workspace)
 {
   assert(im >= il);
   assert(im <= iu-2);
 
-  const int size = m_matU.cols();
+  const int size = m_matT.cols();
 
   for (int k = im; k <= iu-2; ++k)
   {
@@ -404,7 +529,8 @@ inline void RealSchur<MatrixType>::performFrancisQRStep(int il, int im, int iu,
       // These Householder transformations form the O(n^3) part of the algorithm
       m_matT.block(k, k, 3, size-k).applyHouseholderOnTheLeft(ess, tau, workspace);
       m_matT.block(0, k, std::min(iu,k+3) + 1, 3).applyHouseholderOnTheRight(ess, tau, workspace);
-      m_matU.block(0, k, size, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+      if (computeU)
+        m_matU.block(0, k, size, 3).applyHouseholderOnTheRight(ess, tau, workspace);
     }
   }
 
@@ -418,7 +544,8 @@ inline void RealSchur<MatrixType>::performFrancisQRStep(int il, int im, int iu,
     m_matT.coeffRef(iu-1, iu-2) = beta;
     m_matT.block(iu-1, iu-1, 2, size-iu+1).applyHouseholderOnTheLeft(ess, tau, workspace);
     m_matT.block(0, iu-1, iu+1, 2).applyHouseholderOnTheRight(ess, tau, workspace);
-    m_matU.block(0, iu-1, size, 2).applyHouseholderOnTheRight(ess, tau, workspace);
+    if (computeU)
+      m_matU.block(0, iu-1, size, 2).applyHouseholderOnTheRight(ess, tau, workspace);
   }
 
   // clean up pollution due to round-off errors
@@ -430,4 +557,374 @@ inline void RealSchur<MatrixType>::performFrancisQRStep(int il, int im, int iu,
   }
 }
 
+/** \internal Chooses the number of shifts and the size of the deflation window from the size of the active window, as LAPACK's IPARMQ does. */
+template<typename MatrixType>
+void RealSchur<MatrixType>::multishiftParameters(int activeSize, int& numShifts, int& windowSize)
+{
+  if (activeSize < 150)
+    numShifts = 10;
+  else if (activeSize < 590)
+    numShifts = std::max(10, activeSize / int(std::log(double(activeSize)) / std::log(2.0) + 0.5));
+  else if (activeSize < 3000)
+    numShifts = 64;
+  else if (activeSize < 6000)
+    numShifts = 128;
+  else
+    numShifts = 256;
+  numShifts -= numShifts % 2;
+  windowSize = activeSize <= 500 ? numShifts : 3*numShifts/2;
+}
+
+/** \internal Computes the eigenvalues of the \a size x \a size top left corner of the quasi-triangular \a T. */
+template<typename MatrixType>
+void RealSchur<MatrixType>::quasiTriangularEigenvalues(const WorkMatrixType& T, int size, ShiftVectorType& eivals)
+{
+  eivals.resize(size);
+  int i = 0;
+  while (i < size)
+  {
+    if (i == size-1 || T.coeff(i+1, i) == Scalar(0))
+    {
+      eivals.coeffRef(i) = T.coeff(i, i);
+      ++i;
+    }
+    else
+    {
+      const Scalar p = Scalar(0.5) * (T.coeff(i, i) - T.coeff(i+1, i+1));
+      const Scalar q = p * p + T.coeff(i+1, i) * T.coeff(i, i+1);
+      const Scalar z = ei_sqrt(ei_abs(q));
+      if (q < Scalar(0))
+      {
+        eivals.coeffRef(i)   = ComplexScalar(T.coeff(i+1, i+1) + p, z);
+        eivals.coeffRef(i+1) = ComplexScalar(T.coeff(i+1, i+1) + p, -z);
+      }
+      else
+      {
+        eivals.coeffRef(i)   = T.coeff(i+1, i+1) + p + z;
+        eivals.coeffRef(i+1) = T.coeff(i+1, i+1) + p - z;
+      }
+      i += 2;
+    }
+  }
+}
+
+/** \internal Groups the last shifts of \a shifts in at most \a numShifts / 2 pairs made of two
+  * real shifts or of two complex conjugate shifts, which are adjacent in \a shifts. */
+template<typename MatrixType>
+void RealSchur<MatrixType>::pairShifts(const ShiftVectorType& shifts, int numShifts, Matrix<ComplexScalar,2,Dynamic>& shiftPairs)
+{
+  Matrix<ComplexScalar,2,Dynamic> pairs(2, shifts.size()/2);
+  int numPairs = 0, pendingReal = -1;
+  for (int i = 0; i < shifts.size(); ++i)
+  {
+    if (ei_imag(shifts.coeff(i)) != Scalar(0) && i+1 < shifts.size())
+    {
+      pairs.col(numPairs++) << shifts.coeff(i), shifts.coeff(i+1);
+      ++i;
+    }
+    else if (pendingReal >= 0)
+    {
+      pairs.col(numPairs++) << ei_real(shifts.coeff(pendingReal)), ei_real(shifts.coeff(i));
+      pendingReal = -1;
+    }
+    else
+      pendingReal = i;
+  }
+  const int used = std::min(numPairs, numShifts/2);
+  shiftPairs = pairs.block(0, numPairs-used, 2, used);
+}
+
+/** \internal Swaps the adjacent diagonal blocks of sizes \a p and \a q of the quasi-triangular
+  * matrix \a T, the first one starting at row \a j, and updates the orthogonal matrix \a V.
+  *
+  * Two 1x1 blocks are swapped by a rotation. Otherwise, the swap is done by the orthogonal
+  * basis of the invariant subspace \f$ [-X; I] \f$, where X solves the Sylvester equation
+  * \f$ T_{11} X - X T_{22} = T_{12} \f$, as in LAPACK's xLAEXC; the swap is refused, and
+  * \a T and \a V left unchanged, if it is not backward stable.
+  *
+  * \returns whether the blocks have been swapped
+  */
+template<typename MatrixType>
+bool RealSchur<MatrixType>::swapSchurBlocks(WorkMatrixType& T, WorkMatrixType& V, int j, int p, int q)
+{
+  const int n = T.cols();
+  if (p == 1 && q == 1)
+  {
+    const Scalar t11 = T.coeff(j, j), t22 = T.coeff(j+1, j+1);
+    PlanarRotation<Scalar> rot;
+    rot.makeGivens(T.coeff(j, j+1), t22 - t11);
+    if (j+2 < n)
+      T.block(j, j+2, 2, n-j-2).applyOnTheLeft(0, 1, rot.adjoint());
+    T.block(0, j, j, 2).applyOnTheRight(0, 1, rot);
+    T.coeffRef(j, j) = t22;
+    T.coeffRef(j+1, j+1) = t11;
+    V.block(0, j, V.rows(), 2).applyOnTheRight(0, 1, rot);
+    return true;
+  }
+
+  typedef Matrix<Scalar, Dynamic, Dynamic, 0, 4, 4> SmallMatrixType;
+  typedef Matrix<Scalar, Dynamic, 1, 0, 4, 1> SmallVectorType;
+  const int m = p+q;
+
+  // solve the Sylvester equation through its Kronecker product form
+  SmallMatrixType K = SmallMatrixType::Zero(p*q, p*q);
+  SmallVectorType rhs(p*q);
+  for (int l = 0; l < q; ++l)
+    for (int i = 0; i < p; ++i)
+    {
+      for (int k = 0; k < p; ++k)
+        K.coeffRef(i+l*p, k+l*p) += T.coeff(j+i, j+k);
+      for (int k = 0; k < q; ++k)
+        K.coeffRef(i+l*p, i+k*p) -= T.coeff(j+p+k, j+p+l);
+      rhs.coeffRef(i+l*p) = T.coeff(j+i, j+p+l);
+    }
+  const FullPivLU<SmallMatrixType> lu(K);
+  if (!lu.isInvertible())
+    return false;
+  const SmallVectorType x = lu.solve(rhs);
+
+  // orthogonal matrix Q whose first q columns span [-X; I]
+  SmallMatrixType basis(m, q), Q = SmallMatrixType::Identity(m, m);
+  for (int l = 0; l < q; ++l)
+    basis.col(l).head(p) = -x.segment(l*p, p);
+  basis.bottomRows(q).setIdentity();
+  Scalar work[4];
+  for (int l = 0; l < q; ++l)
+  {
+    Scalar tau, beta;
+    SmallVectorType essential(m-l-1);
+    basis.col(l).tail(m-l).makeHouseholder(essential, tau, beta);
+    basis.block(l, l, m-l, q-l).applyHouseholderOnTheLeft(essential, tau, work);
+    Q.rightCols(m-l).applyHouseholderOnTheRight(essential, tau, work);
+  }
+
+  // apply it, and check that the blocks are decoupled
+  const Scalar blockNorm = T.block(j, j, m, m).cwiseAbs().maxCoeff();
+  const WorkMatrixType rowsOfT = T.block(j, j, m, n-j), colsOfT = T.block(0, j, j, m);
+  T.block(j, j, m, n-j) = Q.transpose() * T.block(j, j, m, n-j);
+  T.block(0, j, j+m, m) = T.block(0, j, j+m, m) * Q;
+  if (T.block(j+q, j, p, q).cwiseAbs().maxCoeff() > Scalar(10) * NumTraits<Scalar>::epsilon() * blockNorm)
+  {
+    T.block(j, j, m, n-j) = rowsOfT;
+    T.block(0, j, j, m) = colsOfT;
+    return false;
+  }
+  T.block(j+q, j, p, q).setZero();
+  V.block(0, j, V.rows(), m) = V.block(0, j, V.rows(), m) * Q;
+  return true;
+}
+
+/** \internal Moves the diagonal block of the quasi-triangular \a T starting at row \a ifst up to
+  * row \a ilst by swapping it with the blocks above, updating \a V. The move stops if a swap is refused. */
+template<typename MatrixType>
+void RealSchur<MatrixType>::moveSchurBlockUp(WorkMatrixType& T, WorkMatrixType& V, int ifst, int ilst)
+{
+  int here = ifst;
+  while (here > ilst)
+  {
+    const int blockSize = (here+1 < T.rows() && T.coeff(here+1, here) != Scalar(0)) ? 2 : 1;
+    const int previousSize = (here >= 2 && T.coeff(here-1, here-2) != Scalar(0)) ? 2 : 1;
+    if (!swapSchurBlocks(T, V, here-previousSize, previousSize, blockSize))
+      return;
+    here -= previousSize;
+  }
+}
+
+/** \internal Performs aggressive early deflation on the window of size \a nw at the bottom of the
+  * active rows il, ..., iu.
+  *
+  * The window is reduced to real Schur form \f$ V T_w V^T \f$, after which the column above it
+  * becomes a spike proportional to the first row of V. The diagonal blocks of \f$ T_w \f$ for
+  * which the spike is negligible are deflated, starting from the bottom, the others being moved
+  * up out of the way. The eigenvalues of the blocks which do not deflate are returned in \a shifts,
+  * as they make good shifts for the next sweep, and the rest of the window is brought back to
+  * Hessenberg form. All the transformations are applied to the rest of m_matT, and to m_matU if
+  * \a computeU is true, by matrix-matrix products.
+  *
+  * \returns the number of deflated rows at the bottom of the window
+  */
+template<typename MatrixType>
+int RealSchur<MatrixType>::aggressiveEarlyDeflation(int il, int iu, int nw, Scalar exshift, bool computeU, ShiftVectorType& shifts)
+{
+  const int size = m_matT.cols();
+  const int kw = iu-nw+1;
+  ei_assert(kw > il);
+  const Scalar eps = NumTraits<Scalar>::epsilon();
+  const Scalar smallNum = std::numeric_limits<Scalar>::min() * (Scalar(size) / eps);
+  const Scalar spike = m_matT.coeff(kw, kw-1);
+
+  RealSchur<WorkMatrixType> windowSchur(nw);
+  windowSchur.computeFromHessenberg(m_matT.block(kw, kw, nw, nw), WorkMatrixType::Identity(nw, nw), true);
+  WorkMatrixType TW = windowSchur.matrixT(), V = windowSchur.matrixU();
+
+  int ns = nw;   // the rows 0,...,ns-1 of TW are not deflated
+  int ilst = 0;  // the undeflatable blocks are moved to the rows 0,...,ilst-1
+  while (ilst < ns)
+  {
+    const int bs = (ns > 1 && TW.coeff(ns-1, ns-2) != Scalar(0)) ? 2 : 1;
+    Scalar ref, spikeEntries;
+    if (bs == 1)
+    {
+      ref = ei_abs(TW.coeff(ns-1, ns-1));
+      spikeEntries = ei_abs(spike * V.coeff(0, ns-1));
+    }
+    else
+    {
+      ref = ei_abs(TW.coeff(ns-1, ns-1)) + ei_sqrt(ei_abs(TW.coeff(ns-1, ns-2))) * ei_sqrt(ei_abs(TW.coeff(ns-2, ns-1)));
+      spikeEntries = std::max(ei_abs(spike * V.coeff(0, ns-1)), ei_abs(spike * V.coeff(0, ns-2)));
+    }
+    if (ref == Scalar(0))
+      ref = ei_abs(spike);
+    if (spikeEntries <= std::max(smallNum, eps * ref))
+      ns -= bs;
+    else
+    {
+      moveSchurBlockUp(TW, V, ns-bs, ilst);
+      ilst += bs;
+    }
+  }
+
+  quasiTriangularEigenvalues(TW, ns, shifts);
+  if (ns == nw)
+    return 0;
+
+  // bring the undeflated part of the window back to Hessenberg form
+  Matrix<Scalar, Dynamic, 1> s = spike * V.row(0).head(ns).transpose(), work(nw);
+  if (ns > 1)
+  {
+    Scalar tau, beta;
+    Matrix<Scalar, Dynamic, 1> essential(ns-1);
+    s.makeHouseholder(essential, tau, beta);
+    s.setZero();
+    s.coeffRef(0) = beta;
+    TW.topRows(ns).applyHouseholderOnTheLeft(essential, tau, &work.coeffRef(0));
+    TW.leftCols(ns).applyHouseholderOnTheRight(essential, tau, &work.coeffRef(0));
+    V.leftCols(ns).applyHouseholderOnTheRight(essential, tau, &work.coeffRef(0));
+
+    const HessenbergDecomposition<WorkMatrixType> hess(TW.topLeftCorner(ns, ns));
+    const WorkMatrixType Q = hess.matrixQ();
+    TW.topLeftCorner(ns, ns) = hess.matrixH();
+    TW.topRightCorner(ns, nw-ns) = Q.transpose() * TW.topRightCorner(ns, nw-ns);
+    V.leftCols(ns) = V.leftCols(ns) * Q;
+  }
+
+  // copy the window back, and apply V to the rest of the matrix
+  m_matT.block(kw, kw, nw, nw) = TW;
+  m_matT.col(kw-1).segment(kw, nw).setZero();
+  m_matT.col(kw-1).segment(kw, ns) = s;
+  if (iu+1 < size)
+    m_matT.block(kw, iu+1, nw, size-iu-1) = V.transpose() * m_matT.block(kw, iu+1, nw, size-iu-1);
+  m_matT.block(0, kw, kw, nw) = m_matT.block(0, kw, kw, nw) * V;
+  if (computeU)
+    m_matU.block(0, kw, size, nw) = m_matU.block(0, kw, size, nw) * V;
+
+  for (int i = kw+ns; i <= iu; ++i)
+    m_matT.coeffRef(i, i) += exshift;
+  return nw-ns;
+}
+
+/** \internal Performs a multishift QR sweep on the active rows il, ..., iu, with the given
+  * pairs of shifts.
+  *
+  * Each pair of shifts introduces a 3x3 bulge at the top of the active window, and the bulges are
+  * chased down together, three rows apart. The chase proceeds by chunks of steps: the reflectors
+  * of a chunk are applied within the window of rows and columns touched by the bulges during the
+  * chunk, and accumulated in an orthogonal matrix which is applied to the rest of m_matT, and to
+  * m_matU if \a computeU is true, by matrix-matrix products.
+  */
+template<typename MatrixType>
+void RealSchur<MatrixType>::performMultishiftQRSweep(int il, int iu, const Matrix<ComplexScalar,2,Dynamic>& shiftPairs, bool computeU, Scalar* workspace)
+{
+  const int size = m_matT.cols();
+  const int numBulges = shiftPairs.cols();
+  // at time t, the bulge b is at row il + t - 3b, until it leaves the active window at row iu-1
+  const int lastStep = iu-1-il + 3*(numBulges-1);
+  const int chunkSize = std::max(3*numBulges, 12);
+  WorkMatrixType Z;
+
+  for (int t0 = 0; t0 <= lastStep; t0 += chunkSize)
+  {
+    const int t1 = std::min(t0+chunkSize, lastStep+1);
+    const int w0 = std::max(il, il+t0-3*(numBulges-1)-1);
+    const int w1 = std::min(iu, il+t1-1+3);
+    const int nwin = w1-w0+1;
+    Z.setIdentity(nwin, nwin);
+
+    for (int t = t0; t < t1; ++t)
+    {
+      for (int b = 0; b < numBulges; ++b)
+      {
+        const int k = il+t-3*b;
+        if (k < il || k > iu-1)
+          continue;
+
+        Scalar tau, beta;
+        if (k <= iu-2)
+        {
+          Vector3s v;
+          if (k == il)
+          {
+            // first column of (H - s1 I)(H - s2 I), scaled to avoid overflows
+            const ComplexScalar s1 = shiftPairs.coeff(0, b), s2 = shiftPairs.coeff(1, b);
+            const Scalar h00 = m_matT.coeff(il, il), h10 = m_matT.coeff(il+1, il);
+            const Scalar scale = ei_abs(h00 - ei_real(s2)) + ei_abs(ei_imag(s2)) + ei_abs(h10);
+            if (scale == Scalar(0))
+              continue;
+            const Scalar h10s = h10 / scale;
+            v.coeffRef(0) = h10s * m_matT.coeff(il, il+1) + (h00 - ei_real(s1)) * ((h00 - ei_real(s2)) / scale)
+                          - ei_imag(s1) * (ei_imag(s2) / scale);
+            v.coeffRef(1) = h10s * (h00 + m_matT.coeff(il+1, il+1) - ei_real(s1) - ei_real(s2));
+            v.coeffRef(2) = h10s * m_matT.coeff(il+2, il+1);
+          }
+          else
+            v = m_matT.template block<3,1>(k, k-1);
+
+          Matrix<Scalar, 2, 1> ess;
+          v.makeHouseholder(ess, tau, beta);
+          if (tau == Scalar(0))
+            continue;
+          if (k > il)
+          {
+            m_matT.coeffRef(k, k-1) = beta;
+            m_matT.coeffRef(k+1, k-1) = Scalar(0);
+            m_matT.coeffRef(k+2, k-1) = Scalar(0);
+          }
+          m_matT.block(k, k, 3, w1-k+1).applyHouseholderOnTheLeft(ess, tau, workspace);
+          m_matT.block(w0, k, std::min(iu, k+3)-w0+1, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+          Z.block(0, k-w0, nwin, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+        }
+        else
+        {
+          Matrix<Scalar, 2, 1> v = m_matT.template block<2,1>(iu-1, iu-2);
+          Matrix<Scalar, 1, 1> ess;
+          v.makeHouseholder(ess, tau, beta);
+          if (tau == Scalar(0))
+            continue;
+          m_matT.coeffRef(iu-1, iu-2) = beta;
+          m_matT.coeffRef(iu, iu-2) = Scalar(0);
+          m_matT.block(iu-1, iu-1, 2, w1-iu+2).applyHouseholderOnTheLeft(ess, tau, workspace);
+          m_matT.block(w0, iu-1, iu-w0+1, 2).applyHouseholderOnTheRight(ess, tau, workspace);
+          Z.block(0, iu-1-w0, nwin, 2).applyHouseholderOnTheRight(ess, tau, workspace);
+        }
+      }
+    }
+
+    // apply the accumulated reflectors outside of the window
+    if (w1+1 < size)
+      m_matT.block(w0, w1+1, nwin, size-w1-1) = Z.transpose() * m_matT.block(w0, w1+1, nwin, size-w1-1);
+    if (w0 > 0)
+      m_matT.block(0, w0, w0, nwin) = m_matT.block(0, w0, w0, nwin) * Z;
+    if (computeU)
+      m_matU.block(0, w0, size, nwin) = m_matU.block(0, w0, size, nwin) * Z;
+  }
+
+  // clean up pollution due to round-off errors
+  for (int i = il+2; i <= iu; ++i)
+  {
+    m_matT.coeffRef(i,i-2) = Scalar(0);
+    if (i > il+2)
+      m_matT.coeffRef(i,i-3) = Scalar(0);
+  }
+}
+
 #endif // EIGEN_REAL_SCHUR_H
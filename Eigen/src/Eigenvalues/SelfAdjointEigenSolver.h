@@ -34,6 +34,16 @@
   *
   * \param MatrixType the type of the matrix of which we are computing the eigen decomposition
   *
+  * This class also solves the generalized problem \f$ Ax = \lambda Bx \f$ where \f$ B \f$ is
+  * positive definite. The problem is reduced to a standard one in place by a blocked algorithm
+  * working on the lower triangular part of \f$ A \f$, as LAPACK's xSYGST. When several matrices
+  * \f$ A \f$ share the same \f$ B \f$, the Cholesky factorization of \f$ B \f$ can be computed
+  * once and passed to compute(const MatrixType&, const LLT<MatrixType>&, bool).
+  *
+  * When only a few eigenpairs are wanted, computeSubset() computes the eigenvalues of the
+  * tridiagonal matrix without accumulating the rotations, and the wanted eigenvectors by inverse
+  * iteration, which saves most of the cost of the eigenvectors for large matrices.
+  *
   * \note MatrixType must be an actual Matrix type, it can't be an expression type.
   *
   * \sa MatrixBase::eigenvalues(), class EigenSolver
@@ -67,8 +77,10 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
     SelfAdjointEigenSolver(int size)
         : m_eivec(size, size),
           m_eivalues(size),
-          m_subdiag(TridiagonalizationType::SizeMinusOne)
-    {}
+          m_subdiag()
+    {
+      if (size > 1) m_subdiag.resize(size - 1);
+    }
 
     /** Constructors computing the eigenvalues of the selfadjoint matrix \a matrix,
       * as well as the eigenvectors if \a computeEigenvectors is true.
@@ -100,11 +112,38 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       compute(matA, matB, computeEigenvectors);
     }
 
+    /** Constructors computing the eigenvalues of the generalized eigen problem
+      * \f$ Ax = lambda B x \f$ with \a matA the selfadjoint matrix \f$ A \f$
+      * and \a cholB the Cholesky factorization of the positive definite matrix \f$ B \f$.
+      * The eigenvectors are computed if \a computeEigenvectors is true.
+      *
+      * \sa compute(MatrixType,LLT,bool)
+      */
+    SelfAdjointEigenSolver(const MatrixType& matA, const LLT<MatrixType>& cholB, bool computeEigenvectors = true)
+      : m_eivec(matA.rows(), matA.cols()),
+        m_eivalues(matA.cols()),
+        m_subdiag()
+    {
+      if (matA.rows() > 1) m_subdiag.resize(matA.rows() - 1);
+      compute(matA, cholB, computeEigenvectors);
+    }
+
     SelfAdjointEigenSolver& compute(const MatrixType& matrix, bool computeEigenvectors = true);
 
     SelfAdjointEigenSolver& compute(const MatrixType& matA, const MatrixType& matB, bool computeEigenvectors = true);
 
-    /** \returns the computed eigen vectors as a matrix of column vectors */
+    SelfAdjointEigenSolver& compute(const MatrixType& matA, const LLT<MatrixType>& cholB, bool computeEigenvectors = true);
+
+    SelfAdjointEigenSolver& computeSubset(const MatrixType& matrix, int first, int count, bool computeEigenvectors = true);
+
+    SelfAdjointEigenSolver& computeSubset(const MatrixType& matA, const LLT<MatrixType>& cholB, int first, int count, bool computeEigenvectors = true);
+
+    SelfAdjointEigenSolver& computeDirect(const MatrixType& matrix, bool computeEigenvectors = true);
+
+    /** \returns the computed eigen vectors as a matrix of column vectors
+      *
+      * After computeSubset(), only the columns of the computed eigenvectors are returned.
+      */
     MatrixType eigenvectors(void) const
     {
       #ifndef NDEBUG
@@ -113,7 +152,7 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       return m_eivec;
     }
 
-    /** \returns the computed eigen values */
+    /** \returns the computed eigen values, in increasing order */
     RealVectorType eigenvalues(void) const { return m_eivalues; }
 
     /** \returns the positive square root of the matrix
@@ -136,6 +175,7 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
 
 
   protected:
+    template<typename SolverType, int _Size, bool IsComplex> friend struct ei_direct_selfadjoint_eigenvalues;
     MatrixType m_eivec;
     RealVectorType m_eivalues;
     typename TridiagonalizationType::SubDiagonalType m_subdiag;
@@ -157,13 +197,165 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
   * \param hCoeffs returned Householder coefficients
   *
   * For compilation efficiency reasons, this procedure does not use eigen expression
-  * for its arguments.
+  * for its arguments. The Givens rotations are appended to \a rotations, if not null,
+  * to be applied later to the eigenvectors.
   *
   * Implemented from Golub's "Matrix Computations", algorithm 8.3.2:
   * "implicit symmetric QR step with Wilkinson shift"
   */
 template<typename RealScalar, typename Scalar>
-static void ei_tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, int start, int end, Scalar* matrixQ, int n);
+static void ei_tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, int start, int end, ei_planar_rotation_sequence<Scalar>* rotations);
+
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Computes the eigenvalues of the symmetric tridiagonal matrix represented by \a diag and
+  * \a subdiag by the implicit QR algorithm. The eigenvalues are written in \a diag, unsorted,
+  * and the Givens rotations are applied on the right of \a eivec, if not null.
+  */
+template<typename DiagType, typename SubDiagType, typename MatrixType>
+static void ei_tridiagonal_qr_iteration(DiagType& diag, SubDiagType& subdiag, MatrixType* eivec)
+{
+  typedef typename DiagType::Scalar RealScalar;
+  const int n = diag.size();
+
+  // the rotations of the QR steps are applied to the eigenvectors by batches of about 16 sweeps
+  ei_planar_rotation_sequence<RealScalar> rotations(eivec ? 16*n : 0);
+
+  int end = n-1;
+  int start = 0;
+  while (end>0)
+  {
+    for (int i = start; i<end; ++i)
+      if (ei_isMuchSmallerThan(ei_abs(subdiag[i]),(ei_abs(diag[i])+ei_abs(diag[i+1]))))
+        subdiag[i] = 0;
+
+    // find the largest unreduced block
+    while (end>0 && subdiag[end-1]==0)
+      end--;
+    if (end<=0)
+      break;
+    start = end - 1;
+    while (start>0 && subdiag[start-1]!=0)
+      start--;
+
+    if (eivec && !rotations.hasRoomFor(end-start))
+      rotations.applyOnTheRightAndClear(*eivec);
+    ei_tridiagonal_qr_step(diag.data(), subdiag.data(), start, end, eivec ? &rotations : 0);
+  }
+  if (eivec)
+    rotations.applyOnTheRightAndClear(*eivec);
+}
+
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Computes by inverse iteration the eigenvectors of the symmetric tridiagonal matrix \f$ T \f$
+  * represented by \a diag and \a subdiag, associated to the eigenvalues \a eivalues sorted in
+  * increasing order, and writes them in the columns of \a eivec.
+  *
+  * As LAPACK's xSTEIN, each vector is obtained by a few solves with the LU factorization with
+  * partial pivoting of \f$ T - \lambda I \f$, and is orthogonalized against the vectors of the
+  * previous eigenvalues which are closer than \f$ 10^{-3} \|T\| \f$, equal eigenvalues being
+  * perturbed so that the factorizations differ.
+  */
+template<typename DiagType, typename SubDiagType, typename EivecType>
+static void ei_tridiagonal_inverse_iteration(const DiagType& diag, const SubDiagType& subdiag,
+                                             const DiagType& eivalues, EivecType& eivec)
+{
+  typedef typename DiagType::Scalar RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> VectorType;
+  const int n = diag.size(), count = eivalues.size();
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  const int maxIterations = 5;
+
+  // work on T scaled to unit norm
+  RealScalar tnorm = 0;
+  for (int i = 0; i < n; ++i)
+    tnorm = std::max(tnorm, ei_abs(diag[i]) + (i>0 ? ei_abs(subdiag[i-1]) : RealScalar(0))
+                                            + (i<n-1 ? ei_abs(subdiag[i]) : RealScalar(0)));
+  if (tnorm==RealScalar(0))
+    tnorm = RealScalar(1);
+  const VectorType d = diag / tnorm;
+  const VectorType e = n>1 ? VectorType(subdiag / tnorm) : VectorType();
+
+  // LU factorization P (T - lambda I) = L U where U has two super-diagonals
+  VectorType u0(n), u1(n), u2(n), l(n), x(n);
+  Matrix<int,Dynamic,1> swapped(n);
+  unsigned int seed = 1;
+  int clusterStart = 0;
+  RealScalar shift = 0;
+  eivec.resize(n, count);
+  for (int j = 0; j < count; ++j)
+  {
+    const RealScalar lambda = eivalues[j] / tnorm;
+    if (j>0 && lambda - eivalues[j-1]/tnorm > RealScalar(1e-3))
+      clusterStart = j;
+    shift = (j>0 && lambda - shift < RealScalar(10)*eps) ? shift + RealScalar(10)*eps : lambda;
+
+    RealScalar pivot = d[0] - shift, next = n>1 ? e[0] : RealScalar(0);
+    for (int i = 0; i < n-1; ++i)
+    {
+      const RealScalar nextNext = i<n-2 ? e[i+1] : RealScalar(0);
+      swapped[i] = ei_abs(e[i]) > ei_abs(pivot);
+      if (swapped[i])
+      {
+        l[i] = pivot / e[i];
+        u0[i] = e[i]; u1[i] = d[i+1] - shift; u2[i] = nextNext;
+        pivot = next - l[i] * u1[i];
+        next = -l[i] * nextNext;
+      }
+      else
+      {
+        l[i] = pivot==RealScalar(0) ? RealScalar(0) : e[i] / pivot;
+        u0[i] = pivot; u1[i] = next; u2[i] = 0;
+        pivot = d[i+1] - shift - l[i] * next;
+        next = nextNext;
+      }
+    }
+    u0[n-1] = pivot;
+    // replace the tiny pivots, the matrix being singular to working precision
+    for (int i = 0; i < n; ++i)
+      if (ei_abs(u0[i]) < eps)
+        u0[i] = u0[i] < RealScalar(0) ? -eps : eps;
+
+    for (int i = 0; i < n; ++i)
+    {
+      seed = seed * 1103515245u + 12345u;
+      x[i] = RealScalar(int((seed >> 16) & 0x7fff)) / RealScalar(32768) - RealScalar(0.5);
+    }
+    x.normalize();
+
+    // iterate until the growth of the solution shows a small residual, then once more
+    bool converged = false;
+    for (int iter = 0; iter < maxIterations; ++iter)
+    {
+      for (int i = 0; i < n-1; ++i)
+      {
+        if (swapped[i])
+          std::swap(x[i], x[i+1]);
+        x[i+1] -= l[i] * x[i];
+      }
+      for (int i = n-1; i >= 0; --i)
+      {
+        RealScalar xi = x[i];
+        if (i < n-1) xi -= u1[i] * x[i+1];
+        if (i < n-2) xi -= u2[i] * x[i+2];
+        x[i] = xi / u0[i];
+      }
+      for (int k = clusterStart; k < j; ++k)
+        x -= eivec.col(k).dot(x) * eivec.col(k);
+      const RealScalar growth = x.norm();
+      x /= growth;
+      if (converged)
+        break;
+      converged = growth * RealScalar(10*n) * eps >= RealScalar(1);
+    }
+    eivec.col(j) = x;
+  }
+}
 
 /** Computes the eigenvalues of the selfadjoint matrix \a matrix,
   * as well as the eigenvectors if \a computeEigenvectors is true.
@@ -197,25 +389,7 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>::compute(
   m_subdiag.resize(n-1);
   TridiagonalizationType::decomposeInPlace(m_eivec, diag, m_subdiag, computeEigenvectors);
 
-  int end = n-1;
-  int start = 0;
-  while (end>0)
-  {
-    for (int i = start; i<end; ++i)
-      if (ei_isMuchSmallerThan(ei_abs(m_subdiag[i]),(ei_abs(diag[i])+ei_abs(diag[i+1]))))
-        m_subdiag[i] = 0;
-
-    // find the largest unreduced block
-    while (end>0 && m_subdiag[end-1]==0)
-      end--;
-    if (end<=0)
-      break;
-    start = end - 1;
-    while (start>0 && m_subdiag[start-1]!=0)
-      start--;
-
-    ei_tridiagonal_qr_step(diag.data(), m_subdiag.data(), start, end, computeEigenvectors ? m_eivec.data() : (Scalar*)0, n);
-  }
+  ei_tridiagonal_qr_iteration(diag, m_subdiag, computeEigenvectors ? &m_eivec : 0);
 
   // Sort eigenvalues and corresponding vectors.
   // TODO make the sort optional ?
@@ -233,6 +407,217 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>::compute(
   return *this;
 }
 
+/** \internal
+  * Closed-form eigen decomposition of the 2x2 and 3x3 real selfadjoint matrices used by
+  * SelfAdjointEigenSolver::computeDirect(). Other sizes fall back to compute().
+  */
+template<typename SolverType, int Size, bool IsComplex>
+struct ei_direct_selfadjoint_eigenvalues
+{
+  typedef typename SolverType::MatrixType MatrixType;
+  static void run(SolverType& solver, const MatrixType& mat, bool computeEigenvectors)
+  { solver.compute(mat, computeEigenvectors); }
+};
+
+template<typename SolverType>
+struct ei_direct_selfadjoint_eigenvalues<SolverType,2,false>
+{
+  typedef typename SolverType::MatrixType MatrixType;
+  typedef typename SolverType::RealVectorType VectorType;
+  typedef typename MatrixType::Scalar Scalar;
+
+  static void run(SolverType& solver, const MatrixType& mat, bool computeEigenvectors)
+  {
+    MatrixType& eivecs = solver.m_eivec;
+    VectorType& eivals = solver.m_eivalues;
+
+    // shift and scale the matrix to avoid over/underflow, only the lower triangular part is referenced
+    const Scalar shift = Scalar(0.5) * (mat.coeff(0,0) + mat.coeff(1,1));
+    const Scalar a = mat.coeff(0,0) - shift, b = mat.coeff(1,0), c = mat.coeff(1,1) - shift;
+    Scalar scale = std::max(std::max(ei_abs(a), ei_abs(b)), ei_abs(c));
+    if(scale == Scalar(0)) scale = Scalar(1);
+    const Scalar sa = a/scale, sb = b/scale, sc = c/scale;
+
+    const Scalar t0 = Scalar(0.5) * ei_sqrt(ei_abs2(sa-sc) + Scalar(4)*ei_abs2(sb));
+    const Scalar t1 = Scalar(0.5) * (sa+sc);
+    eivals.coeffRef(0) = t1 - t0;
+    eivals.coeffRef(1) = t1 + t0;
+
+    if(computeEigenvectors)
+    {
+      if(t0 == Scalar(0))
+        eivecs.setIdentity();
+      else
+      {
+        // the kernel of A - lambda_1 I is orthogonal to its largest row
+        const Scalar a1 = sa - eivals.coeff(1), c1 = sc - eivals.coeff(1);
+        if(ei_abs2(a1) > ei_abs2(c1))
+          eivecs.col(1) << -sb, a1;
+        else
+          eivecs.col(1) << -c1, sb;
+        eivecs.col(1).normalize();
+        eivecs.col(0) << eivecs.coeff(1,1), -eivecs.coeff(0,1);
+      }
+    }
+
+    eivals *= scale;
+    eivals.array() += shift;
+  }
+};
+
+template<typename SolverType>
+struct ei_direct_selfadjoint_eigenvalues<SolverType,3,false>
+{
+  typedef typename SolverType::MatrixType MatrixType;
+  typedef typename SolverType::RealVectorType VectorType;
+  typedef typename MatrixType::Scalar Scalar;
+
+  static inline void cross(const VectorType& u, const VectorType& v, VectorType& res)
+  {
+    res.coeffRef(0) = u.coeff(1)*v.coeff(2) - u.coeff(2)*v.coeff(1);
+    res.coeffRef(1) = u.coeff(2)*v.coeff(0) - u.coeff(0)*v.coeff(2);
+    res.coeffRef(2) = u.coeff(0)*v.coeff(1) - u.coeff(1)*v.coeff(0);
+  }
+
+  /** \internal computes the roots of the characteristic polynomial of \a m in increasing order */
+  static inline void computeRoots(const MatrixType& m, VectorType& roots)
+  {
+    const Scalar s_inv3 = Scalar(1)/Scalar(3);
+    const Scalar s_sqrt3 = ei_sqrt(Scalar(3));
+
+    // the characteristic equation is x^3 - c2*x^2 + c1*x - c0 = 0
+    const Scalar c0 = m(0,0)*m(1,1)*m(2,2) + Scalar(2)*m(1,0)*m(2,0)*m(2,1) - m(0,0)*m(2,1)*m(2,1)
+                    - m(1,1)*m(2,0)*m(2,0) - m(2,2)*m(1,0)*m(1,0);
+    const Scalar c1 = m(0,0)*m(1,1) - m(1,0)*m(1,0) + m(0,0)*m(2,2) - m(2,0)*m(2,0)
+                    + m(1,1)*m(2,2) - m(2,1)*m(2,1);
+    const Scalar c2 = m(0,0) + m(1,1) + m(2,2);
+
+    // the roots are real, so the cubic is solved in closed form with trigonometric functions
+    const Scalar c2_over_3 = c2*s_inv3;
+    const Scalar a_over_3 = std::max((c2*c2_over_3 - c1)*s_inv3, Scalar(0));
+    const Scalar half_b = Scalar(0.5)*(c0 + c2_over_3*(Scalar(2)*c2_over_3*c2_over_3 - c1));
+    const Scalar q = std::max(a_over_3*a_over_3*a_over_3 - half_b*half_b, Scalar(0));
+
+    const Scalar rho = ei_sqrt(a_over_3);
+    const Scalar theta = std::atan2(ei_sqrt(q), half_b)*s_inv3;
+    const Scalar cos_theta = ei_cos(theta);
+    const Scalar sin_theta = ei_sin(theta);
+    // roots(0) <= roots(1) <= roots(2) since theta lies in [0, pi/3]
+    roots.coeffRef(0) = c2_over_3 - rho*(cos_theta + s_sqrt3*sin_theta);
+    roots.coeffRef(1) = c2_over_3 - rho*(cos_theta - s_sqrt3*sin_theta);
+    roots.coeffRef(2) = c2_over_3 + Scalar(2)*rho*cos_theta;
+  }
+
+  /** \internal computes a unit vector of the kernel of the rank 2 matrix \a mat, and saves one of
+    * its columns in \a representative */
+  static inline void extractKernel(const MatrixType& mat, VectorType& res, VectorType& representative)
+  {
+    // by construction, there is a non zero coefficient on the diagonal
+    int i0;
+    mat.diagonal().cwiseAbs().maxCoeff(&i0);
+    representative = mat.col(i0);
+    VectorType c0, c1;
+    cross(representative, mat.col((i0+1)%3), c0);
+    cross(representative, mat.col((i0+2)%3), c1);
+    const Scalar n0 = c0.squaredNorm(), n1 = c1.squaredNorm();
+    if(n0 > n1) res = c0 / ei_sqrt(n0);
+    else        res = c1 / ei_sqrt(n1);
+  }
+
+  static void run(SolverType& solver, const MatrixType& mat, bool computeEigenvectors)
+  {
+    MatrixType& eivecs = solver.m_eivec;
+    VectorType& eivals = solver.m_eivalues;
+
+    // shift and scale the matrix to avoid over/underflow, only the lower triangular part is referenced
+    MatrixType scaledMat;
+    for(int j = 0; j < 3; ++j)
+      for(int i = j; i < 3; ++i)
+        scaledMat.coeffRef(j,i) = scaledMat.coeffRef(i,j) = mat.coeff(i,j);
+    const Scalar shift = scaledMat.trace() / Scalar(3);
+    scaledMat.diagonal().array() -= shift;
+    Scalar scale = scaledMat.cwiseAbs().maxCoeff();
+    if(scale > Scalar(0)) scaledMat /= scale;
+    else scale = Scalar(1);
+
+    computeRoots(scaledMat, eivals);
+
+    if(computeEigenvectors)
+    {
+      if((eivals.coeff(2)-eivals.coeff(0)) <= NumTraits<Scalar>::epsilon())
+      {
+        // all three eigenvalues are numerically the same
+        eivecs.setIdentity();
+      }
+      else
+      {
+        // start with the eigenvector of the most distinct eigenvalue
+        Scalar d0 = eivals.coeff(2) - eivals.coeff(1);
+        Scalar d1 = eivals.coeff(1) - eivals.coeff(0);
+        int k = 0, l = 2;
+        if(d0 > d1)
+        {
+          std::swap(k,l);
+          d0 = d1;
+        }
+
+        VectorType ek, el;
+        MatrixType tmp = scaledMat;
+        tmp.diagonal().array() -= eivals.coeff(k);
+        extractKernel(tmp, ek, el);
+
+        if(d0 <= Scalar(2)*NumTraits<Scalar>::epsilon()*d1)
+        {
+          // the two other eigenvalues are numerically the same, so any unit vector orthogonal
+          // to ek is fine: orthonormalize the column saved above
+          el -= ek.dot(el)*ek;
+          el.normalize();
+        }
+        else
+        {
+          VectorType dummy;
+          tmp = scaledMat;
+          tmp.diagonal().array() -= eivals.coeff(l);
+          extractKernel(tmp, el, dummy);
+        }
+        eivecs.col(k) = ek;
+        eivecs.col(l) = el;
+
+        // the last eigenvector is orthogonal to the two others
+        VectorType e1;
+        cross(ek, el, e1);
+        eivecs.col(1) = e1.normalized();
+      }
+    }
+
+    eivals *= scale;
+    eivals.array() += shift;
+  }
+};
+
+/** Computes the eigenvalues of the selfadjoint matrix \a matrix, as well as the eigenvectors if
+  * \a computeEigenvectors is true, using a closed-form algorithm.
+  *
+  * This is only implemented for real 2x2 and 3x3 fixed size matrices, for which it is
+  * significantly faster and allocation free, otherwise this function calls compute(). The
+  * eigenvalues are obtained from the roots of the characteristic polynomial and the eigenvectors
+  * from cross products, so that the results are slightly less accurate than the ones of compute(),
+  * especially when the eigenvalues are clustered.
+  *
+  * Only the lower triangular part of \a matrix is referenced.
+  *
+  * \sa compute(const MatrixType&, bool)
+  */
+template<typename MatrixType>
+SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>::computeDirect(const MatrixType& matrix, bool computeEigenvectors)
+{
+  ei_direct_selfadjoint_eigenvalues<SelfAdjointEigenSolver,Size,NumTraits<Scalar>::IsComplex>::run(*this, matrix, computeEigenvectors);
+  #ifndef NDEBUG
+  m_eigenvectorsOk = computeEigenvectors;
+  #endif
+  return *this;
+}
+
 /** Computes the eigenvalues of the generalized eigen problem
   * \f$ Ax = lambda B x \f$ with \a matA the selfadjoint matrix \f$ A \f$
   * and \a matB the positive definite matrix \f$ B \f$ . The eigenvectors
@@ -248,21 +633,98 @@ compute(const MatrixType& matA, const MatrixType& matB, bool computeEigenvectors
 
   // Compute the cholesky decomposition of matB = L L'
   LLT<MatrixType> cholB(matB);
+  return compute(matA, cholB, computeEigenvectors);
+}
+
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Overwrites the selfadjoint matrix \a a by \f$ L^{-1} a L^{-*} \f$, where \a l holds the Cholesky
+  * factor \f$ L \f$ in its lower triangular part. Only the lower triangular part of \a a is read,
+  * and the whole selfadjoint result is written.
+  *
+  * This is the blocked algorithm of LAPACK's xSYGST: the diagonal blocks are reduced with
+  * triangular solves, and the trailing part is updated by rank-2k updates, performed as two
+  * rank-k updates of the selfadjoint product kernel. It takes about half the operations of two
+  * full triangular solves.
+  */
+template<typename MatrixType>
+static void ei_reduce_generalized_selfadjoint(MatrixType& a, const MatrixType& l)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> BlockType;
+  ei_assert(a.rows()==a.cols() && l.rows()==a.rows() && l.cols()==a.cols());
+  const int size = a.rows();
+
+  int blockSize = size/8;
+  blockSize = (blockSize/16)*16;
+  blockSize = std::min(std::max(blockSize,8), 128);
+
+  BlockType a11, lA11;
+  for (int k=0; k<size; k+=blockSize)
+  {
+    int bs = std::min(blockSize, size-k);
+    int rs = size - k - bs;
+
+    Block<MatrixType,Dynamic,Dynamic> A11(a,k,   k,   bs,bs);
+    Block<MatrixType,Dynamic,Dynamic> A21(a,k+bs,k,   rs,bs);
+    Block<MatrixType,Dynamic,Dynamic> A22(a,k+bs,k+bs,rs,rs);
+    const Block<MatrixType,Dynamic,Dynamic> L11(l,k,   k,   bs,bs);
+    const Block<MatrixType,Dynamic,Dynamic> L21(l,k+bs,k,   rs,bs);
+    const Block<MatrixType,Dynamic,Dynamic> L22(l,k+bs,k+bs,rs,rs);
+
+    // A11 = inv(L11) A11 inv(L11)^*
+    a11 = A11;
+    for (int j=1; j<bs; ++j)
+      a11.col(j).head(j) = a11.row(j).head(j).adjoint();
+    L11.template triangularView<Lower>().solveInPlace(a11);
+    L11.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(a11);
+    A11 = a11;
+    if (rs==0)
+      break;
+
+    L11.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(A21);
+    lA11.noalias() = L21 * a11 * Scalar(0.5);
+    A21 -= lA11;
+
+    // A22 -= A21 L21^* + L21 A21^*, written as (X+Y)(X+Y)^*/2 - (X-Y)(X-Y)^*/2 with X = A21/t and Y = t L21,
+    // where t balances the norms of X and Y to limit the cancellation
+    const RealScalar normA21 = A21.norm(), normL21 = L21.norm();
+    const RealScalar t = (normA21==RealScalar(0) || normL21==RealScalar(0)) ? RealScalar(1) : ei_sqrt(normA21/normL21);
+    BlockType sum = A21 / t + t * L21;
+    A22.template selfadjointView<Lower>().rankUpdate(sum, Scalar(-0.5));
+    sum = A21 / t - t * L21;
+    A22.template selfadjointView<Lower>().rankUpdate(sum, Scalar(0.5));
+
+    A21 -= lA11;
+    L22.template triangularView<Lower>().solveInPlace(A21);
+  }
+
+  // the strictly upper part is read by the 3x3 tridiagonalization
+  for (int j=1; j<size; ++j)
+    a.col(j).head(j) = a.row(j).head(j).adjoint();
+}
+
+/** Computes the eigenvalues of the generalized eigen problem
+  * \f$ Ax = lambda B x \f$ with \a matA the selfadjoint matrix \f$ A \f$
+  * and \a cholB the Cholesky factorization of the positive definite matrix \f$ B \f$.
+  * The eigenvectors are computed if \a computeEigenvectors is true.
+  *
+  * This allows to factorize \f$ B \f$ once for several matrices \f$ A \f$.
+  *
+  * \sa SelfAdjointEigenSolver(MatrixType,LLT,bool), compute(MatrixType,MatrixType,bool)
+  */
+template<typename MatrixType>
+SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>::
+compute(const MatrixType& matA, const LLT<MatrixType>& cholB, bool computeEigenvectors)
+{
+  ei_assert(matA.cols()==matA.rows() && cholB.rows()==matA.rows());
 
   // compute C = inv(L) A inv(L')
   MatrixType matC = matA;
-  cholB.matrixL().solveInPlace(matC);
-  // FIXME since we currently do not support A * inv(L'), let's do (inv(L) A')' :
-  matC.adjointInPlace();
-  cholB.matrixL().solveInPlace(matC);
-  matC.adjointInPlace();
-  // this version works too:
-//   matC = matC.transpose();
-//   cholB.matrixL().conjugate().template marked<Lower>().solveTriangularInPlace(matC);
-//   matC = matC.transpose();
-  // FIXME: this should work: (currently it only does for small matrices)
-//   Transpose<MatrixType> trMatC(matC);
-//   cholB.matrixL().conjugate().eval().template marked<Lower>().solveTriangularInPlace(trMatC);
+  ei_reduce_generalized_selfadjoint(matC, cholB.matrixLLT());
 
   compute(matC, computeEigenvectors);
 
@@ -276,6 +738,97 @@ compute(const MatrixType& matA, const MatrixType& matB, bool computeEigenvectors
   return *this;
 }
 
+/** Computes the eigenvalues of index \a first to \a first + \a count - 1, in increasing order,
+  * of the selfadjoint matrix \a matrix, as well as the corresponding eigenvectors if
+  * \a computeEigenvectors is true.
+  *
+  * The eigenvalues of the tridiagonal form are computed without accumulating the rotations,
+  * and the wanted eigenvectors are obtained by inverse iteration and transformed back with the
+  * Householder reflectors of the tridiagonalization. For \a count much smaller than the size,
+  * this takes about the cost of the tridiagonalization alone.
+  *
+  * \note MatrixType must have dynamic sizes, unless all the eigenpairs are wanted.
+  *
+  * \sa compute(MatrixType,bool)
+  */
+template<typename MatrixType>
+SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>::
+computeSubset(const MatrixType& matrix, int first, int count, bool computeEigenvectors)
+{
+  #ifndef NDEBUG
+  m_eigenvectorsOk = computeEigenvectors;
+  #endif
+  ei_assert(matrix.cols() == matrix.rows());
+  const int n = matrix.cols();
+  ei_assert(first >= 0 && count >= 0 && first + count <= n);
+
+  if (n==1)
+  {
+    m_eivalues.resize(count);
+    m_eivec.resize(n,count);
+    if (count)
+    {
+      m_eivalues.coeffRef(0) = ei_real(matrix.coeff(0,0));
+      m_eivec.setOnes();
+    }
+    return *this;
+  }
+
+  TridiagonalizationType tridiag(matrix);
+  RealVectorType diag = tridiag.diagonal();
+  m_subdiag = tridiag.subDiagonal();
+
+  // all the eigenvalues of T, sorted
+  RealVectorType eivalues = diag;
+  typename TridiagonalizationType::SubDiagonalType subdiag = m_subdiag;
+  ei_tridiagonal_qr_iteration(eivalues, subdiag, (MatrixType*)0);
+  std::sort(eivalues.data(), eivalues.data() + n);
+  m_eivalues = eivalues.segment(first, count);
+
+  if (computeEigenvectors)
+  {
+    Matrix<RealScalar,Dynamic,Dynamic> z;
+    ei_tridiagonal_inverse_iteration(diag, m_subdiag, m_eivalues, z);
+    m_eivec = z.template cast<Scalar>();
+
+    // apply Q = H_0 ... H_{n-2}
+    const MatrixType& packed = tridiag.packedMatrix();
+    const typename TridiagonalizationType::CoeffVectorType hCoeffs = tridiag.householderCoefficients();
+    Matrix<Scalar,1,Dynamic> aux(count);
+    for (int i = n-2; i>=0; i--)
+      m_eivec.bottomRows(n-i-1)
+             .applyHouseholderOnTheLeft(packed.col(i).tail(n-i-2), ei_conj(hCoeffs.coeff(i)), &aux.coeffRef(0,0));
+  }
+  return *this;
+}
+
+/** Computes the eigenvalues of index \a first to \a first + \a count - 1, in increasing order,
+  * of the generalized eigen problem \f$ Ax = lambda B x \f$ with \a matA the selfadjoint matrix
+  * \f$ A \f$ and \a cholB the Cholesky factorization of the positive definite matrix \f$ B \f$,
+  * as well as the corresponding eigenvectors if \a computeEigenvectors is true.
+  *
+  * \sa computeSubset(MatrixType,int,int,bool), compute(MatrixType,LLT,bool)
+  */
+template<typename MatrixType>
+SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>::
+computeSubset(const MatrixType& matA, const LLT<MatrixType>& cholB, int first, int count, bool computeEigenvectors)
+{
+  ei_assert(matA.cols()==matA.rows() && cholB.rows()==matA.rows());
+
+  MatrixType matC = matA;
+  ei_reduce_generalized_selfadjoint(matC, cholB.matrixLLT());
+
+  computeSubset(matC, first, count, computeEigenvectors);
+
+  if (computeEigenvectors)
+  {
+    cholB.matrixU().solveInPlace(m_eivec);
+    for (int i=0; i<m_eivec.cols(); ++i)
+      m_eivec.col(i) = m_eivec.col(i).normalized();
+  }
+  return *this;
+}
+
 #endif // EIGEN_HIDE_HEAVY_CODE
 
 /** \eigenvalues_module
@@ -333,7 +886,7 @@ MatrixBase<Derived>::operatorNorm() const
 
 #ifndef EIGEN_EXTERN_INSTANTIATIONS
 template<typename RealScalar, typename Scalar>
-static void ei_tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, int start, int end, Scalar* matrixQ, int n)
+static void ei_tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, int start, int end, ei_planar_rotation_sequence<Scalar>* rotations)
 {
   RealScalar td = (diag[end-1] - diag[end])*RealScalar(0.5);
   RealScalar e2 = ei_abs2(subdiag[end-1]);
@@ -365,12 +918,9 @@ static void ei_tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, int st
       subdiag[k + 1] = rot.c() * subdiag[k+1];
     }
 
-    // apply the givens rotation to the unit matrix Q = Q * G
-    if (matrixQ)
-    {
-      Map<Matrix<Scalar,Dynamic,Dynamic> > q(matrixQ,n,n);
-      q.applyOnTheRight(k,k+1,rot);
-    }
+    // record the givens rotation to apply it to the unit matrix Q = Q * G
+    if (rotations)
+      rotations->push_back(k,k+1,rot);
   }
 }
 #endif
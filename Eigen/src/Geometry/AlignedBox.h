@@ -25,6 +25,44 @@
 #ifndef EIGEN_ALIGNEDBOX_H
 #define EIGEN_ALIGNEDBOX_H
 
+enum { ei_alignedbox_batch_block_size = 256 };
+
+// Computes, for each column i, the squared distance between the box [lows.col(i),highs.col(i)] and
+// the box [boxMin,boxMax], i.e., sum_k (max(0,lows(k,i)-boxMax(k)) + max(0,boxMin(k)-highs(k,i)))^2.
+// A point is handled as a degenerated box with lows==highs. The distances are accumulated one
+// coordinate at a time for blocks of columns so that the inner loops are packet min/max operations.
+// The squared distances and/or the inclusion flags (null distance) are stored if the respective
+// destinations are not null, and the number of null distances is returned.
+template<typename VectorType, typename LowDerived, typename HighDerived, typename MaskType, typename DistType>
+int ei_alignedbox_batch(const VectorType& boxMin, const VectorType& boxMax,
+                        const MatrixBase<LowDerived>& lows, const MatrixBase<HighDerived>& highs,
+                        MaskType* mask, DistType* dist)
+{
+  typedef typename VectorType::Scalar Scalar;
+  typedef Array<Scalar,Dynamic,1,0,ei_alignedbox_batch_block_size,1> BlockArray;
+  ei_assert(lows.rows()==boxMin.size() && highs.rows()==boxMin.size() && lows.cols()==highs.cols());
+
+  const int n = lows.cols();
+  if(mask) mask->derived().resize(n);
+  if(dist) dist->derived().resize(n);
+
+  int count = 0;
+  for(int j=0; j<n; j+=ei_alignedbox_batch_block_size)
+  {
+    const int bs = std::min<int>(ei_alignedbox_batch_block_size, n-j);
+    BlockArray d2 = BlockArray::Zero(bs);
+    for(int k=0; k<boxMin.size(); ++k)
+      d2 += ( (lows.row(k).segment(j,bs).transpose().array() - boxMax.coeff(k)).max(BlockArray::Zero(bs))
+            + (boxMin.coeff(k) - highs.row(k).segment(j,bs).transpose().array()).max(BlockArray::Zero(bs)) ).square();
+    if(mask)
+      mask->segment(j,bs) = (d2==Scalar(0)).matrix();
+    if(dist)
+      dist->segment(j,bs) = d2.matrix();
+    count += (d2==Scalar(0)).count();
+  }
+  return count;
+}
+
 /** \geometry_module \ingroup Geometry_Module
   * \nonstableyet
   *
@@ -91,7 +129,7 @@ EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF_VECTORIZABLE_FIXED_SIZE(_Scalar,_AmbientDim)
   ~AlignedBox() {}
 
   /** \returns the dimension in which the box holds */
-  inline int dim() const { return AmbientDimAtCompileTime==Dynamic ? m_min.size()-1 : AmbientDimAtCompileTime; }
+  inline int dim() const { return AmbientDimAtCompileTime==Dynamic ? m_min.size() : AmbientDimAtCompileTime; }
 
   /** \deprecated use isEmpty */
   inline bool isNull() const { return isEmpty(); }
@@ -193,6 +231,20 @@ EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF_VECTORIZABLE_FIXED_SIZE(_Scalar,_AmbientDim)
     return (m_min.array()<=p.array()).all() && (p.array()<=m_max.array()).all();
   }
 
+  /** Sets \a result(i) to true if the \a i-th column of \a points is inside the box \c *this,
+    * and to false otherwise.
+    * \returns the number of points inside the box.
+    *
+    * This is the batched version of contains(const MatrixBase&) const. The points are processed
+    * one coordinate at a time, so it is vectorized when the coordinates of the points are stored
+    * contiguously, i.e., when \a points is a row major matrix.
+    *
+    * \sa squaredExteriorDistances()
+    */
+  template<typename Derived, typename ResultType>
+  inline int containsPoints(const MatrixBase<Derived>& points, MatrixBase<ResultType>& result) const
+  { return ei_alignedbox_batch(m_min, m_max, points, points, &result, static_cast<VectorType*>(0)); }
+
   /** \returns true if the box \a b is entirely inside the box \c *this. */
   inline bool contains(const AlignedBox& b) const
   { return (m_min.array()<=b.min().array()).all() && (b.max().array()<=m_max.array()).all(); }
@@ -207,6 +259,28 @@ EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF_VECTORIZABLE_FIXED_SIZE(_Scalar,_AmbientDim)
     return *this;
   }
 
+  /** Extends \c *this such that it contains all the columns of \a points and returns a reference to \c *this.
+    *
+    * The bounding box of the point set is computed in a single pass over blocks of points, and it is
+    * vectorized when the coordinates of the points are stored contiguously (row major storage).
+    */
+  template<typename Derived>
+  inline AlignedBox& extendByPoints(const MatrixBase<Derived>& points)
+  {
+    ei_assert(points.rows()==m_min.size());
+    const int n = points.cols();
+    for(int j=0; j<n; j+=ei_alignedbox_batch_block_size)
+    {
+      const int bs = std::min<int>(ei_alignedbox_batch_block_size, n-j);
+      for(int k=0; k<m_min.size(); ++k)
+      {
+        m_min.coeffRef(k) = std::min(m_min.coeff(k), points.row(k).segment(j,bs).minCoeff());
+        m_max.coeffRef(k) = std::max(m_max.coeff(k), points.row(k).segment(j,bs).maxCoeff());
+      }
+    }
+    return *this;
+  }
+
   /** Extends \c *this such that it contains the box \a b and returns a reference to \c *this. */
   inline AlignedBox& extend(const AlignedBox& b)
   {
@@ -223,6 +297,21 @@ EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF_VECTORIZABLE_FIXED_SIZE(_Scalar,_AmbientDim)
     return *this;
   }
 
+  /** \returns true if the box \a b intersects the box \c *this. */
+  inline bool intersects(const AlignedBox& b) const
+  { return (m_min.array()<=b.m_max.array()).all() && (b.m_min.array()<=m_max.array()).all(); }
+
+  /** Sets \a result(i) to true if the box of minimal corner \a mins.col(i) and maximal corner \a maxs.col(i)
+    * intersects the box \c *this, and to false otherwise.
+    * \returns the number of intersecting boxes.
+    *
+    * Like containsPoints(), this is vectorized when \a mins and \a maxs are row major.
+    */
+  template<typename MinDerived, typename MaxDerived, typename ResultType>
+  inline int intersectsBoxes(const MatrixBase<MinDerived>& mins, const MatrixBase<MaxDerived>& maxs,
+                             MatrixBase<ResultType>& result) const
+  { return ei_alignedbox_batch(m_min, m_max, mins, maxs, &result, static_cast<VectorType*>(0)); }
+
   /** Returns an AlignedBox that is the intersection of \a b and \c *this */
   inline AlignedBox intersection(const AlignedBox& b) const
   {return AlignedBox(m_min.cwiseMax(b.m_min), m_max.cwiseMin(b.m_max)); }
@@ -254,6 +343,24 @@ EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF_VECTORIZABLE_FIXED_SIZE(_Scalar,_AmbientDim)
     */
   inline Scalar squaredExteriorDistance(const AlignedBox& b) const;
 
+  /** Sets \a result(i) to the squared distance between the \a i-th column of \a points and the box \c *this.
+    * This is the batched version of squaredExteriorDistance(const MatrixBase&) const.
+    * \sa containsPoints()
+    */
+  template<typename Derived, typename ResultType>
+  inline void squaredExteriorDistances(const MatrixBase<Derived>& points, MatrixBase<ResultType>& result) const
+  { ei_alignedbox_batch(m_min, m_max, points, points, static_cast<Matrix<bool,Dynamic,1>*>(0), &result); }
+
+  /** Sets \a result(i) to the squared distance between the box of minimal corner \a mins.col(i) and maximal
+    * corner \a maxs.col(i), and the box \c *this.
+    * This is the batched version of squaredExteriorDistance(const AlignedBox&) const.
+    * \sa intersectsBoxes()
+    */
+  template<typename MinDerived, typename MaxDerived, typename ResultType>
+  inline void squaredExteriorDistances(const MatrixBase<MinDerived>& mins, const MatrixBase<MaxDerived>& maxs,
+                                       MatrixBase<ResultType>& result) const
+  { ei_alignedbox_batch(m_min, m_max, mins, maxs, static_cast<Matrix<bool,Dynamic,1>*>(0), &result); }
+
   /** \returns the distance between the point \a p and the box \c *this,
     * and zero if \a p is inside the box.
     * \sa squaredExteriorDistance()
@@ -348,4 +455,57 @@ inline Scalar AlignedBox<Scalar,AmbientDim>::squaredExteriorDistance(const Align
   return dist2;
 }
 
+/** \geometry_module \ingroup Geometry_Module
+  *
+  * Tests a set of axis aligned boxes against a convex region defined by the intersection of half-spaces,
+  * typically a view frustum.
+  *
+  * \param planes a (d+1) x p matrix whose columns are the coefficients of the planes (see Hyperplane::coeffs()),
+  *               the inside of the region being the positive side of each plane
+  * \param mins the minimal corners of the boxes, one box per column
+  * \param maxs the maximal corners of the boxes, one box per column
+  * \param result set to a vector such that \a result(i) is false if the \a i-th box is entirely outside the region
+  *               and true otherwise
+  * \returns the number of boxes which are not culled
+  *
+  * Like in most culling algorithms, a box which is outside the region but which is not entirely on the negative side
+  * of any plane is conservatively reported as not culled. All the boxes are processed together, one plane and one
+  * coordinate at a time, such that this is vectorized when \a mins and \a maxs are row major.
+  */
+template<typename PlanesDerived, typename MinDerived, typename MaxDerived, typename ResultType>
+int boxesInsidePlanes(const MatrixBase<PlanesDerived>& planes, const MatrixBase<MinDerived>& mins,
+                      const MatrixBase<MaxDerived>& maxs, MatrixBase<ResultType>& result)
+{
+  typedef typename PlanesDerived::Scalar Scalar;
+  typedef Array<Scalar,Dynamic,1,0,ei_alignedbox_batch_block_size,1> BlockArray;
+  const int dim = mins.rows();
+  const int n = mins.cols();
+  ei_assert(planes.rows()==dim+1 && maxs.rows()==dim && maxs.cols()==n);
+
+  result.derived().resize(n);
+  int count = 0;
+  for(int j=0; j<n; j+=ei_alignedbox_batch_block_size)
+  {
+    const int bs = std::min<int>(ei_alignedbox_batch_block_size, n-j);
+    // the smallest signed distance of the most positive vertices
+    BlockArray minDist = BlockArray::Constant(bs, NumTraits<Scalar>::highest());
+    for(int p=0; p<planes.cols(); ++p)
+    {
+      BlockArray dist = BlockArray::Constant(bs, planes.coeff(dim,p));
+      for(int k=0; k<dim; ++k)
+      {
+        const Scalar normal = planes.coeff(k,p);
+        if(normal>Scalar(0))
+          dist += normal * maxs.row(k).segment(j,bs).transpose().array();
+        else
+          dist += normal * mins.row(k).segment(j,bs).transpose().array();
+      }
+      minDist = minDist.min(dist);
+    }
+    result.segment(j,bs) = (minDist>=Scalar(0)).matrix();
+    count += (minDist>=Scalar(0)).count();
+  }
+  return count;
+}
+
 #endif // EIGEN_ALIGNEDBOX_H
@@ -0,0 +1,264 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_QUATERNION_BATCH_H
+#define EIGEN_QUATERNION_BATCH_H
+
+/***************************************************************************
+* Batched quaternion operations on structure-of-arrays storage.
+*
+* A set of n quaternions is stored as a n x 4 column-major matrix whose
+* columns hold the x, y, z and w coefficients respectively (the same order
+* as Quaternion::coeffs()). Each column being contiguous, all the operations
+* below are expressed as coefficient-wise array expressions on the columns
+* and are therefore vectorized across quaternions. The inputs are processed
+* by chunks of rows such that the intermediate results stay in the L1 cache.
+***************************************************************************/
+
+template<typename Scalar> struct ei_quaternion_batch_traits
+{
+  enum {
+    // number of quaternions processed at once: a multiple of the packet
+    // size of any architecture (including 256 bits wide registers)
+    BlockSize = 256
+  };
+  typedef Array<Scalar,Dynamic,1,0,BlockSize,1> BlockArray;
+};
+
+/** \geometry_module \ingroup Geometry_Module
+  *
+  * Normalizes in place each of the quaternions stored in the rows of \a q.
+  *
+  * \param q a n x 4 matrix storing n quaternions in structure-of-arrays layout (x,y,z,w columns)
+  *
+  * \sa QuaternionBase::normalize()
+  */
+template<typename Derived>
+void normalizeQuaternions(MatrixBase<Derived>& q)
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef ei_quaternion_batch_traits<Scalar> Traits;
+  typedef typename Traits::BlockArray BlockArray;
+  ei_assert(q.cols()==4);
+
+  const int n = q.rows();
+  for(int i=0; i<n; i+=Traits::BlockSize)
+  {
+    const int bs = std::min<int>(Traits::BlockSize, n-i);
+    BlockArray invNorm = ( q.col(0).segment(i,bs).array().square() + q.col(1).segment(i,bs).array().square()
+                         + q.col(2).segment(i,bs).array().square() + q.col(3).segment(i,bs).array().square() ).sqrt().inverse();
+    for(int k=0; k<4; ++k)
+      q.col(k).segment(i,bs).array() *= invNorm;
+  }
+}
+
+/** \geometry_module \ingroup Geometry_Module
+  *
+  * Computes the products \f$ res_i = a_i * b_i \f$ of the quaternions stored in the rows of \a a and \a b.
+  *
+  * \a res can be the same object than \a a or \a b.
+  *
+  * \sa QuaternionBase::operator*(const QuaternionBase&)
+  */
+template<typename DerivedA, typename DerivedB, typename DerivedRes>
+void multiplyQuaternions(const MatrixBase<DerivedA>& a, const MatrixBase<DerivedB>& b, MatrixBase<DerivedRes>& res)
+{
+  typedef typename DerivedA::Scalar Scalar;
+  typedef ei_quaternion_batch_traits<Scalar> Traits;
+  typedef typename Traits::BlockArray BlockArray;
+  ei_assert(a.cols()==4 && b.cols()==4 && a.rows()==b.rows());
+
+  const int n = a.rows();
+  res.derived().resize(n,4);
+  for(int i=0; i<n; i+=Traits::BlockSize)
+  {
+    const int bs = std::min<int>(Traits::BlockSize, n-i);
+    BlockArray ax = a.col(0).segment(i,bs), ay = a.col(1).segment(i,bs), az = a.col(2).segment(i,bs), aw = a.col(3).segment(i,bs);
+    BlockArray bx = b.col(0).segment(i,bs), by = b.col(1).segment(i,bs), bz = b.col(2).segment(i,bs), bw = b.col(3).segment(i,bs);
+    res.col(0).segment(i,bs).array() = aw * bx + ax * bw + ay * bz - az * by;
+    res.col(1).segment(i,bs).array() = aw * by + ay * bw + az * bx - ax * bz;
+    res.col(2).segment(i,bs).array() = aw * bz + az * bw + ax * by - ay * bx;
+    res.col(3).segment(i,bs).array() = aw * bw - ax * bx - ay * by - az * bz;
+  }
+}
+
+template<typename DerivedT, typename DerivedA, typename DerivedB, typename DerivedRes>
+void ei_interpolate_quaternions(const MatrixBase<DerivedT>& t, const MatrixBase<DerivedA>& a, const MatrixBase<DerivedB>& b,
+                                MatrixBase<DerivedRes>& res, bool spherical)
+{
+  typedef typename DerivedA::Scalar Scalar;
+  typedef ei_quaternion_batch_traits<Scalar> Traits;
+  typedef typename Traits::BlockArray BlockArray;
+  ei_assert(a.cols()==4 && b.cols()==4 && a.rows()==b.rows() && t.size()==a.rows());
+  static const Scalar one = Scalar(1) - NumTraits<Scalar>::epsilon();
+
+  const int n = a.rows();
+  res.derived().resize(n,4);
+  for(int i=0; i<n; i+=Traits::BlockSize)
+  {
+    const int bs = std::min<int>(Traits::BlockSize, n-i);
+    BlockArray tb = t.segment(i,bs);
+    BlockArray d = a.col(0).segment(i,bs).array() * b.col(0).segment(i,bs).array()
+                 + a.col(1).segment(i,bs).array() * b.col(1).segment(i,bs).array()
+                 + a.col(2).segment(i,bs).array() * b.col(2).segment(i,bs).array()
+                 + a.col(3).segment(i,bs).array() * b.col(3).segment(i,bs).array();
+    BlockArray absD = d.abs();
+    BlockArray scale0, scale1;
+    if(spherical)
+    {
+      // only the arc cosine is evaluated one coefficient at a time,
+      // all the sines are evaluated using packets
+      BlockArray theta(bs);
+      for(int j=0; j<bs; ++j)
+        theta.coeffRef(j) = std::acos(std::min(absD.coeff(j),Scalar(1)));
+      BlockArray invSinTheta = theta.sin().inverse();
+      scale0 = (absD>=one).select(Scalar(1)-tb, ((Scalar(1)-tb)*theta).sin() * invSinTheta);
+      scale1 = (absD>=one).select(tb, (tb*theta).sin() * invSinTheta);
+    }
+    else
+    {
+      scale0 = Scalar(1)-tb;
+      scale1 = tb;
+    }
+    // take the shortest path
+    scale1 = (d<Scalar(0)).select(-scale1, scale1);
+
+    for(int k=0; k<4; ++k)
+      res.col(k).segment(i,bs).array() = scale0 * a.col(k).segment(i,bs).array() + scale1 * b.col(k).segment(i,bs).array();
+    if(!spherical)
+    {
+      // renormalize while the block is still in cache
+      Block<DerivedRes> resBlock(res.derived(),i,0,bs,4);
+      normalizeQuaternions(resBlock);
+    }
+  }
+}
+
+/** \geometry_module \ingroup Geometry_Module
+  *
+  * Computes the spherical linear interpolations between the quaternions stored
+  * in the rows of \a a and \a b at the parameter \a t. This is the batched
+  * counterpart of QuaternionBase::slerp().
+  *
+  * \a res can be the same object than \a a or \a b.
+  *
+  * \sa nlerpQuaternions(), QuaternionBase::slerp()
+  */
+template<typename DerivedA, typename DerivedB, typename DerivedRes>
+void slerpQuaternions(typename DerivedA::Scalar t, const MatrixBase<DerivedA>& a, const MatrixBase<DerivedB>& b, MatrixBase<DerivedRes>& res)
+{
+  typedef Matrix<typename DerivedA::Scalar,Dynamic,1> VectorType;
+  ei_interpolate_quaternions(VectorType::Constant(a.rows(),t), a, b, res, true);
+}
+
+/** \geometry_module \ingroup Geometry_Module
+  *
+  * Overload of slerpQuaternions() taking one interpolation parameter per quaternion pair.
+  *
+  * \param t a vector of size \c a.rows()
+  */
+template<typename DerivedT, typename DerivedA, typename DerivedB, typename DerivedRes>
+void slerpQuaternions(const MatrixBase<DerivedT>& t, const MatrixBase<DerivedA>& a, const MatrixBase<DerivedB>& b, MatrixBase<DerivedRes>& res)
+{
+  ei_interpolate_quaternions(t, a, b, res, true);
+}
+
+/** \geometry_module \ingroup Geometry_Module
+  *
+  * Computes the normalized linear interpolations between the quaternions stored
+  * in the rows of \a a and \a b at the parameter \a t. Like slerpQuaternions(),
+  * the shortest path between \c a_i and \c b_i is taken.
+  *
+  * This is a cheaper approximation of slerpQuaternions() which does not
+  * preserve a constant angular velocity.
+  *
+  * \sa slerpQuaternions()
+  */
+template<typename DerivedA, typename DerivedB, typename DerivedRes>
+void nlerpQuaternions(typename DerivedA::Scalar t, const MatrixBase<DerivedA>& a, const MatrixBase<DerivedB>& b, MatrixBase<DerivedRes>& res)
+{
+  typedef Matrix<typename DerivedA::Scalar,Dynamic,1> VectorType;
+  ei_interpolate_quaternions(VectorType::Constant(a.rows(),t), a, b, res, false);
+}
+
+/** \geometry_module \ingroup Geometry_Module
+  *
+  * Overload of nlerpQuaternions() taking one interpolation parameter per quaternion pair.
+  *
+  * \param t a vector of size \c a.rows()
+  */
+template<typename DerivedT, typename DerivedA, typename DerivedB, typename DerivedRes>
+void nlerpQuaternions(const MatrixBase<DerivedT>& t, const MatrixBase<DerivedA>& a, const MatrixBase<DerivedB>& b, MatrixBase<DerivedRes>& res)
+{
+  ei_interpolate_quaternions(t, a, b, res, false);
+}
+
+/** \geometry_module \ingroup Geometry_Module
+  *
+  * Converts the normalized quaternions stored in the rows of \a q to 3x3 rotation matrices.
+  *
+  * \param q a n x 4 matrix storing n quaternions in structure-of-arrays layout (x,y,z,w columns)
+  * \param res a n x 9 matrix such that the coefficient (r,c) of the i-th rotation matrix
+  *            is stored at \c res(i,r+3*c), i.e., the rows of \a res are the column-major
+  *            storage of the rotation matrices
+  *
+  * \sa QuaternionBase::toRotationMatrix()
+  */
+template<typename Derived, typename DerivedRes>
+void quaternionsToRotationMatrices(const MatrixBase<Derived>& q, MatrixBase<DerivedRes>& res)
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef ei_quaternion_batch_traits<Scalar> Traits;
+  typedef typename Traits::BlockArray BlockArray;
+  ei_assert(q.cols()==4);
+
+  const int n = q.rows();
+  res.derived().resize(n,9);
+  for(int i=0; i<n; i+=Traits::BlockSize)
+  {
+    const int bs = std::min<int>(Traits::BlockSize, n-i);
+    BlockArray tx = Scalar(2) * q.col(0).segment(i,bs).array();
+    BlockArray ty = Scalar(2) * q.col(1).segment(i,bs).array();
+    BlockArray tz = Scalar(2) * q.col(2).segment(i,bs).array();
+    BlockArray twx = tx * q.col(3).segment(i,bs).array();
+    BlockArray twy = ty * q.col(3).segment(i,bs).array();
+    BlockArray twz = tz * q.col(3).segment(i,bs).array();
+    BlockArray txx = tx * q.col(0).segment(i,bs).array();
+    BlockArray txy = ty * q.col(0).segment(i,bs).array();
+    BlockArray txz = tz * q.col(0).segment(i,bs).array();
+    BlockArray tyy = ty * q.col(1).segment(i,bs).array();
+    BlockArray tyz = tz * q.col(1).segment(i,bs).array();
+    BlockArray tzz = tz * q.col(2).segment(i,bs).array();
+
+    res.col(0).segment(i,bs).array() = Scalar(1)-(tyy+tzz);
+    res.col(1).segment(i,bs).array() = txy+twz;
+    res.col(2).segment(i,bs).array() = txz-twy;
+    res.col(3).segment(i,bs).array() = txy-twz;
+    res.col(4).segment(i,bs).array() = Scalar(1)-(txx+tzz);
+    res.col(5).segment(i,bs).array() = tyz+twx;
+    res.col(6).segment(i,bs).array() = txz+twy;
+    res.col(7).segment(i,bs).array() = tyz-twx;
+    res.col(8).segment(i,bs).array() = Scalar(1)-(txx+tyy);
+  }
+}
+
+#endif // EIGEN_QUATERNION_BATCH_H
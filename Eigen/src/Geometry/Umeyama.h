@@ -64,6 +64,122 @@ namespace
 
 #endif
 
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+
+// Computes in a single pass over the point sets the (weighted) means of src and dst,
+// the variance of src, i.e., Eq. (36)-(37), and the covariance matrix of Eq. (38).
+// The inputs are processed by blocks of columns such that each coefficient is read
+// only once. In order to avoid the cancellation errors of the naive one pass formula,
+// the points are first shifted by the first point of each set.
+template<typename Derived, typename OtherDerived, typename WeightsType, typename VectorType, typename MatrixType>
+void ei_umeyama_statistics(const MatrixBase<Derived>& src, const MatrixBase<OtherDerived>& dst, const WeightsType* weights,
+                           VectorType& src_mean, VectorType& dst_mean, typename VectorType::Scalar& src_var, MatrixType& sigma)
+{
+  typedef typename VectorType::Scalar Scalar;
+  typedef Matrix<Scalar, VectorType::RowsAtCompileTime, Dynamic> BlockType;
+  enum { BlockSize = 128 };
+
+  const int m = src.rows(); // dimension
+  const int n = src.cols(); // number of measurements
+  ei_assert(dst.rows()==m && dst.cols()==n && (weights==0 || weights->size()==n));
+
+  const VectorType src_shift = src.col(0);
+  const VectorType dst_shift = dst.col(0);
+
+  VectorType src_sum = VectorType::Zero(m);
+  VectorType dst_sum = VectorType::Zero(m);
+  MatrixType cross = MatrixType::Zero(m,m);
+  Scalar src_sqsum = 0;
+  Scalar weight_sum = 0;
+
+  BlockType src_block(m, std::min<int>(BlockSize,n));
+  BlockType dst_block(m, std::min<int>(BlockSize,n));
+  for(int j=0; j<n; j+=BlockSize)
+  {
+    const int bs = std::min<int>(BlockSize, n-j);
+    src_block.leftCols(bs) = src.block(0,j,m,bs).colwise() - src_shift;
+    dst_block.leftCols(bs) = dst.block(0,j,m,bs).colwise() - dst_shift;
+    if(weights)
+    {
+      weight_sum += weights->segment(j,bs).sum();
+      src_sqsum  += src_block.leftCols(bs).colwise().squaredNorm().dot(weights->segment(j,bs));
+      src_sum.noalias() += src_block.leftCols(bs) * weights->segment(j,bs).transpose();
+      dst_sum.noalias() += dst_block.leftCols(bs) * weights->segment(j,bs).transpose();
+      dst_block.leftCols(bs) = dst_block.leftCols(bs) * weights->segment(j,bs).asDiagonal();
+    }
+    else
+    {
+      src_sqsum += src_block.leftCols(bs).squaredNorm();
+      src_sum += src_block.leftCols(bs).rowwise().sum();
+      dst_sum += dst_block.leftCols(bs).rowwise().sum();
+    }
+    cross.noalias() += dst_block.leftCols(bs) * src_block.leftCols(bs).transpose();
+  }
+  if(!weights)
+    weight_sum = Scalar(n);
+  ei_assert(weight_sum > Scalar(0) && "the sum of the weights must be positive");
+
+  const Scalar one_over_n = Scalar(1) / weight_sum;
+  src_sum *= one_over_n;
+  dst_sum *= one_over_n;
+
+  src_mean = src_shift + src_sum;
+  dst_mean = dst_shift + dst_sum;
+  src_var = src_sqsum * one_over_n - src_sum.squaredNorm();
+  sigma = one_over_n * cross;
+  sigma.noalias() -= dst_sum * src_sum.transpose();
+}
+
+// Computes the transformation from the statistics of the point sets, Eq. (39)-(43).
+template<typename TransformationMatrixType, typename VectorType, typename MatrixType>
+TransformationMatrixType ei_umeyama_transform(const VectorType& src_mean, const VectorType& dst_mean,
+                                              typename VectorType::Scalar src_var, const MatrixType& sigma,
+                                              bool with_scaling)
+{
+  typedef typename VectorType::Scalar Scalar;
+  const int m = src_mean.size(); // dimension
+
+  SVD<MatrixType> svd(sigma);
+
+  // Initialize the resulting transformation with an identity matrix...
+  TransformationMatrixType Rt = TransformationMatrixType::Identity(m+1,m+1);
+
+  // Eq. (39)
+  VectorType S = VectorType::Ones(m);
+  if (sigma.determinant()<0) S(m-1) = -1;
+
+  // Eq. (40) and (43)
+  const VectorType& d = svd.singularValues();
+  int rank = 0; for (int i=0; i<m; ++i) if (!ei_isMuchSmallerThan(d.coeff(i),d.coeff(0))) ++rank;
+  if (rank == m-1) {
+    if ( svd.matrixU().determinant() * svd.matrixV().determinant() > 0 ) {
+      Rt.block(0,0,m,m).noalias() = svd.matrixU()*svd.matrixV().transpose();
+    } else {
+      const Scalar s = S(m-1); S(m-1) = -1;
+      Rt.block(0,0,m,m).noalias() = svd.matrixU() * S.asDiagonal() * svd.matrixV().transpose();
+      S(m-1) = s;
+    }
+  } else {
+    Rt.block(0,0,m,m).noalias() = svd.matrixU() * S.asDiagonal() * svd.matrixV().transpose();
+  }
+
+  // Eq. (42)
+  const Scalar c = with_scaling ? 1/src_var * svd.singularValues().dot(S) : Scalar(1);
+
+  // Eq. (41)
+  // Note that we first assign dst_mean to the destination so that there no need
+  // for a temporary.
+  Rt.col(m).head(m) = dst_mean;
+  Rt.col(m).head(m).noalias() -= c*Rt.topLeftCorner(m,m)*src_mean;
+
+  if (with_scaling) Rt.block(0,0,m,m) *= c;
+
+  return Rt;
+}
+
+#endif // EIGEN_PARSED_BY_DOXYGEN
+
 /**
 * \geometry_module \ingroup Geometry_Module
 *
@@ -86,12 +202,15 @@ namespace
 * The analysis is involving the SVD having a complexity of \f$O(d^3)\f$
 * though the actual computational effort lies in the covariance
 * matrix computation which has an asymptotic lower bound of \f$O(dm)\f$ when 
-* the input point sets have dimension \f$d \times m\f$.
+* the input point sets have dimension \f$d \times m\f$. The means and the
+* covariance matrix are accumulated in a single blocked pass over the inputs.
 *
 * Currently the method is working only for floating point matrices.
 *
 * \todo Should the return type of umeyama() become a Transform?
 *
+* \sa umeyamaRansac()
+*
 * \param src Source points \f$ \mathbf{x} = \left( x_1, \hdots, x_n \right) \f$.
 * \param dst Destination points \f$ \mathbf{y} = \left( y_1, \hdots, y_n \right) \f$.
 * \param with_scaling Sets \f$ c=1 \f$ when <code>false</code> is passed.
@@ -108,7 +227,6 @@ umeyama(const MatrixBase<Derived>& src, const MatrixBase<OtherDerived>& dst, boo
 {
   typedef typename ei_umeyama_transform_matrix_type<Derived, OtherDerived>::type TransformationMatrixType;
   typedef typename ei_traits<TransformationMatrixType>::Scalar Scalar;
-  typedef typename NumTraits<Scalar>::Real RealScalar;
 
   EIGEN_STATIC_ASSERT(!NumTraits<Scalar>::IsComplex, NUMERIC_TYPE_MUST_BE_REAL)
   EIGEN_STATIC_ASSERT((ei_is_same_type<Scalar, typename ei_traits<OtherDerived>::Scalar>::ret),
@@ -118,64 +236,195 @@ umeyama(const MatrixBase<Derived>& src, const MatrixBase<OtherDerived>& dst, boo
 
   typedef Matrix<Scalar, Dimension, 1> VectorType;
   typedef Matrix<Scalar, Dimension, Dimension> MatrixType;
-  typedef typename ei_plain_matrix_type_row_major<Derived>::type RowMajorMatrixType;
+  typedef Matrix<Scalar, 1, Dynamic> WeightsType;
 
-  const int m = src.rows(); // dimension
-  const int n = src.cols(); // number of measurements
+  VectorType src_mean, dst_mean;
+  MatrixType sigma;
+  Scalar src_var;
+  ei_umeyama_statistics(src, dst, static_cast<const WeightsType*>(0), src_mean, dst_mean, src_var, sigma);
+
+  return ei_umeyama_transform<TransformationMatrixType>(src_mean, dst_mean, src_var, sigma, with_scaling);
+}
+
+/**
+* \geometry_module \ingroup Geometry_Module
+*
+* \brief Returns the transformation between two weighted point sets.
+*
+* This is the weighted variant of umeyama(const MatrixBase&, const MatrixBase&, bool):
+* it estimates \f$ c, \mathbf{R}, \f$ and \f$ \mathbf{t} \f$ minimizing
+* \f{align*}
+*   \frac{1}{\sum_i w_i} \sum_{i=1}^n w_i \vert\vert y_i - (c\mathbf{R}x_i + \mathbf{t}) \vert\vert_2^2
+* \f}
+* Points with a zero weight are ignored, which allows to restrict the estimation to a
+* set of inliers without copying them.
+*
+* \param src Source points \f$ \mathbf{x} = \left( x_1, \hdots, x_n \right) \f$.
+* \param dst Destination points \f$ \mathbf{y} = \left( y_1, \hdots, y_n \right) \f$.
+* \param weights Non negative weights \f$ \left( w_1, \hdots, w_n \right) \f$, at least one of them being positive.
+* \param with_scaling Sets \f$ c=1 \f$ when <code>false</code> is passed.
+*/
+template <typename Derived, typename OtherDerived, typename WeightsDerived>
+typename ei_umeyama_transform_matrix_type<Derived, OtherDerived>::type
+umeyama(const MatrixBase<Derived>& src, const MatrixBase<OtherDerived>& dst, const MatrixBase<WeightsDerived>& weights,
+        bool with_scaling = true)
+{
+  typedef typename ei_umeyama_transform_matrix_type<Derived, OtherDerived>::type TransformationMatrixType;
+  typedef typename ei_traits<TransformationMatrixType>::Scalar Scalar;
 
-  // required for demeaning ...
-  const RealScalar one_over_n = 1 / static_cast<RealScalar>(n);
+  EIGEN_STATIC_ASSERT(!NumTraits<Scalar>::IsComplex, NUMERIC_TYPE_MUST_BE_REAL)
+  EIGEN_STATIC_ASSERT((ei_is_same_type<Scalar, typename ei_traits<OtherDerived>::Scalar>::ret),
+    YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(WeightsDerived)
 
-  // computation of mean
-  const VectorType src_mean = src.rowwise().sum() * one_over_n;
-  const VectorType dst_mean = dst.rowwise().sum() * one_over_n;
+  enum { Dimension = EIGEN_SIZE_MIN(Derived::RowsAtCompileTime, OtherDerived::RowsAtCompileTime) };
 
-  // demeaning of src and dst points
-  const RowMajorMatrixType src_demean = src.colwise() - src_mean;
-  const RowMajorMatrixType dst_demean = dst.colwise() - dst_mean;
+  typedef Matrix<Scalar, Dimension, 1> VectorType;
+  typedef Matrix<Scalar, Dimension, Dimension> MatrixType;
+  typedef Matrix<Scalar, 1, Dynamic> WeightsType;
 
-  // Eq. (36)-(37)
-  const Scalar src_var = src_demean.rowwise().squaredNorm().sum() * one_over_n;
+  const WeightsType w = weights;
+  VectorType src_mean, dst_mean;
+  MatrixType sigma;
+  Scalar src_var;
+  ei_umeyama_statistics(src, dst, &w, src_mean, dst_mean, src_var, sigma);
 
-  // Eq. (38)
-  const MatrixType sigma = one_over_n * dst_demean * src_demean.transpose();
+  return ei_umeyama_transform<TransformationMatrixType>(src_mean, dst_mean, src_var, sigma, with_scaling);
+}
 
-  SVD<MatrixType> svd(sigma);
+#ifndef EIGEN_PARSED_BY_DOXYGEN
 
-  // Initialize the resulting transformation with an identity matrix...
-  TransformationMatrixType Rt = TransformationMatrixType::Identity(m+1,m+1);
+// Returns the number of pairs (x_i,y_i) such that |y_i - T x_i|^2 < threshold2, and
+// optionally sets mask(i) to 1 for them and to 0 for the others.
+template<typename Derived, typename OtherDerived, typename TransformationMatrixType, typename WeightsType>
+int ei_umeyama_inliers(const MatrixBase<Derived>& src, const MatrixBase<OtherDerived>& dst,
+                       const TransformationMatrixType& Rt, typename WeightsType::Scalar threshold2, WeightsType* mask)
+{
+  typedef typename WeightsType::Scalar Scalar;
+  enum { Dimension = EIGEN_SIZE_MIN(Derived::RowsAtCompileTime, OtherDerived::RowsAtCompileTime), BlockSize = 128 };
+  const int m = src.rows();
+  const int n = src.cols();
 
-  // Eq. (39)
-  VectorType S = VectorType::Ones(m);
-  if (sigma.determinant()<0) S(m-1) = -1;
+  const Matrix<Scalar, Dimension, Dimension> R = Rt.topLeftCorner(m,m);
+  const Matrix<Scalar, Dimension, 1> t = Rt.col(m).head(m);
 
-  // Eq. (40) and (43)
-  const VectorType& d = svd.singularValues();
-  int rank = 0; for (int i=0; i<m; ++i) if (!ei_isMuchSmallerThan(d.coeff(i),d.coeff(0))) ++rank;
-  if (rank == m-1) {
-    if ( svd.matrixU().determinant() * svd.matrixV().determinant() > 0 ) {
-      Rt.block(0,0,m,m).noalias() = svd.matrixU()*svd.matrixV().transpose();
-    } else {
-      const Scalar s = S(m-1); S(m-1) = -1;
-      Rt.block(0,0,m,m).noalias() = svd.matrixU() * S.asDiagonal() * svd.matrixV().transpose();
-      S(m-1) = s;
+  // process the points by blocks to keep the residuals in cache
+  Matrix<Scalar, Dimension, Dynamic> residuals(m, std::min<int>(BlockSize,n));
+  if (mask)
+    mask->resize(n);
+  int count = 0;
+  for (int j=0; j<n; j+=BlockSize)
+  {
+    const int bs = std::min<int>(BlockSize, n-j);
+    residuals.leftCols(bs) = dst.block(0,j,m,bs).colwise() - t;
+    residuals.leftCols(bs).noalias() -= R * src.block(0,j,m,bs);
+    if (mask)
+    {
+      mask->segment(j,bs) = (residuals.leftCols(bs).colwise().squaredNorm().array() < threshold2).template cast<Scalar>();
+      count += int(mask->segment(j,bs).sum());
     }
-  } else {
-    Rt.block(0,0,m,m).noalias() = svd.matrixU() * S.asDiagonal() * svd.matrixV().transpose();
+    else
+      count += (residuals.leftCols(bs).colwise().squaredNorm().array() < threshold2).count();
   }
+  return count;
+}
 
-  // Eq. (42)
-  const Scalar c = 1/src_var * svd.singularValues().dot(S);
+#endif // EIGEN_PARSED_BY_DOXYGEN
 
-  // Eq. (41)
-  // Note that we first assign dst_mean to the destination so that there no need
-  // for a temporary.
-  Rt.col(m).head(m) = dst_mean;
-  Rt.col(m).head(m).noalias() -= c*Rt.topLeftCorner(m,m)*src_mean;
+/**
+* \geometry_module \ingroup Geometry_Module
+*
+* \brief Returns the transformation between two point sets contaminated by outliers.
+*
+* This function robustly estimates the transformation of umeyama() using a RANSAC scheme:
+* \a num_hypotheses minimal samples of \f$ d \f$ point pairs are randomly drawn, a
+* transformation is computed for each of them, and the one having the largest number of
+* inliers, i.e., of pairs satisfying
+* \f$ \vert\vert y_i - (c\mathbf{R}x_i + \mathbf{t}) \vert\vert_2 < \f$ \a threshold, is
+* finally refined by the weighted umeyama() on its inliers. The best hypothesis is returned
+* unrefined when it has fewer inliers than a minimal sample.
+*
+* The samples are drawn using the standard rand() generator, then the hypotheses are
+* evaluated independently of each others, in parallel when OpenMP is enabled.
+*
+* \param src Source points \f$ \mathbf{x} = \left( x_1, \hdots, x_n \right) \f$.
+* \param dst Destination points \f$ \mathbf{y} = \left( y_1, \hdots, y_n \right) \f$.
+* \param threshold Maximal residual of the inliers.
+* \param num_hypotheses Number of random minimal samples.
+* \param with_scaling Sets \f$ c=1 \f$ when <code>false</code> is passed.
+* \param inliers If not null, set to a row vector of size \f$ n \f$ whose coefficients are 1 for the inliers
+*                of the returned transformation and 0 for the outliers.
+*
+* \sa umeyama()
+*/
+template <typename Derived, typename OtherDerived>
+typename ei_umeyama_transform_matrix_type<Derived, OtherDerived>::type
+umeyamaRansac(const MatrixBase<Derived>& src, const MatrixBase<OtherDerived>& dst,
+              typename ei_traits<Derived>::Scalar threshold, int num_hypotheses = 100, bool with_scaling = true,
+              Matrix<typename ei_traits<Derived>::Scalar, 1, Dynamic>* inliers = 0)
+{
+  typedef typename ei_umeyama_transform_matrix_type<Derived, OtherDerived>::type TransformationMatrixType;
+  typedef typename ei_traits<TransformationMatrixType>::Scalar Scalar;
 
-  if (with_scaling) Rt.block(0,0,m,m) *= c;
+  enum { Dimension = EIGEN_SIZE_MIN(Derived::RowsAtCompileTime, OtherDerived::RowsAtCompileTime) };
 
-  return Rt;
+  typedef Matrix<Scalar, Dimension, Dynamic> PointsType;
+  typedef Matrix<Scalar, 1, Dynamic> WeightsType;
+
+  const int m = src.rows(); // dimension
+  const int n = src.cols(); // number of measurements
+  const int sample_size = std::max(m,2);
+  ei_assert(n>=sample_size && num_hypotheses>0);
+  const Scalar threshold2 = threshold*threshold;
+
+  // draw the samples sequentially so that the result does not depend on the number of threads
+  Matrix<int, Dynamic, Dynamic> samples(sample_size, num_hypotheses);
+  for (int h=0; h<num_hypotheses; ++h)
+    for (int k=0; k<sample_size; ++k)
+    {
+      int i;
+      do i = ei_random<int>(0,n-1); while ((samples.col(h).head(k).array()==i).any());
+      samples(k,h) = i;
+    }
+
+  Matrix<int, Dynamic, 1> scores(num_hypotheses);
+
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for if(omp_get_num_threads()==1)
+  #endif
+  for (int h=0; h<num_hypotheses; ++h)
+  {
+    PointsType src_sample(m,sample_size), dst_sample(m,sample_size);
+    for (int k=0; k<sample_size; ++k)
+    {
+      src_sample.col(k) = src.col(samples(k,h));
+      dst_sample.col(k) = dst.col(samples(k,h));
+    }
+    scores(h) = ei_umeyama_inliers(src, dst, umeyama(src_sample, dst_sample, with_scaling), threshold2,
+                                   static_cast<WeightsType*>(0));
+  }
+
+  int best;
+  scores.maxCoeff(&best);
+
+  PointsType src_sample(m,sample_size), dst_sample(m,sample_size);
+  for (int k=0; k<sample_size; ++k)
+  {
+    src_sample.col(k) = src.col(samples(k,best));
+    dst_sample.col(k) = dst.col(samples(k,best));
+  }
+  TransformationMatrixType best_Rt = umeyama(src_sample, dst_sample, with_scaling);
+
+  // refine the best hypothesis on its inliers, unless they are too few to
+  // determine a transformation
+  WeightsType weights(n);
+  if (ei_umeyama_inliers(src, dst, best_Rt, threshold2, &weights) >= sample_size)
+    best_Rt = umeyama(src, dst, weights, with_scaling);
+
+  if (inliers)
+    ei_umeyama_inliers(src, dst, best_Rt, threshold2, inliers);
+
+  return best_Rt;
 }
 
 #endif // EIGEN_UMEYAMA_H
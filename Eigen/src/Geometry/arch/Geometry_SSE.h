@@ -54,8 +54,8 @@ struct ei_cross3_impl<Architecture::SSE,VectorLhs,VectorRhs,float,true>
   inline static typename ei_plain_matrix_type<VectorLhs>::type
   run(const VectorLhs& lhs, const VectorRhs& rhs)
   {
-    __m128 a = lhs.coeffs().packet<VectorLhs::Flags&AlignedBit ? Aligned : Unaligned>(0);
-    __m128 b = rhs.coeffs().packet<VectorRhs::Flags&AlignedBit ? Aligned : Unaligned>(0);
+    __m128 a = lhs.template packet<VectorLhs::Flags&AlignedBit ? Aligned : Unaligned>(0);
+    __m128 b = rhs.template packet<VectorRhs::Flags&AlignedBit ? Aligned : Unaligned>(0);
     __m128 mul1=_mm_mul_ps(ei_vec4f_swizzle1(a,1,2,0,3),ei_vec4f_swizzle1(b,2,0,1,3));
     __m128 mul2=_mm_mul_ps(ei_vec4f_swizzle1(a,2,0,1,3),ei_vec4f_swizzle1(b,1,2,0,3));
     typename ei_plain_matrix_type<VectorLhs>::type res;
@@ -64,4 +64,65 @@ struct ei_cross3_impl<Architecture::SSE,VectorLhs,VectorRhs,float,true>
   }
 };
 
+template<class Derived, class OtherDerived>
+struct ei_quat_product<Architecture::SSE, Derived, OtherDerived, double, Aligned>
+{
+  inline static Quaternion<double> run(const QuaternionBase<Derived>& _a, const QuaternionBase<OtherDerived>& _b)
+  {
+    const Packet2d mask = _mm_castsi128_pd(_mm_set_epi32(0x0,0x0,0x80000000,0x0));
+    Quaternion<double> res;
+
+    Packet2d a_xy = _a.coeffs().template packet<Aligned>(0);
+    Packet2d a_zw = _a.coeffs().template packet<Aligned>(2);
+    Packet2d b_xy = _b.coeffs().template packet<Aligned>(0);
+    Packet2d b_zw = _b.coeffs().template packet<Aligned>(2);
+    Packet2d a_xx = _mm_unpacklo_pd(a_xy, a_xy);
+    Packet2d a_yy = _mm_unpackhi_pd(a_xy, a_xy);
+    Packet2d a_zz = _mm_unpacklo_pd(a_zw, a_zw);
+    Packet2d a_ww = _mm_unpackhi_pd(a_zw, a_zw);
+
+    // res.xy = t1 +/- swap(t2) with t1 = ww*xy + yy*zw and t2 = zz*xy - xx*zw
+    Packet2d t1 = ei_padd(ei_pmul(a_ww, b_xy), ei_pmul(a_yy, b_zw));
+    Packet2d t2 = ei_psub(ei_pmul(a_zz, b_xy), ei_pmul(a_xx, b_zw));
+#ifdef EIGEN_VECTORIZE_SSE3
+    ei_pstore(&res.x(), _mm_addsub_pd(t1, ei_preverse(t2)));
+#else
+    ei_pstore(&res.x(), ei_padd(t1, ei_pxor(mask, ei_preverse(t2))));
+#endif
+
+    // res.zw = t1 -/+ swap(t2) with t1 = ww*zw - yy*xy and t2 = zz*zw + xx*xy
+    t1 = ei_psub(ei_pmul(a_ww, b_zw), ei_pmul(a_yy, b_xy));
+    t2 = ei_padd(ei_pmul(a_zz, b_zw), ei_pmul(a_xx, b_xy));
+#ifdef EIGEN_VECTORIZE_SSE3
+    ei_pstore(&res.z(), ei_preverse(_mm_addsub_pd(ei_preverse(t1), t2)));
+#else
+    ei_pstore(&res.z(), ei_psub(t1, ei_pxor(mask, ei_preverse(t2))));
+#endif
+    return res;
+  }
+};
+
+template<typename VectorLhs,typename VectorRhs>
+struct ei_cross3_impl<Architecture::SSE,VectorLhs,VectorRhs,double,true>
+{
+  inline static typename ei_plain_matrix_type<VectorLhs>::type
+  run(const VectorLhs& lhs, const VectorRhs& rhs)
+  {
+    Packet2d a_xy = lhs.template packet<VectorLhs::Flags&AlignedBit ? Aligned : Unaligned>(0);
+    Packet2d a_zw = lhs.template packet<VectorLhs::Flags&AlignedBit ? Aligned : Unaligned>(2);
+    Packet2d b_xy = rhs.template packet<VectorRhs::Flags&AlignedBit ? Aligned : Unaligned>(0);
+    Packet2d b_zw = rhs.template packet<VectorRhs::Flags&AlignedBit ? Aligned : Unaligned>(2);
+    // (a.y*b.z - a.z*b.y, a.z*b.x - a.x*b.z)
+    Packet2d res_xy = ei_psub(ei_pmul(_mm_shuffle_pd(a_xy,a_zw,1), _mm_shuffle_pd(b_zw,b_xy,0)),
+                              ei_pmul(_mm_shuffle_pd(a_zw,a_xy,0), _mm_shuffle_pd(b_xy,b_zw,1)));
+    // (a.x*b.y - a.y*b.x, 0)
+    Packet2d t = ei_pmul(a_xy, ei_preverse(b_xy));
+    Packet2d res_zw = _mm_unpacklo_pd(_mm_sub_sd(t, _mm_unpackhi_pd(t,t)), _mm_setzero_pd());
+    typename ei_plain_matrix_type<VectorLhs>::type res;
+    ei_pstore(&res.x(), res_xy);
+    ei_pstore(&res.z(), res_zw);
+    return res;
+  }
+};
+
 #endif // EIGEN_GEOMETRY_SSE_H
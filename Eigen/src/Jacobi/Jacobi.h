@@ -395,4 +395,201 @@ void /*EIGEN_DONT_INLINE*/ ei_apply_rotation_in_the_plane(VectorX& _x, VectorY&
   }
 }
 
+/** \internal
+  * Applies on the right of the column-major matrix of \a rows rows starting at \a data, with outer stride \a stride,
+  * the chain of \a count rotations whose planes and cosine-sine pairs are stored by pairs in \a planes and
+  * \a rotations, the second column of each rotation being one of the two columns of the next one.
+  *
+  * The entries of the shared column are kept in registers from one rotation to the next, so that each entry of
+  * the matrix is loaded and stored once for the whole chain, and the rows are processed by groups filling a
+  * cache line, so that each column is fetched once. This covers the rotations of a QR step, which move along
+  * the diagonal, as well as the rotations of a rank one update, which all act on the same last column.
+  */
+template<typename MatrixScalar, typename Scalar>
+void ei_apply_rotation_chain_on_the_right(MatrixScalar* data, int stride, int rows, const int* planes, const Scalar* rotations, int count)
+{
+  typedef typename ei_packet_traits<MatrixScalar>::type Packet;
+  enum { PacketSize = ei_packet_traits<MatrixScalar>::size, Step = 4*PacketSize };
+
+  // x <- c x - s y and y <- conj(s) x + conj(c) y, as MatrixBase::applyOnTheRight()
+  const int unrolledEnd = (rows / Step) * Step;
+  for(int r = 0; r < unrolledEnd; r += Step)
+  {
+    // z holds the current entries of the column cur
+    int cur = planes[0];
+    MatrixScalar* colZ = data + cur*stride + r;
+    Packet z0 = ei_ploadu(colZ),              z1 = ei_ploadu(colZ+PacketSize),
+           z2 = ei_ploadu(colZ+2*PacketSize), z3 = ei_ploadu(colZ+3*PacketSize);
+    for(int k = 0; k < count; ++k)
+    {
+      const Scalar c = rotations[2*k], s = rotations[2*k+1];
+      const Packet pc = ei_pset1(MatrixScalar(c)), pms = ei_pset1(MatrixScalar(-s));
+      const Packet pcs = ei_pset1(MatrixScalar(ei_conj(s))), pcc = ei_pset1(MatrixScalar(ei_conj(c)));
+      MatrixScalar* colX = data + planes[2*k]*stride + r;
+      MatrixScalar* colY = data + planes[2*k+1]*stride + r;
+      Packet x0, x1, x2, x3, y0, y1, y2, y3;
+      if(planes[2*k] == cur)
+      {
+        x0 = z0; x1 = z1; x2 = z2; x3 = z3;
+        y0 = ei_ploadu(colY);              y1 = ei_ploadu(colY+PacketSize);
+        y2 = ei_ploadu(colY+2*PacketSize); y3 = ei_ploadu(colY+3*PacketSize);
+      }
+      else
+      {
+        x0 = ei_ploadu(colX);              x1 = ei_ploadu(colX+PacketSize);
+        x2 = ei_ploadu(colX+2*PacketSize); x3 = ei_ploadu(colX+3*PacketSize);
+        y0 = z0; y1 = z1; y2 = z2; y3 = z3;
+      }
+      ei_pstoreu(colX,              ei_padd(ei_pmul(pc,x0), ei_pmul(pms,y0)));
+      ei_pstoreu(colX+PacketSize,   ei_padd(ei_pmul(pc,x1), ei_pmul(pms,y1)));
+      ei_pstoreu(colX+2*PacketSize, ei_padd(ei_pmul(pc,x2), ei_pmul(pms,y2)));
+      ei_pstoreu(colX+3*PacketSize, ei_padd(ei_pmul(pc,x3), ei_pmul(pms,y3)));
+      z0 = ei_padd(ei_pmul(pcs,x0), ei_pmul(pcc,y0));
+      z1 = ei_padd(ei_pmul(pcs,x1), ei_pmul(pcc,y1));
+      z2 = ei_padd(ei_pmul(pcs,x2), ei_pmul(pcc,y2));
+      z3 = ei_padd(ei_pmul(pcs,x3), ei_pmul(pcc,y3));
+      cur = planes[2*k+1];
+      colZ = colY;
+    }
+    ei_pstoreu(colZ, z0);
+    ei_pstoreu(colZ+PacketSize, z1);
+    ei_pstoreu(colZ+2*PacketSize, z2);
+    ei_pstoreu(colZ+3*PacketSize, z3);
+  }
+
+  for(int r = unrolledEnd; r < rows; ++r)
+  {
+    int cur = planes[0];
+    MatrixScalar* colZ = data + cur*stride + r;
+    MatrixScalar z = *colZ;
+    for(int k = 0; k < count; ++k)
+    {
+      const Scalar c = rotations[2*k], s = rotations[2*k+1];
+      MatrixScalar* colX = data + planes[2*k]*stride + r;
+      MatrixScalar* colY = data + planes[2*k+1]*stride + r;
+      const MatrixScalar x = planes[2*k] == cur ? z : *colX;
+      const MatrixScalar y = planes[2*k] == cur ? *colY : z;
+      *colX = MatrixScalar(c) * x - MatrixScalar(s) * y;
+      z = MatrixScalar(ei_conj(s)) * x + MatrixScalar(ei_conj(c)) * y;
+      cur = planes[2*k+1];
+      colZ = colY;
+    }
+    *colZ = z;
+  }
+}
+
+template<typename Derived, typename Scalar,
+         bool UseChainKernel = (ei_traits<Derived>::Flags&DirectAccessBit) && !(ei_traits<Derived>::Flags&RowMajorBit)>
+struct ei_apply_rotation_chain_selector
+{
+  static void run(MatrixBase<Derived>& m, int startRow, int rows, const int* planes, const Scalar* rotations, int count)
+  {
+    typedef typename Derived::ColXpr ColXpr;
+    for(int k = 0; k < count; ++k)
+    {
+      ColXpr colP(m.derived().col(planes[2*k]));
+      ColXpr colQ(m.derived().col(planes[2*k+1]));
+      VectorBlock<ColXpr> x(colP, startRow, rows);
+      VectorBlock<ColXpr> y(colQ, startRow, rows);
+      ei_apply_rotation_in_the_plane(x, y, PlanarRotation<Scalar>(rotations[2*k], rotations[2*k+1]).transpose());
+    }
+  }
+};
+
+template<typename Derived, typename Scalar>
+struct ei_apply_rotation_chain_selector<Derived, Scalar, true>
+{
+  static void run(MatrixBase<Derived>& m, int startRow, int rows, const int* planes, const Scalar* rotations, int count)
+  {
+    ei_apply_rotation_chain_on_the_right(&m.derived().coeffRef(startRow,0), m.derived().stride(), rows, planes, rotations, count);
+  }
+};
+
+/** \internal
+  * \jacobi_module
+  * \class ei_planar_rotation_sequence
+  * \brief Stores a sequence of planar rotations to apply them at once on the right of a matrix
+  *
+  * Algorithms like the tridiagonal QR iteration or the Jacobi SVD accumulate long sequences of
+  * rotations in a basis matrix B, i.e., compute \f$ B J_0 J_1 \cdots J_{k-1} \f$ where \f$ J_i \f$
+  * acts on the columns \f$ p_i \f$ and \f$ q_i \f$. Applying each rotation as soon as it is known
+  * costs a full pass over two columns of B. Since B is not needed until the end, this class lets
+  * such algorithms record the rotations, up to a given capacity, and apply them in a cache-friendly
+  * way: B is split in blocks of rows small enough to stay in cache, and all the rotations are applied
+  * to a block before moving to the next one. Chains of rotations in which each rotation shares a
+  * column with the next one, like the rotations of a QR step on a tridiagonal matrix, are applied in
+  * a single vectorized pass over their columns by ei_apply_rotation_chain_on_the_right() when B is
+  * column-major with direct access. The same holds for rotations which all act on the same column,
+  * like the ones of a rank one update.
+  *
+  * \sa MatrixBase::applyOnTheRight(int, int, const PlanarRotation&)
+  */
+template<typename Scalar> class ei_planar_rotation_sequence
+{
+  public:
+
+    /** Constructs an empty sequence able to store \a capacity rotations */
+    ei_planar_rotation_sequence(int capacity)
+      : m_size(0)
+    {
+      // resize() rather than the constructors, which reject empty matrices
+      m_planes.resize(2, capacity);
+      m_rotations.resize(2, capacity);
+    }
+
+    int size() const { return m_size; }
+    int capacity() const { return m_planes.cols(); }
+    /** \returns whether \a count more rotations can be stored */
+    bool hasRoomFor(int count) const { return m_size + count <= capacity(); }
+    void clear() { m_size = 0; }
+
+    /** Appends the rotation \a j acting on the columns \a p and \a q, as MatrixBase::applyOnTheRight(p,q,j) would */
+    void push_back(int p, int q, const PlanarRotation<Scalar>& j)
+    {
+      ei_assert(m_size < capacity());
+      m_planes.coeffRef(0,m_size) = p;
+      m_planes.coeffRef(1,m_size) = q;
+      m_rotations.coeffRef(0,m_size) = j.c();
+      m_rotations.coeffRef(1,m_size) = j.s();
+      ++m_size;
+    }
+
+    /** Computes \a m = \a m J_0 ... J_{k-1} and clears the sequence */
+    template<typename Derived>
+    void applyOnTheRightAndClear(MatrixBase<Derived>& m);
+
+  protected:
+    Matrix<int,2,Dynamic> m_planes;
+    Matrix<Scalar,2,Dynamic> m_rotations;
+    int m_size;
+};
+
+template<typename Scalar>
+template<typename Derived>
+void ei_planar_rotation_sequence<Scalar>::applyOnTheRightAndClear(MatrixBase<Derived>& m)
+{
+  // the block of rows should fit in the cache, but not be too short for the vectorized kernel
+  enum { PacketSize = ei_packet_traits<typename Derived::Scalar>::size,
+         MinBlockRows = 128 };
+
+  const int rows = m.rows(), cols = m.cols();
+  int blockRows = EIGEN_TUNE_FOR_CPU_CACHE_SIZE / (int(sizeof(typename Derived::Scalar)) * std::max(cols,1));
+  blockRows = std::max(int(MinBlockRows), blockRows - blockRows % PacketSize);
+
+  for(int r0 = 0; r0 < rows; r0 += blockRows)
+  {
+    const int actualRows = std::min(blockRows, rows - r0);
+    // split the sequence in chains of rotations in which the second column of each rotation is used by the next one
+    for(int i = 0; i < m_size; )
+    {
+      int end = i+1;
+      while(end < m_size && (m_planes.coeff(0,end) == m_planes.coeff(1,end-1) || m_planes.coeff(1,end) == m_planes.coeff(1,end-1)))
+        ++end;
+      ei_apply_rotation_chain_selector<Derived,Scalar>::run(m, r0, actualRows, &m_planes.coeffRef(0,i), &m_rotations.coeffRef(0,i), end-i);
+      i = end;
+    }
+  }
+  m_size = 0;
+}
+
 #endif // EIGEN_JACOBI_H
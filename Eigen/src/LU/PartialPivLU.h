@@ -182,6 +182,7 @@ template<typename _MatrixType> class PartialPivLU
     inline int cols() const { return m_lu.cols(); }
 
   protected:
+    template<typename T> friend struct ei_binary_serializer;
     MatrixType m_lu;
     PermutationType m_p;
     PermutationVectorType m_rowsTranspositions;
@@ -363,16 +364,13 @@ struct ei_partial_lu_impl
 
       // update permutations and apply them to A10
       for(int i=k; i<k+bs; ++i)
-      {
-        int piv = (row_transpositions[i] += k);
-        A_0.row(i).swap(A_0.row(piv));
-      }
+        row_transpositions[i] += k;
+      ei_apply_row_transpositions(A_0, row_transpositions, k, k+bs);
 
       if(trows)
       {
         // apply permutations to A_2
-        for(int i=k;i<k+bs; ++i)
-          A_2.row(i).swap(A_2.row(row_transpositions[i]));
+        ei_apply_row_transpositions(A_2, row_transpositions, k, k+bs);
 
         // A12 = A11^-1 A12
         A11.template triangularView<UnitLower>().solveInPlace(A12);
@@ -384,6 +382,79 @@ struct ei_partial_lu_impl
   }
 };
 
+/** \internal
+  * Fully unrolled version of ei_partial_lu_impl::unblocked_lu() for small fixed size matrices: the
+  * step \a Index eliminates the column \a Index with fixed size blocks.
+  */
+template<typename MatrixType, int Index, int Size = MatrixType::RowsAtCompileTime, bool Stop = Index==Size>
+struct ei_partial_lu_unroller
+{
+  typedef typename MatrixType::RealScalar RealScalar;
+  enum { RemainingSize = Size-Index-1 };
+
+  template<typename IntVector>
+  static EIGEN_STRONG_INLINE void run(MatrixType& lu, IntVector& row_transpositions, int& nb_transpositions)
+  {
+    int row_of_biggest_in_col;
+    RealScalar biggest_in_corner
+      = lu.col(Index).template tail<Size-Index>().cwiseAbs().maxCoeff(&row_of_biggest_in_col);
+    row_of_biggest_in_col += Index;
+
+    if(biggest_in_corner == 0) // the pivot is exactly zero: the matrix is singular
+    {
+      for(int i = Index; i < Size; i++)
+        row_transpositions.coeffRef(i) = i;
+      return;
+    }
+
+    row_transpositions.coeffRef(Index) = row_of_biggest_in_col;
+    if(Index != row_of_biggest_in_col)
+    {
+      lu.row(Index).swap(lu.row(row_of_biggest_in_col));
+      ++nb_transpositions;
+    }
+
+    if(RemainingSize > 0)
+    {
+      Block<MatrixType,RemainingSize,1> l(lu,Index+1,Index,RemainingSize,1);
+      l /= lu.coeff(Index,Index);
+      Block<MatrixType,RemainingSize,RemainingSize>(lu,Index+1,Index+1,RemainingSize,RemainingSize).noalias()
+        -= l * Block<MatrixType,1,RemainingSize>(lu,Index,Index+1,1,RemainingSize);
+    }
+    ei_partial_lu_unroller<MatrixType,Index+1,Size>::run(lu, row_transpositions, nb_transpositions);
+  }
+};
+
+template<typename MatrixType, int Index, int Size>
+struct ei_partial_lu_unroller<MatrixType,Index,Size,true>
+{
+  template<typename IntVector>
+  static EIGEN_STRONG_INLINE void run(MatrixType&, IntVector&, int&) {}
+};
+
+template<typename MatrixType, int Unrolling = ei_decomposition_unrolling<MatrixType>::ret>
+struct ei_partial_lu_selector
+{
+  template<typename IntVector>
+  static void run(MatrixType& lu, IntVector& row_transpositions, int& nb_transpositions)
+  {
+    ei_partial_lu_impl
+      <typename MatrixType::Scalar, MatrixType::Flags&RowMajorBit?RowMajor:ColMajor>
+      ::blocked_lu(lu.rows(), lu.cols(), &lu.coeffRef(0,0), lu.outerStride(), &row_transpositions.coeffRef(0), nb_transpositions);
+  }
+};
+
+template<typename MatrixType>
+struct ei_partial_lu_selector<MatrixType,CompleteUnrolling>
+{
+  template<typename IntVector>
+  static void run(MatrixType& lu, IntVector& row_transpositions, int& nb_transpositions)
+  {
+    nb_transpositions = 0;
+    ei_partial_lu_unroller<MatrixType,0>::run(lu, row_transpositions, nb_transpositions);
+  }
+};
+
 /** \internal performs the LU decomposition with partial pivoting in-place.
   */
 template<typename MatrixType, typename IntVector>
@@ -392,9 +463,7 @@ void ei_partial_lu_inplace(MatrixType& lu, IntVector& row_transpositions, int& n
   ei_assert(lu.cols() == row_transpositions.size());
   ei_assert((&row_transpositions.coeffRef(1)-&row_transpositions.coeffRef(0)) == 1);
 
-  ei_partial_lu_impl
-    <typename MatrixType::Scalar, MatrixType::Flags&RowMajorBit?RowMajor:ColMajor>
-    ::blocked_lu(lu.rows(), lu.cols(), &lu.coeffRef(0,0), lu.outerStride(), &row_transpositions.coeffRef(0), nb_transpositions);
+  ei_partial_lu_selector<MatrixType>::run(lu, row_transpositions, nb_transpositions);
 }
 
 template<typename MatrixType>
@@ -194,6 +194,85 @@ typename MatrixType::RealScalar HouseholderQR<MatrixType>::logAbsDeterminant() c
   return m_qr.diagonal().cwiseAbs().array().log().sum();
 }
 
+/** \internal performs the Householder QR decomposition in-place, \a temp being a workspace of cols() coefficients */
+template<typename MatrixType, int Unrolling = ei_decomposition_unrolling<MatrixType>::ret>
+struct ei_householder_qr_inplace
+{
+  typedef typename MatrixType::RealScalar RealScalar;
+
+  template<typename HCoeffs, typename RowVector>
+  static void run(MatrixType& mat, HCoeffs& hCoeffs, RowVector& temp)
+  {
+    int rows = mat.rows();
+    int cols = mat.cols();
+    int size = std::min(rows,cols);
+
+    for(int k = 0; k < size; ++k)
+    {
+      int remainingRows = rows - k;
+      int remainingCols = cols - k - 1;
+
+      RealScalar beta;
+      mat.col(k).tail(remainingRows).makeHouseholderInPlace(hCoeffs.coeffRef(k), beta);
+      mat.coeffRef(k,k) = beta;
+
+      // apply H to remaining part of mat from the left
+      mat.bottomRightCorner(remainingRows, remainingCols)
+          .applyHouseholderOnTheLeft(mat.col(k).tail(remainingRows-1), hCoeffs.coeffRef(k), &temp.coeffRef(k+1));
+    }
+  }
+};
+
+/** \internal
+  * Fully unrolled version of ei_householder_qr_inplace for small fixed size matrices: the step
+  * \a Index computes the reflector of the column \a Index and applies it with fixed size blocks.
+  */
+template<typename MatrixType, int Index,
+         int Size = EIGEN_ENUM_MIN(MatrixType::RowsAtCompileTime,MatrixType::ColsAtCompileTime),
+         bool Stop = Index==Size>
+struct ei_householder_qr_unroller
+{
+  typedef typename MatrixType::RealScalar RealScalar;
+  enum {
+    RemainingRows = MatrixType::RowsAtCompileTime - Index,
+    RemainingCols = MatrixType::ColsAtCompileTime - Index - 1
+  };
+
+  template<typename HCoeffs, typename RowVector>
+  static EIGEN_STRONG_INLINE void run(MatrixType& mat, HCoeffs& hCoeffs, RowVector& temp)
+  {
+    RealScalar beta;
+    Block<MatrixType,RemainingRows,1> col(mat,Index,Index,RemainingRows,1);
+    col.makeHouseholderInPlace(hCoeffs.coeffRef(Index), beta);
+    mat.coeffRef(Index,Index) = beta;
+
+    if(RemainingCols > 0)
+    {
+      Block<MatrixType,RemainingRows,RemainingCols>(mat,Index,Index+1,RemainingRows,RemainingCols)
+        .applyHouseholderOnTheLeft(Block<MatrixType,RemainingRows-1,1>(mat,Index+1,Index,RemainingRows-1,1),
+                                   hCoeffs.coeff(Index), temp.data()+Index+1);
+    }
+    ei_householder_qr_unroller<MatrixType,Index+1,Size>::run(mat, hCoeffs, temp);
+  }
+};
+
+template<typename MatrixType, int Index, int Size>
+struct ei_householder_qr_unroller<MatrixType,Index,Size,true>
+{
+  template<typename HCoeffs, typename RowVector>
+  static EIGEN_STRONG_INLINE void run(MatrixType&, HCoeffs&, RowVector&) {}
+};
+
+template<typename MatrixType>
+struct ei_householder_qr_inplace<MatrixType,CompleteUnrolling>
+{
+  template<typename HCoeffs, typename RowVector>
+  static void run(MatrixType& mat, HCoeffs& hCoeffs, RowVector& temp)
+  {
+    ei_householder_qr_unroller<MatrixType,0>::run(mat, hCoeffs, temp);
+  }
+};
+
 template<typename MatrixType>
 HouseholderQR<MatrixType>& HouseholderQR<MatrixType>::compute(const MatrixType& matrix)
 {
@@ -206,19 +285,8 @@ HouseholderQR<MatrixType>& HouseholderQR<MatrixType>::compute(const MatrixType&
 
   m_temp.resize(cols);
 
-  for(int k = 0; k < size; ++k)
-  {
-    int remainingRows = rows - k;
-    int remainingCols = cols - k - 1;
-
-    RealScalar beta;
-    m_qr.col(k).tail(remainingRows).makeHouseholderInPlace(m_hCoeffs.coeffRef(k), beta);
-    m_qr.coeffRef(k,k) = beta;
+  ei_householder_qr_inplace<MatrixType>::run(m_qr, m_hCoeffs, m_temp);
 
-    // apply H to remaining part of m_qr from the left
-    m_qr.bottomRightCorner(remainingRows, remainingCols)
-        .applyHouseholderOnTheLeft(m_qr.col(k).tail(remainingRows-1), m_hCoeffs.coeffRef(k), &m_temp.coeffRef(k+1));
-  }
   m_isInitialized = true;
   return *this;
 }
@@ -0,0 +1,292 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_UPDATABLEQR_H
+#define EIGEN_UPDATABLEQR_H
+
+/** \ingroup QR_Module
+  * \nonstableyet
+  *
+  * \class UpdatableQR
+  *
+  * \brief QR decomposition of a matrix supporting the addition and removal of rows and columns
+  *
+  * \param MatrixType the type of the matrix of which we are computing the QR decomposition,
+  * which must have dynamic sizes
+  *
+  * This class computes the decomposition A = QR of a m x n matrix A, where Q is a m x m unitary
+  * matrix and R is a m x n upper trapezoidal matrix, both stored explicitly. The decomposition
+  * is first computed by HouseholderQR, and is then updated by Givens rotations (see class
+  * PlanarRotation) when a row or a column is appended to or removed from A, at the cost of
+  * \f$ O(m^2) \f$ operations instead of the \f$ O(mn^2) \f$ of a new decomposition.
+  *
+  * See: Gene H. Golub, Charles F. Van Loan, Matrix Computations, 3rd edition, Section 12.5.
+  *
+  * As HouseholderQR, this is \b not a rank-revealing decomposition.
+  *
+  * \sa class HouseholderQR, LLT::rankUpdate()
+  */
+template<typename _MatrixType> class UpdatableQR
+{
+  public:
+
+    typedef _MatrixType MatrixType;
+    enum {
+      RowsAtCompileTime = MatrixType::RowsAtCompileTime,
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      Options = MatrixType::Options,
+      MaxRowsAtCompileTime = MatrixType::MaxRowsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime
+    };
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef Matrix<Scalar, RowsAtCompileTime, RowsAtCompileTime, ei_traits<MatrixType>::Flags&RowMajorBit ? RowMajor : ColMajor, MaxRowsAtCompileTime, MaxRowsAtCompileTime> MatrixQType;
+
+    /**
+    * \brief Default Constructor.
+    *
+    * The default constructor is useful in cases in which the user intends to
+    * perform decompositions via UpdatableQR::compute(const MatrixType&).
+    */
+    UpdatableQR() : m_q(), m_r(), m_isInitialized(false) {}
+
+    UpdatableQR(const MatrixType& matrix)
+      : m_q(matrix.rows(), matrix.rows()),
+        m_r(matrix.rows(), matrix.cols()),
+        m_isInitialized(false)
+    {
+      compute(matrix);
+    }
+
+    /** This method returns the solution x of the least squares problem \f$ \min_x |Ax-b| \f$, where A
+      * is the matrix of which *this is the QR decomposition.
+      *
+      * \param b the right-hand-side of the equation to solve.
+      *
+      * \note A must have at least as many rows as columns, and full column rank.
+      */
+    template<typename Rhs>
+    inline const ei_solve_retval<UpdatableQR, Rhs>
+    solve(const MatrixBase<Rhs>& b) const
+    {
+      ei_assert(m_isInitialized && "UpdatableQR is not initialized.");
+      ei_assert(m_r.rows() >= m_r.cols() && "UpdatableQR::solve(): the matrix has more columns than rows");
+      return ei_solve_retval<UpdatableQR, Rhs>(*this, b.derived());
+    }
+
+    /** \returns the unitary matrix Q */
+    const MatrixQType& matrixQ() const
+    {
+      ei_assert(m_isInitialized && "UpdatableQR is not initialized.");
+      return m_q;
+    }
+
+    /** \returns the upper trapezoidal matrix R */
+    const MatrixType& matrixR() const
+    {
+      ei_assert(m_isInitialized && "UpdatableQR is not initialized.");
+      return m_r;
+    }
+
+    UpdatableQR& compute(const MatrixType& matrix);
+
+    template<typename Derived>
+    UpdatableQR& appendRow(const MatrixBase<Derived>& row);
+    UpdatableQR& removeRow(int i);
+    template<typename Derived>
+    UpdatableQR& appendColumn(const MatrixBase<Derived>& col);
+    UpdatableQR& removeColumn(int j);
+
+    MatrixType reconstructedMatrix() const;
+
+    inline int rows() const { return m_r.rows(); }
+    inline int cols() const { return m_r.cols(); }
+
+  protected:
+    MatrixQType m_q;
+    MatrixType m_r;
+    bool m_isInitialized;
+};
+
+#ifndef EIGEN_HIDE_HEAVY_CODE
+
+template<typename MatrixType>
+UpdatableQR<MatrixType>& UpdatableQR<MatrixType>::compute(const MatrixType& matrix)
+{
+  const HouseholderQR<MatrixType> qr(matrix);
+  m_q = qr.householderQ();
+  m_r = qr.matrixQR().template triangularView<Upper>();
+  m_isInitialized = true;
+  return *this;
+}
+
+/** Updates the decomposition of A to the one of the matrix obtained by appending
+  * the row vector \a row at the bottom of A.
+  */
+template<typename MatrixType>
+template<typename Derived>
+UpdatableQR<MatrixType>& UpdatableQR<MatrixType>::appendRow(const MatrixBase<Derived>& row)
+{
+  ei_assert(m_isInitialized && "UpdatableQR is not initialized.");
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  const int m = m_r.rows(), n = m_r.cols();
+  ei_assert(row.size() == n);
+
+  m_r.conservativeResize(m+1, n);
+  m_r.row(m) = row;
+  m_q.conservativeResize(m+1, m+1);
+  m_q.row(m).setZero();
+  m_q.col(m).setZero();
+  m_q.coeffRef(m,m) = Scalar(1);
+
+  // eliminate the new row against the diagonal of R
+  PlanarRotation<Scalar> G;
+  for(int j = 0; j < std::min(m,n); ++j)
+  {
+    G.makeGivens(m_r.coeff(j,j), m_r.coeff(m,j), &m_r.coeffRef(j,j));
+    m_r.coeffRef(m,j) = Scalar(0);
+    m_r.rightCols(n-j-1).applyOnTheLeft(j, m, G.adjoint());
+    m_q.applyOnTheRight(j, m, G);
+  }
+  return *this;
+}
+
+/** Updates the decomposition of A to the one of the matrix obtained by removing
+  * the row \a i of A.
+  */
+template<typename MatrixType>
+UpdatableQR<MatrixType>& UpdatableQR<MatrixType>::removeRow(int i)
+{
+  ei_assert(m_isInitialized && "UpdatableQR is not initialized.");
+  const int m = m_r.rows(), n = m_r.cols();
+  ei_assert(i >= 0 && i < m);
+
+  // rotate the row i of Q to a multiple of the first unit vector, so that the row i of A
+  // only depends on the first row of R, which becomes upper Hessenberg
+  PlanarRotation<Scalar> G;
+  for(int k = m-2; k >= 0; --k)
+  {
+    G.makeGivens(ei_conj(m_q.coeff(i,k)), ei_conj(m_q.coeff(i,k+1)));
+    m_q.applyOnTheRight(k, k+1, G);
+    m_q.coeffRef(i,k+1) = Scalar(0);
+    if(k < n)
+      m_r.rightCols(n-k).applyOnTheLeft(k, k+1, G.adjoint());
+  }
+
+  // drop the row i and the first column of Q, and the first row of R
+  MatrixQType q(m-1, m-1);
+  q.topRows(i) = m_q.block(0, 1, i, m-1);
+  q.bottomRows(m-1-i) = m_q.block(i+1, 1, m-1-i, m-1);
+  m_q.swap(q);
+  MatrixType r = m_r.bottomRows(m-1);
+  m_r.swap(r);
+  return *this;
+}
+
+/** Updates the decomposition of A to the one of the matrix obtained by appending
+  * the column vector \a col at the right of A.
+  */
+template<typename MatrixType>
+template<typename Derived>
+UpdatableQR<MatrixType>& UpdatableQR<MatrixType>::appendColumn(const MatrixBase<Derived>& col)
+{
+  ei_assert(m_isInitialized && "UpdatableQR is not initialized.");
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  const int m = m_r.rows(), n = m_r.cols();
+  ei_assert(col.size() == m);
+
+  m_r.conservativeResize(m, n+1);
+  m_r.col(n).noalias() = m_q.adjoint() * col;
+
+  // eliminate the new column below the diagonal, from the bottom
+  PlanarRotation<Scalar> G;
+  for(int k = m-2; k >= n; --k)
+  {
+    G.makeGivens(m_r.coeff(k,n), m_r.coeff(k+1,n), &m_r.coeffRef(k,n));
+    m_r.coeffRef(k+1,n) = Scalar(0);
+    m_q.applyOnTheRight(k, k+1, G);
+  }
+  return *this;
+}
+
+/** Updates the decomposition of A to the one of the matrix obtained by removing
+  * the column \a j of A.
+  */
+template<typename MatrixType>
+UpdatableQR<MatrixType>& UpdatableQR<MatrixType>::removeColumn(int j)
+{
+  ei_assert(m_isInitialized && "UpdatableQR is not initialized.");
+  const int m = m_r.rows(), n = m_r.cols();
+  ei_assert(j >= 0 && j < n);
+
+  for(int c = j; c < n-1; ++c)
+    m_r.col(c) = m_r.col(c+1);
+  m_r.conservativeResize(m, n-1);
+
+  // the columns j to n-2 of R are now upper Hessenberg
+  PlanarRotation<Scalar> G;
+  for(int k = j; k < std::min(n-1, m-1); ++k)
+  {
+    G.makeGivens(m_r.coeff(k,k), m_r.coeff(k+1,k), &m_r.coeffRef(k,k));
+    m_r.coeffRef(k+1,k) = Scalar(0);
+    m_r.rightCols(n-k-2).applyOnTheLeft(k, k+1, G.adjoint());
+    m_q.applyOnTheRight(k, k+1, G);
+  }
+  return *this;
+}
+
+/** \returns the matrix represented by the decomposition,
+  * i.e., it returns the product: Q R.
+  * This function is provided for debug purpose. */
+template<typename MatrixType>
+MatrixType UpdatableQR<MatrixType>::reconstructedMatrix() const
+{
+  ei_assert(m_isInitialized && "UpdatableQR is not initialized.");
+  return m_q * m_r;
+}
+
+template<typename _MatrixType, typename Rhs>
+struct ei_solve_retval<UpdatableQR<_MatrixType>, Rhs>
+  : ei_solve_retval_base<UpdatableQR<_MatrixType>, Rhs>
+{
+  EIGEN_MAKE_SOLVE_HELPERS(UpdatableQR<_MatrixType>,Rhs)
+
+  template<typename Dest> void evalTo(Dest& dst) const
+  {
+    const int cols = dec().cols();
+    ei_assert(rhs().rows() == dec().rows());
+
+    typename Rhs::PlainObject c(rhs().rows(), rhs().cols());
+    c.noalias() = dec().matrixQ().adjoint() * rhs();
+
+    dec().matrixR()
+       .topLeftCorner(cols, cols)
+       .template triangularView<Upper>()
+       .solveInPlace(c.topRows(cols));
+
+    dst = c.topRows(cols);
+  }
+};
+
+#endif // EIGEN_HIDE_HEAVY_CODE
+
+#endif // EIGEN_UPDATABLEQR_H
@@ -52,7 +52,7 @@ class SparseLLT
 
     /** Creates a dummy LLT factorization object with flags \a flags. */
     SparseLLT(int flags = 0)
-      : m_flags(flags), m_status(0)
+      : m_flags(flags), m_status(0), m_succeeded(false)
     {
       m_precision = RealScalar(0.1) * Eigen::NumTraits<RealScalar>::dummy_precision();
     }
@@ -60,7 +60,7 @@ class SparseLLT
     /** Creates a LLT object and compute the respective factorization of \a matrix using
       * flags \a flags. */
     SparseLLT(const MatrixType& matrix, int flags = 0)
-      : m_matrix(matrix.rows(), matrix.cols()), m_flags(flags), m_status(0)
+      : m_matrix(matrix.rows(), matrix.cols()), m_flags(flags), m_status(0), m_succeeded(false)
     {
       m_precision = RealScalar(0.1) * Eigen::NumTraits<RealScalar>::dummy_precision();
       compute(matrix);
@@ -113,6 +113,7 @@ class SparseLLT
     inline bool succeeded(void) const { return m_succeeded; }
 
   protected:
+    template<typename T> friend struct ei_binary_serializer;
     CholMatrixType m_matrix;
     RealScalar m_precision;
     int m_flags;
@@ -171,6 +172,13 @@ void SparseLLT<MatrixType,Backend>::compute(const MatrixType& a)
         }
       }
     }
+    // the matrix is not positive definite
+    if (ei_real(x) <= RealScalar(0))
+    {
+      m_matrix.finalize();
+      m_succeeded = false;
+      return;
+    }
     // copy the temporary vector to the respective m_matrix.col()
     // while scaling the result by 1/real(x)
     RealScalar rx = ei_sqrt(ei_real(x));
@@ -183,6 +191,7 @@ void SparseLLT<MatrixType,Backend>::compute(const MatrixType& a)
     }
   }
   m_matrix.finalize();
+  m_succeeded = true;
 }
 
 /** Computes b = L^-T L^-1 b */
@@ -0,0 +1,149 @@
+
+// g++ -O3 -DNDEBUG -I.. bench_autodiff.cpp -o bench_autodiff && ./bench_autodiff
+// Compares the cost of computing the jacobian of a small least-squares residual
+// using hand-written derivatives, AutoDiffJacobian with fixed and dynamic size
+// derivatives, and NumericalDiff.
+
+#include <iostream>
+#include <Eigen/Core>
+#include <unsupported/Eigen/AutoDiff>
+#include <unsupported/Eigen/NumericalDiff>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+#ifndef NPARAMS
+#define NPARAMS 6
+#endif
+
+#ifndef NRESIDUALS
+#define NRESIDUALS 32
+#endif
+
+// residuals of the model sum_k p(2k) exp(-p(2k+1) t), fitted on NRESIDUALS samples
+template<int NX>
+struct ExpSum
+{
+  typedef double Scalar;
+  enum {
+    InputsAtCompileTime = NX,
+    ValuesAtCompileTime = NRESIDUALS
+  };
+  typedef Matrix<Scalar,InputsAtCompileTime,1> InputType;
+  typedef Matrix<Scalar,ValuesAtCompileTime,1> ValueType;
+  typedef Matrix<Scalar,ValuesAtCompileTime,InputsAtCompileTime> JacobianType;
+
+  ExpSum() { y.setRandom(); }
+
+  int inputs() const { return NPARAMS; }
+  int values() const { return NRESIDUALS; }
+
+  template<typename T>
+  void operator() (const Matrix<T,InputsAtCompileTime,1>& p, Matrix<T,ValuesAtCompileTime,1>* r) const
+  {
+    for(int i=0; i<NRESIDUALS; ++i)
+    {
+      double t = double(i)/NRESIDUALS;
+      T v = p[0] * std::exp(-t * p[1]);
+      for(int k=2; k<NPARAMS; k+=2)
+        v += p[k] * std::exp(-t * p[k+1]);
+      (*r)[i] = v - y[i];
+    }
+  }
+
+  // interface of NumericalDiff
+  int operator() (const InputType& p, ValueType& r) const
+  {
+    (*this)(p, &r);
+    return 0;
+  }
+
+  void jacobian(const InputType& p, JacobianType& jac) const
+  {
+    for(int i=0; i<NRESIDUALS; ++i)
+    {
+      double t = double(i)/NRESIDUALS;
+      for(int k=0; k<NPARAMS; k+=2)
+      {
+        double e = std::exp(-t * p[k+1]);
+        jac(i,k) = e;
+        jac(i,k+1) = -t * p[k] * e;
+      }
+    }
+  }
+
+  ValueType y;
+};
+
+template<typename Func> EIGEN_DONT_INLINE
+void autodiff_jacobian(const AutoDiffJacobian<Func>& f, const typename Func::InputType& p,
+                       typename Func::ValueType& r, typename Func::JacobianType& jac)
+{
+  f(p, &r, &jac);
+}
+
+template<typename Func> EIGEN_DONT_INLINE
+void hand_jacobian(const Func& f, const typename Func::InputType& p,
+                   typename Func::ValueType& r, typename Func::JacobianType& jac)
+{
+  f(p, r);
+  f.jacobian(p, jac);
+}
+
+template<typename Func> EIGEN_DONT_INLINE
+void numerical_jacobian(const Func& f, const typename Func::InputType& p,
+                        typename Func::ValueType& r, typename Func::JacobianType& jac)
+{
+  f(p, r);
+  f.df(p, jac);
+}
+
+int main()
+{
+  typedef ExpSum<NPARAMS> Fixed;
+  typedef ExpSum<Dynamic> Dyn;
+  const int tries = 5;
+  const int rep = 10000;
+
+  Fixed f;
+  Dyn fd;
+  fd.y = f.y;
+  Fixed::InputType p = Fixed::InputType::Random();
+  Dyn::InputType pd = p;
+  Fixed::ValueType r;
+  Fixed::JacobianType jac, jacref;
+  Dyn::JacobianType jacd(NRESIDUALS,NPARAMS);
+
+  AutoDiffJacobian<Fixed> adf(f);
+  AutoDiffJacobian<Dyn> add(fd);
+  NumericalDiff<Fixed> ndf(f);
+  NumericalDiff<Fixed,Central> ndc(f);
+
+  BenchTimer t;
+  std::cout << NPARAMS << " parameters, " << NRESIDUALS << " residuals\n";
+
+  BENCH(t, tries, rep, f(p, r));
+  double base = t.best();
+  std::cout << "function only        : " << 1e6*t.best()/rep << " us\n";
+
+  BENCH(t, tries, rep, hand_jacobian(f, p, r, jacref));
+  std::cout << "hand-written         : " << 1e6*t.best()/rep << " us  (x" << t.best()/base << ")\n";
+
+  BENCH(t, tries, rep, autodiff_jacobian(adf, p, r, jac));
+  std::cout << "AutoDiff fixed size  : " << 1e6*t.best()/rep << " us  (x" << t.best()/base << ")"
+            << "  error " << (jac-jacref).norm() << "\n";
+
+  BENCH(t, tries, rep, autodiff_jacobian(add, pd, r, jacd));
+  std::cout << "AutoDiff dynamic size: " << 1e6*t.best()/rep << " us  (x" << t.best()/base << ")"
+            << "  error " << (jacd-jacref).norm() << "\n";
+
+  BENCH(t, tries, rep, numerical_jacobian(ndf, p, r, jac));
+  std::cout << "NumericalDiff forward: " << 1e6*t.best()/rep << " us  (x" << t.best()/base << ")"
+            << "  error " << (jac-jacref).norm() << "\n";
+
+  BENCH(t, tries, rep, numerical_jacobian(ndc, p, r, jac));
+  std::cout << "NumericalDiff central: " << 1e6*t.best()/rep << " us  (x" << t.best()/base << ")"
+            << "  error " << (jac-jacref).norm() << "\n";
+
+  return 0;
+}
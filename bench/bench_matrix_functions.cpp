@@ -0,0 +1,56 @@
+
+// g++ -O3 -DNDEBUG -I.. bench_matrix_functions.cpp -o bench_matrix_functions && ./bench_matrix_functions 500 1000 2000
+// Times the dense matrix functions of the MatrixFunctions module on random
+// matrices of the given sizes (500 and 1000 by default), and reports the
+// residual of each result.
+
+#include <iostream>
+#include <cstdlib>
+#include <Eigen/Core>
+#include <unsupported/Eigen/MatrixFunctions>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+std::complex<double> expfn(std::complex<double> x, int)
+{
+  return std::exp(x);
+}
+
+void bench(int size)
+{
+  const int tries = 2;
+  BenchTimer t;
+  // the eigenvalues of expA are away from the negative real axis
+  MatrixXd A = MatrixXd::Random(size, size) / std::sqrt(double(size));
+  MatrixXd expA, F, S, L;
+
+  std::cout << "size " << size << "\n";
+
+  BENCH(t, tries, 1, expA = A.exp());
+  std::cout << "  exp()            : " << t.best() << " s\n";
+
+  BENCH(t, tries, 1, F = A.matrixFunction(expfn));
+  std::cout << "  matrixFunction() : " << t.best() << " s"
+            << "  error " << (F - expA).norm() / expA.norm() << "\n";
+
+  BENCH(t, tries, 1, S = expA.sqrt());
+  std::cout << "  sqrt()           : " << t.best() << " s"
+            << "  residual " << (S * S - expA).norm() / expA.norm() << "\n";
+
+  BENCH(t, tries, 1, L = expA.log());
+  std::cout << "  log()            : " << t.best() << " s"
+            << "  error " << (L - A).norm() / A.norm() << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc > 1)
+    for (int i = 1; i < argc; ++i)
+      bench(std::atoi(argv[i]));
+  else {
+    bench(500);
+    bench(1000);
+  }
+  return 0;
+}
@@ -0,0 +1,88 @@
+// g++ -O3 -DNDEBUG -I.. bench_small_double.cpp -o bench_small_double
+// g++ -O3 -DNDEBUG -DEIGEN_DONT_VECTORIZE -I.. bench_small_double.cpp -o bench_small_double_novec
+// add -msse3 to enable the addsub/movedup variants
+
+#include <iostream>
+#include <vector>
+#include <Eigen/Geometry>
+#include <Eigen/LU>
+#include <bench/BenchTimer.h>
+using namespace Eigen;
+using namespace std;
+
+#ifndef REPEAT
+#define REPEAT 10000
+#endif
+
+#ifndef TRIES
+#define TRIES 5
+#endif
+
+// each functor applies its operation to N independent operands so that
+// the timings measure the throughput of the kernels themselves
+enum { N = 256 };
+
+template<typename Op>
+void bench(const char* name, Op& op)
+{
+  BenchTimer t;
+  BENCH(t, TRIES, REPEAT, op());
+  cout << name << "\t" << 1e9 * t.best() / (double(REPEAT) * N) << " ns" << endl;
+}
+
+template<typename A, typename B, typename R>
+struct Operands
+{
+  std::vector<A, aligned_allocator<A> > a;
+  std::vector<B, aligned_allocator<B> > b;
+  std::vector<R, aligned_allocator<R> > r;
+  Operands() : a(N), b(N), r(N) {}
+};
+
+struct Inverse4d : Operands<Matrix4d,Matrix4d,Matrix4d>
+{
+  Inverse4d() { for (int i=0; i<N; ++i) a[i] = Matrix4d::Random() + 4*Matrix4d::Identity(); }
+  EIGEN_DONT_INLINE void operator()() { for (int i=0; i<N; ++i) r[i] = a[i].inverse(); }
+};
+
+struct Product4d : Operands<Matrix4d,Matrix4d,Matrix4d>
+{
+  Product4d() { for (int i=0; i<N; ++i) { a[i].setRandom(); b[i].setRandom(); } }
+  EIGEN_DONT_INLINE void operator()() { for (int i=0; i<N; ++i) r[i].noalias() = a[i] * b[i]; }
+};
+
+struct MatVec4d : Operands<Matrix4d,Vector4d,Vector4d>
+{
+  MatVec4d() { for (int i=0; i<N; ++i) { a[i].setRandom(); b[i].setRandom(); } }
+  EIGEN_DONT_INLINE void operator()() { for (int i=0; i<N; ++i) r[i].noalias() = a[i] * b[i]; }
+};
+
+struct MatVec3d : Operands<Matrix3d,Vector3d,Vector3d>
+{
+  MatVec3d() { for (int i=0; i<N; ++i) { a[i].setRandom(); b[i].setRandom(); } }
+  EIGEN_DONT_INLINE void operator()() { for (int i=0; i<N; ++i) r[i].noalias() = a[i] * b[i]; }
+};
+
+struct QuatProduct : Operands<Quaterniond,Quaterniond,Quaterniond>
+{
+  QuatProduct() { for (int i=0; i<N; ++i) { a[i].coeffs().setRandom(); b[i].coeffs().setRandom(); } }
+  EIGEN_DONT_INLINE void operator()() { for (int i=0; i<N; ++i) r[i] = a[i] * b[i]; }
+};
+
+struct Cross3 : Operands<Vector4d,Vector4d,Vector4d>
+{
+  Cross3() { for (int i=0; i<N; ++i) { a[i].setRandom(); b[i].setRandom(); } }
+  EIGEN_DONT_INLINE void operator()() { for (int i=0; i<N; ++i) r[i] = a[i].cross3(b[i]); }
+};
+
+int main()
+{
+  cout << "vectorization: " << (ei_packet_traits<double>::size > 1 ? "on" : "off") << endl;
+  Inverse4d   inv;  bench("Matrix4d::inverse()", inv);
+  Product4d   prod; bench("Matrix4d * Matrix4d", prod);
+  MatVec4d    mv4;  bench("Matrix4d * Vector4d", mv4);
+  MatVec3d    mv3;  bench("Matrix3d * Vector3d", mv3);
+  QuatProduct qp;   bench("Quaterniond * Quaterniond", qp);
+  Cross3      c3;   bench("Vector4d::cross3()", c3);
+  return 0;
+}
@@ -235,6 +235,15 @@ int main()
     cout << "  " << #FUNC << " => \t " << t.value() << "s\n"; \
   }
   
+  #define BENCH_TIMER_BATCH(TIMER,CODE) {\
+    TIMER.reset(); \
+    for(int k=0; k<2; ++k) {\
+      TIMER.start(); \
+      CODE; \
+      TIMER.stop(); \
+    } \
+  }
+
   cout << "\nSpeed:\n" << std::fixed;
   BENCH(nlerp);
   BENCH(slerp_eigen);
@@ -242,4 +251,18 @@ int main()
   BENCH(slerp_legacy_nlerp);
   BENCH(slerp_rw);
   BENCH(slerp_gael);
+
+  // batched versions on structure-of-arrays storage
+  {
+    const int n = 1000000;
+    Matrix<float,Dynamic,4> qa = Matrix<float,Dynamic,4>::Random(n,4),
+                            qb = Matrix<float,Dynamic,4>::Random(n,4), qc(n,4);
+    normalizeQuaternions(qa);
+    normalizeQuaternions(qb);
+    BenchTimer t;
+    BENCH_TIMER_BATCH(t, nlerpQuaternions(s,qa,qb,qc));
+    cout << "  nlerpQuaternions => \t " << t.value() << "s\n";
+    BENCH_TIMER_BATCH(t, slerpQuaternions(s,qa,qb,qc));
+    cout << "  slerpQuaternions => \t " << t.value() << "s\n";
+  }
 }
\ No newline at end of file
@@ -108,6 +108,20 @@ template<typename MatrixType> void cholesky(const MatrixType& m)
     VERIFY_IS_APPROX(symm * vecX, vecB);
     matX = cholup.solve(matB);
     VERIFY_IS_APPROX(symm * matX, matB);
+
+    // test rank one updates and downdates
+    VectorType vecU = VectorType::Random(rows);
+    SquareMatrixType symmUpdated = symm + vecU * vecU.adjoint();
+    chollo.rankUpdate(vecU);
+    VERIFY_IS_APPROX(symmUpdated, chollo.reconstructedMatrix());
+    cholup.rankUpdate(vecU);
+    VERIFY_IS_APPROX(symmUpdated, cholup.reconstructedMatrix());
+    chollo.rankUpdate(vecU, -1);
+    VERIFY_IS_APPROX(symm, chollo.reconstructedMatrix());
+    cholup.rankUpdate(vecU, -1);
+    VERIFY_IS_APPROX(symm, cholup.reconstructedMatrix());
+    vecX = cholup.solve(vecB);
+    VERIFY_IS_APPROX(symm * vecX, vecB);
   }
 
   int sign = ei_random<int>()%2 ? 1 : -1;
@@ -124,6 +138,16 @@ template<typename MatrixType> void cholesky(const MatrixType& m)
     VERIFY_IS_APPROX(symm * vecX, vecB);
     matX = ldlt.solve(matB);
     VERIFY_IS_APPROX(symm * matX, matB);
+
+    // test rank one updates and downdates, keeping the sign of the matrix
+    VectorType vecU = VectorType::Random(rows);
+    SquareMatrixType symmUpdated = symm + RealScalar(sign) * vecU * vecU.adjoint();
+    ldlt.rankUpdate(vecU, RealScalar(sign));
+    VERIFY_IS_APPROX(symmUpdated, ldlt.reconstructedMatrix());
+    ldlt.rankUpdate(vecU, RealScalar(-sign));
+    VERIFY_IS_APPROX(symm, ldlt.reconstructedMatrix());
+    vecX = ldlt.solve(vecB);
+    VERIFY_IS_APPROX(symm * vecX, vecB);
   }
 
 }
@@ -155,6 +179,8 @@ void test_cholesky()
     CALL_SUBTEST_3( cholesky(Matrix2d()) );
     CALL_SUBTEST_4( cholesky(Matrix3f()) );
     CALL_SUBTEST_5( cholesky(Matrix4d()) );
+    CALL_SUBTEST_5(( cholesky(Matrix<double,6,6>()) ));
+    CALL_SUBTEST_7(( cholesky(Matrix<float,8,8>()) ));
     CALL_SUBTEST_2( cholesky(MatrixXd(200,200)) );
     CALL_SUBTEST_6( cholesky(MatrixXcd(100,100)) );
   }
@@ -59,6 +59,10 @@ template<typename MatrixType> void eigensolver(const MatrixType& m)
   VERIFY_IS_APPROX(a.template cast<Complex>() * ei1.eigenvectors(),
                    ei1.eigenvectors() * ei1.eigenvalues().asDiagonal());
 
+  EigenSolver<MatrixType> eiNoEivecs(a, false);
+  VERIFY_IS_APPROX(ei1.eigenvalues(), eiNoEivecs.eigenvalues());
+  VERIFY_RAISES_ASSERT(eiNoEivecs.eigenvectors());
+  VERIFY_RAISES_ASSERT(eiNoEivecs.pseudoEigenvectors());
 }
 
 template<typename MatrixType> void eigensolver_verify_assert()
@@ -83,6 +87,10 @@ void test_eigensolver_generic()
     CALL_SUBTEST_2( eigensolver(MatrixXd(2,2)) );
     CALL_SUBTEST_3( eigensolver(Matrix<double,1,1>()) );
     CALL_SUBTEST_4( eigensolver(Matrix2d()) );
+
+    // large enough for the multishift iteration
+    int s = ei_random<int>(80,200);
+    CALL_SUBTEST_7( eigensolver(MatrixXd(s,s)) );
   }
 
   CALL_SUBTEST_1( eigensolver_verify_assert<Matrix4f>() );
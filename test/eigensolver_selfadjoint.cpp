@@ -104,15 +104,98 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
   VERIFY((symmA * eiSymm.eigenvectors()).isApprox(
           eiSymm.eigenvectors() * eiSymm.eigenvalues().asDiagonal(), largerEps));
 
+  // eigenvalues only
+  SelfAdjointEigenSolver<MatrixType> eiSymmNoVec(symmA, false);
+  VERIFY_IS_APPROX(eiSymm.eigenvalues(), eiSymmNoVec.eigenvalues());
+  SelfAdjointEigenSolver<MatrixType> eiSymmGenNoVec(symmA, symmB, false);
+  VERIFY_IS_APPROX(eiSymmGen.eigenvalues(), eiSymmGenNoVec.eigenvalues());
+  VERIFY_IS_APPROX(symmA.operatorNorm(), eiSymm.eigenvalues().cwiseAbs().maxCoeff());
+
   // generalized eigen problem Ax = lBx
   VERIFY((symmA * eiSymmGen.eigenvectors()).isApprox(
           symmB * (eiSymmGen.eigenvectors() * eiSymmGen.eigenvalues().asDiagonal()), largerEps));
 
+  // generalized eigen problem with the Cholesky factorization of B computed once
+  LLT<MatrixType> cholB(symmB);
+  SelfAdjointEigenSolver<MatrixType> eiSymmGenLLT(symmA, cholB);
+  VERIFY_IS_APPROX(eiSymmGen.eigenvalues(), eiSymmGenLLT.eigenvalues());
+  VERIFY((symmA * eiSymmGenLLT.eigenvectors()).isApprox(
+          symmB * (eiSymmGenLLT.eigenvectors() * eiSymmGenLLT.eigenvalues().asDiagonal()), largerEps));
+
+  // subset of the eigen pairs, all of them for fixed sizes
+  int first = 0, count = rows;
+  if (MatrixType::RowsAtCompileTime==Dynamic)
+  {
+    first = ei_random<int>(0, rows-1);
+    count = ei_random<int>(1, rows-first);
+  }
+  SelfAdjointEigenSolver<MatrixType> eiSymmSubset(rows);
+  eiSymmSubset.computeSubset(symmA, first, count);
+  VERIFY_IS_APPROX(eiSymm.eigenvalues().segment(first, count), eiSymmSubset.eigenvalues());
+  VERIFY((symmA * eiSymmSubset.eigenvectors()).isApprox(
+          eiSymmSubset.eigenvectors() * eiSymmSubset.eigenvalues().asDiagonal(), largerEps));
+  VERIFY((eiSymmSubset.eigenvectors().adjoint() * eiSymmSubset.eigenvectors()).eval().isIdentity(largerEps));
+
+  eiSymmSubset.computeSubset(symmA, cholB, first, count);
+  VERIFY_IS_APPROX(eiSymmGen.eigenvalues().segment(first, count), eiSymmSubset.eigenvalues());
+  VERIFY((symmA * eiSymmSubset.eigenvectors()).isApprox(
+          symmB * (eiSymmSubset.eigenvectors() * eiSymmSubset.eigenvalues().asDiagonal()), largerEps));
+
+  // multiple eigenvalues
+  eiSymmSubset.computeSubset(MatrixType::Identity(rows, cols), first, count);
+  VERIFY((eiSymmSubset.eigenvectors().adjoint() * eiSymmSubset.eigenvectors()).eval().isIdentity(largerEps));
+
   MatrixType sqrtSymmA = eiSymm.operatorSqrt();
   VERIFY_IS_APPROX(symmA, sqrtSymmA*sqrtSymmA);
   VERIFY_IS_APPROX(sqrtSymmA, symmA*eiSymm.operatorInverseSqrt());
 }
 
+template<typename MatrixType> void selfadjointeigensolver_direct()
+{
+  /* closed-form computeDirect() of the 2x2 and 3x3 real matrices */
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar, MatrixType::RowsAtCompileTime, 1> RealVectorType;
+  enum { Size = MatrixType::RowsAtCompileTime };
+
+  RealScalar largerEps = 10*test_precision<RealScalar>();
+
+  MatrixType a = MatrixType::Random();
+  MatrixType symmA = a.adjoint() * a;
+  // only the lower triangular part is referenced
+  MatrixType lowerA = symmA;
+  lowerA.template triangularView<StrictlyUpper>().setZero();
+
+  SelfAdjointEigenSolver<MatrixType> eiSymm(symmA);
+  SelfAdjointEigenSolver<MatrixType> eiDirect;
+  eiDirect.computeDirect(lowerA);
+  VERIFY(eiDirect.eigenvalues().isApprox(eiSymm.eigenvalues(), largerEps));
+  VERIFY((symmA * eiDirect.eigenvectors()).isApprox(
+          eiDirect.eigenvectors() * eiDirect.eigenvalues().asDiagonal(), largerEps));
+  VERIFY((eiDirect.eigenvectors().adjoint() * eiDirect.eigenvectors()).eval().isIdentity(largerEps));
+
+  eiDirect.computeDirect(symmA, false);
+  VERIFY(eiDirect.eigenvalues().isApprox(eiSymm.eigenvalues(), largerEps));
+
+  // multiple eigenvalues
+  RealVectorType d = RealVectorType::Random();
+  d(0) = d(1);
+  MatrixType q = SelfAdjointEigenSolver<MatrixType>(symmA).eigenvectors();
+  MatrixType symmB = q * d.asDiagonal() * q.adjoint();
+  eiDirect.computeDirect(symmB);
+  std::sort(d.data(), d.data()+Size);
+  VERIFY(eiDirect.eigenvalues().isApprox(d, largerEps));
+  VERIFY((symmB * eiDirect.eigenvectors()).isApprox(
+          eiDirect.eigenvectors() * eiDirect.eigenvalues().asDiagonal(), largerEps));
+  VERIFY((eiDirect.eigenvectors().adjoint() * eiDirect.eigenvectors()).eval().isIdentity(largerEps));
+
+  eiDirect.computeDirect(MatrixType::Zero());
+  VERIFY_IS_MUCH_SMALLER_THAN(eiDirect.eigenvalues().norm(), RealScalar(1));
+  eiDirect.computeDirect(MatrixType::Identity());
+  VERIFY(eiDirect.eigenvectors().isIdentity());
+  VERIFY_IS_APPROX(eiDirect.eigenvalues(), RealVectorType::Ones());
+}
+
 void test_eigensolver_selfadjoint()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -128,6 +211,13 @@ void test_eigensolver_selfadjoint()
     CALL_SUBTEST_4( selfadjointeigensolver(MatrixXd(2,2)) );
     CALL_SUBTEST_6( selfadjointeigensolver(Matrix<double,1,1>()) );
     CALL_SUBTEST_7( selfadjointeigensolver(Matrix<double,2,2>()) );
+
+    CALL_SUBTEST_1( selfadjointeigensolver_direct<Matrix3f>() );
+    CALL_SUBTEST_7( selfadjointeigensolver_direct<Matrix2d>() );
+    CALL_SUBTEST_9( selfadjointeigensolver_direct<Matrix3d>() );
+    CALL_SUBTEST_9( selfadjointeigensolver_direct<Matrix2f>() );
+    // other sizes fall back to compute()
+    CALL_SUBTEST_2( selfadjointeigensolver_direct<Matrix4d>() );
   }
 
   // Test problem size constructors
@@ -106,6 +106,70 @@ void alignedboxCastTests(const BoxType& _box)
 }
 
 
+template<typename Scalar, int Dim, int Options>
+void alignedboxBatch(int n)
+{
+  // batched containment, distance and culling tests
+  typedef AlignedBox<Scalar,Dim> BoxType;
+  typedef Matrix<Scalar,Dim,1> VectorType;
+  typedef Matrix<Scalar,Dim,Dynamic,Options> PointsType;
+
+  PointsType points = PointsType::Random(Dim,n);
+  PointsType centers = PointsType::Random(Dim,n);
+  PointsType extents = PointsType::Random(Dim,n).cwiseAbs() * Scalar(0.2);
+  PointsType mins = centers - extents, maxs = centers + extents;
+  BoxType box(VectorType::Constant(Scalar(-0.5)), VectorType::Constant(Scalar(0.5)));
+
+  BoxType bounds, ref;
+  bounds.extendByPoints(points);
+  for(int i=0; i<n; ++i) ref.extend(points.col(i));
+  VERIFY(bounds.min()==ref.min() && bounds.max()==ref.max());
+  // the corners of an empty box must not leak in the bounds of negative points
+  BoxType negBounds;
+  negBounds.extendByPoints(-points.cwiseAbs() - PointsType::Ones(Dim,n));
+  VERIFY((negBounds.max().array() < Scalar(-1) + NumTraits<Scalar>::epsilon()).all());
+
+  Matrix<bool,Dynamic,1> inside, intersect, visible;
+  Matrix<Scalar,Dynamic,1> dist, boxDist;
+  int countInside = box.containsPoints(points, inside);
+  int countIntersect = box.intersectsBoxes(mins, maxs, intersect);
+  box.squaredExteriorDistances(points, dist);
+  box.squaredExteriorDistances(mins, maxs, boxDist);
+  VERIFY(inside.size()==n && intersect.size()==n && dist.size()==n && boxDist.size()==n);
+  VERIFY(countInside==inside.count() && countIntersect==intersect.count());
+  for(int i=0; i<n; ++i)
+  {
+    BoxType bi(mins.col(i), maxs.col(i));
+    VERIFY(inside(i)==box.contains(points.col(i)));
+    VERIFY(intersect(i)==box.intersects(bi));
+    VERIFY_IS_APPROX(dist(i)+Scalar(1), box.squaredExteriorDistance(points.col(i))+Scalar(1));
+    VERIFY_IS_APPROX(boxDist(i)+Scalar(1), box.squaredExteriorDistance(bi)+Scalar(1));
+  }
+
+  // the faces of box as inward planes: every intersecting box must be reported
+  // as visible, and boxes further than the box along one axis must be culled
+  Matrix<Scalar,Dim+1,2*Dim> planes = Matrix<Scalar,Dim+1,2*Dim>::Zero();
+  for(int k=0; k<Dim; ++k)
+  {
+    planes(k,2*k) = Scalar(1);    planes(Dim,2*k) = Scalar(0.5);
+    planes(k,2*k+1) = Scalar(-1); planes(Dim,2*k+1) = Scalar(0.5);
+  }
+  int countVisible = boxesInsidePlanes(planes, mins, maxs, visible);
+  VERIFY(countVisible==visible.count());
+  // for axis aligned planes, the culling test is exact
+  VERIFY(visible==intersect);
+
+  // a plane with a non axis aligned normal
+  Hyperplane<Scalar,Dim> plane(VectorType::Ones().normalized(), Scalar(0.1));
+  boxesInsidePlanes(plane.coeffs(), mins, maxs, visible);
+  for(int i=0; i<n; ++i)
+  {
+    BoxType bi(mins.col(i), maxs.col(i));
+    Scalar maxDist = plane.signedDistance(bi.max());
+    VERIFY(visible(i)==(maxDist>=Scalar(0)));
+  }
+}
+
 void specificTest1()
 {
     Vector2f m; m << -1.0f, -2.0f;
@@ -181,4 +245,12 @@ void test_geo_alignedbox()
   }
   CALL_SUBTEST_12( specificTest1() );
   CALL_SUBTEST_13( specificTest2() );
+
+  for(int i = 0; i < g_repeat; i++)
+  {
+    CALL_SUBTEST_14(( alignedboxBatch<float,3,RowMajor>(ei_random<int>(1,1000)) ));
+    CALL_SUBTEST_14(( alignedboxBatch<float,2,ColMajor>(ei_random<int>(1,1000)) ));
+    CALL_SUBTEST_15(( alignedboxBatch<double,3,RowMajor>(ei_random<int>(1,1000)) ));
+    CALL_SUBTEST_15(( alignedboxBatch<double,4,ColMajor>(ei_random<int>(1,1000)) ));
+  }
 }
@@ -137,6 +137,56 @@ template<typename Scalar> void mapQuaternion(void){
   VERIFY_RAISES_ASSERT((MQuaternionA(array3unaligned)));
 }
 
+template<typename Scalar> void quaternionBatch(void)
+{
+  /* this test covers the following files:
+     QuaternionBatch.h
+  */
+  typedef Quaternion<Scalar> Quaternionx;
+  typedef Matrix<Scalar,Dynamic,4> QuaternionArray;
+  typedef Matrix<Scalar,Dynamic,1> VectorX;
+
+  // cover both full and partial blocks
+  int n = ei_random<int>(1,600);
+  QuaternionArray a = QuaternionArray::Random(n,4), b = QuaternionArray::Random(n,4), res;
+  VectorX t = VectorX::Random(n).cwiseAbs();
+  Matrix<Scalar,Dynamic,9> mats;
+
+  normalizeQuaternions(a);
+  normalizeQuaternions(b);
+  for(int i=0; i<n; ++i)
+    VERIFY_IS_APPROX(a.row(i).norm(), Scalar(1));
+
+  multiplyQuaternions(a, b, res);
+  for(int i=0; i<n; ++i)
+    VERIFY_IS_APPROX(res.row(i).transpose(), (Quaternionx(a.row(i).transpose())*Quaternionx(b.row(i).transpose())).coeffs());
+
+  slerpQuaternions(t, a, b, res);
+  for(int i=0; i<n; ++i)
+    VERIFY_IS_APPROX(res.row(i).transpose(), Quaternionx(a.row(i).transpose()).slerp(t(i), Quaternionx(b.row(i).transpose())).coeffs());
+
+  // interpolating a quaternion with itself
+  slerpQuaternions(t(0), a, a, res);
+  VERIFY_IS_APPROX(res, a);
+
+  nlerpQuaternions(Scalar(0), a, b, res);
+  VERIFY_IS_APPROX(res, a);
+  nlerpQuaternions(Scalar(1), a, b, res);
+  for(int i=0; i<n; ++i)
+    VERIFY(res.row(i).isApprox(b.row(i)) || res.row(i).isApprox(-b.row(i)));
+
+  quaternionsToRotationMatrices(a, mats);
+  for(int i=0; i<n; ++i)
+    VERIFY_IS_APPROX((Matrix<Scalar,3,3>(Map<Matrix<Scalar,3,3> >(Matrix<Scalar,9,1>(mats.row(i).transpose()).data()))),
+                     Quaternionx(a.row(i).transpose()).toRotationMatrix());
+
+  // in place composition
+  QuaternionArray c = a;
+  multiplyQuaternions(c, b, c);
+  multiplyQuaternions(a, b, res);
+  VERIFY_IS_APPROX(c, res);
+}
+
 void test_geo_quaternion()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -144,5 +194,7 @@ void test_geo_quaternion()
     CALL_SUBTEST_2( quaternion<double>() );
     CALL_SUBTEST( mapQuaternion<float>() );
     CALL_SUBTEST( mapQuaternion<double>() );
+    CALL_SUBTEST_1( quaternionBatch<float>() );
+    CALL_SUBTEST_2( quaternionBatch<double>() );
   }
 }
@@ -62,6 +62,10 @@ void test_hessenberg()
   CALL_SUBTEST_4(( hessenberg<float,Dynamic>(ei_random<int>(1,320)) ));
   CALL_SUBTEST_5(( hessenberg<std::complex<double>,Dynamic>(ei_random<int>(1,320)) ));
 
+  // sizes above the crossover of the blocked reduction, which then reduces panels before finishing unblocked
+  CALL_SUBTEST_7(( hessenberg<double,Dynamic>(200) ));
+  CALL_SUBTEST_7(( hessenberg<std::complex<float>,Dynamic>(161) ));
+
   // Test problem size constructors
   CALL_SUBTEST_6(HessenbergDecomposition<MatrixXf>(10));
 }
@@ -62,6 +62,24 @@ template<typename MatrixType, unsigned int Options> void svd(const MatrixType& m
   VERIFY_IS_UNITARY(v);
 }
 
+template<typename MatrixType> void svd_one_sided(const MatrixType& m)
+{
+  int rows = m.rows();
+  int cols = m.cols();
+  MatrixType a = MatrixType::Random(rows,cols);
+
+  // the one-sided iteration computes the same singular values
+  JacobiSVD<MatrixType,OneSidedJacobi> oneSided(a);
+  JacobiSVD<MatrixType> twoSided(a);
+  VERIFY_IS_APPROX(oneSided.singularValues(), twoSided.singularValues());
+
+  // rank deficient matrix, the left singular vectors of the zero singular values must be completed
+  MatrixType b = a;
+  b.col(0).setZero();
+  if(cols > 2) b.col(cols-1) = b.col(1);
+  svd<MatrixType,OneSidedJacobi>(b, false);
+}
+
 template<typename MatrixType> void svd_verify_assert()
 {
   MatrixType tmp;
@@ -98,9 +116,18 @@ void test_jacobisvd()
 
     CALL_SUBTEST_7(( svd<MatrixXf,Square>(MatrixXf(50,50)) ));
     CALL_SUBTEST_8(( svd<MatrixXcd,AtLeastAsManyRowsAsCols>(MatrixXcd(14,7)) ));
+
+    CALL_SUBTEST_4(( svd<Matrix4d,Square|OneSidedJacobi>() ));
+    CALL_SUBTEST_5(( svd<Matrix<float,3,5> , AtLeastAsManyColsAsRows|OneSidedJacobi>() ));
+    CALL_SUBTEST_7(( svd<MatrixXf,Square|OneSidedJacobi>(MatrixXf(51,51)) ));
+    CALL_SUBTEST_8(( svd<MatrixXcd,AtLeastAsManyRowsAsCols|OneSidedJacobi>(MatrixXcd(14,7)) ));
+    CALL_SUBTEST_13(( svd_one_sided(MatrixXd(ei_random<int>(1,40), ei_random<int>(1,40))) ));
+    CALL_SUBTEST_14(( svd_one_sided(MatrixXcf(ei_random<int>(1,20), ei_random<int>(1,20))) ));
   }
   CALL_SUBTEST_9(( svd<MatrixXf,0>(MatrixXf(300,200)) ));
   CALL_SUBTEST_10(( svd<MatrixXcd,AtLeastAsManyColsAsRows>(MatrixXcd(100,150)) ));
+  CALL_SUBTEST_9(( svd<MatrixXf,OneSidedJacobi>(MatrixXf(300,200)) ));
+  CALL_SUBTEST_10(( svd<MatrixXcd,AtLeastAsManyColsAsRows|OneSidedJacobi>(MatrixXcd(100,150)) ));
 
   CALL_SUBTEST_3(( svd_verify_assert<Matrix3f>() ));
   CALL_SUBTEST_3(( svd_verify_assert<Matrix3d>() ));
@@ -157,6 +157,30 @@ template<typename MatrixType> void lu_partial_piv()
   VERIFY_IS_APPROX(m1, plu.reconstructedMatrix());
 }
 
+template<typename MatrixType> void lu_partial_piv_fixedsize()
+{
+  /* the decomposition of small fixed size matrices is fully unrolled,
+     compare it with the blocked one */
+  typedef Matrix<typename MatrixType::Scalar, Dynamic, Dynamic> DynamicMatrixType;
+  enum { Size = MatrixType::RowsAtCompileTime };
+
+  MatrixType m1 = MatrixType::Random();
+  PartialPivLU<MatrixType> plu(m1);
+  PartialPivLU<DynamicMatrixType> dplu(m1);
+  VERIFY_IS_APPROX(m1, plu.reconstructedMatrix());
+  VERIFY_IS_APPROX(DynamicMatrixType(plu.matrixLU()), dplu.matrixLU());
+  VERIFY(plu.permutationP().indices() == dplu.permutationP().indices());
+  VERIFY_IS_APPROX(plu.determinant(), m1.determinant());
+
+  // exactly singular matrix: both stop at the first zero pivot
+  int j = ei_random<int>(0, Size-1);
+  m1.col(j).setZero();
+  plu.compute(m1);
+  dplu.compute(m1);
+  VERIFY_IS_APPROX(DynamicMatrixType(plu.matrixLU()), dplu.matrixLU());
+  VERIFY(plu.permutationP().indices() == dplu.permutationP().indices());
+}
+
 template<typename MatrixType> void lu_verify_assert()
 {
   MatrixType tmp;
@@ -189,6 +213,9 @@ void test_lu()
   for(int i = 0; i < g_repeat; i++) {
     CALL_SUBTEST_1( lu_non_invertible<Matrix3f>() );
     CALL_SUBTEST_1( lu_verify_assert<Matrix3f>() );
+    CALL_SUBTEST_1( lu_partial_piv_fixedsize<Matrix3f>() );
+    CALL_SUBTEST_2( lu_partial_piv_fixedsize<Matrix4d>() );
+    CALL_SUBTEST_2(( lu_partial_piv_fixedsize<Matrix<double,8,8> >() ));
 
     CALL_SUBTEST_2( (lu_non_invertible<Matrix<double, 4, 6> >()) );
     CALL_SUBTEST_2( (lu_verify_assert<Matrix<double, 4, 6> >()) );
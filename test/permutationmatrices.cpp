@@ -103,6 +103,37 @@ template<typename MatrixType> void permutationmatrices(const MatrixType& m)
   m_permuted = m_permuted * rp;
   VERIFY_IS_APPROX(m_permuted, m_original*rp);
 
+  Matrix<Scalar,Rows,1> v_original = Matrix<Scalar,Rows,1>::Random(rows), v_permuted = v_original;
+  v_permuted = lp * v_permuted;
+  VERIFY_IS_APPROX(v_permuted, lp*v_original);
+  v_permuted = v_original;
+  v_permuted = lp.inverse() * v_permuted;
+  VERIFY_IS_APPROX(v_permuted, lp.inverse()*v_original);
+
+  // check the permutations of an expression with the other storage order
+  typedef Matrix<Scalar,Rows,Cols,(Options&RowMajor) ? ColMajor : RowMajor> OtherMatrixType;
+  OtherMatrixType m_other = m_original;
+  m_permuted = lp * m_other * rp;
+  VERIFY_IS_APPROX(m_permuted, lp * m_original * rp);
+  m_permuted = lp.inverse() * m_other * rp.inverse();
+  VERIFY_IS_APPROX(m_permuted, lp.inverse() * m_original * rp.inverse());
+
+  // check the sequential application of row transpositions
+  LeftPermutationVectorType transpositions(rows);
+  LeftPermutationType tp;
+  tp.setIdentity(rows);
+  for(int k = 0; k < rows; ++k)
+  {
+    transpositions(k) = ei_random<int>(k, rows-1);
+    tp.applyTranspositionOnTheRight(k, transpositions(k));
+  }
+  m_permuted = m_original;
+  ei_apply_row_transpositions(m_permuted, &transpositions.coeffRef(0), 0, rows);
+  VERIFY_IS_APPROX(m_permuted, tp.inverse() * m_original);
+  m_other = m_original;
+  ei_apply_row_transpositions(m_other, &transpositions.coeffRef(0), 0, rows);
+  VERIFY_IS_APPROX(m_other, tp.inverse() * m_original);
+
   if(rows>1 && cols>1)
   {
     lp2 = lp;
@@ -97,6 +97,61 @@ template<typename MatrixType> void qr_invertible()
   VERIFY_IS_APPROX(ei_log(absdet), qr.logAbsDeterminant());
 }
 
+template<typename MatrixType> void qr_updatable()
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+
+  int rows = ei_random<int>(10,40);
+  int cols = ei_random<int>(2,rows-5);
+  MatrixType a = MatrixType::Random(rows,cols);
+  UpdatableQR<MatrixType> qr(a);
+  VERIFY_IS_APPROX(a, qr.reconstructedMatrix());
+
+  // append and remove rows
+  VectorType row = VectorType::Random(cols);
+  a.conservativeResize(rows+1, cols);
+  a.row(rows) = row.transpose();
+  qr.appendRow(row.transpose());
+  VERIFY(qr.rows() == rows+1);
+  VERIFY_IS_APPROX(a, qr.reconstructedMatrix());
+
+  int i = ei_random<int>(0,rows);
+  MatrixType b(rows, cols);
+  b.topRows(i) = a.topRows(i);
+  b.bottomRows(rows-i) = a.bottomRows(rows-i);
+  a = b;
+  qr.removeRow(i);
+  VERIFY(qr.rows() == rows);
+  VERIFY_IS_APPROX(a, qr.reconstructedMatrix());
+
+  // append and remove columns
+  VectorType col = VectorType::Random(rows);
+  a.conservativeResize(rows, cols+1);
+  a.col(cols) = col;
+  qr.appendColumn(col);
+  VERIFY(qr.cols() == cols+1);
+  VERIFY_IS_APPROX(a, qr.reconstructedMatrix());
+
+  int j = ei_random<int>(0,cols);
+  b.resize(rows, cols);
+  b.leftCols(j) = a.leftCols(j);
+  b.rightCols(cols-j) = a.rightCols(cols-j);
+  a = b;
+  qr.removeColumn(j);
+  VERIFY(qr.cols() == cols);
+  VERIFY_IS_APPROX(a, qr.reconstructedMatrix());
+
+  VERIFY_IS_UNITARY(qr.matrixQ());
+  MatrixType r = qr.matrixR().template triangularView<Upper>();
+  VERIFY_IS_EQUAL(r, qr.matrixR());
+
+  // least squares solution, checked on the normal equations
+  VectorType rhs = VectorType::Random(rows);
+  VectorType x = qr.solve(rhs);
+  VERIFY_IS_APPROX(a.adjoint() * (a * x), a.adjoint() * rhs);
+}
+
 template<typename MatrixType> void qr_verify_assert()
 {
   MatrixType tmp;
@@ -118,6 +173,8 @@ void test_qr()
    CALL_SUBTEST_4(( qr_fixedsize<Matrix<double,6,2>, 4 >() ));
    CALL_SUBTEST_5(( qr_fixedsize<Matrix<double,2,5>, 7 >() ));
    CALL_SUBTEST_11( qr(Matrix<float,1,1>()) );
+   CALL_SUBTEST_10( qr(Matrix4d()) );
+   CALL_SUBTEST_10(( qr_fixedsize<Matrix<double,8,8>, 3 >() ));
   }
 
   for(int i = 0; i < g_repeat; i++) {
@@ -125,6 +182,8 @@ void test_qr()
     CALL_SUBTEST_6( qr_invertible<MatrixXd>() );
     CALL_SUBTEST_7( qr_invertible<MatrixXcf>() );
     CALL_SUBTEST_8( qr_invertible<MatrixXcd>() );
+    CALL_SUBTEST_6( qr_updatable<MatrixXd>() );
+    CALL_SUBTEST_8( qr_updatable<MatrixXcd>() );
   }
 
   CALL_SUBTEST_9(qr_verify_assert<Matrix3f>());
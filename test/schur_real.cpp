@@ -57,7 +57,6 @@ template<typename MatrixType> void schur(int size = MatrixType::ColsAtCompileTim
     RealSchur<MatrixType> schurOfA(A);
     MatrixType U = schurOfA.matrixU();
     MatrixType T = schurOfA.matrixT();
-    std::cout << "T = \n" << T << "\n\n";
     verifyIsQuasiTriangular(T);
     VERIFY_IS_APPROX(A, U * T * U.transpose());
   }
@@ -74,6 +73,11 @@ template<typename MatrixType> void schur(int size = MatrixType::ColsAtCompileTim
   RealSchur<MatrixType> rs2(A);
   VERIFY_IS_EQUAL(rs1.matrixT(), rs2.matrixT());
   VERIFY_IS_EQUAL(rs1.matrixU(), rs2.matrixU());
+
+  // Test computation of only T, not U
+  RealSchur<MatrixType> rsOnlyT(A, false);
+  VERIFY_IS_EQUAL(rs1.matrixT(), rsOnlyT.matrixT());
+  VERIFY_RAISES_ASSERT(rsOnlyT.matrixU());
 }
 
 void test_schur_real()
@@ -82,6 +86,8 @@ void test_schur_real()
   CALL_SUBTEST_2(( schur<MatrixXd>(ei_random<int>(1,50)) ));
   CALL_SUBTEST_3(( schur<Matrix<float, 1, 1> >() ));
   CALL_SUBTEST_4(( schur<Matrix<double, 3, 3, Eigen::RowMajor> >() ));
+  // large enough for the multishift iteration
+  CALL_SUBTEST_6(( schur<MatrixXd>(ei_random<int>(80,300)) ));
 
   // Test problem size constructors
   CALL_SUBTEST_5(RealSchur<MatrixXf>(10));
@@ -92,6 +92,56 @@ template<typename MatrixType> void stable_norm(const MatrixType& m)
   VERIFY_IS_APPROX(vrand.rowwise().stableNorm(),      vrand.rowwise().norm());
   VERIFY_IS_APPROX(vrand.rowwise().blueNorm(),        vrand.rowwise().norm());
   VERIFY_IS_APPROX(vrand.rowwise().hypotNorm(),       vrand.rowwise().norm());
+
+  // test a mix of small, medium and big coefficients
+  MatrixType vmix = vrand;
+  for(int k = 0; k < std::max(1,m.size()/3); ++k)
+    vmix(ei_random<int>(0,m.size()-1)) = ei_random<bool>() ? big : small;
+  VERIFY_IS_APPROX(vmix.blueNorm(), vmix.stableNorm());
+}
+
+template<typename MatrixType> void blue_norm_partial_redux(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,(MatrixType::Flags&RowMajorBit) ? ColMajor : RowMajor> OtherMatrixType;
+
+  int rows = m.rows();
+  int cols = m.cols();
+
+  Scalar big = ei_abs(ei_random<Scalar>()) * (std::numeric_limits<RealScalar>::max() * RealScalar(1e-4));
+  Scalar small = static_cast<RealScalar>(1)/big;
+
+  // mix small, medium and big coefficients in the columns and in the rows
+  MatrixType vmix = MatrixType::Random(rows, cols);
+  for(int k = 0; k < std::max(1,m.size()/3); ++k)
+    vmix(ei_random<int>(0,rows-1), ei_random<int>(0,cols-1)) = ei_random<bool>() ? big : small;
+  OtherMatrixType vmixOther = vmix;
+
+  VERIFY_IS_APPROX(vmix.colwise().blueNorm(), vmix.colwise().stableNorm());
+  VERIFY_IS_APPROX(vmix.rowwise().blueNorm(), vmix.rowwise().stableNorm());
+  VERIFY_IS_APPROX(vmixOther.colwise().blueNorm(), vmix.colwise().stableNorm());
+  VERIFY_IS_APPROX(vmixOther.rowwise().blueNorm(), vmix.rowwise().stableNorm());
+
+  MatrixType vbig(rows, cols);
+  vbig.fill(big);
+  VERIFY_IS_APPROX(vbig.colwise().blueNorm(), vbig.colwise().stableNorm());
+  VERIFY_IS_APPROX(vbig.rowwise().blueNorm(), vbig.rowwise().stableNorm());
+
+  // the result of a partial reduction can be stored in a vector of either orientation
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  VectorType colNorms = vmix.colwise().blueNorm();
+  VectorType rowNorms = vmix.rowwise().blueNorm();
+  VERIFY(colNorms.size() == cols);
+  VERIFY(rowNorms.size() == rows);
+  VERIFY_IS_APPROX(colNorms, vmix.colwise().stableNorm().transpose());
+  VERIFY_IS_APPROX(rowNorms, vmix.rowwise().stableNorm());
+  VectorType w;
+  w = vmixOther.colwise().blueNorm();
+  VERIFY(w.size() == cols);
+  VERIFY_IS_APPROX(w, vmix.colwise().stableNorm().transpose());
+  Array<Scalar,Dynamic,1> a = vmix.colwise().blueNorm();
+  VERIFY(a.size() == cols);
 }
 
 void test_stable_norm()
@@ -102,5 +152,8 @@ void test_stable_norm()
     CALL_SUBTEST_3( stable_norm(VectorXd(ei_random<int>(10,2000))) );
     CALL_SUBTEST_4( stable_norm(VectorXf(ei_random<int>(10,2000))) );
     CALL_SUBTEST_5( stable_norm(VectorXcd(ei_random<int>(10,2000))) );
+    CALL_SUBTEST_6( blue_norm_partial_redux(MatrixXd(ei_random<int>(1,200), ei_random<int>(1,200))) );
+    CALL_SUBTEST_7( blue_norm_partial_redux(Matrix<float,Dynamic,Dynamic,RowMajor>(ei_random<int>(1,200), ei_random<int>(1,600))) );
+    CALL_SUBTEST_8( blue_norm_partial_redux(MatrixXcf(ei_random<int>(1,50), ei_random<int>(1,50))) );
   }
 }
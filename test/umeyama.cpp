@@ -171,6 +171,65 @@ void run_fixed_size_test(int num_elements)
   VERIFY(error < Scalar(10)*std::numeric_limits<Scalar>::epsilon());
 }
 
+template <typename MatrixType>
+void run_weighted_test(int dim, int num_elements)
+{
+  typedef typename ei_traits<MatrixType>::Scalar Scalar;
+  typedef Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> MatrixX;
+  typedef Matrix<Scalar, Eigen::Dynamic, 1> VectorX;
+  typedef Matrix<Scalar, 1, Eigen::Dynamic> RowVectorX;
+
+  const Scalar c = ei_abs(ei_random<Scalar>());
+
+  MatrixX R = randMatrixSpecialUnitary<Scalar>(dim);
+  VectorX t = Scalar(50)*VectorX::Random(dim,1);
+
+  MatrixX cR_t = MatrixX::Identity(dim+1,dim+1);
+  cR_t.block(0,0,dim,dim) = c*R;
+  cR_t.block(0,dim,dim,1) = t;
+
+  MatrixX src = MatrixX::Random(dim+1, num_elements);
+  src.row(dim) = Matrix<Scalar, 1, Dynamic>::Constant(num_elements, Scalar(1));
+
+  MatrixX dst = cR_t*src;
+
+  // uniform weights must give the same result than the unweighted version
+  MatrixX cR_t_umeyama = umeyama(src.block(0,0,dim,num_elements), dst.block(0,0,dim,num_elements),
+                                 RowVectorX::Constant(num_elements, Scalar(2)));
+  VERIFY_IS_APPROX(cR_t_umeyama, (MatrixX)umeyama(src.block(0,0,dim,num_elements), dst.block(0,0,dim,num_elements)));
+
+  // corrupt some points and give them a null weight
+  const int num_outliers = num_elements/4;
+  VectorX w = VectorX::Random(num_elements).cwiseAbs().array() + Scalar(0.1);
+  for (int i=0; i<num_outliers; ++i)
+  {
+    dst.col(i).head(dim) += Scalar(10)*VectorX::Random(dim);
+    w(i) = 0;
+  }
+
+  cR_t_umeyama = umeyama(src.block(0,0,dim,num_elements), dst.block(0,0,dim,num_elements), w);
+
+  const Scalar error = ( cR_t_umeyama*src.rightCols(num_elements-num_outliers) - dst.rightCols(num_elements-num_outliers) ).array().square().sum();
+  VERIFY(error < Scalar(10)*std::numeric_limits<Scalar>::epsilon());
+
+  // the RANSAC estimation must recover the transformation and the outliers
+  RowVectorX inliers;
+  cR_t_umeyama = umeyamaRansac(src.block(0,0,dim,num_elements), dst.block(0,0,dim,num_elements),
+                               Scalar(1e-2), 100, true, &inliers);
+  VERIFY_IS_APPROX(cR_t_umeyama, cR_t);
+  VERIFY_IS_APPROX(inliers.sum(), Scalar(num_elements-num_outliers));
+  VERIFY(inliers.head(num_outliers).isZero());
+
+  // without any inlier, the best hypothesis is returned unrefined
+  cR_t_umeyama = umeyamaRansac(src.block(0,0,dim,num_elements), dst.block(0,0,dim,num_elements),
+                               Scalar(0), 10, true, &inliers);
+  VERIFY(inliers.isZero());
+  VERIFY(cR_t_umeyama.array().abs().maxCoeff() <= NumTraits<Scalar>::highest());
+
+  // the weights cannot all be zero
+  VERIFY_RAISES_ASSERT(umeyama(src, dst, RowVectorX::Zero(src.cols())));
+}
+
 void test_umeyama()
 {
   for (int i=0; i<g_repeat; ++i)
@@ -191,6 +250,11 @@ void test_umeyama()
     CALL_SUBTEST_6((run_fixed_size_test<double, 2>(num_elements)));
     CALL_SUBTEST_7((run_fixed_size_test<double, 3>(num_elements)));
     CALL_SUBTEST_8((run_fixed_size_test<double, 4>(num_elements)));
+
+    for (int dim=2; dim<5; ++dim)
+    {
+      CALL_SUBTEST_9(run_weighted_test<MatrixXd>(dim, num_elements));
+    }
   }
 
   // Those two calls don't compile and result in meaningful error messages!
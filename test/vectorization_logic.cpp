@@ -105,6 +105,18 @@ void test_vectorization_logic()
            Matrix<float,4,8>
           >(DefaultTraversal,CompleteUnrolling)));
 
+  VERIFY(test_assign(Matrix4f(),Matrix4f().lazyProduct(Matrix4f()),
+    InnerVectorizedTraversal,CompleteUnrolling));
+
+  VERIFY(test_assign(Matrix4d(),Matrix4d().lazyProduct(Matrix4d()),
+    InnerVectorizedTraversal,InnerUnrolling));
+
+  VERIFY(test_assign(Vector4d(),Matrix4d().lazyProduct(Vector4d()),
+    InnerVectorizedTraversal,CompleteUnrolling));
+
+  VERIFY(test_assign(Matrix<float,4,4,RowMajor>(),Matrix<float,4,4,RowMajor>().lazyProduct(Matrix<float,4,4,RowMajor>()),
+    InnerVectorizedTraversal,CompleteUnrolling));
+
   VERIFY(test_redux(VectorXf(10),
     LinearVectorizedTraversal,NoUnrolling));
 
@@ -0,0 +1,729 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_AUTODIFF_REVERSE_H
+#define EIGEN_AUTODIFF_REVERSE_H
+
+namespace Eigen {
+
+template<typename _Scalar> class AutoDiffTape;
+template<typename _Scalar> class AutoDiffReverseScalar;
+
+/** \internal
+  * A block allocator: the allocated objects are never moved, and the memory
+  * is kept by clear() to be reused by the next allocations.
+  */
+template<typename T>
+class ei_ad_arena
+{
+  public:
+    enum { BlockSize = 4096 };
+
+    ei_ad_arena() : m_current(0) {}
+    ~ei_ad_arena()
+    {
+      for(size_t i=0; i<m_blocks.size(); ++i)
+        delete[] m_blocks[i].data;
+    }
+
+    /** \returns a pointer to \a n contiguous objects */
+    T* allocate(int n)
+    {
+      while(m_current<int(m_blocks.size()) && m_blocks[m_current].used+n > m_blocks[m_current].size)
+        ++m_current;
+      if(m_current==int(m_blocks.size()))
+      {
+        Block b;
+        b.size = std::max<int>(BlockSize, n);
+        b.used = 0;
+        b.data = new T[b.size];
+        m_blocks.push_back(b);
+      }
+      Block& b = m_blocks[m_current];
+      T* res = b.data + b.used;
+      b.used += n;
+      return res;
+    }
+
+    void clear()
+    {
+      for(size_t i=0; i<m_blocks.size(); ++i)
+        m_blocks[i].used = 0;
+      m_current = 0;
+    }
+
+    int blocks() const { return int(m_blocks.size()); }
+    const T* blockData(int i) const { return m_blocks[i].data; }
+    int blockUsed(int i) const { return m_blocks[i].used; }
+
+  private:
+    struct Block { T* data; int size; int used; };
+    std::vector<Block> m_blocks;
+    int m_current;
+
+    ei_ad_arena(const ei_ad_arena&);
+    ei_ad_arena& operator=(const ei_ad_arena&);
+};
+
+/** \class AutoDiffTapeOp
+  * \brief Base class of the operations recorded on an AutoDiffTape with a custom adjoint rule
+  *
+  * Such an operation owns \c n consecutive outputs on the tape, starting at first(). During the
+  * reverse sweep, backward() is called once the adjoints of these outputs are known, and must
+  * accumulate the adjoints of the inputs.
+  */
+template<typename Scalar>
+class AutoDiffTapeOp
+{
+  public:
+    AutoDiffTapeOp() : m_first(-1) {}
+    virtual ~AutoDiffTapeOp() {}
+
+    /** Accumulates the adjoints of the inputs, \a adjoints being the array of all the adjoints of the tape. */
+    virtual void backward(Scalar* adjoints) const = 0;
+
+    int first() const { return m_first; }
+
+  protected:
+    int m_first;
+    friend class AutoDiffTape<Scalar>;
+};
+
+/** \class AutoDiffTape
+  * \brief Records the operations performed on AutoDiffReverseScalar objects for reverse mode differentiation
+  *
+  * \param _Scalar the underlying scalar type
+  *
+  * Each active scalar is a node of the tape, storing the indices of its operands and the partial
+  * derivatives with respect to them. All this data is stored in arenas which are kept across calls
+  * to clear(), so that recording the same function again does not allocate any memory.
+  *
+  * gradient() then computes the adjoints of all the nodes, i.e., the derivatives of a given output
+  * with respect to all of them, in a single reverse sweep of the tape.
+  *
+  * \sa AutoDiffReverseScalar
+  */
+template<typename _Scalar>
+class AutoDiffTape
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef AutoDiffReverseScalar<Scalar> ActiveScalar;
+    typedef AutoDiffTapeOp<Scalar> Op;
+
+    AutoDiffTape() : m_size(0), m_operands(0) {}
+    ~AutoDiffTape() { clear(); }
+
+    /** Removes all the recorded operations. The memory is kept for the next recording.
+      * The active scalars recorded on this tape must not be used anymore. */
+    void clear()
+    {
+      for(size_t i=0; i<m_ops.size(); ++i)
+        delete m_ops[i];
+      m_ops.clear();
+      m_nodes.clear();
+      m_parents.clear();
+      m_partials.clear();
+      m_adjoints.clear();
+      m_size = 0;
+      m_operands = 0;
+    }
+
+    /** \returns the number of recorded nodes */
+    int size() const { return m_size; }
+
+    /** \returns the number of recorded partial derivatives */
+    int operands() const { return m_operands; }
+
+    /** Records a node having \a count operands, whose indices and partial derivatives must be
+      * written to \a parents and \a partials. \returns the index of the node */
+    int record(int count, int*& parents, Scalar*& partials)
+    {
+      Node* node = m_nodes.allocate(1);
+      node->count = count;
+      node->parents = parents = count>0 ? m_parents.allocate(count) : 0;
+      node->partials = partials = count>0 ? m_partials.allocate(count) : 0;
+      m_operands += count;
+      return m_size++;
+    }
+
+    /** Records an independent variable. \returns its index */
+    int record()
+    {
+      int* parents;
+      Scalar* partials;
+      return record(0, parents, partials);
+    }
+
+    /** Records the node of a unary operation. \returns its index */
+    int record(int a, const Scalar& da)
+    {
+      int* parents;
+      Scalar* partials;
+      int id = record(1, parents, partials);
+      parents[0] = a;
+      partials[0] = da;
+      return id;
+    }
+
+    /** Records the node of a binary operation. \returns its index */
+    int record(int a, const Scalar& da, int b, const Scalar& db)
+    {
+      int* parents;
+      Scalar* partials;
+      int id = record(2, parents, partials);
+      parents[0] = a;
+      partials[0] = da;
+      parents[1] = b;
+      partials[1] = db;
+      return id;
+    }
+
+    /** Records the operation \a op, which is then owned by the tape, with \a outputs outputs.
+      * \returns the index of the first output */
+    int record(Op* op, int outputs)
+    {
+      op->m_first = m_size;
+      for(int i=0; i<outputs; ++i)
+        record();
+      m_ops.push_back(op);
+      return op->m_first;
+    }
+
+    /** Computes the adjoints of all the active scalars of the tape with respect to \a y */
+    void gradient(const ActiveScalar& y)
+    {
+      m_adjoints.assign(m_size, Scalar(0));
+      if(!y.isActive())
+        return;
+      ei_assert(y.tape()==this && "the output is recorded on another tape");
+      m_adjoints[y.index()] = Scalar(1);
+
+      int id = m_size;
+      int op = int(m_ops.size())-1;
+      for(int b=m_nodes.blocks()-1; b>=0; --b)
+      {
+        const Node* nodes = m_nodes.blockData(b);
+        for(int j=m_nodes.blockUsed(b)-1; j>=0; --j)
+        {
+          --id;
+          const Node& node = nodes[j];
+          const Scalar a = m_adjoints[id];
+          if(a!=Scalar(0))
+            for(int k=0; k<node.count; ++k)
+              m_adjoints[node.parents[k]] += a * node.partials[k];
+          while(op>=0 && m_ops[op]->first()==id)
+            m_ops[op--]->backward(&m_adjoints[0]);
+        }
+      }
+    }
+
+    /** \returns the adjoint of \a x computed by the last call to gradient() */
+    Scalar adjoint(const ActiveScalar& x) const
+    {
+      if(!x.isActive() || x.index()>=int(m_adjoints.size()))
+        return Scalar(0);
+      ei_assert(x.tape()==this);
+      return m_adjoints[x.index()];
+    }
+
+    /** \returns the adjoints of the coefficients of \a x computed by the last call to gradient() */
+    template<typename Derived>
+    Matrix<Scalar,Derived::RowsAtCompileTime,Derived::ColsAtCompileTime> adjoints(const MatrixBase<Derived>& x) const
+    {
+      Matrix<Scalar,Derived::RowsAtCompileTime,Derived::ColsAtCompileTime> res(x.rows(), x.cols());
+      for(int j=0; j<x.cols(); ++j)
+        for(int i=0; i<x.rows(); ++i)
+          res(i,j) = adjoint(x.coeff(i,j));
+      return res;
+    }
+
+  protected:
+    struct Node
+    {
+      const int* parents;
+      const Scalar* partials;
+      int count;
+    };
+
+    ei_ad_arena<Node> m_nodes;
+    ei_ad_arena<int> m_parents;
+    ei_ad_arena<Scalar> m_partials;
+    std::vector<Op*> m_ops;
+    std::vector<Scalar> m_adjoints;
+    int m_size;
+    int m_operands;
+
+  private:
+    AutoDiffTape(const AutoDiffTape&);
+    AutoDiffTape& operator=(const AutoDiffTape&);
+};
+
+/** \class AutoDiffReverseScalar
+  * \brief A scalar type replacement with reverse mode automatic differentiation capability
+  *
+  * \param _Scalar the underlying scalar type
+  *
+  * Unlike AutoDiffScalar, which carries the derivatives with respect to all the inputs, this type only
+  * stores a value and the index of its node on an AutoDiffTape. The gradient of a scalar output with
+  * respect to any number of inputs is then obtained by a single reverse sweep of the tape, at a cost
+  * which is a small multiple of the cost of the function itself:
+  * \code
+  * AutoDiffTape<double> tape;
+  * Matrix<AutoDiffReverseScalar<double>,Dynamic,1> x(n);
+  * for(int i=0; i<n; ++i)
+  *   x[i] = AutoDiffReverseScalar<double>(tape, x0[i]);
+  * AutoDiffReverseScalar<double> y = f(x);
+  * tape.gradient(y);
+  * VectorXd g = tape.adjoints(x);
+  * \endcode
+  *
+  * A scalar constructed from a plain value is a constant, and is not recorded. AutoDiffReverseScalar
+  * can be used as the scalar type of Eigen matrices, in which case every scalar operation is recorded.
+  * For large matrix operations, reverseProduct(), reverseDot() and reverseLltSolve() record a single
+  * operation with a specialized adjoint rule instead.
+  *
+  * It supports the following list of global math function:
+  *  - std::abs, std::sqrt, std::pow, std::exp, std::log, std::sin, std::cos,
+  *  - ei_abs, ei_sqrt, ei_pow, ei_exp, ei_log, ei_sin, ei_cos, ei_abs2.
+  */
+template<typename _Scalar>
+class AutoDiffReverseScalar
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef AutoDiffTape<Scalar> Tape;
+
+    /** Constructs a zero constant */
+    AutoDiffReverseScalar() : m_value(0), m_tape(0), m_index(-1) {}
+
+    /** Constructs a constant */
+    AutoDiffReverseScalar(const Scalar& value) : m_value(value), m_tape(0), m_index(-1) {}
+
+    /** Constructs an independent variable of value \a value recorded on \a tape */
+    AutoDiffReverseScalar(Tape& tape, const Scalar& value) : m_value(value), m_tape(&tape), m_index(tape.record()) {}
+
+    /** \internal Constructs the scalar of value \a value corresponding to the node \a index of \a tape */
+    AutoDiffReverseScalar(const Scalar& value, Tape* tape, int index) : m_value(value), m_tape(tape), m_index(index) {}
+
+    friend std::ostream & operator << (std::ostream & s, const AutoDiffReverseScalar& a)
+    {
+      return s << a.value();
+    }
+
+    inline const Scalar& value() const { return m_value; }
+    inline Tape* tape() const { return m_tape; }
+    inline int index() const { return m_index; }
+    inline bool isActive() const { return m_tape!=0; }
+
+    /** \returns the adjoint computed by the last call to AutoDiffTape::gradient() */
+    inline Scalar adjoint() const { return m_tape ? m_tape->adjoint(*this) : Scalar(0); }
+
+    /** \internal \returns f(x) given its value \a f and the derivative \a df of f at x */
+    inline const AutoDiffReverseScalar chain(const Scalar& f, const Scalar& df) const
+    {
+      return m_tape ? AutoDiffReverseScalar(f, m_tape, m_tape->record(m_index, df)) : AutoDiffReverseScalar(f);
+    }
+
+    friend inline const AutoDiffReverseScalar operator+(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b)
+    { return binary(a, b, a.m_value + b.m_value, Scalar(1), Scalar(1)); }
+    friend inline const AutoDiffReverseScalar operator+(const AutoDiffReverseScalar& a, const Scalar& b)
+    { return a.chain(a.m_value + b, Scalar(1)); }
+    friend inline const AutoDiffReverseScalar operator+(const Scalar& a, const AutoDiffReverseScalar& b)
+    { return b.chain(a + b.m_value, Scalar(1)); }
+
+    friend inline const AutoDiffReverseScalar operator-(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b)
+    { return binary(a, b, a.m_value - b.m_value, Scalar(1), Scalar(-1)); }
+    friend inline const AutoDiffReverseScalar operator-(const AutoDiffReverseScalar& a, const Scalar& b)
+    { return a.chain(a.m_value - b, Scalar(1)); }
+    friend inline const AutoDiffReverseScalar operator-(const Scalar& a, const AutoDiffReverseScalar& b)
+    { return b.chain(a - b.m_value, Scalar(-1)); }
+
+    friend inline const AutoDiffReverseScalar operator*(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b)
+    { return binary(a, b, a.m_value * b.m_value, b.m_value, a.m_value); }
+    friend inline const AutoDiffReverseScalar operator*(const AutoDiffReverseScalar& a, const Scalar& b)
+    { return a.chain(a.m_value * b, b); }
+    friend inline const AutoDiffReverseScalar operator*(const Scalar& a, const AutoDiffReverseScalar& b)
+    { return b.chain(a * b.m_value, a); }
+
+    friend inline const AutoDiffReverseScalar operator/(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b)
+    {
+      const Scalar inv = Scalar(1) / b.m_value;
+      const Scalar q = a.m_value * inv;
+      return binary(a, b, q, inv, -q * inv);
+    }
+    friend inline const AutoDiffReverseScalar operator/(const AutoDiffReverseScalar& a, const Scalar& b)
+    { return a.chain(a.m_value / b, Scalar(1) / b); }
+    friend inline const AutoDiffReverseScalar operator/(const Scalar& a, const AutoDiffReverseScalar& b)
+    {
+      const Scalar q = a / b.m_value;
+      return b.chain(q, -q / b.m_value);
+    }
+
+    inline const AutoDiffReverseScalar operator-() const { return chain(-m_value, Scalar(-1)); }
+
+    inline AutoDiffReverseScalar& operator+=(const AutoDiffReverseScalar& other) { return *this = *this + other; }
+    inline AutoDiffReverseScalar& operator-=(const AutoDiffReverseScalar& other) { return *this = *this - other; }
+    inline AutoDiffReverseScalar& operator*=(const AutoDiffReverseScalar& other) { return *this = *this * other; }
+    inline AutoDiffReverseScalar& operator/=(const AutoDiffReverseScalar& other) { return *this = *this / other; }
+    inline AutoDiffReverseScalar& operator+=(const Scalar& other) { return *this = *this + other; }
+    inline AutoDiffReverseScalar& operator-=(const Scalar& other) { return *this = *this - other; }
+    inline AutoDiffReverseScalar& operator*=(const Scalar& other) { return *this = *this * other; }
+    inline AutoDiffReverseScalar& operator/=(const Scalar& other) { return *this = *this / other; }
+
+    friend inline bool operator==(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b) { return a.m_value == b.m_value; }
+    friend inline bool operator!=(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b) { return a.m_value != b.m_value; }
+    friend inline bool operator< (const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b) { return a.m_value <  b.m_value; }
+    friend inline bool operator<=(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b) { return a.m_value <= b.m_value; }
+    friend inline bool operator> (const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b) { return a.m_value >  b.m_value; }
+    friend inline bool operator>=(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b) { return a.m_value >= b.m_value; }
+
+  protected:
+    static inline const AutoDiffReverseScalar binary(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b,
+                                                     const Scalar& f, const Scalar& da, const Scalar& db)
+    {
+      if(!a.m_tape)
+        return b.chain(f, db);
+      if(!b.m_tape)
+        return a.chain(f, da);
+      ei_assert(a.m_tape==b.m_tape && "the operands are recorded on different tapes");
+      return AutoDiffReverseScalar(f, a.m_tape, a.m_tape->record(a.m_index, da, b.m_index, db));
+    }
+
+    Scalar m_value;
+    Tape* m_tape;
+    int m_index;
+};
+
+/** \internal Splits the active matrix \a x into its values and node indices (-1 for constants),
+  * and updates \a tape with the tape of its active coefficients. */
+template<typename Derived, typename Scalar>
+void ei_ad_reverse_split(const MatrixBase<Derived>& x, Matrix<Scalar,Dynamic,Dynamic>& values,
+                         Matrix<int,Dynamic,Dynamic>& indices, AutoDiffTape<Scalar>*& tape)
+{
+  values.resize(x.rows(), x.cols());
+  indices.resize(x.rows(), x.cols());
+  for(int j=0; j<x.cols(); ++j)
+    for(int i=0; i<x.rows(); ++i)
+    {
+      const AutoDiffReverseScalar<Scalar>& c = x.coeff(i,j);
+      values(i,j) = c.value();
+      indices(i,j) = c.index();
+      if(c.isActive())
+      {
+        ei_assert((tape==0 || tape==c.tape()) && "the operands are recorded on different tapes");
+        tape = c.tape();
+      }
+    }
+}
+
+/** \internal Accumulates \a values into the adjoints of the nodes \a indices */
+template<typename Scalar, typename Derived>
+void ei_ad_reverse_scatter(Scalar* adjoints, const Matrix<int,Dynamic,Dynamic>& indices, const MatrixBase<Derived>& values)
+{
+  for(int j=0; j<indices.cols(); ++j)
+    for(int i=0; i<indices.rows(); ++i)
+      if(indices(i,j)>=0)
+        adjoints[indices(i,j)] += values.coeff(i,j);
+}
+
+/** \internal Adjoint rule of C = A * B: Abar += Cbar B^T, Bbar += A^T Cbar */
+template<typename Scalar>
+class ei_ad_reverse_product_op : public AutoDiffTapeOp<Scalar>
+{
+  public:
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+    typedef Matrix<int,Dynamic,Dynamic> IndexType;
+
+    ei_ad_reverse_product_op(const MatrixType& a, const IndexType& ia, const MatrixType& b, const IndexType& ib)
+      : m_ia(ia), m_ib(ib)
+    {
+      // A is only needed to compute Bbar, and conversely
+      if((ib.array()>=0).any())
+        m_a = a;
+      if((ia.array()>=0).any())
+        m_b = b;
+    }
+
+    void backward(Scalar* adjoints) const
+    {
+      Map<MatrixType> cbar(adjoints + this->first(), m_ia.rows(), m_ib.cols());
+      if(cbar.squaredNorm()==Scalar(0))
+        return;
+      if(m_b.size()>0)
+        ei_ad_reverse_scatter(adjoints, m_ia, MatrixType(cbar * m_b.transpose()));
+      if(m_a.size()>0)
+        ei_ad_reverse_scatter(adjoints, m_ib, MatrixType(m_a.transpose() * cbar));
+    }
+
+  protected:
+    MatrixType m_a, m_b;
+    IndexType m_ia, m_ib;
+};
+
+/** \internal Adjoint rule of X = A^-1 B for a selfadjoint A whose lower triangular part is used:
+  * with G = A^-1 Xbar, Bbar += G and Abar -= G X^T, symmetrized onto the lower triangular part. */
+template<typename Scalar>
+class ei_ad_reverse_llt_solve_op : public AutoDiffTapeOp<Scalar>
+{
+  public:
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+    typedef Matrix<int,Dynamic,Dynamic> IndexType;
+
+    ei_ad_reverse_llt_solve_op(const LLT<MatrixType>& llt, const IndexType& ia, const MatrixType& x, const IndexType& ib)
+      : m_llt(llt), m_x(x), m_ia(ia), m_ib(ib)
+    {}
+
+    void backward(Scalar* adjoints) const
+    {
+      Map<MatrixType> xbar(adjoints + this->first(), m_x.rows(), m_x.cols());
+      if(xbar.squaredNorm()==Scalar(0))
+        return;
+      MatrixType g = m_llt.solve(xbar);
+      ei_ad_reverse_scatter(adjoints, m_ib, g);
+      MatrixType m = g * m_x.transpose();
+      const int n = m.rows();
+      for(int j=0; j<n; ++j)
+      {
+        if(m_ia(j,j)>=0)
+          adjoints[m_ia(j,j)] -= m(j,j);
+        for(int i=j+1; i<n; ++i)
+          if(m_ia(i,j)>=0)
+            adjoints[m_ia(i,j)] -= m(i,j) + m(j,i);
+      }
+    }
+
+  protected:
+    LLT<MatrixType> m_llt;
+    MatrixType m_x;
+    IndexType m_ia, m_ib;
+};
+
+/** \returns the dot product of the active vectors \a a and \a b, recorded as a single node
+  * of the tape having an operand per active coefficient.
+  *
+  * \sa AutoDiffReverseScalar
+  */
+template<typename DerivedA, typename DerivedB>
+typename DerivedA::Scalar reverseDot(const MatrixBase<DerivedA>& a, const MatrixBase<DerivedB>& b)
+{
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(DerivedA)
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(DerivedB)
+  typedef typename DerivedA::Scalar ActiveScalar;
+  typedef typename ActiveScalar::Scalar Scalar;
+  ei_assert(a.size()==b.size());
+
+  const int n = a.size();
+  Scalar value = 0;
+  int count = 0;
+  AutoDiffTape<Scalar>* tape = 0;
+  for(int i=0; i<n; ++i)
+  {
+    const ActiveScalar& ai = a.coeff(i);
+    const ActiveScalar& bi = b.coeff(i);
+    value += ai.value() * bi.value();
+    if(ai.isActive()) { tape = ai.tape(); ++count; }
+    if(bi.isActive()) { tape = bi.tape(); ++count; }
+  }
+  if(!tape)
+    return ActiveScalar(value);
+
+  int* parents;
+  Scalar* partials;
+  int id = tape->record(count, parents, partials);
+  for(int i=0; i<n; ++i)
+  {
+    const ActiveScalar& ai = a.coeff(i);
+    const ActiveScalar& bi = b.coeff(i);
+    if(ai.isActive()) { ei_assert(ai.tape()==tape); *parents++ = ai.index(); *partials++ = bi.value(); }
+    if(bi.isActive()) { ei_assert(bi.tape()==tape); *parents++ = bi.index(); *partials++ = ai.value(); }
+  }
+  return ActiveScalar(value, tape, id);
+}
+
+/** \returns the product of the active matrices \a a and \a b.
+  *
+  * The product is evaluated on the values with the plain scalar type, and a single operation
+  * is recorded on the tape. Its storage is proportional to the size of the operands, instead of
+  * the \c m*n*k nodes recorded by a product of matrices of AutoDiffReverseScalar.
+  *
+  * \sa AutoDiffReverseScalar
+  */
+template<typename DerivedA, typename DerivedB>
+Matrix<typename DerivedA::Scalar,Dynamic,Dynamic> reverseProduct(const MatrixBase<DerivedA>& a, const MatrixBase<DerivedB>& b)
+{
+  typedef typename DerivedA::Scalar ActiveScalar;
+  typedef typename ActiveScalar::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  ei_assert(a.cols()==b.rows());
+
+  MatrixType av, bv;
+  Matrix<int,Dynamic,Dynamic> ia, ib;
+  AutoDiffTape<Scalar>* tape = 0;
+  ei_ad_reverse_split(a, av, ia, tape);
+  ei_ad_reverse_split(b, bv, ib, tape);
+  MatrixType c = av * bv;
+
+  Matrix<ActiveScalar,Dynamic,Dynamic> res(c.rows(), c.cols());
+  if(!tape || c.size()==0)
+  {
+    for(int j=0; j<c.cols(); ++j)
+      for(int i=0; i<c.rows(); ++i)
+        res(i,j) = ActiveScalar(c(i,j));
+    return res;
+  }
+
+  int first = tape->record(new ei_ad_reverse_product_op<Scalar>(av, ia, bv, ib), c.size());
+  for(int j=0; j<c.cols(); ++j)
+    for(int i=0; i<c.rows(); ++i)
+      res(i,j) = ActiveScalar(c(i,j), tape, first + i + j*c.rows());
+  return res;
+}
+
+/** \returns the solution X of \f$ A X = B \f$, where \a a is a selfadjoint positive definite
+  * active matrix of which only the lower triangular part is referenced, as with LLT.
+  *
+  * The Cholesky factorization is computed on the values, and a single operation is recorded on
+  * the tape. Its adjoint rule reuses the factorization, so that its storage is proportional to the
+  * size of the operands instead of the \c n^3 nodes recorded by an LLT of AutoDiffReverseScalar.
+  *
+  * \sa AutoDiffReverseScalar, LLT
+  */
+template<typename DerivedA, typename DerivedB>
+Matrix<typename DerivedA::Scalar,Dynamic,Dynamic> reverseLltSolve(const MatrixBase<DerivedA>& a, const MatrixBase<DerivedB>& b)
+{
+  typedef typename DerivedA::Scalar ActiveScalar;
+  typedef typename ActiveScalar::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  ei_assert(a.rows()==a.cols() && a.rows()==b.rows());
+
+  MatrixType av, bv;
+  Matrix<int,Dynamic,Dynamic> ia, ib;
+  AutoDiffTape<Scalar>* tape = 0;
+  ei_ad_reverse_split(a, av, ia, tape);
+  ei_ad_reverse_split(b, bv, ib, tape);
+  LLT<MatrixType> llt(av);
+  MatrixType x = llt.solve(bv);
+
+  Matrix<ActiveScalar,Dynamic,Dynamic> res(x.rows(), x.cols());
+  if(!tape || x.size()==0)
+  {
+    for(int j=0; j<x.cols(); ++j)
+      for(int i=0; i<x.rows(); ++i)
+        res(i,j) = ActiveScalar(x(i,j));
+    return res;
+  }
+
+  int first = tape->record(new ei_ad_reverse_llt_solve_op<Scalar>(llt, ia, x, ib), x.size());
+  for(int j=0; j<x.cols(); ++j)
+    for(int i=0; i<x.rows(); ++i)
+      res(i,j) = ActiveScalar(x(i,j), tape, first + i + j*x.rows());
+  return res;
+}
+
+template<typename _Scalar> struct NumTraits<AutoDiffReverseScalar<_Scalar> >
+  : NumTraits<_Scalar>
+{
+  typedef AutoDiffReverseScalar<_Scalar> Real;
+  typedef AutoDiffReverseScalar<_Scalar> NonInteger;
+  typedef AutoDiffReverseScalar<_Scalar> Nested;
+
+  inline static Real epsilon() { return Real(NumTraits<_Scalar>::epsilon()); }
+  inline static Real dummy_precision() { return Real(NumTraits<_Scalar>::dummy_precision()); }
+  inline static Real highest() { return Real(NumTraits<_Scalar>::highest()); }
+  inline static Real lowest() { return Real(NumTraits<_Scalar>::lowest()); }
+};
+
+}
+
+#define EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(FUNC,CODE) \
+  template<typename Scalar> \
+  inline const Eigen::AutoDiffReverseScalar<Scalar> FUNC(const Eigen::AutoDiffReverseScalar<Scalar>& x) { \
+    using namespace Eigen; \
+    CODE; \
+  }
+
+namespace std
+{
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(abs,
+    return x.chain(std::abs(x.value()), x.value()<Scalar(0) ? Scalar(-1) : Scalar(1));)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(sqrt,
+    Scalar sqrtx = std::sqrt(x.value());
+    return x.chain(sqrtx, Scalar(0.5) / sqrtx);)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(cos,
+    return x.chain(std::cos(x.value()), -std::sin(x.value()));)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(sin,
+    return x.chain(std::sin(x.value()), std::cos(x.value()));)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(exp,
+    Scalar expx = std::exp(x.value());
+    return x.chain(expx, expx);)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(log,
+    return x.chain(std::log(x.value()), Scalar(1)/x.value());)
+
+  template<typename Scalar>
+  inline const Eigen::AutoDiffReverseScalar<Scalar>
+  pow(const Eigen::AutoDiffReverseScalar<Scalar>& x, typename Eigen::ei_cleantype<Scalar>::type y)
+  {
+    return x.chain(std::pow(x.value(),y), y * std::pow(x.value(),y-1));
+  }
+}
+
+namespace Eigen {
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_abs,
+  return x.chain(ei_abs(x.value()), x.value()<Scalar(0) ? Scalar(-1) : Scalar(1));)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_abs2,
+  return x.chain(ei_abs2(x.value()), Scalar(2)*x.value());)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_sqrt,
+  Scalar sqrtx = ei_sqrt(x.value());
+  return x.chain(sqrtx, Scalar(0.5) / sqrtx);)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_cos,
+  return x.chain(ei_cos(x.value()), -ei_sin(x.value()));)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_sin,
+  return x.chain(ei_sin(x.value()), ei_cos(x.value()));)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_exp,
+  Scalar expx = ei_exp(x.value());
+  return x.chain(expx, expx);)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_log,
+  return x.chain(ei_log(x.value()), Scalar(1)/x.value());)
+
+template<typename Scalar>
+inline const AutoDiffReverseScalar<Scalar>
+ei_pow(const AutoDiffReverseScalar<Scalar>& x, typename ei_cleantype<Scalar>::type y)
+{ return std::pow(x,y); }
+
+#undef EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY
+
+}
+
+#endif // EIGEN_AUTODIFF_REVERSE_H
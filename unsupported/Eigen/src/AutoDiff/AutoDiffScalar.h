@@ -63,12 +63,31 @@ void ei_make_coherent(const A& a, const B&b)
   * in that case, the expression template mechanism only occurs at the top Matrix level,
   * while derivatives are computed right away.
   *
+  * When _DerType is a fixed size column vector of real scalars (e.g., \c Vector4d), a
+  * specialization is used instead of the expression template mechanism: all the operations
+  * return plain AutoDiffScalar objects, and the derivatives are directly updated using
+  * SIMD packets without any intermediate temporary.
+  *
   */
 
 template<typename _DerType, bool Enable> struct ei_auto_diff_special_op;
 
+// tells whether the fixed size specialization of AutoDiffScalar should be used for _DerType
+template<typename _DerType> struct ei_auto_diff_is_fixed
+{
+  enum { ret = 0 };
+};
 
-template<typename _DerType>
+template<typename _Scalar, int _Rows, int _Options, int _MaxRows>
+struct ei_auto_diff_is_fixed<Matrix<_Scalar, _Rows, 1, _Options, _MaxRows, 1> >
+{
+  enum { ret = _Rows!=Dynamic && !NumTraits<_Scalar>::IsComplex };
+};
+
+template<typename _DerType, bool _FixedSize = ei_auto_diff_is_fixed<_DerType>::ret>
+class AutoDiffScalar;
+
+template<typename _DerType, bool _FixedSize>
 class AutoDiffScalar
   : public ei_auto_diff_special_op
             <_DerType, !ei_is_same_type<typename ei_traits<typename ei_cleantype<_DerType>::type>::Scalar,
@@ -174,6 +193,17 @@ class AutoDiffScalar
       return *this;
     }
 
+    inline const AutoDiffScalar<DerType&> operator-(const Scalar& other) const
+    {
+      return AutoDiffScalar<DerType&>(m_value - other, m_derivatives);
+    }
+
+    inline AutoDiffScalar& operator-=(const Scalar& other)
+    {
+      value() -= other;
+      return *this;
+    }
+
     template<typename OtherDerType>
     inline const AutoDiffScalar<CwiseBinaryOp<ei_scalar_sum_op<Scalar>,DerType,typename ei_cleantype<OtherDerType>::type> >
     operator+(const AutoDiffScalar<OtherDerType>& other) const
@@ -210,7 +240,6 @@ class AutoDiffScalar
       return *this;
     }
 
-    template<typename OtherDerType>
     inline const AutoDiffScalar<CwiseUnaryOp<ei_scalar_opposite_op<Scalar>, DerType> >
     operator-() const
     {
@@ -264,7 +293,7 @@ class AutoDiffScalar
     {
       return AutoDiffScalar<CwiseUnaryOp<ei_scalar_multiple_op<Scalar>, DerType> >(
         other / a.value(),
-        a.derivatives() * (-Scalar(1)/other));
+        a.derivatives() * (-other/(a.value()*a.value())));
     }
 
 //     inline const AutoDiffScalar<typename CwiseUnaryOp<ei_scalar_multiple_op<Real>, DerType>::Type >
@@ -405,6 +434,273 @@ struct ei_auto_diff_special_op<_DerType, false>
   void operator+() const;
 };
 
+/** \internal
+  * Operations on the derivatives of the fixed size AutoDiffScalar: they compute
+  * dst = s*a or dst = s*a + t*b using packets, and dst is allowed to alias a and b.
+  */
+template<typename Scalar, int Size>
+struct ei_auto_diff_fixed_ops
+{
+  typedef typename ei_packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = ei_packet_traits<Scalar>::size,
+    VectorizedSize = ei_packet_traits<Scalar>::HasMul && ei_packet_traits<Scalar>::HasAdd
+                   ? (Size/PacketSize)*PacketSize : 0
+  };
+
+  static EIGEN_STRONG_INLINE void scale(Scalar* dst, const Scalar& s, const Scalar* a)
+  {
+    const Packet ps = ei_pset1(s);
+    for(int i=0; i<VectorizedSize; i+=PacketSize)
+      ei_pstoreu(dst+i, ei_pmul(ps, ei_ploadu(a+i)));
+    for(int i=VectorizedSize; i<Size; ++i)
+      dst[i] = s * a[i];
+  }
+
+  static EIGEN_STRONG_INLINE void axpby(Scalar* dst, const Scalar& s, const Scalar* a, const Scalar& t, const Scalar* b)
+  {
+    const Packet ps = ei_pset1(s);
+    const Packet pt = ei_pset1(t);
+    for(int i=0; i<VectorizedSize; i+=PacketSize)
+      ei_pstoreu(dst+i, ei_padd(ei_pmul(ps, ei_ploadu(a+i)), ei_pmul(pt, ei_ploadu(b+i))));
+    for(int i=VectorizedSize; i<Size; ++i)
+      dst[i] = s * a[i] + t * b[i];
+  }
+
+  static EIGEN_STRONG_INLINE void add(Scalar* dst, const Scalar* a, const Scalar* b)
+  {
+    for(int i=0; i<VectorizedSize; i+=PacketSize)
+      ei_pstoreu(dst+i, ei_padd(ei_ploadu(a+i), ei_ploadu(b+i)));
+    for(int i=VectorizedSize; i<Size; ++i)
+      dst[i] = a[i] + b[i];
+  }
+
+  static EIGEN_STRONG_INLINE void sub(Scalar* dst, const Scalar* a, const Scalar* b)
+  {
+    for(int i=0; i<VectorizedSize; i+=PacketSize)
+      ei_pstoreu(dst+i, ei_psub(ei_ploadu(a+i), ei_ploadu(b+i)));
+    for(int i=VectorizedSize; i<Size; ++i)
+      dst[i] = a[i] - b[i];
+  }
+};
+
+/** \internal
+  * Specialization of AutoDiffScalar for fixed size derivative vectors.
+  * Unlike the generic version, every operation directly returns an AutoDiffScalar
+  * storing its derivatives, which are computed with explicit packet operations.
+  */
+template<typename _Scalar, int _Size, int _Options, int _MaxSize>
+class AutoDiffScalar<Matrix<_Scalar, _Size, 1, _Options, _MaxSize, 1>, true>
+{
+  public:
+    typedef Matrix<_Scalar, _Size, 1, _Options, _MaxSize, 1> DerType;
+    typedef _Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real Real;
+    typedef ei_auto_diff_fixed_ops<Scalar,_Size> Ops;
+
+    /** Default constructor without any initialization. */
+    AutoDiffScalar() {}
+
+    /** Constructs an active scalar from its \a value,
+        and initializes the \a nbDer derivatives such that it corresponds to the \a derNumber -th variable */
+    AutoDiffScalar(const Scalar& value, int nbDer, int derNumber)
+      : m_value(value)
+    {
+      ei_assert(nbDer==_Size);
+      m_derivatives.setZero();
+      m_derivatives.coeffRef(derNumber) = Scalar(1);
+    }
+
+    /** Conversion from a scalar constant to an active scalar.
+      * The derivatives are set to zero. */
+    explicit AutoDiffScalar(const Real& value)
+      : m_value(value)
+    {
+      m_derivatives.setZero();
+    }
+
+    /** Constructs an active scalar from its \a value and derivatives \a der */
+    AutoDiffScalar(const Scalar& value, const DerType& der)
+      : m_value(value), m_derivatives(der)
+    {}
+
+    template<typename OtherDerType, bool OtherFixedSize>
+    AutoDiffScalar(const AutoDiffScalar<OtherDerType,OtherFixedSize>& other)
+      : m_value(other.value()), m_derivatives(other.derivatives())
+    {}
+
+    friend std::ostream & operator << (std::ostream & s, const AutoDiffScalar& a)
+    {
+      return s << a.value();
+    }
+
+    inline const Scalar& value() const { return m_value; }
+    inline Scalar& value() { return m_value; }
+
+    inline const DerType& derivatives() const { return m_derivatives; }
+    inline DerType& derivatives() { return m_derivatives; }
+
+    inline const AutoDiffScalar operator+(const Scalar& other) const
+    {
+      return AutoDiffScalar(m_value + other, m_derivatives);
+    }
+
+    friend inline const AutoDiffScalar operator+(const Scalar& a, const AutoDiffScalar& b)
+    {
+      return AutoDiffScalar(a + b.value(), b.derivatives());
+    }
+
+    inline const AutoDiffScalar operator-(const Scalar& other) const
+    {
+      return AutoDiffScalar(m_value - other, m_derivatives);
+    }
+
+    friend inline const AutoDiffScalar operator-(const Scalar& a, const AutoDiffScalar& b)
+    {
+      AutoDiffScalar res;
+      res.m_value = a - b.value();
+      Ops::scale(res.m_derivatives.data(), Scalar(-1), b.m_derivatives.data());
+      return res;
+    }
+
+    inline const AutoDiffScalar operator+(const AutoDiffScalar& other) const
+    {
+      AutoDiffScalar res;
+      res.m_value = m_value + other.m_value;
+      Ops::add(res.m_derivatives.data(), m_derivatives.data(), other.m_derivatives.data());
+      return res;
+    }
+
+    inline const AutoDiffScalar operator-(const AutoDiffScalar& other) const
+    {
+      AutoDiffScalar res;
+      res.m_value = m_value - other.m_value;
+      Ops::sub(res.m_derivatives.data(), m_derivatives.data(), other.m_derivatives.data());
+      return res;
+    }
+
+    inline const AutoDiffScalar operator-() const
+    {
+      AutoDiffScalar res;
+      res.m_value = -m_value;
+      Ops::scale(res.m_derivatives.data(), Scalar(-1), m_derivatives.data());
+      return res;
+    }
+
+    inline const AutoDiffScalar operator*(const Scalar& other) const
+    {
+      AutoDiffScalar res;
+      res.m_value = m_value * other;
+      Ops::scale(res.m_derivatives.data(), other, m_derivatives.data());
+      return res;
+    }
+
+    friend inline const AutoDiffScalar operator*(const Scalar& other, const AutoDiffScalar& a)
+    {
+      return a * other;
+    }
+
+    inline const AutoDiffScalar operator/(const Scalar& other) const
+    {
+      return *this * (Scalar(1)/other);
+    }
+
+    friend inline const AutoDiffScalar operator/(const Scalar& other, const AutoDiffScalar& a)
+    {
+      AutoDiffScalar res;
+      res.m_value = other / a.m_value;
+      Ops::scale(res.m_derivatives.data(), -res.m_value / a.m_value, a.m_derivatives.data());
+      return res;
+    }
+
+    inline const AutoDiffScalar operator*(const AutoDiffScalar& other) const
+    {
+      AutoDiffScalar res;
+      res.m_value = m_value * other.m_value;
+      Ops::axpby(res.m_derivatives.data(), other.m_value, m_derivatives.data(), m_value, other.m_derivatives.data());
+      return res;
+    }
+
+    inline const AutoDiffScalar operator/(const AutoDiffScalar& other) const
+    {
+      AutoDiffScalar res;
+      const Scalar inv = Scalar(1) / other.m_value;
+      res.m_value = m_value * inv;
+      Ops::axpby(res.m_derivatives.data(), inv, m_derivatives.data(), -res.m_value * inv, other.m_derivatives.data());
+      return res;
+    }
+
+    inline AutoDiffScalar& operator+=(const Scalar& other)
+    {
+      m_value += other;
+      return *this;
+    }
+
+    inline AutoDiffScalar& operator-=(const Scalar& other)
+    {
+      m_value -= other;
+      return *this;
+    }
+
+    inline AutoDiffScalar& operator*=(const Scalar& other)
+    {
+      m_value *= other;
+      Ops::scale(m_derivatives.data(), other, m_derivatives.data());
+      return *this;
+    }
+
+    inline AutoDiffScalar& operator/=(const Scalar& other)
+    {
+      return *this *= Scalar(1)/other;
+    }
+
+    inline AutoDiffScalar& operator+=(const AutoDiffScalar& other)
+    {
+      m_value += other.m_value;
+      Ops::add(m_derivatives.data(), m_derivatives.data(), other.m_derivatives.data());
+      return *this;
+    }
+
+    inline AutoDiffScalar& operator-=(const AutoDiffScalar& other)
+    {
+      m_value -= other.m_value;
+      Ops::sub(m_derivatives.data(), m_derivatives.data(), other.m_derivatives.data());
+      return *this;
+    }
+
+    inline AutoDiffScalar& operator*=(const AutoDiffScalar& other)
+    {
+      const Scalar u = m_value, v = other.m_value;
+      m_value = u * v;
+      Ops::axpby(m_derivatives.data(), v, m_derivatives.data(), u, other.m_derivatives.data());
+      return *this;
+    }
+
+    inline AutoDiffScalar& operator/=(const AutoDiffScalar& other)
+    {
+      const Scalar inv = Scalar(1) / other.m_value;
+      m_value *= inv;
+      Ops::axpby(m_derivatives.data(), inv, m_derivatives.data(), -m_value * inv, other.m_derivatives.data());
+      return *this;
+    }
+
+    /** \internal \returns f(x) given its value \a f and the derivative \a df of f at x */
+    inline const AutoDiffScalar chain(const Scalar& f, const Scalar& df) const
+    {
+      AutoDiffScalar res;
+      res.m_value = f;
+      Ops::scale(res.m_derivatives.data(), df, m_derivatives.data());
+      return res;
+    }
+
+  protected:
+    Scalar m_value;
+    DerType m_derivatives;
+
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF(int(ei_traits<DerType>::Flags)&AlignedBit)
+};
+
 template<typename A_Scalar, int A_Rows, int A_Cols, int A_Options, int A_MaxRows, int A_MaxCols, typename B>
 struct ei_make_coherent_impl<Matrix<A_Scalar, A_Rows, A_Cols, A_Options, A_MaxRows, A_MaxCols>, B> {
   typedef Matrix<A_Scalar, A_Rows, A_Cols, A_Options, A_MaxRows, A_MaxCols> A;
@@ -459,10 +755,10 @@ template<typename A_Scalar, int A_Rows, int A_Cols, int A_Options, int A_MaxRows
    typedef Matrix<A_Scalar, A_Rows, A_Cols, A_Options, A_MaxRows, A_MaxCols> ReturnType;
 };
 
-template<typename DerType, typename T>
-struct ei_scalar_product_traits<AutoDiffScalar<DerType>,T>
+template<typename DerType, bool FixedSize, typename T>
+struct ei_scalar_product_traits<AutoDiffScalar<DerType,FixedSize>,T>
 {
- typedef AutoDiffScalar<DerType> ReturnType;
+ typedef AutoDiffScalar<DerType,FixedSize> ReturnType;
 };
 
 }
@@ -477,10 +773,46 @@ struct ei_scalar_product_traits<AutoDiffScalar<DerType>,T>
     CODE; \
   }
 
+#define EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(FUNC,CODE) \
+  template<typename Scalar, int Size, int Options, int MaxSize> \
+  inline const Eigen::AutoDiffScalar<Eigen::Matrix<Scalar,Size,1,Options,MaxSize,1>,true> \
+  FUNC(const Eigen::AutoDiffScalar<Eigen::Matrix<Scalar,Size,1,Options,MaxSize,1>,true>& x) { \
+    using namespace Eigen; \
+    CODE; \
+  }
+
 namespace std
 {
+  EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(abs,
+    return x.chain(std::abs(x.value()), x.value()<Scalar(0) ? Scalar(-1) : Scalar(1));)
+
+  EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(sqrt,
+    Scalar sqrtx = std::sqrt(x.value());
+    return x.chain(sqrtx, Scalar(0.5) / sqrtx);)
+
+  EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(cos,
+    return x.chain(std::cos(x.value()), -std::sin(x.value()));)
+
+  EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(sin,
+    return x.chain(std::sin(x.value()), std::cos(x.value()));)
+
+  EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(exp,
+    Scalar expx = std::exp(x.value());
+    return x.chain(expx, expx);)
+
+  EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(log,
+    return x.chain(std::log(x.value()), Scalar(1)/x.value());)
+
+  template<typename Scalar, int Size, int Options, int MaxSize>
+  inline const Eigen::AutoDiffScalar<Eigen::Matrix<Scalar,Size,1,Options,MaxSize,1>,true>
+  pow(const Eigen::AutoDiffScalar<Eigen::Matrix<Scalar,Size,1,Options,MaxSize,1>,true>& x,
+      typename Eigen::ei_cleantype<Scalar>::type y)
+  {
+    return x.chain(std::pow(x.value(),y), y * std::pow(x.value(),y-1));
+  }
+
   EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY(abs,
-    return ReturnType(std::abs(x.value()), x.derivatives() * (sign(x.value())));)
+    return ReturnType(std::abs(x.value()), x.derivatives() * (x.value()<Scalar(0) ? Scalar(-1) : Scalar(1)));)
 
   EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY(sqrt,
     Scalar sqrtx = std::sqrt(x.value());
@@ -522,7 +854,7 @@ template<typename DerType>
 inline typename DerType::Scalar ei_imag(const AutoDiffScalar<DerType>&)    { return 0.; }
 
 EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY(ei_abs,
-  return ReturnType(ei_abs(x.value()), x.derivatives() * (sign(x.value())));)
+  return ReturnType(ei_abs(x.value()), x.derivatives() * (x.value()<Scalar(0) ? Scalar(-1) : Scalar(1)));)
 
 EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY(ei_abs2,
   return ReturnType(ei_abs2(x.value()), x.derivatives() * (Scalar(2)*x.value()));)
@@ -549,13 +881,42 @@ inline const AutoDiffScalar<CwiseUnaryOp<ei_scalar_multiple_op<typename ei_trait
 ei_pow(const AutoDiffScalar<DerType>& x, typename ei_traits<DerType>::Scalar y)
 { return std::pow(x,y);}
 
+EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(ei_abs,
+  return x.chain(ei_abs(x.value()), x.value()<Scalar(0) ? Scalar(-1) : Scalar(1));)
+
+EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(ei_abs2,
+  return x.chain(ei_abs2(x.value()), Scalar(2)*x.value());)
+
+EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(ei_sqrt,
+  Scalar sqrtx = ei_sqrt(x.value());
+  return x.chain(sqrtx, Scalar(0.5) / sqrtx);)
+
+EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(ei_cos,
+  return x.chain(ei_cos(x.value()), -ei_sin(x.value()));)
+
+EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(ei_sin,
+  return x.chain(ei_sin(x.value()), ei_cos(x.value()));)
+
+EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(ei_exp,
+  Scalar expx = ei_exp(x.value());
+  return x.chain(expx, expx);)
+
+EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED(ei_log,
+  return x.chain(ei_log(x.value()), Scalar(1)/x.value());)
+
+template<typename Scalar, int Size, int Options, int MaxSize>
+inline const AutoDiffScalar<Matrix<Scalar,Size,1,Options,MaxSize,1>,true>
+ei_pow(const AutoDiffScalar<Matrix<Scalar,Size,1,Options,MaxSize,1>,true>& x, typename ei_cleantype<Scalar>::type y)
+{ return std::pow(x,y);}
+
 #undef EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY
+#undef EIGEN_AUTODIFF_DECLARE_GLOBAL_UNARY_FIXED
 
-template<typename DerType> struct NumTraits<AutoDiffScalar<DerType> >
+template<typename DerType, bool FixedSize> struct NumTraits<AutoDiffScalar<DerType,FixedSize> >
   : NumTraits< typename NumTraits<typename DerType::Scalar>::Real >
 {
-  typedef AutoDiffScalar<DerType> NonInteger;
-  typedef AutoDiffScalar<DerType>& Nested;
+  typedef AutoDiffScalar<DerType,FixedSize> NonInteger;
+  typedef AutoDiffScalar<DerType,FixedSize>& Nested;
 };
 
 }
@@ -27,17 +27,164 @@
   // This FFT implementation was derived from kissfft http:sourceforge.net/projects/kissfft
   // Copyright 2003-2009 Mark Borgerding
 
+// Complex arithmetic used by the radix-2 and radix-4 butterflies. The butterflies
+// process Size interleaved complex numbers at once, the generic version below
+// works on a single std::complex.
+template <typename _Scalar>
+struct ei_kiss_cpx_ops
+{
+  typedef std::complex<_Scalar> Complex;
+  typedef Complex type;
+  enum { Size = 1 };
+  static inline type load(const Complex * from) { return *from; }
+  static inline void store(Complex * to, const type & a) { *to = a; }
+  static inline type add(const type & a, const type & b) { return a+b; }
+  static inline type sub(const type & a, const type & b) { return a-b; }
+  static inline type mul(const type & a, const type & b) { return a*b; }
+  // multiplies by -i for the forward transform and by i for the inverse one
+  static inline type rotate(const type & a, bool inverse)
+  { return inverse ? Complex(-a.imag(),a.real()) : Complex(a.imag(),-a.real()); }
+};
+
+template <typename _Scalar>
+struct ei_kiss_cpx_packet : ei_kiss_cpx_ops<_Scalar> {};
+
+#ifdef EIGEN_VECTORIZE_SSE
+template <>
+struct ei_kiss_cpx_packet<float>
+{
+  typedef std::complex<float> Complex;
+  typedef Packet4f type;
+  enum { Size = 2 };
+  static EIGEN_STRONG_INLINE type load(const Complex * from) { return ei_ploadu(reinterpret_cast<const float*>(from)); }
+  static EIGEN_STRONG_INLINE void store(Complex * to, const type & a) { ei_pstoreu(reinterpret_cast<float*>(to), a); }
+  static EIGEN_STRONG_INLINE type add(const type & a, const type & b) { return ei_padd(a,b); }
+  static EIGEN_STRONG_INLINE type sub(const type & a, const type & b) { return ei_psub(a,b); }
+  static EIGEN_STRONG_INLINE type mul(const type & a, const type & b)
+  {
+    const type negReal = _mm_castsi128_ps(_mm_set_epi32(0x0,0x80000000,0x0,0x80000000));
+    return ei_padd(ei_pmul(a, _mm_shuffle_ps(b,b,_MM_SHUFFLE(2,2,0,0))),
+                   ei_pxor(ei_pmul(_mm_shuffle_ps(a,a,_MM_SHUFFLE(2,3,0,1)), _mm_shuffle_ps(b,b,_MM_SHUFFLE(3,3,1,1))), negReal));
+  }
+  static EIGEN_STRONG_INLINE type rotate(const type & a, bool inverse)
+  {
+    const type negReal = _mm_castsi128_ps(_mm_set_epi32(0x0,0x80000000,0x0,0x80000000));
+    const type negImag = _mm_castsi128_ps(_mm_set_epi32(0x80000000,0x0,0x80000000,0x0));
+    return ei_pxor(_mm_shuffle_ps(a,a,_MM_SHUFFLE(2,3,0,1)), inverse ? negReal : negImag);
+  }
+};
+
+template <>
+struct ei_kiss_cpx_packet<double>
+{
+  typedef std::complex<double> Complex;
+  typedef Packet2d type;
+  enum { Size = 1 };
+  static EIGEN_STRONG_INLINE type load(const Complex * from) { return ei_ploadu(reinterpret_cast<const double*>(from)); }
+  static EIGEN_STRONG_INLINE void store(Complex * to, const type & a) { ei_pstoreu(reinterpret_cast<double*>(to), a); }
+  static EIGEN_STRONG_INLINE type add(const type & a, const type & b) { return ei_padd(a,b); }
+  static EIGEN_STRONG_INLINE type sub(const type & a, const type & b) { return ei_psub(a,b); }
+  static EIGEN_STRONG_INLINE type mul(const type & a, const type & b)
+  {
+    const type negReal = _mm_castsi128_pd(_mm_set_epi32(0x0,0x0,0x80000000,0x0));
+    return ei_padd(ei_pmul(a, _mm_unpacklo_pd(b,b)),
+                   ei_pxor(ei_pmul(_mm_shuffle_pd(a,a,0x1), _mm_unpackhi_pd(b,b)), negReal));
+  }
+  static EIGEN_STRONG_INLINE type rotate(const type & a, bool inverse)
+  {
+    const type negReal = _mm_castsi128_pd(_mm_set_epi32(0x0,0x0,0x80000000,0x0));
+    const type negImag = _mm_castsi128_pd(_mm_set_epi32(0x80000000,0x0,0x0,0x0));
+    return ei_pxor(_mm_shuffle_pd(a,a,0x1), inverse ? negReal : negImag);
+  }
+};
+#endif
+
 template <typename _Scalar>
 struct ei_kiss_cpx_fft
 {
   typedef _Scalar Scalar;
   typedef std::complex<Scalar> Complex;
+  typedef ei_kiss_cpx_packet<Scalar> PacketOps;
+  typedef ei_kiss_cpx_ops<Scalar> ScalarOps;
+
+  // prime radices larger than this are computed with Bluestein's algorithm
+  // instead of the O(p^2) generic butterfly
+  enum { BluesteinThreshold = 61 };
+
   std::vector<Complex> m_twiddles;
   std::vector<int> m_stageRadix;
   std::vector<int> m_stageRemainder;
+  // contiguous copies of the twiddles of the radix-2 and radix-4 stages
+  std::vector<std::vector<Complex> > m_stageTwiddles;
   std::vector<Complex> m_scratchBuf;
   bool m_inverse;
 
+  // Bluestein's algorithm: chirps and transformed chirp filters of the large
+  // prime stages, and the power of two plan used for the convolutions
+  std::vector<std::vector<Complex> > m_chirps;
+  std::vector<std::vector<Complex> > m_chirpFilters;
+  std::vector<Complex> m_convBuf1;
+  std::vector<Complex> m_convBuf2;
+  ei_kiss_cpx_fft * m_convPlan;
+
+  ei_kiss_cpx_fft() : m_inverse(false), m_convPlan(0) {}
+
+  ei_kiss_cpx_fft(const ei_kiss_cpx_fft & other) : m_convPlan(0) { *this = other; }
+
+  ~ei_kiss_cpx_fft() { delete m_convPlan; }
+
+  ei_kiss_cpx_fft & operator=(const ei_kiss_cpx_fft & other)
+  {
+    if (this != &other) {
+      m_twiddles = other.m_twiddles;
+      m_stageRadix = other.m_stageRadix;
+      m_stageRemainder = other.m_stageRemainder;
+      m_stageTwiddles = other.m_stageTwiddles;
+      m_scratchBuf = other.m_scratchBuf;
+      m_inverse = other.m_inverse;
+      m_chirps = other.m_chirps;
+      m_chirpFilters = other.m_chirpFilters;
+      m_convBuf1 = other.m_convBuf1;
+      m_convBuf2 = other.m_convBuf2;
+      delete m_convPlan;
+      m_convPlan = other.m_convPlan ? new ei_kiss_cpx_fft(*other.m_convPlan) : 0;
+    }
+    return *this;
+  }
+
+  void init(int nfft, bool inverse)
+  {
+    make_twiddles(nfft,inverse);
+    factorize(nfft);
+    make_stage_data();
+  }
+
+  // builds the plan of the transform in the opposite direction of \a other,
+  // conjugating its twiddles instead of recomputing them
+  void init_conjugate(const ei_kiss_cpx_fft & other)
+  {
+    *this = other;
+    m_inverse = !other.m_inverse;
+    conjugate(m_twiddles);
+    for (size_t s=0;s<m_stageTwiddles.size();++s)
+      conjugate(m_stageTwiddles[s]);
+    for (size_t s=0;s<m_chirps.size();++s) {
+      conjugate(m_chirps[s]);
+      // the filter of the conjugate chirp is the conjugate of the mirrored filter
+      std::vector<Complex> & filter = m_chirpFilters[s];
+      if (filter.size()) {
+        std::reverse(filter.begin()+1,filter.end());
+        conjugate(filter);
+      }
+    }
+  }
+
+  static void conjugate(std::vector<Complex> & v)
+  {
+    for (size_t i=0;i<v.size();++i)
+      v[i] = conj(v[i]);
+  }
+
   inline
     void make_twiddles(int nfft,bool inverse)
     {
@@ -66,11 +213,75 @@ struct ei_kiss_cpx_fft
       n /= p;
       m_stageRadix.push_back(p);
       m_stageRemainder.push_back(n);
-      if ( p > 5 )
-        m_scratchBuf.resize(p); // scratchbuf will be needed in bfly_generic
+      if ( p > 5 && p <= BluesteinThreshold )
+        m_scratchBuf.resize(std::max<size_t>(m_scratchBuf.size(),p)); // scratchbuf will be needed in bfly_generic
     }while(n>1);
   }
 
+  void make_stage_data()
+  {
+    const int nstages = static_cast<int>(m_stageRadix.size());
+    const int nfft = static_cast<int>(m_twiddles.size());
+    m_stageTwiddles.resize(nstages);
+    m_chirps.resize(nstages);
+    m_chirpFilters.resize(nstages);
+
+    // all the Bluestein convolutions share one power of two size
+    int maxPrime = 0;
+    for (int s=0;s<nstages;++s)
+      if (m_stageRadix[s] > BluesteinThreshold)
+        maxPrime = std::max(maxPrime,m_stageRadix[s]);
+    if (maxPrime) {
+      int nconv = 1;
+      while (nconv < 2*maxPrime-1)
+        nconv <<= 1;
+      m_convPlan = new ei_kiss_cpx_fft;
+      m_convPlan->init(nconv,false);
+      m_convBuf1.resize(nconv);
+      m_convBuf2.resize(nconv);
+    }
+
+    int fstride = 1;
+    for (int s=0;s<nstages;++s) {
+      const int p = m_stageRadix[s];
+      const int m = m_stageRemainder[s];
+      if (p==2 || p==4) {
+        std::vector<Complex> & tw = m_stageTwiddles[s];
+        tw.resize((p-1)*m);
+        for (int q=1;q<p;++q)
+          for (int k=0;k<m;++k)
+            tw[(q-1)*m+k] = m_twiddles[q*k*fstride];
+      }else if (p > BluesteinThreshold) {
+        make_chirp(s,p);
+      }
+      fstride *= p;
+    }
+    ei_assert(fstride==nfft);
+  }
+
+  // chirp w_n = exp(-+ i pi n^2 / p) and the transform of its conjugate, with
+  // the 1/nconv factor of the inverse transform of the convolution folded in
+  void make_chirp(int stage,int p)
+  {
+    const int nconv = static_cast<int>(m_convBuf1.size());
+    const Scalar pi = acos( (Scalar) -1);
+    std::vector<Complex> & chirp = m_chirps[stage];
+    chirp.resize(p);
+    for (int n=0;n<p;++n) {
+      // n^2 mod 2p keeps the phase accurate for large n
+      long long n2 = (static_cast<long long>(n)*n) % (2*p);
+      chirp[n] = exp( Complex(0,(m_inverse?1:-1) * pi * Scalar(n2) / p) );
+    }
+    std::fill(m_convBuf1.begin(),m_convBuf1.end(),Complex(0));
+    for (int n=0;n<p;++n) {
+      m_convBuf1[n] = conj(chirp[n]) / Scalar(nconv);
+      if (n)
+        m_convBuf1[nconv-n] = m_convBuf1[n];
+    }
+    m_chirpFilters[stage].resize(nconv);
+    m_convPlan->work(0, &m_chirpFilters[stage][0], &m_convBuf1[0], 1,1);
+  }
+
   template <typename _Src>
     inline
     void work( int stage,Complex * xout, const _Src * xin, size_t fstride,size_t in_stride)
@@ -99,45 +310,66 @@ struct ei_kiss_cpx_fft
 
       // recombine the p smaller DFTs 
       switch (p) {
-        case 2: bfly2(xout,fstride,m); break;
+        case 2: bfly2(xout,&m_stageTwiddles[stage][0],m); break;
         case 3: bfly3(xout,fstride,m); break;
-        case 4: bfly4(xout,fstride,m); break;
+        case 4: bfly4(xout,&m_stageTwiddles[stage][0],m); break;
         case 5: bfly5(xout,fstride,m); break;
-        default: bfly_generic(xout,fstride,m,p); break;
+        default:
+          if (p > BluesteinThreshold)
+            bfly_bluestein(xout,fstride,m,p,stage);
+          else
+            bfly_generic(xout,fstride,m,p);
+          break;
       }
     }
 
+  template <typename Ops>
+  static EIGEN_STRONG_INLINE
+    void bfly2_kernel( Complex * Fout, const Complex * tw, int k, int m)
+    {
+      typename Ops::type t = Ops::mul(Ops::load(Fout+m+k), Ops::load(tw+k));
+      typename Ops::type f = Ops::load(Fout+k);
+      Ops::store(Fout+m+k, Ops::sub(f,t));
+      Ops::store(Fout+k, Ops::add(f,t));
+    }
+
   inline
-    void bfly2( Complex * Fout, const size_t fstride, int m)
+    void bfly2( Complex * Fout, const Complex * tw, int m)
     {
-      for (int k=0;k<m;++k) {
-        Complex t = Fout[m+k] * m_twiddles[k*fstride];
-        Fout[m+k] = Fout[k] - t;
-        Fout[k] += t;
-      }
+      int k=0;
+      for (;k+int(PacketOps::Size)<=m;k+=PacketOps::Size)
+        bfly2_kernel<PacketOps>(Fout,tw,k,m);
+      for (;k<m;++k)
+        bfly2_kernel<ScalarOps>(Fout,tw,k,m);
+    }
+
+  template <typename Ops>
+  static EIGEN_STRONG_INLINE
+    void bfly4_kernel( Complex * Fout, const Complex * tw, int k, int m, bool inverse)
+    {
+      typedef typename Ops::type Packet;
+      Packet s0 = Ops::mul(Ops::load(Fout+k+m), Ops::load(tw+k));
+      Packet s1 = Ops::mul(Ops::load(Fout+k+2*m), Ops::load(tw+m+k));
+      Packet s2 = Ops::mul(Ops::load(Fout+k+3*m), Ops::load(tw+2*m+k));
+      Packet f0 = Ops::load(Fout+k);
+      Packet s5 = Ops::sub(f0,s1);
+      f0 = Ops::add(f0,s1);
+      Packet s3 = Ops::add(s0,s2);
+      Packet s4 = Ops::rotate(Ops::sub(s0,s2),inverse);
+      Ops::store(Fout+k+2*m, Ops::sub(f0,s3));
+      Ops::store(Fout+k, Ops::add(f0,s3));
+      Ops::store(Fout+k+m, Ops::add(s5,s4));
+      Ops::store(Fout+k+3*m, Ops::sub(s5,s4));
     }
 
   inline
-    void bfly4( Complex * Fout, const size_t fstride, const size_t m)
+    void bfly4( Complex * Fout, const Complex * tw, int m)
     {
-      Complex scratch[6];
-      int negative_if_inverse = m_inverse * -2 +1;
-      for (size_t k=0;k<m;++k) {
-        scratch[0] = Fout[k+m] * m_twiddles[k*fstride];
-        scratch[1] = Fout[k+2*m] * m_twiddles[k*fstride*2];
-        scratch[2] = Fout[k+3*m] * m_twiddles[k*fstride*3];
-        scratch[5] = Fout[k] - scratch[1];
-
-        Fout[k] += scratch[1];
-        scratch[3] = scratch[0] + scratch[2];
-        scratch[4] = scratch[0] - scratch[2];
-        scratch[4] = Complex( scratch[4].imag()*negative_if_inverse , -scratch[4].real()* negative_if_inverse );
-
-        Fout[k+2*m]  = Fout[k] - scratch[3];
-        Fout[k] += scratch[3];
-        Fout[k+m] = scratch[5] + scratch[4];
-        Fout[k+3*m] = scratch[5] - scratch[4];
-      }
+      int k=0;
+      for (;k+int(PacketOps::Size)<=m;k+=PacketOps::Size)
+        bfly4_kernel<PacketOps>(Fout,tw,k,m,m_inverse);
+      for (;k<m;++k)
+        bfly4_kernel<ScalarOps>(Fout,tw,k,m,m_inverse);
     }
 
   inline
@@ -271,6 +503,38 @@ struct ei_kiss_cpx_fft
         }
       }
     }
+  /* perform a large prime radix butterfly as a convolution (Bluestein's algorithm) */
+  void bfly_bluestein( Complex * Fout, const size_t fstride, int m, int p, int stage)
+  {
+    const Complex * chirp = &m_chirps[stage][0];
+    const Complex * filter = &m_chirpFilters[stage][0];
+    const Complex * twiddles = &m_twiddles[0];
+    const int Norig = static_cast<int>(m_twiddles.size());
+    const int nconv = static_cast<int>(m_convBuf1.size());
+    Complex * a = &m_convBuf1[0];
+    Complex * b = &m_convBuf2[0];
+
+    for (int u=0;u<m;++u) {
+      // twiddle and chirp the input
+      int twidx = 0;
+      for (int q=0;q<p;++q) {
+        a[q] = Fout[u+q*m] * twiddles[twidx] * chirp[q];
+        twidx += static_cast<int>(fstride) * u;
+        if (twidx>=Norig) twidx-=Norig;
+      }
+      std::fill(a+p,a+nconv,Complex(0));
+
+      // circular convolution with the chirp filter, the inverse transform
+      // being computed as the conjugate of the transform of the conjugate
+      m_convPlan->work(0, b, a, 1,1);
+      for (int k=0;k<nconv;++k)
+        b[k] = conj(b[k] * filter[k]);
+      m_convPlan->work(0, a, b, 1,1);
+
+      for (int q=0;q<p;++q)
+        Fout[u+q*m] = conj(a[q]) * chirp[q];
+    }
+  }
 };
 
 template <typename _Scalar>
@@ -308,15 +572,15 @@ struct ei_kissfft_impl
   inline
     void fwd( Complex * dst,const Scalar * src,int nfft) 
     {
-      if ( nfft&3  ) {
+      if ( nfft&1 || nfft==2 ) {
         // use generic mode for odd
         m_tmpBuf1.resize(nfft);
         get_plan(nfft,false).work(0, &m_tmpBuf1[0], src, 1,1);
         std::copy(m_tmpBuf1.begin(),m_tmpBuf1.begin()+(nfft>>1)+1,dst );
       }else{
         int ncfft = nfft>>1;
-        int ncfft2 = nfft>>2;
-        Complex * rtw = real_twiddles(ncfft2);
+        int ncfft2 = ncfft>>1;
+        Complex * rtw = real_twiddles(ncfft);
 
         // use optimized mode for even real
         fwd( dst, reinterpret_cast<const Complex*> (src), ncfft);
@@ -348,7 +612,7 @@ struct ei_kissfft_impl
   inline
     void inv( Scalar * dst,const Complex * src,int nfft) 
     {
-      if (nfft&3) {
+      if ( nfft&1 || nfft==2 ) {
         m_tmpBuf1.resize(nfft);
         m_tmpBuf2.resize(nfft);
         std::copy(src,src+(nfft>>1)+1,m_tmpBuf1.begin() );
@@ -358,10 +622,9 @@ struct ei_kissfft_impl
         for (int k=0;k<nfft;++k)
           dst[k] = m_tmpBuf2[k].real();
       }else{
-        // optimized version for multiple of 4
+        // optimized version for even sizes
         int ncfft = nfft>>1;
-        int ncfft2 = nfft>>2;
-        Complex * rtw = real_twiddles(ncfft2);
+        Complex * rtw = real_twiddles(ncfft);
         m_tmpBuf1.resize(ncfft);
         m_tmpBuf1[0] = Complex( src[0].real() + src[ncfft].real(), src[0].real() - src[ncfft].real() );
         for (int k = 1; k <= ncfft / 2; ++k) {
@@ -392,22 +655,25 @@ struct ei_kissfft_impl
   inline
     PlanData & get_plan(int nfft, bool inverse)
     {
-      // TODO look for PlanKey(nfft, ! inverse) and conjugate the twiddles
       PlanData & pd = m_plans[ PlanKey(nfft,inverse) ];
       if ( pd.m_twiddles.size() == 0 ) {
-        pd.make_twiddles(nfft,inverse);
-        pd.factorize(nfft);
+        // the twiddles of the opposite direction are the conjugates of ours
+        typename PlanMap::const_iterator other = m_plans.find( PlanKey(nfft,!inverse) );
+        if ( other != m_plans.end() && other->second.m_twiddles.size() )
+          pd.init_conjugate(other->second);
+        else
+          pd.init(nfft,inverse);
       }
       return pd;
     }
 
   inline
-    Complex * real_twiddles(int ncfft2)
+    Complex * real_twiddles(int ncfft)
     {
-      std::vector<Complex> & twidref = m_realTwiddles[ncfft2];// creates new if not there
+      std::vector<Complex> & twidref = m_realTwiddles[ncfft];// creates new if not there
+      int ncfft2 = ncfft>>1;
       if ( (int)twidref.size() != ncfft2 ) {
         twidref.resize(ncfft2);
-        int ncfft= ncfft2<<1;
         Scalar pi =  acos( Scalar(-1) );
         for (int k=1;k<=ncfft2;++k) 
           twidref[k-1] = exp( Complex(0,-pi * (Scalar(k) / ncfft + Scalar(.5)) ) );
@@ -177,9 +177,12 @@ void MatrixExponential<MatrixType>::compute(ResultType &result)
   computeUV(RealScalar());
   m_tmp1 = m_U + m_V;	// numerator of Pade approximant
   m_tmp2 = -m_U + m_V;	// denominator of Pade approximant
-  result = m_tmp2.partialPivLu().solve(m_tmp1);
-  for (int i=0; i<m_squarings; i++)
-    result *= result;		// undo scaling by repeated squaring
+  m_U = m_tmp2.partialPivLu().solve(m_tmp1);
+  for (int i=0; i<m_squarings; i++) {
+    m_V.noalias() = m_U * m_U;	// undo scaling by repeated squaring
+    m_U.swap(m_V);
+  }
+  result = m_U;
 }
 
 template <typename MatrixType>
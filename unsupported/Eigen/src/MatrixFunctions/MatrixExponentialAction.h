@@ -0,0 +1,325 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_MATRIX_EXPONENTIAL_ACTION
+#define EIGEN_MATRIX_EXPONENTIAL_ACTION
+
+/** \internal \returns the 1-norm of \f$ A - \mu I \f$ for a dense matrix. */
+template <typename Derived>
+typename NumTraits<typename ei_traits<Derived>::Scalar>::Real
+ei_shifted_l1_norm(const MatrixBase<Derived>& A, const typename ei_traits<Derived>::Scalar& mu)
+{
+  typedef typename NumTraits<typename ei_traits<Derived>::Scalar>::Real RealScalar;
+  RealScalar res = 0;
+  for (int j=0; j<A.cols(); j++) {
+    RealScalar sum = A.col(j).cwiseAbs().sum();
+    if (j < A.rows())
+      sum += ei_abs(A.coeff(j,j) - mu) - ei_abs(A.coeff(j,j));
+    res = std::max(res, sum);
+  }
+  return res;
+}
+
+/** \internal \returns the 1-norm of \f$ A - \mu I \f$ for a sparse matrix. */
+template <typename Derived>
+typename NumTraits<typename ei_traits<Derived>::Scalar>::Real
+ei_shifted_l1_norm(const SparseMatrixBase<Derived>& A, const typename ei_traits<Derived>::Scalar& mu)
+{
+  typedef typename ei_traits<Derived>::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  Matrix<RealScalar,Dynamic,1> sums = Matrix<RealScalar,Dynamic,1>::Zero(A.cols());
+  std::vector<bool> hasDiagonal(A.cols(), false);
+  for (int j=0; j<A.outerSize(); j++)
+    for (typename Derived::InnerIterator it(A.derived(), j); it; ++it) {
+      if (it.row() == it.col()) {
+        sums[it.col()] += ei_abs(it.value() - mu);
+        hasDiagonal[it.col()] = true;
+      }
+      else
+        sums[it.col()] += ei_abs(it.value());
+    }
+  for (int j=0; j<std::min(A.rows(),A.cols()); j++)
+    if (!hasDiagonal[j])
+      sums[j] += ei_abs(mu);
+  return A.cols()==0 ? RealScalar(0) : sums.maxCoeff();
+}
+
+/** \internal \returns the trace of a dense matrix. */
+template <typename Derived>
+typename ei_traits<Derived>::Scalar ei_matrix_trace(const MatrixBase<Derived>& A)
+{
+  return A.trace();
+}
+
+/** \internal \returns the trace of a sparse matrix. */
+template <typename Derived>
+typename ei_traits<Derived>::Scalar ei_matrix_trace(const SparseMatrixBase<Derived>& A)
+{
+  typename ei_traits<Derived>::Scalar res(0);
+  for (int j=0; j<A.outerSize(); j++)
+    for (typename Derived::InnerIterator it(A.derived(), j); it; ++it)
+      if (it.row() == it.col())
+        res += it.value();
+  return res;
+}
+
+/** \ingroup MatrixFunctions_Module
+  * \brief Operator interface of a dense or sparse matrix for MatrixExponentialAction.
+  * \tparam MatrixType  type of the matrix, either a dense Matrix or a SparseMatrix.
+  *
+  * The class stores a reference to the matrix, so it should not be
+  * changed (or destroyed) while the operator is used. Matrix-free operators
+  * passed to MatrixExponentialAction should provide the same members.
+  */
+template <typename MatrixType>
+class MatrixExponentialOperator
+{
+  public:
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+    MatrixExponentialOperator(const MatrixType& A) : m_A(A) { ei_assert(A.rows() == A.cols()); }
+
+    /** \returns the size of the (square) operator. */
+    int rows() const { return m_A.rows(); }
+
+    /** \returns the trace of the operator, used to shift it; returning 0 disables the shift. */
+    Scalar trace() const { return ei_matrix_trace(m_A); }
+
+    /** \returns the 1-norm of \f$ A - \mu I \f$, or an upper bound of it. */
+    RealScalar norm1(const Scalar& mu) const { return ei_shifted_l1_norm(m_A, mu); }
+
+    /** Computes \f$ y = A x \f$. */
+    void apply(const VectorType& x, VectorType& y) const { y = m_A * x; }
+
+  protected:
+    const MatrixType& m_A;
+};
+
+/** \ingroup MatrixFunctions_Module
+  * \brief Class for computing the action of the matrix exponential on a vector.
+  * \tparam OperatorType  type of the operator \f$ A \f$, such as MatrixExponentialOperator.
+  *
+  * This computes \f$ \exp(tA) v \f$ without ever forming \f$ \exp(tA) \f$ or any
+  * other dense matrix, using only products of \f$ A \f$ with vectors. This makes it
+  * suited to large sparse or matrix-free operators, as found in exponential time
+  * integrators.
+  *
+  * The operator has to provide the \c Scalar, \c RealScalar and \c VectorType typedefs,
+  * and the \c rows(), \c trace(), \c norm1(mu) and \c apply(x,y) members of
+  * MatrixExponentialOperator.
+  *
+  * The method is the truncated Taylor series with scaling of: Awad H. Al-Mohy and
+  * Nicholas J. Higham, "Computing the action of the matrix exponential, with an
+  * application to exponential integrators," <em>SIAM J. Sci. Comput.</em>,
+  * <b>33</b>:488&ndash;511, 2011. The degree and the number of steps are chosen
+  * from the 1-norm of the shifted operator.
+  */
+template <typename OperatorType>
+class MatrixExponentialAction {
+
+  public:
+
+    typedef typename OperatorType::Scalar Scalar;
+    typedef typename OperatorType::RealScalar RealScalar;
+    typedef typename OperatorType::VectorType VectorType;
+    typedef Matrix<RealScalar,Dynamic,1> TimesType;
+
+    /** \brief Constructor.
+      *
+      * The class stores a reference to \p A, so it should not be
+      * changed (or destroyed) before compute() is called.
+      *
+      * \param[in] A  operator whose exponential is applied.
+      */
+    MatrixExponentialAction(const OperatorType& A)
+      : m_A(A), m_mu(A.trace() / Scalar(RealScalar(A.rows()))), m_products(0)
+    {
+      // the shift only pays off when it decreases the norm
+      m_norm = A.norm1(m_mu);
+      RealScalar norm = A.norm1(Scalar(0));
+      if (norm <= m_norm) {
+        m_mu = Scalar(0);
+        m_norm = norm;
+      }
+    }
+
+    /** \brief Computes \f$ \exp(tA) v \f$.
+      *
+      * \param[in]  v       vector the exponential is applied to.
+      * \param[in]  t       time.
+      * \param[out] result  \f$ \exp(tA) v \f$.
+      */
+    template <typename ResultType>
+    void compute(const VectorType& v, RealScalar t, ResultType& result);
+
+    /** \brief Computes \f$ \exp(t_k A) v \f$ for several time points.
+      *
+      * The time points have to be sorted in increasing order. The k-th column of
+      * \p result is set to \f$ \exp(t_k A) v \f$, each solution being advanced from
+      * the previous one.
+      *
+      * \param[in]  v       vector the exponential is applied to.
+      * \param[in]  times   time points \f$ t_k \f$.
+      * \param[out] result  matrix with a column per time point.
+      */
+    template <typename ResultType>
+    void compute(const VectorType& v, const TimesType& times, ResultType& result);
+
+    /** \returns the number of products with the operator of the last call to compute(). */
+    int products() const { return m_products; }
+
+  private:
+
+    // Prevent copying
+    MatrixExponentialAction(const MatrixExponentialAction&);
+    MatrixExponentialAction& operator=(const MatrixExponentialAction&);
+
+    /** \brief Chooses the degree \p m and the number of steps \p s for time \p t. */
+    void parameters(RealScalar t, int& m, int& s) const;
+
+    /** \brief Overwrites \p b by \f$ \exp(tA) b \f$. */
+    void advance(VectorType& b, RealScalar t);
+
+    const OperatorType& m_A;
+    Scalar m_mu;
+    RealScalar m_norm;
+    VectorType m_tmp, m_F;
+    int m_products;
+};
+
+template <typename OperatorType>
+void MatrixExponentialAction<OperatorType>::parameters(RealScalar t, int& m, int& s) const
+{
+  // largest norm for which the backward error of the Taylor polynomial of degree
+  // m is below the unit roundoff of double, for m = 1,...,30 and then by steps of 5
+  static const double theta[] = {
+    2.29e-16, 2.58e-8, 1.39e-5, 3.40e-4, 2.40e-3, 9.07e-3, 2.38e-2, 5.00e-2, 8.96e-2, 1.44e-1,
+    2.14e-1, 3.00e-1, 4.00e-1, 5.14e-1, 6.41e-1, 7.81e-1, 9.31e-1, 1.09, 1.26, 1.44,
+    1.62, 1.82, 2.01, 2.22, 2.43, 2.64, 2.86, 3.08, 3.31, 3.54,
+    4.7, 6.0, 7.2, 8.5, 9.9 };
+  const RealScalar norm = ei_abs(t) * m_norm;
+  m = 0;
+  s = 1;
+  if (norm == RealScalar(0))
+    return;
+  double best = -1;
+  for (int i=0; i<35; i++) {
+    const int degree = i < 30 ? i+1 : 30 + 5*(i-29);
+    const double steps = std::ceil(double(norm) / theta[i]);
+    if (best < 0 || degree * steps < best) {
+      best = degree * steps;
+      m = degree;
+      s = int(steps);
+    }
+  }
+}
+
+template <typename OperatorType>
+void MatrixExponentialAction<OperatorType>::advance(VectorType& b, RealScalar t)
+{
+  int m, s;
+  parameters(t, m, s);
+  const RealScalar tol = NumTraits<RealScalar>::epsilon();
+  const Scalar eta = ei_exp(t * m_mu / Scalar(RealScalar(s)));
+  m_F = b;
+  for (int i=0; i<s; i++) {
+    RealScalar c1 = b.cwiseAbs().maxCoeff();
+    for (int j=1; j<=m; j++) {
+      m_A.apply(b, m_tmp);
+      ++m_products;
+      if (m_mu != Scalar(0))
+        m_tmp -= m_mu * b;
+      b = (t / RealScalar(s*j)) * m_tmp;
+      const RealScalar c2 = b.cwiseAbs().maxCoeff();
+      m_F += b;
+      if (c1 + c2 <= tol * m_F.cwiseAbs().maxCoeff())
+        break;
+      c1 = c2;
+    }
+    m_F *= eta;
+    b = m_F;
+  }
+}
+
+template <typename OperatorType>
+template <typename ResultType>
+void MatrixExponentialAction<OperatorType>::compute(const VectorType& v, RealScalar t, ResultType& result)
+{
+  ei_assert(v.size() == m_A.rows());
+  m_products = 0;
+  VectorType b = v;
+  advance(b, t);
+  result = b;
+}
+
+template <typename OperatorType>
+template <typename ResultType>
+void MatrixExponentialAction<OperatorType>::compute(const VectorType& v, const TimesType& times, ResultType& result)
+{
+  ei_assert(v.size() == m_A.rows());
+  m_products = 0;
+  result.resize(v.size(), times.size());
+  VectorType b = v;
+  RealScalar previous = 0;
+  for (int k=0; k<times.size(); k++) {
+    ei_assert(k == 0 || times[k] >= times[k-1]);
+    advance(b, times[k] - previous);
+    result.col(k) = b;
+    previous = times[k];
+  }
+}
+
+/** \ingroup MatrixFunctions_Module
+  *
+  * \brief Computes \f$ \exp(tA) v \f$ for a dense or sparse matrix \p A.
+  *
+  * \sa class MatrixExponentialAction
+  */
+template <typename MatrixType, typename VectorType, typename ResultType>
+void matrixExponentialAction(const MatrixType& A, const VectorType& v,
+                             typename NumTraits<typename MatrixType::Scalar>::Real t, ResultType& result)
+{
+  MatrixExponentialOperator<MatrixType> op(A);
+  MatrixExponentialAction<MatrixExponentialOperator<MatrixType> > action(op);
+  action.compute(v, t, result);
+}
+
+/** \ingroup MatrixFunctions_Module
+  *
+  * \brief Computes \f$ \exp(t_k A) v \f$ at the sorted time points \p times
+  * for a dense or sparse matrix \p A, storing a column per time point in \p result.
+  *
+  * \sa class MatrixExponentialAction
+  */
+template <typename MatrixType, typename VectorType, typename ResultType>
+void matrixExponentialAction(const MatrixType& A, const VectorType& v,
+                             const Matrix<typename NumTraits<typename MatrixType::Scalar>::Real,Dynamic,1>& times,
+                             ResultType& result)
+{
+  MatrixExponentialOperator<MatrixType> op(A);
+  MatrixExponentialAction<MatrixExponentialOperator<MatrixType> > action(op);
+  action.compute(v, times, result);
+}
+
+#endif // EIGEN_MATRIX_EXPONENTIAL_ACTION
@@ -29,6 +29,87 @@
 #include "MatrixFunctionAtomic.h"
 
 
+/** \internal \brief Assigns the complex matrix \p res to \p result, taking its real part
+  * if \p result is real. */
+template <typename ResultType, int IsComplex = NumTraits<typename ResultType::Scalar>::IsComplex>
+struct ei_matrix_function_assign_result_impl
+{
+  template <typename ComplexMatrix>
+  static void run(ResultType& result, const ComplexMatrix& res) { result = res.real(); }
+};
+
+template <typename ResultType>
+struct ei_matrix_function_assign_result_impl<ResultType, 1>
+{
+  template <typename ComplexMatrix>
+  static void run(ResultType& result, const ComplexMatrix& res) { result = res; }
+};
+
+template <typename ResultType, typename ComplexMatrix>
+void ei_matrix_function_assign_result(ResultType& result, const ComplexMatrix& res)
+{
+  ei_matrix_function_assign_result_impl<ResultType>::run(result, res);
+}
+
+/** \internal \brief Solves \f$ (A + \beta I) x = b \f$ for the upper triangular block of \p A
+  * starting at \p ia of size \p m, \p b being the column \p col of \p X starting at row \p ix,
+  * which is overwritten by \p x. This is column oriented so that it only accesses
+  * contiguous columns of \p A.
+  */
+template <typename MatrixA, typename MatrixX>
+void ei_matrix_function_shifted_triangular_solve(const MatrixA& A, int ia, typename ei_traits<MatrixA>::Scalar beta,
+                                                  MatrixX& X, int ix, int col, int m)
+{
+  for (int i = m - 1; i >= 0; --i) {
+    X.coeffRef(ix+i, col) /= A.coeff(ia+i, ia+i) + beta;
+    if (i > 0)
+      X.col(col).segment(ix, i) -= X.coeff(ix+i, col) * A.col(ia+i).segment(ia, i);
+  }
+}
+
+/** \internal \brief Solves the triangular Sylvester equation \f$ AX + XB = C \f$.
+  *
+  * \p A is the m-by-m upper triangular block of \p MA starting at (\p ia, \p ia), \p B the
+  * n-by-n upper triangular block of \p MB starting at (\p ib, \p ib), and \p C the m-by-n block
+  * of \p MX starting at (\p ix, \p jx), which is overwritten by the solution \p X. The blocks of
+  * \p MA, \p MB and \p MX may belong to the same matrix as long as they do not overlap.
+  *
+  * The equation is split recursively along the largest dimension,
+  * \f[ \left[ \begin{array}{cc} A_{11} & A_{12} \\ 0 & A_{22} \end{array} \right]
+  *     \left[ \begin{array}{c} X_1 \\ X_2 \end{array} \right]
+  *   + \left[ \begin{array}{c} X_1 \\ X_2 \end{array} \right] B
+  *   = \left[ \begin{array}{c} C_1 \\ C_2 \end{array} \right], \f]
+  * first solving \f$ A_{22} X_2 + X_2 B = C_2 \f$ and then
+  * \f$ A_{11} X_1 + X_1 B = C_1 - A_{12} X_2 \f$, so that most of the work is done by
+  * matrix-matrix products. Small blocks are solved a column at a time.
+  */
+template <typename MatrixA, typename MatrixB, typename MatrixX>
+void ei_matrix_function_solve_triangular_sylvester(const MatrixA& MA, int ia, const MatrixB& MB, int ib,
+                                                   MatrixX& MX, int ix, int jx, int m, int n)
+{
+  static const int BlockSize = 32;
+  if (m == 0 || n == 0)
+    return;
+  if (m <= BlockSize && n <= BlockSize) {
+    for (int j = 0; j < n; ++j) {
+      if (j > 0)
+        MX.col(jx+j).segment(ix, m).noalias() -= MX.block(ix, jx, m, j) * MB.col(ib+j).segment(ib, j);
+      ei_matrix_function_shifted_triangular_solve(MA, ia, MB.coeff(ib+j, ib+j), MX, ix, jx+j, m);
+    }
+  } else if (m >= n) {
+    const int m1 = m / 2, m2 = m - m1;
+    ei_matrix_function_solve_triangular_sylvester(MA, ia+m1, MB, ib, MX, ix+m1, jx, m2, n);
+    MX.block(ix, jx, m1, n).noalias() -= MA.block(ia, ia+m1, m1, m2) * MX.block(ix+m1, jx, m2, n);
+    ei_matrix_function_solve_triangular_sylvester(MA, ia, MB, ib, MX, ix, jx, m1, n);
+  } else {
+    const int n1 = n / 2, n2 = n - n1;
+    ei_matrix_function_solve_triangular_sylvester(MA, ia, MB, ib, MX, ix, jx, m, n1);
+    MX.block(ix, jx+n1, m, n2).noalias() -= MX.block(ix, jx, m, n1) * MB.block(ib, ib+n1, n1, n2);
+    ei_matrix_function_solve_triangular_sylvester(MA, ia, MB, ib+n1, MX, ix, jx+n1, m, n2);
+  }
+}
+
+
 /** \ingroup MatrixFunctions_Module
   * \brief Class for computing matrix exponentials.
   * \tparam MatrixType type of the argument of the matrix function,
@@ -212,7 +293,9 @@ void MatrixFunction<MatrixType,1>::compute(ResultType& result)
   permuteSchur();
   computeBlockAtomic();
   computeOffDiagonal();
-  result = m_U * m_fT * m_U.adjoint();
+  MatrixType tmp;
+  tmp.noalias() = m_fT.template triangularView<Upper>() * m_U.adjoint();
+  result = m_U * tmp;
 }
 
 /** \brief Store the Schur decomposition of #m_A in #m_T and #m_U */
@@ -390,6 +473,9 @@ Block<MatrixType> MatrixFunction<MatrixType,1>::block(const MatrixType& A, int i
   * equals #m_f applied to #m_T) has already been computed and computes
   * the part above the block diagonal. The part below the diagonal is
   * zero, because #m_T is upper triangular.
+  *
+  * The sums over the intermediate blocks of the Parlett recurrence are
+  * done with one matrix product over the contiguous panels of #m_fT and #m_T.
   */
 template <typename MatrixType>
 void MatrixFunction<MatrixType,1>::computeOffDiagonal()
@@ -397,13 +483,16 @@ void MatrixFunction<MatrixType,1>::computeOffDiagonal()
   for (int diagIndex = 1; diagIndex < m_clusterSize.rows(); diagIndex++) {
     for (int blockIndex = 0; blockIndex < m_clusterSize.rows() - diagIndex; blockIndex++) {
       // compute (blockIndex, blockIndex+diagIndex) block
+      const int rowStart = m_blockStart(blockIndex), rows = m_clusterSize(blockIndex);
+      const int colStart = m_blockStart(blockIndex+diagIndex), cols = m_clusterSize(blockIndex+diagIndex);
+      const int midStart = m_blockStart(blockIndex+1), mid = colStart - midStart;
       DynMatrixType A = block(m_T, blockIndex, blockIndex);
       DynMatrixType B = -block(m_T, blockIndex+diagIndex, blockIndex+diagIndex);
       DynMatrixType C = block(m_fT, blockIndex, blockIndex) * block(m_T, blockIndex, blockIndex+diagIndex);
-      C -= block(m_T, blockIndex, blockIndex+diagIndex) * block(m_fT, blockIndex+diagIndex, blockIndex+diagIndex);
-      for (int k = blockIndex + 1; k < blockIndex + diagIndex; k++) {
-	C += block(m_fT, blockIndex, k) * block(m_T, k, blockIndex+diagIndex);
-	C -= block(m_T, blockIndex, k) * block(m_fT, k, blockIndex+diagIndex);
+      C.noalias() -= block(m_T, blockIndex, blockIndex+diagIndex) * block(m_fT, blockIndex+diagIndex, blockIndex+diagIndex);
+      if (mid > 0) {
+	C.noalias() += m_fT.block(rowStart, midStart, rows, mid) * m_T.block(midStart, colStart, mid, cols);
+	C.noalias() -= m_T.block(rowStart, midStart, rows, mid) * m_fT.block(midStart, colStart, mid, cols);
       }
       block(m_fT, blockIndex, blockIndex+diagIndex) = solveTriangularSylvester(A, B, C);
     }
@@ -431,7 +520,8 @@ void MatrixFunction<MatrixType,1>::computeOffDiagonal()
   * It is assumed that A and B are such that the numerator is never
   * zero (otherwise the Sylvester equation does not have a unique
   * solution). In that case, these equations can be evaluated in the
-  * order \f$ i=m,\ldots,1 \f$ and \f$ j=1,\ldots,n \f$.
+  * order \f$ i=m,\ldots,1 \f$ and \f$ j=1,\ldots,n \f$. Large equations are
+  * split in blocks first, see ei_matrix_function_solve_triangular_sylvester().
   */
 template <typename MatrixType>
 typename MatrixFunction<MatrixType,1>::DynMatrixType MatrixFunction<MatrixType,1>::solveTriangularSylvester(
@@ -446,34 +536,8 @@ typename MatrixFunction<MatrixType,1>::DynMatrixType MatrixFunction<MatrixType,1
   ei_assert(C.rows() == A.rows());
   ei_assert(C.cols() == B.rows());
 
-  int m = A.rows();
-  int n = B.rows();
-  DynMatrixType X(m, n);
-
-  for (int i = m - 1; i >= 0; --i) {
-    for (int j = 0; j < n; ++j) {
-
-      // Compute AX = \sum_{k=i+1}^m A_{ik} X_{kj}
-      Scalar AX;
-      if (i == m - 1) {
-	AX = 0; 
-      } else {
-	Matrix<Scalar,1,1> AXmatrix = A.row(i).tail(m-1-i) * X.col(j).tail(m-1-i);
-	AX = AXmatrix(0,0);
-      }
-
-      // Compute XB = \sum_{k=1}^{j-1} X_{ik} B_{kj}
-      Scalar XB;
-      if (j == 0) {
-	XB = 0; 
-      } else {
-	Matrix<Scalar,1,1> XBmatrix = X.row(i).head(j) * B.col(j).head(j);
-	XB = XBmatrix(0,0);
-      }
-
-      X(i,j) = (C(i,j) - AX - XB) / (A(i,i) + B(j,j));
-    }
-  }
+  DynMatrixType X = C;
+  ei_matrix_function_solve_triangular_sylvester(A, 0, B, 0, X, 0, 0, A.rows(), B.rows());
   return X;
 }
 
@@ -80,22 +80,48 @@ class MatrixFunctionAtomic
     RealScalar m_mu;
 };
 
+/** \brief Compute matrix function of atomic matrix
+  *
+  * The Taylor series around the mean of the eigenvalues is evaluated
+  * with the Paterson-Stockmeyer scheme: the terms are summed by chunks of
+  * \c ChunkSize, each chunk being a linear combination of the powers of
+  * the shifted argument up to \c ChunkSize-1, multiplied by a power of
+  * the shifted argument of degree a multiple of \c ChunkSize. This needs
+  * two matrix products per chunk instead of one per term.
+  */
 template <typename MatrixType>
 MatrixType MatrixFunctionAtomic<MatrixType>::compute(const MatrixType& A)
 {
-  // TODO: Use that A is upper triangular
+  static const int ChunkSize = 6;
   m_Arows = A.rows();
   m_avgEival = A.trace() / Scalar(RealScalar(m_Arows));
   m_Ashifted = A - m_avgEival * MatrixType::Identity(m_Arows, m_Arows);
   computeMu();
-  MatrixType F = m_f(m_avgEival, 0) * MatrixType::Identity(m_Arows, m_Arows);
-  MatrixType P = m_Ashifted;
-  MatrixType Fincr;
-  for (int s = 1; s < 1.1 * m_Arows + 10; s++) { // upper limit is fairly arbitrary
-    Fincr = m_f(m_avgEival, s) * P;
+
+  // powers of the shifted argument, which is upper triangular
+  MatrixType powers[ChunkSize+1];
+  powers[0] = MatrixType::Identity(m_Arows, m_Arows);
+  powers[1] = m_Ashifted;
+  for (int i = 2; i <= ChunkSize; i++)
+    powers[i].noalias() = powers[i-1].template triangularView<Upper>() * m_Ashifted;
+
+  MatrixType F = MatrixType::Zero(m_Arows, m_Arows);
+  MatrixType P = powers[0]; // m_Ashifted^s / s! where s is the degree of the first term of the chunk
+  MatrixType S, Fincr, tmp;
+  for (int s = 0; s < 1.1 * m_Arows + 10; s += ChunkSize) { // upper limit is fairly arbitrary
+    // S = sum_i f^(s+i) s! / (s+i)! m_Ashifted^i
+    RealScalar factor = 1;
+    S = m_f(m_avgEival, s) * powers[0];
+    for (int i = 1; i < ChunkSize; i++) {
+      factor /= RealScalar(s + i);
+      S += (Scalar(factor) * m_f(m_avgEival, s + i)) * powers[i];
+    }
+    Fincr.noalias() = P.template triangularView<Upper>() * S;
     F += Fincr;
-    P = Scalar(RealScalar(1.0/(s + 1))) * P * m_Ashifted;
-    if (taylorConverged(s, F, Fincr, P)) {
+    factor /= RealScalar(s + ChunkSize);
+    tmp.noalias() = P.template triangularView<Upper>() * powers[ChunkSize];
+    P = Scalar(factor) * tmp;
+    if (taylorConverged(s + ChunkSize - 1, F, Fincr, P)) {
       return F;
     }
   }
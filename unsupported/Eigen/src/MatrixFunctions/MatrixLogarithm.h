@@ -0,0 +1,230 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_MATRIX_LOGARITHM
+#define EIGEN_MATRIX_LOGARITHM
+
+/** \internal \brief Computes the nodes and weights of the Gauss-Legendre quadrature
+  * of degree \p m on [0,1], by Newton's method on the Legendre polynomial.
+  */
+template <typename RealScalar>
+void ei_gauss_legendre_nodes(int m, Matrix<RealScalar,Dynamic,1>& nodes, Matrix<RealScalar,Dynamic,1>& weights)
+{
+  nodes.resize(m);
+  weights.resize(m);
+  for (int i = 0; i < m; ++i) {
+    double x = std::cos(3.14159265358979323846 * (i + 0.75) / (m + 0.5)), dp = 1;
+    for (int iter = 0; iter < 100; ++iter) {
+      double p0 = 1, p1 = x;
+      for (int k = 2; k <= m; ++k) {
+        const double p2 = ((2*k-1) * x * p1 - (k-1) * p0) / k;
+        p0 = p1;
+        p1 = p2;
+      }
+      dp = m * (x * p1 - p0) / (x * x - 1);
+      const double dx = p1 / dp;
+      x -= dx;
+      if (std::abs(dx) < 1e-16)
+        break;
+    }
+    nodes[i] = RealScalar((x + 1) / 2);
+    weights[i] = RealScalar(1 / ((1 - x * x) * dp * dp));
+  }
+}
+
+/** \internal \brief Computes the principal logarithm of the upper triangular matrix \p T.
+  *
+  * This is the inverse scaling and squaring method: square roots of \p T are taken with
+  * ei_matrix_sqrt_triangular() until it is close enough to the identity, then the logarithm
+  * is approximated by the diagonal Pad&eacute; approximant
+  * \f$ r_m(X) = \sum_j w_j X (I + x_j X)^{-1} \f$ at \f$ X = T^{1/2^k} - I \f$, written in
+  * partial fractions with the Gauss-Legendre nodes \f$ x_j \f$ and weights \f$ w_j \f$,
+  * so that it only needs triangular solves. The diagonal is then recomputed from the
+  * diagonal of \p T.
+  *
+  * See: Nicholas J. Higham, Functions of Matrices: Theory and Computation, SIAM, 2008,
+  * Section 11.5.
+  */
+template <typename MatrixType>
+void ei_matrix_log_triangular(const MatrixType& T, MatrixType& result)
+{
+  typedef typename ei_traits<MatrixType>::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  // largest norm of X for which the error of r_m(X) is below the unit roundoff of double
+  static const double theta[] = { 1.10e-5, 1.82e-3, 1.62e-2, 5.39e-2, 1.14e-1, 1.87e-1, 2.64e-1 };
+  static const int maxDegree = 7;
+
+  const int n = T.rows();
+  const MatrixType Id = MatrixType::Identity(n, n);
+  MatrixType X = T, sqrtX;
+  int numberOfSquareRoots = 0, degree = maxDegree;
+  while (numberOfSquareRoots < 64) {
+    const RealScalar normTminusI = (X - Id).cwiseAbs().colwise().sum().maxCoeff();
+    if (normTminusI <= theta[maxDegree-1]) {
+      degree = 1;
+      while (normTminusI > theta[degree-1])
+        ++degree;
+      // one more square root about halves the norm, which pays off if the degree decreases by more than one
+      int halfDegree = 1;
+      while (normTminusI / 2 > theta[halfDegree-1])
+        ++halfDegree;
+      if (degree - halfDegree <= 1)
+        break;
+    }
+    ei_matrix_sqrt_triangular(X, sqrtX);
+    X.swap(sqrtX);
+    ++numberOfSquareRoots;
+  }
+  X -= Id;
+
+  RealVectorType nodes, weights;
+  ei_gauss_legendre_nodes(degree, nodes, weights);
+  result.setZero(n, n);
+  MatrixType denominator;
+  for (int j = 0; j < degree; ++j) {
+    denominator = Id + Scalar(nodes[j]) * X;
+    result += Scalar(weights[j]) * denominator.template triangularView<Upper>().solve(X);
+  }
+  result *= Scalar(RealScalar(std::pow(2.0, numberOfSquareRoots)));
+  for (int i = 0; i < n; ++i)
+    result.coeffRef(i, i) = ei_log(T.coeff(i, i));
+}
+
+/** \ingroup MatrixFunctions_Module
+  * \brief Class for computing matrix logarithms.
+  * \tparam MatrixType type of the argument of the matrix logarithm,
+  * expected to be an instantiation of the Matrix class template.
+  *
+  * The principal logarithm is computed with the Schur method: the argument is
+  * reduced to upper triangular form by ComplexSchur and the logarithm of the
+  * triangular factor is computed by ei_matrix_log_triangular(). Real matrices go
+  * through the complex Schur form and the real part of the result is returned,
+  * which is the principal logarithm if the matrix has no eigenvalue on the closed
+  * negative real axis.
+  */
+template <typename MatrixType>
+class MatrixLogarithm
+{
+  private:
+
+    typedef ei_traits<MatrixType> Traits;
+    typedef typename Traits::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef std::complex<RealScalar> ComplexScalar;
+    typedef Matrix<ComplexScalar, Traits::RowsAtCompileTime, Traits::ColsAtCompileTime, MatrixType::Options,
+                   Traits::MaxRowsAtCompileTime, Traits::MaxColsAtCompileTime> ComplexMatrix;
+
+  public:
+
+    /** \brief Constructor.
+      *
+      * \param[in]  A  matrix whose logarithm is to be computed.
+      *
+      * The class stores a reference to \p A, so it should not be
+      * changed (or destroyed) before compute() is called.
+      */
+    MatrixLogarithm(const MatrixType& A) : m_A(A) { ei_assert(A.rows() == A.cols()); }
+
+    /** \brief Compute the matrix logarithm.
+      *
+      * \param[out] result  logarithm of \p A, as specified in the constructor.
+      */
+    template <typename ResultType>
+    void compute(ResultType &result)
+    {
+      const ComplexSchur<ComplexMatrix> schurOfA(m_A.template cast<ComplexScalar>());
+      ComplexMatrix logT, tmp;
+      ei_matrix_log_triangular(schurOfA.matrixT(), logT);
+      tmp.noalias() = logT.template triangularView<Upper>() * schurOfA.matrixU().adjoint();
+      ComplexMatrix res = schurOfA.matrixU() * tmp;
+      ei_matrix_function_assign_result(result, res);
+    }
+
+  private:
+
+    // Prevent copying
+    MatrixLogarithm(const MatrixLogarithm&);
+    MatrixLogarithm& operator=(const MatrixLogarithm&);
+
+    const MatrixType& m_A; /**< \brief Reference to argument of matrix logarithm. */
+};
+
+/** \ingroup MatrixFunctions_Module
+  *
+  * \brief Proxy for the matrix logarithm of some matrix (expression).
+  *
+  * \tparam Derived  Type of the argument to the matrix logarithm.
+  *
+  * This class holds the argument to the matrix logarithm until it
+  * is assigned or evaluated for some other reason (so the argument
+  * should not be changed in the meantime). It is the return type of
+  * MatrixBase::log() and most of the time this is the only way it is
+  * used.
+  */
+template<typename Derived> class MatrixLogarithmReturnValue
+: public ReturnByValue<MatrixLogarithmReturnValue<Derived> >
+{
+  public:
+
+    /** \brief Constructor.
+      *
+      * \param[in] src %Matrix (expression) forming the argument of the
+      * matrix logarithm.
+      */
+    MatrixLogarithmReturnValue(const Derived& src) : m_src(src) { }
+
+    /** \brief Compute the matrix logarithm.
+      *
+      * \param[out] result the matrix logarithm of \p src in the
+      * constructor.
+      */
+    template <typename ResultType>
+    inline void evalTo(ResultType& result) const
+    {
+      const typename ei_eval<Derived>::type srcEvaluated = m_src.eval();
+      MatrixLogarithm<typename Derived::PlainObject> ml(srcEvaluated);
+      ml.compute(result);
+    }
+
+    int rows() const { return m_src.rows(); }
+    int cols() const { return m_src.cols(); }
+
+  protected:
+    const Derived& m_src;
+};
+
+template<typename Derived>
+struct ei_traits<MatrixLogarithmReturnValue<Derived> >
+{
+  typedef typename Derived::PlainObject ReturnType;
+};
+
+template <typename Derived>
+const MatrixLogarithmReturnValue<Derived> MatrixBase<Derived>::log() const
+{
+  ei_assert(rows() == cols());
+  return MatrixLogarithmReturnValue<Derived>(derived());
+}
+
+#endif // EIGEN_MATRIX_LOGARITHM
@@ -0,0 +1,183 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_MATRIX_SQUARE_ROOT
+#define EIGEN_MATRIX_SQUARE_ROOT
+
+/** \internal \brief Computes the square root of the upper triangular block of \p T
+  * starting at (\p i0, \p i0) of size \p n, and stores it in the same block of \p R.
+  *
+  * The block is split in two, the square roots \f$ R_{11} \f$ and \f$ R_{22} \f$ of the
+  * diagonal blocks are computed recursively and the off-diagonal block is the solution of
+  * the Sylvester equation \f$ R_{11} R_{12} + R_{12} R_{22} = T_{12} \f$.
+  * Small blocks are computed a column at a time, column \f$ j \f$ of \f$ R \f$ above the
+  * diagonal being the solution of an upper triangular system with matrix
+  * \f$ R_{0:j-1,0:j-1} + R_{jj} I \f$.
+  */
+template <typename MatrixType>
+void ei_matrix_sqrt_triangular(const MatrixType& T, MatrixType& R, int i0, int n)
+{
+  static const int BlockSize = 32;
+  if (n <= BlockSize) {
+    for (int j = 0; j < n; ++j) {
+      R.coeffRef(i0+j, i0+j) = ei_sqrt(T.coeff(i0+j, i0+j));
+      if (j > 0) {
+        R.col(i0+j).segment(i0, j) = T.col(i0+j).segment(i0, j);
+        ei_matrix_function_shifted_triangular_solve(R, i0, R.coeff(i0+j, i0+j), R, i0, i0+j, j);
+      }
+    }
+  } else {
+    const int n1 = n / 2, n2 = n - n1;
+    ei_matrix_sqrt_triangular(T, R, i0, n1);
+    ei_matrix_sqrt_triangular(T, R, i0+n1, n2);
+    R.block(i0, i0+n1, n1, n2) = T.block(i0, i0+n1, n1, n2);
+    ei_matrix_function_solve_triangular_sylvester(R, i0, R, i0+n1, R, i0, i0+n1, n1, n2);
+  }
+}
+
+/** \internal \brief Computes the principal square root of the upper triangular matrix \p T. */
+template <typename MatrixType>
+void ei_matrix_sqrt_triangular(const MatrixType& T, MatrixType& R)
+{
+  ei_assert(T.rows() == T.cols());
+  R.resize(T.rows(), T.cols());
+  R.setZero();
+  ei_matrix_sqrt_triangular(T, R, 0, T.rows());
+}
+
+/** \ingroup MatrixFunctions_Module
+  * \brief Class for computing matrix square roots.
+  * \tparam MatrixType type of the argument of the matrix square root,
+  * expected to be an instantiation of the Matrix class template.
+  *
+  * The principal square root is computed with the Schur method: the argument is
+  * reduced to upper triangular form by ComplexSchur, and the square root of the
+  * triangular factor is computed blockwise by ei_matrix_sqrt_triangular(). Real
+  * matrices go through the complex Schur form and the real part of the result is
+  * returned, which is the principal square root if the matrix has no eigenvalue
+  * on the closed negative real axis.
+  */
+template <typename MatrixType>
+class MatrixSquareRoot
+{
+  private:
+
+    typedef ei_traits<MatrixType> Traits;
+    typedef typename Traits::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef std::complex<RealScalar> ComplexScalar;
+    typedef Matrix<ComplexScalar, Traits::RowsAtCompileTime, Traits::ColsAtCompileTime, MatrixType::Options,
+                   Traits::MaxRowsAtCompileTime, Traits::MaxColsAtCompileTime> ComplexMatrix;
+
+  public:
+
+    /** \brief Constructor.
+      *
+      * \param[in]  A  matrix whose square root is to be computed.
+      *
+      * The class stores a reference to \p A, so it should not be
+      * changed (or destroyed) before compute() is called.
+      */
+    MatrixSquareRoot(const MatrixType& A) : m_A(A) { ei_assert(A.rows() == A.cols()); }
+
+    /** \brief Compute the matrix square root.
+      *
+      * \param[out] result  square root of \p A, as specified in the constructor.
+      */
+    template <typename ResultType>
+    void compute(ResultType &result)
+    {
+      const ComplexSchur<ComplexMatrix> schurOfA(m_A.template cast<ComplexScalar>());
+      ComplexMatrix sqrtT, tmp;
+      ei_matrix_sqrt_triangular(schurOfA.matrixT(), sqrtT);
+      tmp.noalias() = sqrtT.template triangularView<Upper>() * schurOfA.matrixU().adjoint();
+      ComplexMatrix res = schurOfA.matrixU() * tmp;
+      ei_matrix_function_assign_result(result, res);
+    }
+
+  private:
+
+    // Prevent copying
+    MatrixSquareRoot(const MatrixSquareRoot&);
+    MatrixSquareRoot& operator=(const MatrixSquareRoot&);
+
+    const MatrixType& m_A; /**< \brief Reference to argument of matrix square root. */
+};
+
+/** \ingroup MatrixFunctions_Module
+  *
+  * \brief Proxy for the matrix square root of some matrix (expression).
+  *
+  * \tparam Derived  Type of the argument to the matrix square root.
+  *
+  * This class holds the argument to the matrix square root until it
+  * is assigned or evaluated for some other reason (so the argument
+  * should not be changed in the meantime). It is the return type of
+  * MatrixBase::sqrt() and most of the time this is the only way it is
+  * used.
+  */
+template<typename Derived> class MatrixSquareRootReturnValue
+: public ReturnByValue<MatrixSquareRootReturnValue<Derived> >
+{
+  public:
+
+    /** \brief Constructor.
+      *
+      * \param[in] src %Matrix (expression) forming the argument of the
+      * matrix square root.
+      */
+    MatrixSquareRootReturnValue(const Derived& src) : m_src(src) { }
+
+    /** \brief Compute the matrix square root.
+      *
+      * \param[out] result the matrix square root of \p src in the
+      * constructor.
+      */
+    template <typename ResultType>
+    inline void evalTo(ResultType& result) const
+    {
+      const typename ei_eval<Derived>::type srcEvaluated = m_src.eval();
+      MatrixSquareRoot<typename Derived::PlainObject> me(srcEvaluated);
+      me.compute(result);
+    }
+
+    int rows() const { return m_src.rows(); }
+    int cols() const { return m_src.cols(); }
+
+  protected:
+    const Derived& m_src;
+};
+
+template<typename Derived>
+struct ei_traits<MatrixSquareRootReturnValue<Derived> >
+{
+  typedef typename Derived::PlainObject ReturnType;
+};
+
+template <typename Derived>
+const MatrixSquareRootReturnValue<Derived> MatrixBase<Derived>::sqrt() const
+{
+  ei_assert(rows() == cols());
+  return MatrixSquareRootReturnValue<Derived>(derived());
+}
+
+#endif // EIGEN_MATRIX_SQUARE_ROOT
@@ -0,0 +1,314 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_BATCHHYBRIDNONLINEARSOLVER_H
+#define EIGEN_BATCHHYBRIDNONLINEARSOLVER_H
+
+/**
+  * \ingroup NonLinearOptimization_Module
+  * \brief Finds a zero of many independent small systems of n nonlinear
+  * functions in n variables, using the Powell hybrid method ("dogleg").
+  *
+  * This follows HybridNonLinearSolver::solve(), with the same step bound updates,
+  * progress monitors and return codes, but the problems are solved independently,
+  * in parallel when OpenMP is enabled, using workspace whose sizes are given by
+  * the functor at compile time.
+  *
+  * The Broyden rank-one update of the jacobian between two evaluations is applied
+  * to the jacobian itself, which is then refactorized. For the small fixed sizes this
+  * class is meant for, this is cheaper than updating the dynamic sized factors as
+  * HybridNonLinearSolver does.
+  *
+  * The functor interface is the one of BatchLevenbergMarquardt, the jacobian being square.
+  */
+template<typename FunctorType, typename Scalar=double>
+class BatchHybridNonLinearSolver
+{
+public:
+    BatchHybridNonLinearSolver(const FunctorType &_functor)
+        : functor(_functor) {}
+
+    struct Parameters {
+        Parameters()
+            : factor(Scalar(100.))
+            , maxfev(1000)
+            , xtol(ei_sqrt(NumTraits<Scalar>::epsilon()))
+            , parallel(true) {}
+        Scalar factor;
+        int maxfev;   // maximum number of function evaluation per problem
+        Scalar xtol;
+        bool parallel; // solve the problems in parallel (requires OpenMP)
+    };
+
+    enum {
+        InputsAtCompileTime = FunctorType::InputsAtCompileTime
+    };
+    typedef typename FunctorType::InputType FVectorType;
+    typedef typename FunctorType::JacobianType JacobianType;
+    typedef Matrix< Scalar, InputsAtCompileTime, Dynamic > BatchType;
+
+    /** Solves all the problems, the initial guess and the solution of the k-th problem being
+      * the k-th column of \a x. The results are stored in status, nfev, njev, iter and fnorm. */
+    void solve(BatchType &x);
+
+    /** Solves the single problem \a k. */
+    HybridNonLinearSolverSpace::Status solve(int k, FVectorType &x);
+
+    void resetParameters(void) { parameters = Parameters(); }
+
+    Parameters parameters;
+    std::vector<HybridNonLinearSolverSpace::Status> status;
+    VectorXi nfev;
+    VectorXi njev;
+    VectorXi iter;
+    Matrix< Scalar, Dynamic, 1 > fnorm;
+
+private:
+    // workspace of a single problem, allocated once per thread
+    struct Workspace {
+        Workspace(int n) : fvec(n), qtf(n), diag(n), wa1(n), wa2(n), wa3(n), wa4(n), fjac(n,n), qr(n,n) {}
+        FVectorType fvec, qtf, diag, wa1, wa2, wa3, wa4;
+        JacobianType fjac;
+        HouseholderQR<JacobianType> qr;
+        int nfev, njev, iter;
+        Scalar fnorm;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+    HybridNonLinearSolverSpace::Status solve(int k, FVectorType &x, Workspace &w) const;
+
+    const FunctorType &functor;
+};
+
+template<typename FunctorType, typename Scalar>
+void BatchHybridNonLinearSolver<FunctorType,Scalar>::solve(BatchType &x)
+{
+    const int count = x.cols();
+    const int n = x.rows();
+    status.assign(count, HybridNonLinearSolverSpace::ImproperInputParameters);
+    nfev.setZero(count);
+    njev.setZero(count);
+    iter.setZero(count);
+    fnorm.setZero(count);
+
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel if(parameters.parallel && count>1)
+#endif
+    {
+        Workspace w(n);
+        FVectorType xk(n);
+#ifdef EIGEN_HAS_OPENMP
+        #pragma omp for schedule(dynamic,16)
+#endif
+        for (int k = 0; k < count; ++k) {
+            xk = x.col(k);
+            status[k] = solve(k, xk, w);
+            x.col(k) = xk;
+            nfev[k] = w.nfev;
+            njev[k] = w.njev;
+            iter[k] = w.iter;
+            fnorm[k] = w.fnorm;
+        }
+    }
+}
+
+template<typename FunctorType, typename Scalar>
+HybridNonLinearSolverSpace::Status
+BatchHybridNonLinearSolver<FunctorType,Scalar>::solve(int k, FVectorType &x)
+{
+    Workspace w(x.size());
+    HybridNonLinearSolverSpace::Status res = solve(k, x, w);
+    status.assign(1, res);
+    nfev.setConstant(1, w.nfev);
+    njev.setConstant(1, w.njev);
+    iter.setConstant(1, w.iter);
+    fnorm.setConstant(1, w.fnorm);
+    return res;
+}
+
+template<typename FunctorType, typename Scalar>
+HybridNonLinearSolverSpace::Status
+BatchHybridNonLinearSolver<FunctorType,Scalar>::solve(int k, FVectorType &x, Workspace &w) const
+{
+    const int n = x.size();
+
+    w.nfev = 0;
+    w.njev = 0;
+    w.iter = 0;
+    w.fnorm = 0.;
+
+    /*     check the input parameters for errors. */
+    if (n <= 0 || functor.values() != n || parameters.xtol < 0. || parameters.maxfev <= 0 || parameters.factor <= 0. )
+        return HybridNonLinearSolverSpace::ImproperInputParameters;
+
+    /*     evaluate the function at the starting point */
+    /*     and calculate its norm. */
+    w.nfev = 1;
+    if ( functor(k, x, w.fvec) < 0)
+        return HybridNonLinearSolverSpace::UserAksed;
+    w.fnorm = w.fvec.stableNorm();
+
+    /*     initialize iteration counter and monitors. */
+    w.iter = 1;
+    int ncsuc = 0, ncfail = 0, nslow1 = 0, nslow2 = 0;
+    Scalar delta = 0., xnorm = 0., pnorm, fnorm1, actred, prered, ratio, temp;
+
+    while (true) {
+        bool jeval = true;
+
+        /* calculate the jacobian matrix. */
+        if ( functor.df(k, x, w.fjac) < 0)
+            return HybridNonLinearSolverSpace::UserAksed;
+        ++w.njev;
+
+        w.wa2 = w.fjac.colwise().blueNorm();
+
+        /* on the first iteration, scale according to the norms of the columns */
+        /* of the initial jacobian, calculate the norm of the scaled x and */
+        /* initialize the step bound delta. */
+        if (w.iter == 1) {
+            for (int j = 0; j < n; ++j)
+                w.diag[j] = (w.wa2[j]==0.) ? 1. : w.wa2[j];
+            xnorm = w.diag.cwiseProduct(x).stableNorm();
+            delta = parameters.factor * xnorm;
+            if (delta == 0.)
+                delta = parameters.factor;
+        }
+
+        /* rescale if necessary. */
+        w.diag = w.diag.cwiseMax(w.wa2);
+
+        while (true) {
+            /* compute the qr factorization of the jacobian, */
+            /* and form (q transpose)*fvec. */
+            w.qr.compute(w.fjac);
+            w.qtf = w.fvec;
+            w.qtf.applyOnTheLeft(w.qr.householderQ().adjoint());
+
+            /* determine the direction p. */
+            ei_dogleg<Scalar>(w.qr.matrixQR(), w.diag, w.qtf, delta, w.wa1);
+
+            /* store the direction p and x + p. calculate the norm of p. */
+            w.wa1 = -w.wa1;
+            w.wa2 = x + w.wa1;
+            pnorm = w.diag.cwiseProduct(w.wa1).stableNorm();
+
+            /* on the first iteration, adjust the initial step bound. */
+            if (w.iter == 1)
+                delta = std::min(delta,pnorm);
+
+            /* evaluate the function at x + p and calculate its norm. */
+            if ( functor(k, w.wa2, w.wa4) < 0)
+                return HybridNonLinearSolverSpace::UserAksed;
+            ++w.nfev;
+            fnorm1 = w.wa4.stableNorm();
+
+            /* compute the scaled actual reduction. */
+            actred = -1.;
+            if (fnorm1 < w.fnorm) /* Computing 2nd power */
+                actred = 1. - ei_abs2(fnorm1 / w.fnorm);
+
+            /* compute the scaled predicted reduction, wa3 being fvec + J p. */
+            w.wa3.noalias() = w.fjac * w.wa1;
+            w.wa3 += w.fvec;
+            temp = w.wa3.stableNorm();
+            prered = 0.;
+            if (temp < w.fnorm) /* Computing 2nd power */
+                prered = 1. - ei_abs2(temp / w.fnorm);
+
+            /* compute the ratio of the actual to the predicted reduction. */
+            ratio = 0.;
+            if (prered > 0.)
+                ratio = actred / prered;
+
+            /* update the step bound. */
+            if (ratio < Scalar(.1)) {
+                ncsuc = 0;
+                ++ncfail;
+                delta = Scalar(.5) * delta;
+            } else {
+                ncfail = 0;
+                ++ncsuc;
+                if (ratio >= Scalar(.5) || ncsuc > 1)
+                    delta = std::max(delta, pnorm / Scalar(.5));
+                if (ei_abs(ratio - 1.) <= Scalar(.1)) {
+                    delta = pnorm / Scalar(.5);
+                }
+            }
+
+            /* keep J p for the broyden update. */
+            w.wa3 -= w.fvec;
+
+            /* test for successful iteration. */
+            if (ratio >= Scalar(1e-4)) {
+                /* successful iteration. update x, fvec, and their norms. */
+                x = w.wa2;
+                w.fvec.swap(w.wa4);
+                xnorm = w.diag.cwiseProduct(x).stableNorm();
+                w.fnorm = fnorm1;
+                ++w.iter;
+                w.wa4 = w.fvec - w.wa4;
+            }
+            else
+                w.wa4 -= w.fvec;
+            /* wa4 now holds f(x+p) - f(x). */
+
+            /* determine the progress of the iteration. */
+            ++nslow1;
+            if (actred >= Scalar(.001))
+                nslow1 = 0;
+            if (jeval)
+                ++nslow2;
+            if (actred >= Scalar(.1))
+                nslow2 = 0;
+
+            /* test for convergence. */
+            if (delta <= parameters.xtol * xnorm || w.fnorm == 0.)
+                return HybridNonLinearSolverSpace::RelativeErrorTooSmall;
+
+            /* tests for termination and stringent tolerances. */
+            if (w.nfev >= parameters.maxfev)
+                return HybridNonLinearSolverSpace::TooManyFunctionEvaluation;
+            if (Scalar(.1) * std::max(Scalar(.1) * delta, pnorm) <= NumTraits<Scalar>::epsilon() * xnorm)
+                return HybridNonLinearSolverSpace::TolTooSmall;
+            if (nslow2 == 5)
+                return HybridNonLinearSolverSpace::NotMakingProgressJacobian;
+            if (nslow1 == 10)
+                return HybridNonLinearSolverSpace::NotMakingProgressIterations;
+
+            /* criterion for recalculating jacobian. */
+            if (ncfail == 2)
+                break; // leave inner loop and go for the next outer loop iteration
+
+            /* broyden rank one modification of the jacobian: */
+            /* J += (f(x+p) - f(x) - J p) (D^2 p)^T / |D p|^2 */
+            w.wa4 -= w.wa3;
+            w.wa1 = w.diag.cwiseProduct( w.diag.cwiseProduct(w.wa1)/pnorm );
+            w.fjac.noalias() += (w.wa4/pnorm) * w.wa1.transpose();
+
+            jeval = false;
+        }
+    }
+}
+
+//vim: ai ts=4 sts=4 et sw=4
+#endif // EIGEN_BATCHHYBRIDNONLINEARSOLVER_H
@@ -0,0 +1,237 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_BATCHLEVENBERGMARQUARDT_H
+#define EIGEN_BATCHLEVENBERGMARQUARDT_H
+
+/**
+  * \ingroup NonLinearOptimization_Module
+  * \brief Solves many independent small non linear least squares problems of
+  * the same shape, using the Levenberg Marquardt algorithm.
+  *
+  * The problems are solved independently, in parallel when OpenMP is enabled.
+  * All the workspace has the sizes given by the functor at compile time, so
+  * that when those are fixed, solving a problem does not allocate any memory.
+  * Each step solves the damped normal equations
+  * \f[ (J^T J + \lambda D^2) p = -J^T f \f]
+  * with a Cholesky factorization, \f$ \lambda \f$ being updated following Nielsen's
+  * strategy, as in SparseLevenbergMarquardt.
+  *
+  * The functor must define the \c InputType, \c ValueType and \c JacobianType typedefs,
+  * \c inputs(), \c values(), and evaluate the problem \a k through
+  * <tt>int operator()(int k, const InputType& x, ValueType& fvec) const</tt> and
+  * <tt>int df(int k, const InputType& x, JacobianType& fjac) const</tt>.
+  * Both are called concurrently for different problems when the solver is parallel.
+  * Like for LevenbergMarquardt, a negative return value stops the minimization of
+  * the problem.
+  */
+template<typename FunctorType, typename Scalar=double>
+class BatchLevenbergMarquardt
+{
+public:
+    BatchLevenbergMarquardt(const FunctorType &_functor)
+        : functor(_functor) {}
+
+    struct Parameters {
+        Parameters()
+            : tau(Scalar(1e-3))
+            , maxfev(400)
+            , ftol(ei_sqrt(NumTraits<Scalar>::epsilon()))
+            , xtol(ei_sqrt(NumTraits<Scalar>::epsilon()))
+            , gtol(Scalar(0.))
+            , parallel(true) {}
+        Scalar tau;       // initial damping, relative to the largest diagonal entry of J^T J
+        int maxfev;       // maximum number of function evaluation per problem
+        Scalar ftol;
+        Scalar xtol;
+        Scalar gtol;
+        bool parallel;    // solve the problems in parallel (requires OpenMP)
+    };
+
+    enum {
+        InputsAtCompileTime = FunctorType::InputsAtCompileTime,
+        ValuesAtCompileTime = FunctorType::ValuesAtCompileTime
+    };
+    typedef typename FunctorType::InputType FVectorType;
+    typedef typename FunctorType::ValueType ValueType;
+    typedef typename FunctorType::JacobianType JacobianType;
+    typedef Matrix< Scalar, InputsAtCompileTime, Dynamic > BatchType;
+
+    /** Minimizes all the problems, the initial guess and the solution of the k-th problem being
+      * the k-th column of \a x. The results are stored in status, nfev, njev, iter and fnorm. */
+    void minimize(BatchType &x);
+
+    /** Minimizes the single problem \a k. */
+    LevenbergMarquardtSpace::Status minimize(int k, FVectorType &x);
+
+    void resetParameters(void) { parameters = Parameters(); }
+
+    Parameters parameters;
+    std::vector<LevenbergMarquardtSpace::Status> status;
+    VectorXi nfev;
+    VectorXi njev;
+    VectorXi iter;
+    Matrix< Scalar, Dynamic, 1 > fnorm;
+
+private:
+    typedef Matrix< Scalar, InputsAtCompileTime, InputsAtCompileTime > NormalType;
+
+    // workspace of a single problem, allocated once per thread
+    struct Workspace {
+        Workspace(int n, int m) : fvec(m), wa4(m), wa3(m), fjac(m,n), wa1(n), wa2(n), grad(n), colnorms(n), diag(n), jtj(n,n), damped(n,n) {}
+        ValueType fvec, wa4, wa3;
+        JacobianType fjac;
+        FVectorType wa1, wa2, grad, colnorms, diag;
+        NormalType jtj, damped;   // damped holds the Cholesky factor of the damped normal matrix
+        int nfev, njev, iter;
+        Scalar fnorm;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+    // the damped step solver and the function evaluation of problem k seen by ei_lmnielsen
+    struct NielsenStep {
+        typedef LLT_Traits<NormalType,Lower> Traits;
+        NielsenStep(const BatchLevenbergMarquardt &_lm, int _k, Workspace &_w) : lm(_lm), k(_k), w(_w) {}
+        bool solve(Scalar lambda, FVectorType &p)
+        {
+            w.damped = w.jtj;
+            w.damped.diagonal() += lambda * w.diag.cwiseAbs2();
+            // the factorization fails when rounding errors make the damped matrix indefinite
+            if (!Traits::inplace_decomposition(w.damped))
+                return false;
+            p = -w.grad;
+            Traits::getL(w.damped).solveInPlace(p);
+            Traits::getU(w.damped).solveInPlace(p);
+            const Scalar p2 = p.squaredNorm();
+            return p2 == p2 && p2 <= NumTraits<Scalar>::highest();
+        }
+        int evaluate(const FVectorType &x, ValueType &v) { return lm.functor(k, x, v); }
+        void jacobianProduct(const FVectorType &p, ValueType &jp) { jp.noalias() = w.fjac * p; }
+        const BatchLevenbergMarquardt &lm;
+        int k;
+        Workspace &w;
+    };
+
+    LevenbergMarquardtSpace::Status solve(int k, FVectorType &x, Workspace &w) const;
+
+    const FunctorType &functor;
+};
+
+template<typename FunctorType, typename Scalar>
+void BatchLevenbergMarquardt<FunctorType,Scalar>::minimize(BatchType &x)
+{
+    const int count = x.cols();
+    const int n = x.rows();
+    const int m = functor.values();
+    status.assign(count, LevenbergMarquardtSpace::NotStarted);
+    nfev.setZero(count);
+    njev.setZero(count);
+    iter.setZero(count);
+    fnorm.setZero(count);
+
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel if(parameters.parallel && count>1)
+#endif
+    {
+        Workspace w(n, m);
+        FVectorType xk(n);
+#ifdef EIGEN_HAS_OPENMP
+        #pragma omp for schedule(dynamic,16)
+#endif
+        for (int k = 0; k < count; ++k) {
+            xk = x.col(k);
+            status[k] = solve(k, xk, w);
+            x.col(k) = xk;
+            nfev[k] = w.nfev;
+            njev[k] = w.njev;
+            iter[k] = w.iter;
+            fnorm[k] = w.fnorm;
+        }
+    }
+}
+
+template<typename FunctorType, typename Scalar>
+LevenbergMarquardtSpace::Status
+BatchLevenbergMarquardt<FunctorType,Scalar>::minimize(int k, FVectorType &x)
+{
+    Workspace w(x.size(), functor.values());
+    LevenbergMarquardtSpace::Status res = solve(k, x, w);
+    status.assign(1, res);
+    nfev.setConstant(1, w.nfev);
+    njev.setConstant(1, w.njev);
+    iter.setConstant(1, w.iter);
+    fnorm.setConstant(1, w.fnorm);
+    return res;
+}
+
+template<typename FunctorType, typename Scalar>
+LevenbergMarquardtSpace::Status
+BatchLevenbergMarquardt<FunctorType,Scalar>::solve(int k, FVectorType &x, Workspace &w) const
+{
+    const int n = x.size();
+    const int m = functor.values();
+
+    w.nfev = 0;
+    w.njev = 0;
+    w.iter = 0;
+    w.fnorm = 0.;
+
+    /*     check the input parameters for errors. */
+    if (n <= 0 || m < n || parameters.ftol < 0. || parameters.xtol < 0. || parameters.gtol < 0. || parameters.maxfev <= 0 || parameters.tau <= 0.)
+        return LevenbergMarquardtSpace::ImproperInputParameters;
+
+    /*     evaluate the function at the starting point */
+    /*     and calculate its norm. */
+    w.nfev = 1;
+    if ( functor(k, x, w.fvec) < 0)
+        return LevenbergMarquardtSpace::UserAsked;
+    w.fnorm = w.fvec.stableNorm();
+
+    Scalar lambda = 0., nu = 2., xnorm = 0., gnorm;
+    w.diag.setZero();
+    w.iter = 1;
+    NielsenStep step(*this, k, w);
+
+    LevenbergMarquardtSpace::Status status;
+    do {
+        /* calculate the jacobian matrix. */
+        int df_ret = functor.df(k, x, w.fjac);
+        if (df_ret<0)
+            return LevenbergMarquardtSpace::UserAsked;
+        if (df_ret>0)
+            // numerical diff, we evaluated the function df_ret times
+            w.nfev += df_ret;
+        else w.njev++;
+
+        /* normal equations, gradient and norms of the columns of the jacobian */
+        w.jtj.noalias() = w.fjac.transpose() * w.fjac;
+        w.grad.noalias() = w.fjac.transpose() * w.fvec;
+        w.colnorms = w.jtj.diagonal().cwiseSqrt();
+
+        status = ei_lmnielsen(step, parameters, x, w.fvec, w.grad, w.colnorms, w.diag, w.wa1, w.wa2, w.wa3, w.wa4,
+                              lambda, nu, xnorm, w.fnorm, gnorm, w.nfev, w.iter);
+    } while (status==LevenbergMarquardtSpace::Running);
+    return status;
+}
+
+//vim: ai ts=4 sts=4 et sw=4
+#endif // EIGEN_BATCHLEVENBERGMARQUARDT_H
@@ -0,0 +1,270 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_SPARSELEVENBERGMARQUARDT_H
+#define EIGEN_SPARSELEVENBERGMARQUARDT_H
+
+/**
+  * \ingroup NonLinearOptimization_Module
+  * \brief Performs non linear least squares minimization for problems with a
+  * large and sparse jacobian, using the Levenberg Marquardt algorithm.
+  *
+  * Unlike LevenbergMarquardt, which factorizes a dense m x n jacobian with a QR
+  * decomposition at each step, this class never forms a dense matrix. Each step
+  * solves the damped normal equations
+  * \f[ (J^T J + \lambda D^2) p = -J^T f \f]
+  * where \f$ D \f$ holds the norms of the columns of the jacobian, either with
+  * a sparse LDLT factorization whose symbolic analysis is reused as long as the
+  * sparsity pattern of the jacobian does not change, or with a matrix free
+  * conjugate gradient preconditioned by the diagonal of the system. The damping
+  * parameter \f$ \lambda \f$ is updated following Nielsen's strategy.
+  *
+  * The functor must provide \c values(), <tt>int operator()(const FVectorType& x, FVectorType& fvec)</tt>
+  * and <tt>int df(const FVectorType& x, JacobianType& fjac)</tt>, where \c JacobianType
+  * is a column major SparseMatrix. Like for LevenbergMarquardt, a negative return value
+  * stops the minimization.
+  *
+  * \note The Cholesky solver does not reorder the unknowns, so the fill-in of the factor
+  * depends on the numbering of the parameters. For very large problems with an unfavorable
+  * structure, the conjugate gradient solver has a much smaller memory footprint.
+  */
+template<typename FunctorType, typename Scalar=double>
+class SparseLevenbergMarquardt
+{
+public:
+    SparseLevenbergMarquardt(FunctorType &_functor)
+        : functor(_functor) { nfev = njev = iter = cgiter = 0;  fnorm = gnorm = 0.; }
+
+    enum LinearSolver {
+        Cholesky,
+        ConjugateGradient
+    };
+
+    struct Parameters {
+        Parameters()
+            : tau(Scalar(1e-3))
+            , maxfev(400)
+            , ftol(ei_sqrt(NumTraits<Scalar>::epsilon()))
+            , xtol(ei_sqrt(NumTraits<Scalar>::epsilon()))
+            , gtol(Scalar(0.))
+            , solver(Cholesky)
+            , cgtol(Scalar(1e-6))
+            , maxcgiter(0) {}
+        Scalar tau;       // initial damping, relative to the largest diagonal entry of J^T J
+        int maxfev;       // maximum number of function evaluation
+        Scalar ftol;
+        Scalar xtol;
+        Scalar gtol;
+        LinearSolver solver;
+        Scalar cgtol;     // relative residual of the conjugate gradient iterations
+        int maxcgiter;    // maximum number of conjugate gradient iterations, 0 means n
+    };
+
+    typedef Matrix< Scalar, Dynamic, 1 > FVectorType;
+    typedef SparseMatrix< Scalar > JacobianType;
+
+    LevenbergMarquardtSpace::Status minimize(FVectorType &x);
+    LevenbergMarquardtSpace::Status minimizeInit(FVectorType &x);
+    LevenbergMarquardtSpace::Status minimizeOneStep(FVectorType &x);
+
+    void resetParameters(void) { parameters = Parameters(); }
+
+    Parameters parameters;
+    FVectorType  fvec, diag;
+    JacobianType fjac;
+    int nfev;
+    int njev;
+    int iter;
+    int cgiter;   // total number of conjugate gradient iterations
+    Scalar fnorm, gnorm;
+
+    Scalar lm_param(void) { return lambda; }
+private:
+    bool solve(const FVectorType &g, FVectorType &p);
+    bool samePattern(const JacobianType &a) const;
+    static bool isFinite(const FVectorType &v) { Scalar s = v.squaredNorm(); return s==s && s<=NumTraits<Scalar>::highest(); }
+
+    FunctorType &functor;
+    int n;
+    int m;
+    FVectorType wa1, wa2, wa3, wa4, grad, colnorms;
+
+    // normal matrix J^T J, its damped version, and the sparse factorization
+    // whose symbolic part is reused across steps
+    JacobianType jtj, damped;
+    SparseLDLT<JacobianType> ldlt;
+    VectorXi patternOuter, patternInner;
+
+    Scalar lambda, nu, xnorm;
+
+    // the damped step solver and the function evaluation seen by ei_lmnielsen
+    struct NielsenStep {
+        NielsenStep(SparseLevenbergMarquardt &_lm) : lm(_lm) {}
+        bool solve(Scalar, FVectorType &p) { return lm.solve(-lm.grad, p); }
+        int evaluate(const FVectorType &x, FVectorType &v) { return lm.functor(x, v); }
+        void jacobianProduct(const FVectorType &p, FVectorType &jp) { jp = lm.fjac * p; }
+        SparseLevenbergMarquardt &lm;
+    };
+};
+
+template<typename FunctorType, typename Scalar>
+LevenbergMarquardtSpace::Status
+SparseLevenbergMarquardt<FunctorType,Scalar>::minimize(FVectorType  &x)
+{
+    LevenbergMarquardtSpace::Status status = minimizeInit(x);
+    if (status==LevenbergMarquardtSpace::ImproperInputParameters)
+        return status;
+    do {
+        status = minimizeOneStep(x);
+    } while (status==LevenbergMarquardtSpace::Running);
+    return status;
+}
+
+template<typename FunctorType, typename Scalar>
+LevenbergMarquardtSpace::Status
+SparseLevenbergMarquardt<FunctorType,Scalar>::minimizeInit(FVectorType  &x)
+{
+    n = x.size();
+    m = functor.values();
+
+    wa1.resize(n); wa2.resize(n); wa3.resize(m);
+    wa4.resize(m);
+    fvec.resize(m);
+    fjac.resize(m, n);
+    diag.setZero(n);
+    patternOuter.resize(0);
+    patternInner.resize(0);
+
+    nfev = 0;
+    njev = 0;
+    cgiter = 0;
+
+    /*     check the input parameters for errors. */
+    if (n <= 0 || m < n || parameters.ftol < 0. || parameters.xtol < 0. || parameters.gtol < 0. || parameters.maxfev <= 0 || parameters.tau <= 0.)
+        return LevenbergMarquardtSpace::ImproperInputParameters;
+
+    /*     evaluate the function at the starting point */
+    /*     and calculate its norm. */
+    nfev = 1;
+    if ( functor(x, fvec) < 0)
+        return LevenbergMarquardtSpace::UserAsked;
+    fnorm = fvec.stableNorm();
+
+    lambda = 0.;
+    nu = 2.;
+    iter = 1;
+
+    return LevenbergMarquardtSpace::NotStarted;
+}
+
+template<typename FunctorType, typename Scalar>
+bool SparseLevenbergMarquardt<FunctorType,Scalar>::samePattern(const JacobianType &a) const
+{
+    if (patternOuter.size()!=a.outerSize()+1 || patternInner.size()!=a.nonZeros())
+        return false;
+    return std::equal(a._outerIndexPtr(), a._outerIndexPtr()+a.outerSize()+1, patternOuter.data())
+        && std::equal(a._innerIndexPtr(), a._innerIndexPtr()+a.nonZeros(), patternInner.data());
+}
+
+/* solves (J^T J + lambda D^2) p = g, returns false if the system could not be solved */
+template<typename FunctorType, typename Scalar>
+bool SparseLevenbergMarquardt<FunctorType,Scalar>::solve(const FVectorType &g, FVectorType &p)
+{
+    const FVectorType d2 = lambda * diag.cwiseAbs2();
+
+    if (parameters.solver==Cholesky) {
+        JacobianType shift(n,n);
+        shift.reserve(n);
+        for (int j = 0; j < n; ++j)
+            shift.insert(j,j) = d2[j];
+        shift.finalize();
+        damped = jtj + shift;
+
+        /* the symbolic factorization only depends on the pattern of the matrix */
+        if (!samePattern(damped)) {
+            patternOuter = VectorXi::Map(damped._outerIndexPtr(), damped.outerSize()+1);
+            patternInner = VectorXi::Map(damped._innerIndexPtr(), damped.nonZeros());
+            ldlt._symbolic(damped);
+        }
+        if (!ldlt._numeric(damped))
+            return false;
+        p = g;
+        return ldlt.solveInPlace(p) && isFinite(p);
+    }
+
+    /* matrix free conjugate gradient with a jacobi preconditioner */
+    const FVectorType invprec = (colnorms.cwiseAbs2() + d2).cwiseMax(FVectorType::Constant(n, NumTraits<Scalar>::epsilon())).cwiseInverse();
+    const int maxcgiter = parameters.maxcgiter>0 ? parameters.maxcgiter : n;
+    const Scalar threshold = ei_abs2(parameters.cgtol) * g.squaredNorm();
+    p.setZero(n);
+    FVectorType r = g;
+    FVectorType z = invprec.cwiseProduct(r);
+    FVectorType dir = z;
+    FVectorType q(n);
+    Scalar rz = r.dot(z);
+    for (int k = 0; k < maxcgiter && r.squaredNorm() > threshold; ++k) {
+        wa3 = fjac * dir;
+        q = fjac.transpose() * wa3;
+        q += d2.cwiseProduct(dir);
+        const Scalar alpha = rz / dir.dot(q);
+        p += alpha * dir;
+        r -= alpha * q;
+        z = invprec.cwiseProduct(r);
+        const Scalar rznew = r.dot(z);
+        dir = z + (rznew / rz) * dir;
+        rz = rznew;
+        ++cgiter;
+    }
+    return isFinite(p);
+}
+
+template<typename FunctorType, typename Scalar>
+LevenbergMarquardtSpace::Status
+SparseLevenbergMarquardt<FunctorType,Scalar>::minimizeOneStep(FVectorType  &x)
+{
+    assert(x.size()==n); // check the caller is not cheating us
+
+    /* calculate the jacobian matrix. */
+    int df_ret = functor.df(x, fjac);
+    if (df_ret<0)
+        return LevenbergMarquardtSpace::UserAsked;
+    if (df_ret>0)
+        // numerical diff, we evaluated the function df_ret times
+        nfev += df_ret;
+    else njev++;
+    ei_assert(fjac.rows()==m && fjac.cols()==n);
+
+    /* gradient and norms of the columns of the jacobian */
+    grad = fjac.transpose() * fvec;
+    colnorms.resize(n);
+    for (int j = 0; j < n; ++j)
+        colnorms[j] = fjac.col(j).norm();
+    if (parameters.solver==Cholesky)
+        jtj = fjac.transpose() * fjac;
+
+    NielsenStep step(*this);
+    return ei_lmnielsen(step, parameters, x, fvec, grad, colnorms, diag, wa1, wa2, wa3, wa4,
+                        lambda, nu, xnorm, fnorm, gnorm, nfev, iter);
+}
+
+//vim: ai ts=4 sts=4 et sw=4
+#endif // EIGEN_SPARSELEVENBERGMARQUARDT_H
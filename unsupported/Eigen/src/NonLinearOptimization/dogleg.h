@@ -1,11 +1,11 @@
 
-template <typename Scalar>
+template <typename Scalar, typename MatrixType, typename VectorType>
 void ei_dogleg(
-        const Matrix< Scalar, Dynamic, Dynamic >  &qrfac,
-        const Matrix< Scalar, Dynamic, 1 >  &diag,
-        const Matrix< Scalar, Dynamic, 1 >  &qtb,
+        const MatrixType  &qrfac,
+        const VectorType  &diag,
+        const VectorType  &qtb,
         Scalar delta,
-        Matrix< Scalar, Dynamic, 1 >  &x)
+        VectorType  &x)
 {
     /* Local variables */
     int i, j;
@@ -19,7 +19,7 @@ void ei_dogleg(
     assert(n==qtb.size());
     assert(n==x.size());
     assert(n==diag.size());
-    Matrix< Scalar, Dynamic, 1 >  wa1(n), wa2(n);
+    VectorType  wa1(n), wa2(n);
 
     /* first, calculate the gauss-newton direction. */
     for (j = n-1; j >=0; --j) {
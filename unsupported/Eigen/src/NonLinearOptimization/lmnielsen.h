@@ -0,0 +1,158 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_LMNIELSEN_H
+#define EIGEN_LMNIELSEN_H
+
+/* One iteration of the Levenberg Marquardt algorithm on the damped normal
+ * equations (J^T J + lambda D^2) p = -J^T f, the damping parameter lambda
+ * being updated following Nielsen's strategy. This is shared by
+ * SparseLevenbergMarquardt and BatchLevenbergMarquardt.
+ *
+ * The caller has evaluated the jacobian at x, the gradient grad = J^T f
+ * and the norms of the columns of J. The step object provides:
+ *   bool solve(Scalar lambda, FVectorType &p), which solves the damped
+ *        system and returns false when it could not be solved,
+ *   int evaluate(const FVectorType &x, ValueType &fvec), the function,
+ *   void jacobianProduct(const FVectorType &p, ValueType &jp), jp = J p.
+ *
+ * Returns Running when the iteration succeeded without meeting a stopping
+ * criterion. */
+template <typename Step, typename Parameters, typename FVectorType, typename ValueType, typename Scalar>
+LevenbergMarquardtSpace::Status ei_lmnielsen(
+        Step &step,
+        const Parameters &parameters,
+        FVectorType &x,
+        ValueType &fvec,
+        const FVectorType &grad,
+        const FVectorType &colnorms,
+        FVectorType &diag,
+        FVectorType &wa1,
+        FVectorType &wa2,
+        ValueType &wa3,
+        ValueType &wa4,
+        Scalar &lambda,
+        Scalar &nu,
+        Scalar &xnorm,
+        Scalar &fnorm,
+        Scalar &gnorm,
+        int &nfev,
+        int &iter)
+{
+    const int n = x.size();
+    Scalar pnorm, fnorm1, actred, prered, ratio;
+
+    /* scale according to the norms of the columns of the jacobian, */
+    /* never decreasing the scaling factors. */
+    for (int j = 0; j < n; ++j)
+        diag[j] = std::max(diag[j], colnorms[j]==0. ? Scalar(1.) : colnorms[j]);
+
+    if (iter == 1) {
+        xnorm = diag.cwiseProduct(x).stableNorm();
+        lambda = parameters.tau * colnorms.cwiseAbs2().maxCoeff() / diag.cwiseAbs2().maxCoeff();
+        if (lambda == 0.)
+            lambda = parameters.tau;
+    }
+
+    /* compute the norm of the scaled gradient. */
+    gnorm = 0.;
+    if (fnorm != 0.)
+        for (int j = 0; j < n; ++j)
+            if (colnorms[j] != 0.)
+                gnorm = std::max(gnorm, ei_abs(grad[j] / (fnorm * colnorms[j])));
+
+    /* test for convergence of the gradient norm. */
+    if (gnorm <= parameters.gtol)
+        return LevenbergMarquardtSpace::CosinusTooSmall;
+
+    ratio = 0.;
+    do {
+
+        /* determine the step, increasing the damping if the system is singular. */
+        if (!step.solve(lambda, wa1)) {
+            lambda *= nu;
+            nu *= 2.;
+            if (lambda > Scalar(1) / NumTraits<Scalar>::epsilon())
+                return LevenbergMarquardtSpace::XtolTooSmall;
+            continue;
+        }
+        wa2 = x + wa1;
+        pnorm = diag.cwiseProduct(wa1).stableNorm();
+
+        /* evaluate the function at x + p and calculate its norm. */
+        if ( step.evaluate(wa2, wa4) < 0)
+            return LevenbergMarquardtSpace::UserAsked;
+        ++nfev;
+        fnorm1 = wa4.stableNorm();
+
+        /* compute the scaled actual and predicted reductions. */
+        actred = -1.;
+        if (Scalar(.1) * fnorm1 < fnorm)
+            actred = 1. - ei_abs2(fnorm1 / fnorm);
+        step.jacobianProduct(wa1, wa3);
+        wa3 += fvec;
+        prered = 1. - ei_abs2(wa3.stableNorm() / fnorm);
+
+        ratio = 0.;
+        if (prered != 0.)
+            ratio = actred / prered;
+
+        /* update the damping parameter and test for successful iteration. */
+        if (ratio > 0.) {
+            const Scalar t = 2. * ratio - 1.;
+            lambda *= std::max(Scalar(1./3.), Scalar(1.) - t*t*t);
+            nu = 2.;
+            x = wa2;
+            fvec = wa4;
+            xnorm = diag.cwiseProduct(x).stableNorm();
+            fnorm = fnorm1;
+            ++iter;
+        } else {
+            lambda *= nu;
+            nu *= 2.;
+        }
+
+        /* tests for convergence. */
+        if (ei_abs(actred) <= parameters.ftol && prered <= parameters.ftol && pnorm <= parameters.xtol * xnorm)
+            return LevenbergMarquardtSpace::RelativeErrorAndReductionTooSmall;
+        if (ei_abs(actred) <= parameters.ftol && prered <= parameters.ftol)
+            return LevenbergMarquardtSpace::RelativeReductionTooSmall;
+        if (pnorm <= parameters.xtol * xnorm)
+            return LevenbergMarquardtSpace::RelativeErrorTooSmall;
+        if (fnorm == 0.)
+            return LevenbergMarquardtSpace::RelativeErrorTooSmall;
+
+        /* tests for termination and stringent tolerances. */
+        if (nfev >= parameters.maxfev)
+            return LevenbergMarquardtSpace::TooManyFunctionEvaluation;
+        if (ei_abs(actred) <= NumTraits<Scalar>::epsilon() && prered <= NumTraits<Scalar>::epsilon())
+            return LevenbergMarquardtSpace::FtolTooSmall;
+        if (pnorm <= NumTraits<Scalar>::epsilon() * xnorm)
+            return LevenbergMarquardtSpace::XtolTooSmall;
+
+    } while (ratio <= 0.);
+
+    return LevenbergMarquardtSpace::Running;
+}
+
+//vim: ai ts=4 sts=4 et sw=4
+#endif // EIGEN_LMNIELSEN_H
@@ -44,6 +44,14 @@ enum NumericalDiffMode {
   * http://en.wikipedia.org/wiki/Numerical_differentiation
   *
   * Currently only "Forward" and "Central" scheme are implemented.
+  *
+  * The perturbed functor evaluations are independent, and can be performed in
+  * parallel with setParallel(). Moreover, when the sparsity pattern of the
+  * jacobian is known, setSparsityPattern() groups the structurally orthogonal
+  * columns (columns having no non zero in a common row) using the greedy
+  * coloring of Curtis, Powell and Reid, and all the columns of a group are
+  * perturbed at once. The number of functor evaluations is then proportional
+  * to the number of groups instead of the number of parameters.
   */
 template<typename _Functor, NumericalDiffMode mode=Forward>
 class NumericalDiff : public _Functor
@@ -54,84 +62,202 @@ public:
     typedef typename Functor::InputType InputType;
     typedef typename Functor::ValueType ValueType;
     typedef typename Functor::JacobianType JacobianType;
+    typedef SparseMatrix<Scalar> SparseJacobianType;
 
-    NumericalDiff(Scalar _epsfcn=0.) : Functor(), epsfcn(_epsfcn) {}
-    NumericalDiff(const Functor& f, Scalar _epsfcn=0.) : Functor(f), epsfcn(_epsfcn) {}
+    NumericalDiff(Scalar _epsfcn=0.) : Functor(), epsfcn(_epsfcn), m_parallel(false), m_ncolors(0) {}
+    NumericalDiff(const Functor& f, Scalar _epsfcn=0.) : Functor(f), epsfcn(_epsfcn), m_parallel(false), m_ncolors(0) {}
 
     // forward constructors
     template<typename T0>
-        NumericalDiff(const T0& a0) : Functor(a0), epsfcn(0) {}
+        NumericalDiff(const T0& a0) : Functor(a0), epsfcn(0), m_parallel(false), m_ncolors(0) {}
     template<typename T0, typename T1>
-        NumericalDiff(const T0& a0, const T1& a1) : Functor(a0, a1), epsfcn(0) {}
+        NumericalDiff(const T0& a0, const T1& a1) : Functor(a0, a1), epsfcn(0), m_parallel(false), m_ncolors(0) {}
     template<typename T0, typename T1, typename T2>
-        NumericalDiff(const T0& a0, const T1& a1, const T1& a2) : Functor(a0, a1, a2), epsfcn(0) {}
+        NumericalDiff(const T0& a0, const T1& a1, const T1& a2) : Functor(a0, a1, a2), epsfcn(0), m_parallel(false), m_ncolors(0) {}
 
     enum {
         InputsAtCompileTime = Functor::InputsAtCompileTime,
         ValuesAtCompileTime = Functor::ValuesAtCompileTime
     };
 
+    /**
+      * Enables or disables the parallel evaluation of the functor (requires OpenMP).
+      * The functor must then support concurrent calls to operator().
+      */
+    void setParallel(bool parallel) { m_parallel = parallel; }
+
+    /**
+      * Sets the sparsity pattern of the jacobian, given by the non zeros of \a pattern,
+      * and computes the column groups. Entries of the jacobian outside this pattern are
+      * assumed to be zero.
+      */
+    template<typename Derived>
+    void setSparsityPattern(const SparseMatrixBase<Derived>& pattern);
+
+    /** Removes the sparsity pattern, going back to one evaluation per parameter. */
+    void clearSparsityPattern() { m_pattern.resize(0,0); m_colors.resize(0); m_ncolors = 0; }
+
+    /** \returns the number of column groups, or 0 if no sparsity pattern is set. */
+    int colors() const { return m_ncolors; }
+
+    /** \returns the group of each column. */
+    const VectorXi& columnColors() const { return m_colors; }
+
     /**
       * return the number of evaluation of functor
      */
     int df(const InputType& _x, JacobianType &jac) const
     {
-        /* Local variables */
-        Scalar h;
-        int nfev=0;
+        if (m_ncolors>0)
+            jac.setZero(Functor::values(), _x.size());
+        return compute(_x, &jac, 0);
+    }
+
+    /**
+      * Computes the non zeros of the jacobian given by the sparsity pattern into \a jac,
+      * which is suitable for SparseLevenbergMarquardt.
+      * return the number of evaluation of functor
+      */
+    int df(const InputType& _x, SparseJacobianType &jac) const
+    {
+        ei_assert(m_ncolors>0 && "a sparsity pattern is required to compute a sparse jacobian");
+        jac = m_pattern;
+        return compute(_x, 0, &jac);
+    }
+
+private:
+    // Computes the jacobian into either dense or sparse, the latter having the sparsity pattern.
+    int compute(const InputType& _x, JacobianType *dense, SparseJacobianType *sparseJac) const
+    {
         const int n = _x.size();
+        const int m = Functor::values();
         const Scalar eps = ei_sqrt((std::max(epsfcn,NumTraits<Scalar>::epsilon() )));
-        ValueType val1, val2;
-        InputType x = _x;
-        // TODO : we should do this only if the size is not already known
-        val1.resize(Functor::values());
-        val2.resize(Functor::values());
-
-        // initialization
-        switch(mode) {
-            case Forward:
-                // compute f(x)
-                Functor::operator()(x, val1); nfev++;
-                break;
-            case Central:
-                // do nothing
-                break;
-            default:
-                assert(false);
-        };
-
-        // Function Body
-        for (int j = 0; j < n; ++j) {
-            h = eps * ei_abs(x[j]);
-            if (h == 0.) {
-                h = eps;
-            }
-            switch(mode) {
-                case Forward:
-                    x[j] += h;
-                    Functor::operator()(x, val2);
-                    nfev++;
-                    x[j] = _x[j];
-                    jac.col(j) = (val2-val1)/h;
-                    break;
-                case Central:
-                    x[j] += h;
-                    Functor::operator()(x, val2); nfev++;
-                    x[j] -= 2*h;
-                    Functor::operator()(x, val1); nfev++;
+        const bool sparse = m_ncolors>0;
+        const int ngroups = sparse ? m_ncolors : n;
+        ei_assert(!sparse || (m_pattern.rows()==m && m_pattern.cols()==n));
+
+        // compute f(x)
+        ValueType val0;
+        val0.resize(m);
+        if (mode==Forward)
+            Functor::operator()(_x, val0);
+
+#ifdef EIGEN_HAS_OPENMP
+        #pragma omp parallel if(m_parallel && ngroups>1)
+#endif
+        {
+            // workspace of each thread, only the perturbed entries of x being restored after each group
+            ValueType val1, val2;
+            if (mode==Central)
+                val1.resize(m);
+            val2.resize(m);
+            InputType x = _x;
+            const ValueType &base = mode==Central ? val1 : val0;
+#ifdef EIGEN_HAS_OPENMP
+            #pragma omp for schedule(dynamic)
+#endif
+            for (int g = 0; g < ngroups; ++g) {
+                const int begin = sparse ? m_groupStart[g] : g;
+                const int end = sparse ? m_groupStart[g+1] : g+1;
+
+                // perturb all the columns of the group
+                for (int k = begin; k < end; ++k) {
+                    const int j = sparse ? m_groupColumns[k] : k;
+                    x[j] += step(_x[j], eps);
+                }
+                Functor::operator()(x, val2);
+                if (mode==Central) {
+                    for (int k = begin; k < end; ++k) {
+                        const int j = sparse ? m_groupColumns[k] : k;
+                        x[j] = _x[j] - step(_x[j], eps);
+                    }
+                    Functor::operator()(x, val1);
+                }
+
+                for (int k = begin; k < end; ++k) {
+                    const int j = sparse ? m_groupColumns[k] : k;
                     x[j] = _x[j];
-                    jac.col(j) = (val2-val1)/(2*h);
-                    break;
-                default:
-                    assert(false);
-            };
+                    const Scalar h = (mode==Central ? Scalar(2) : Scalar(1)) * step(_x[j], eps);
+                    if (!sparse) {
+                        dense->col(j) = (val2-base)/h;
+                        continue;
+                    }
+                    for (int p = m_pattern._outerIndexPtr()[j]; p < m_pattern._outerIndexPtr()[j+1]; ++p) {
+                        const int i = m_pattern._innerIndexPtr()[p];
+                        const Scalar d = (val2[i]-base[i])/h;
+                        if (dense)
+                            dense->coeffRef(i,j) = d;
+                        else
+                            sparseJac->_valuePtr()[p] = d;
+                    }
+                }
+            }
         }
-        return nfev;
+        return (mode==Forward ? 1 : 0) + (mode==Central ? 2 : 1) * ngroups;
     }
-private:
+
+    static Scalar step(const Scalar& x, const Scalar& eps)
+    {
+        Scalar h = eps * ei_abs(x);
+        return h == 0. ? eps : h;
+    }
+
     Scalar epsfcn;
+    bool m_parallel;
+    int m_ncolors;
+    SparseJacobianType m_pattern;
+    VectorXi m_colors;
+    // columns of the groups, the columns of group g being m_groupColumns[m_groupStart[g]:m_groupStart[g+1]]
+    VectorXi m_groupStart;
+    VectorXi m_groupColumns;
 };
 
+template<typename _Functor, NumericalDiffMode mode>
+template<typename Derived>
+void NumericalDiff<_Functor,mode>::setSparsityPattern(const SparseMatrixBase<Derived>& pattern)
+{
+    const int m = pattern.rows();
+    const int n = pattern.cols();
+
+    // column major pattern with unit values, and its row major counterpart
+    m_pattern.resize(m, n);
+    m_pattern.reserve(pattern.nonZeros());
+    SparseMatrix<Scalar> colMajor = pattern.derived().template cast<Scalar>();
+    for (int j = 0; j < n; ++j)
+        for (typename SparseMatrix<Scalar>::InnerIterator it(colMajor, j); it; ++it)
+            m_pattern.insert(it.index(), j) = Scalar(1);
+    m_pattern.finalize();
+    SparseMatrix<Scalar,RowMajor> rowMajor = m_pattern;
+
+    // greedy coloring: each column gets the smallest color which is not used
+    // by a column having a non zero in a common row
+    m_colors.setConstant(n, -1);
+    VectorXi forbidden = VectorXi::Constant(n, -1);
+    m_ncolors = 0;
+    for (int j = 0; j < n; ++j) {
+        for (typename SparseJacobianType::InnerIterator it(m_pattern, j); it; ++it)
+            for (typename SparseMatrix<Scalar,RowMajor>::InnerIterator rit(rowMajor, it.index()); rit; ++rit)
+                if (m_colors[rit.index()] >= 0)
+                    forbidden[m_colors[rit.index()]] = j;
+        int c = 0;
+        while (forbidden[c] == j)
+            ++c;
+        m_colors[j] = c;
+        m_ncolors = std::max(m_ncolors, c+1);
+    }
+
+    // columns of each group
+    m_groupStart.setZero(m_ncolors+1);
+    for (int j = 0; j < n; ++j)
+        ++m_groupStart[m_colors[j]+1];
+    for (int c = 0; c < m_ncolors; ++c)
+        m_groupStart[c+1] += m_groupStart[c];
+    m_groupColumns.resize(n);
+    VectorXi next = m_groupStart.head(std::max(m_ncolors,1));
+    for (int j = 0; j < n; ++j)
+        m_groupColumns[next[m_colors[j]]++] = j;
+}
+
 //vim: ai ts=4 sts=4 et sw=4
 #endif // EIGEN_NUMERICAL_DIFF_H
 
@@ -0,0 +1,412 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_ABERTH_POLYNOMIAL_SOLVER_H
+#define EIGEN_ABERTH_POLYNOMIAL_SOLVER_H
+
+/** \internal
+ * Computes the two roots of \f$ a_0 + a_1 x + a_2 x^2 \f$, \f$ a_2 \neq 0 \f$.
+ * The root of largest modulus is computed first, the other one is obtained from
+ * the product of the roots, so that there is no cancellation.
+ */
+template< typename RootType >
+void ei_quadratic_roots( const RootType& a0, const RootType& a1, const RootType& a2,
+    RootType& r0, RootType& r1 )
+{
+  typedef typename NumTraits<RootType>::Real RealScalar;
+
+  RootType s = std::sqrt( a1*a1 - RealScalar(4)*a2*a0 );
+  if( ei_real( ei_conj(a1)*s ) < RealScalar(0) ){
+    s = -s; }
+  const RootType q = -RealScalar(0.5)*(a1 + s);
+  r0 = q/a2;
+  r1 = ( RootType(0) == q ) ? RootType(0) : a0/q;
+}
+
+/** \internal
+ * \returns \f$ 1/z \f$ without the special cases of the complex division, which slow down
+ * the Aberth iteration. \a z is scaled so that its squared modulus does not underflow for
+ * clustered roots.
+ */
+template< typename RootType >
+inline RootType ei_aberth_inverse( const RootType& z )
+{
+  typedef typename NumTraits<RootType>::Real RealScalar;
+
+  const RealScalar s = RealScalar(1) / ( ei_abs(ei_real(z)) + ei_abs(ei_imag(z)) );
+  const RootType w = s*z;
+  return ( s/ei_abs2(w) ) * ei_conj(w);
+}
+
+
+/** \ingroup Polynomials_Module
+ *
+ * \class AberthPolynomialSolver
+ *
+ * \brief A polynomial solver based on the Aberth-Ehrlich simultaneous iteration
+ *
+ * Computes the complex roots of a polynomial, with real or complex coefficients.
+ *
+ * \param _Scalar the scalar type, i.e., the type of the polynomial coefficients
+ * \param _Deg the degree of the polynomial, can be a compile time value or Dynamic.
+ *             Notice that the number of polynomial coefficients is _Deg+1.
+ *
+ * All the roots are refined at once: each sweep updates the approximation \f$ z_i \f$ by
+ * \f[ z_i \leftarrow z_i - \frac{1}{\frac{p'(z_i)}{p(z_i)} - \sum_{j \neq i} \frac{1}{z_i - z_j}}, \f]
+ * which costs \f$ O(d^2) \f$ operations per sweep for a polynomial of degree \f$ d \f$, instead
+ * of the \f$ O(d^3) \f$ of the eigenvalue computation of the companion matrix done by
+ * PolynomialSolver. The initial approximations are placed on circles whose radii are given by
+ * the Newton polygon of the moduli of the coefficients, and an approximation is no longer
+ * updated once its backward error is of the order of the machine precision, the polynomial
+ * being evaluated at \f$ 1/z_i \f$ in reverse order when \f$ |z_i| > 1 \f$.
+ *
+ * The roots at zero are deflated beforehand and the polynomials of degree 1 and 2 are solved
+ * in closed form. When the degree is known at compile time, the solver does not allocate any
+ * memory, and when it is Dynamic the workspace is only reallocated when the degree changes,
+ * which makes it suitable for solving many polynomials in a row, see BatchPolynomialSolver.
+ *
+ * Unlike the QR algorithm, the Aberth iteration converges for multiple roots and roots of
+ * equal moduli, the convergence being only linear in the case of multiple roots.
+ *
+ * See: Dario A. Bini, Numerical computation of polynomial zeros by means of Aberth's method,
+ * Numerical Algorithms 13 (1996), pp. 179-200.
+ */
+template< typename _Scalar, int _Deg >
+class AberthPolynomialSolver : public PolynomialSolverBase<_Scalar,_Deg>
+{
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW_IF_VECTORIZABLE_FIXED_SIZE(_Scalar,_Deg==Dynamic ? Dynamic : _Deg)
+
+    typedef PolynomialSolverBase<_Scalar,_Deg>    PS_Base;
+    EIGEN_POLYNOMIAL_SOLVER_BASE_INHERITED_TYPES( PS_Base )
+
+    enum {
+      CoeffsAtCompileTime = _Deg==Dynamic ? Dynamic : _Deg+1
+    };
+    // the degree decreases when there are roots at zero, hence the fixed maximal sizes
+    typedef Matrix<RootType,Dynamic,1,0,CoeffsAtCompileTime,1>    CoeffsType;
+    typedef Matrix<RealScalar,Dynamic,1,0,CoeffsAtCompileTime,1>  RealCoeffsType;
+    typedef Matrix<int,Dynamic,1,0,CoeffsAtCompileTime,1>         IndicesType;
+
+  public:
+    /** Computes the complex roots of a new polynomial. */
+    template< typename OtherPolynomial >
+    void compute( const OtherPolynomial& poly );
+
+  public:
+    template< typename OtherPolynomial >
+    inline AberthPolynomialSolver( const OtherPolynomial& poly )
+      : m_maxIterations(100), m_iterations(0), m_isConverged(true) {
+      compute( poly ); }
+
+    inline AberthPolynomialSolver()
+      : m_maxIterations(100), m_iterations(0), m_isConverged(true) {}
+
+    /** Sets the maximal number of sweeps of the iteration (default: 100). */
+    inline void setMaxIterations( int maxIterations ){
+      m_maxIterations = maxIterations; }
+
+    /** \returns the number of sweeps done by the last call to compute(). */
+    inline int iterations() const { return m_iterations; }
+
+    /** \returns true if all the roots reached the machine precision within
+     * the maximal number of sweeps in the last call to compute(). */
+    inline bool converged() const { return m_isConverged; }
+
+  protected:
+    void initialApproximations( int first, int deg );
+    RootType logarithmicDerivative( const RootType& z, int deg, bool& isSmall ) const;
+
+  protected:
+    using                   PS_Base::m_roots;
+    CoeffsType              m_coeffs;
+    RealCoeffsType          m_absCoeffs;
+    RealCoeffsType          m_logAbsCoeffs;
+    IndicesType             m_hull;
+    IndicesType             m_isRootConverged;
+    int                     m_maxIterations;
+    int                     m_iterations;
+    bool                    m_isConverged;
+};
+
+template< typename _Scalar, int _Deg >
+template< typename OtherPolynomial >
+void AberthPolynomialSolver<_Scalar,_Deg>::compute( const OtherPolynomial& poly )
+{
+  const int d = poly.size()-1;
+  assert( Scalar(0) != poly[d] );
+  m_roots.resize( d );
+  m_iterations = 0;
+  m_isConverged = true;
+
+  // deflate the roots at zero
+  int first = 0;
+  while( first < d && Scalar(0) == poly[first] ){
+    m_roots[first++] = RootType(0); }
+  const int deg = d - first;
+
+  // scale the coefficients to avoid overflows in the evaluations
+  RealScalar scale(0);
+  for( int k=0; k<=deg; ++k ){
+    scale = std::max( scale, ei_abs( poly[first+k] ) ); }
+  m_coeffs.resize( deg+1 );
+  m_absCoeffs.resize( deg+1 );
+  for( int k=0; k<=deg; ++k )
+  {
+    m_coeffs[k] = RootType( poly[first+k] ) / scale;
+    m_absCoeffs[k] = ei_abs( m_coeffs[k] );
+  }
+
+  if( 0 == deg ){
+    return; }
+  if( 1 == deg ){
+    m_roots[first] = -m_coeffs[0]/m_coeffs[1];
+    return; }
+  if( 2 == deg ){
+    ei_quadratic_roots( m_coeffs[0], m_coeffs[1], m_coeffs[2], m_roots[first], m_roots[first+1] );
+    return; }
+
+  initialApproximations( first, deg );
+
+  m_isRootConverged.setZero( deg );
+  int remaining = deg;
+  while( remaining > 0 && m_iterations < m_maxIterations )
+  {
+    ++m_iterations;
+    for( int i=0; i<deg; ++i )
+    {
+      if( m_isRootConverged[i] ){
+        continue; }
+
+      RootType& zi = m_roots[first+i];
+      bool isSmall;
+      const RootType ratio = logarithmicDerivative( zi, deg, isSmall );
+      if( isSmall )
+      {
+        m_isRootConverged[i] = 1;
+        --remaining;
+        continue;
+      }
+
+      RootType sum(0);
+      for( int j=0; j<deg; ++j ){
+        if( j != i ){
+          sum += ei_aberth_inverse( zi - m_roots[first+j] ); } }
+      zi -= ei_aberth_inverse( ratio - sum );
+    }
+  }
+  m_isConverged = (0 == remaining);
+}
+
+/** \internal
+ * Sets the initial approximations of the roots of the deflated polynomial of degree \a deg,
+ * stored from \a first on in m_roots: for each edge of the upper convex hull of the points
+ * \f$ (k, \log|a_k|) \f$ going from \f$ k_s \f$ to \f$ k_{s+1} \f$, \f$ k_{s+1}-k_s \f$ points are
+ * equally spaced on the circle of radius \f$ |a_{k_s}/a_{k_{s+1}}|^{1/(k_{s+1}-k_s)} \f$.
+ */
+template< typename _Scalar, int _Deg >
+void AberthPolynomialSolver<_Scalar,_Deg>::initialApproximations( int first, int deg )
+{
+  const RealScalar twoPi = RealScalar(6.283185307179586476925286766559);
+  const RealScalar sigma = RealScalar(0.7);
+
+  m_logAbsCoeffs.resize( deg+1 );
+  m_hull.resize( deg+1 );
+  int h = 0;
+  for( int k=0; k<=deg; ++k )
+  {
+    if( RealScalar(0) == m_absCoeffs[k] ){
+      continue; }
+    m_logAbsCoeffs[k] = ei_log( m_absCoeffs[k] );
+    // remove the last point of the hull while it is not above the segment to the new point
+    while( h >= 2 )
+    {
+      const int a = m_hull[h-2], b = m_hull[h-1];
+      const RealScalar cross = RealScalar(b-a)*(m_logAbsCoeffs[k]-m_logAbsCoeffs[b])
+                             - (m_logAbsCoeffs[b]-m_logAbsCoeffs[a])*RealScalar(k-b);
+      if( cross < RealScalar(0) ){
+        break; }
+      --h;
+    }
+    m_hull[h++] = k;
+  }
+
+  for( int s=0; s+1<h; ++s )
+  {
+    const int k0 = m_hull[s], n = m_hull[s+1] - k0;
+    const RealScalar radius = ei_exp( (m_logAbsCoeffs[k0] - m_logAbsCoeffs[k0+n]) / RealScalar(n) );
+    const RootType rotation = std::polar( RealScalar(1), twoPi/RealScalar(n) );
+    RootType z = std::polar( radius, twoPi*RealScalar(k0)/RealScalar(deg) + sigma );
+    for( int j=0; j<n; ++j )
+    {
+      m_roots[first+k0+j] = z;
+      z *= rotation;
+    }
+  }
+}
+
+/** \internal
+ * \returns \f$ p'(z)/p(z) \f$ for the deflated polynomial of degree \a deg, and sets \a isSmall
+ * if \f$ |p(z)| \f$ is below the rounding error bound of its evaluation, in which case the
+ * returned value is meaningless.
+ */
+template< typename _Scalar, int _Deg >
+typename AberthPolynomialSolver<_Scalar,_Deg>::RootType
+AberthPolynomialSolver<_Scalar,_Deg>::logarithmicDerivative( const RootType& z, int deg, bool& isSmall ) const
+{
+  const RealScalar tol = RealScalar(4*deg) * NumTraits<RealScalar>::epsilon();
+  const RealScalar absz = ei_abs( z );
+  if( absz <= RealScalar(1) )
+  {
+    RootType p = m_coeffs[deg], dp(0);
+    RealScalar bound = m_absCoeffs[deg];
+    for( int k=deg-1; k>=0; --k )
+    {
+      dp = dp*z + p;
+      p = p*z + m_coeffs[k];
+      bound = bound*absz + m_absCoeffs[k];
+    }
+    isSmall = ei_abs( p ) <= tol*bound;
+    return isSmall ? RootType(0) : dp*ei_aberth_inverse( p );
+  }
+  else
+  {
+    // p(z) = z^deg q(y) with y = 1/z and q the reversed polynomial,
+    // so that p'(z)/p(z) = y (deg - y q'(y)/q(y))
+    const RootType y = ei_aberth_inverse( z );
+    const RealScalar absy = RealScalar(1)/absz;
+    RootType q = m_coeffs[0], dq(0);
+    RealScalar bound = m_absCoeffs[0];
+    for( int k=1; k<=deg; ++k )
+    {
+      dq = dq*y + q;
+      q = q*y + m_coeffs[k];
+      bound = bound*absy + m_absCoeffs[k];
+    }
+    isSmall = ei_abs( q ) <= tol*bound;
+    return isSmall ? RootType(0) : y*(RealScalar(deg) - y*dq*ei_aberth_inverse( q ));
+  }
+}
+
+
+/** \ingroup Polynomials_Module
+ *
+ * \class BatchPolynomialSolver
+ *
+ * \brief Computes the roots of many polynomials of the same degree
+ *
+ * \param _Scalar the scalar type, i.e., the type of the polynomial coefficients
+ * \param _Deg the degree of the polynomials, can be a compile time value or Dynamic.
+ *
+ * The polynomials are the columns of the matrix passed to compute(), and the roots of the
+ * k-th polynomial are the k-th column of roots(). Each polynomial is solved by an
+ * AberthPolynomialSolver, one per thread, so that no memory is allocated per polynomial.
+ * The polynomials are solved in parallel when OpenMP is enabled.
+ *
+ * \code
+ * Matrix<double,4,Dynamic> polys = Matrix<double,4,Dynamic>::Random(4,100000);
+ * BatchPolynomialSolver<double,3> psolve( polys );
+ * std::cout << psolve.roots().col(0) << std::endl;
+ * \endcode
+ */
+template< typename _Scalar, int _Deg >
+class BatchPolynomialSolver
+{
+  public:
+    typedef AberthPolynomialSolver<_Scalar,_Deg>  SolverType;
+    typedef typename SolverType::Scalar           Scalar;
+    typedef typename SolverType::RealScalar       RealScalar;
+    typedef typename SolverType::RootType         RootType;
+    typedef Matrix<RootType,_Deg,Dynamic>         RootsType;
+
+  public:
+    /** Computes the complex roots of the polynomials stored in the columns of \a polys. */
+    template< typename OtherPolynomials >
+    void compute( const OtherPolynomials& polys );
+
+  public:
+    template< typename OtherPolynomials >
+    inline BatchPolynomialSolver( const OtherPolynomials& polys )
+      : m_maxIterations(100), m_parallel(true) {
+      compute( polys ); }
+
+    inline BatchPolynomialSolver()
+      : m_maxIterations(100), m_parallel(true) {}
+
+    /** \returns the roots of the polynomials, one column per polynomial */
+    inline const RootsType& roots() const { return m_roots; }
+
+    /** \returns the number of sweeps of the Aberth iteration for each polynomial */
+    inline const VectorXi& iterations() const { return m_iterations; }
+
+    /** \returns true if the roots of all the polynomials converged */
+    inline bool converged() const {
+      return 0 == m_isConverged.size() || m_isConverged.minCoeff() != 0; }
+
+    /** \returns true if the roots of the \a k -th polynomial converged */
+    inline bool converged( int k ) const { return m_isConverged[k] != 0; }
+
+    /** Sets the maximal number of sweeps of the iteration for each polynomial (default: 100). */
+    inline void setMaxIterations( int maxIterations ){
+      m_maxIterations = maxIterations; }
+
+    /** Solves the polynomials in parallel (requires OpenMP, default: true). */
+    inline void setParallel( bool parallel ){
+      m_parallel = parallel; }
+
+  protected:
+    RootsType   m_roots;
+    VectorXi    m_iterations;
+    VectorXi    m_isConverged;
+    int         m_maxIterations;
+    bool        m_parallel;
+};
+
+template< typename _Scalar, int _Deg >
+template< typename OtherPolynomials >
+void BatchPolynomialSolver<_Scalar,_Deg>::compute( const OtherPolynomials& polys )
+{
+  const int count = polys.cols();
+  m_roots.resize( polys.rows()-1, count );
+  m_iterations.resize( count );
+  m_isConverged.resize( count );
+
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel if(m_parallel && count>1)
+#endif
+  {
+    SolverType solver;
+    solver.setMaxIterations( m_maxIterations );
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp for schedule(static)
+#endif
+    for( int k=0; k<count; ++k )
+    {
+      solver.compute( polys.col(k) );
+      m_roots.col(k) = solver.roots();
+      m_iterations[k] = solver.iterations();
+      m_isConverged[k] = solver.converged();
+    }
+  }
+}
+
+#endif // EIGEN_ABERTH_POLYNOMIAL_SOLVER_H
@@ -355,7 +355,7 @@ class PolynomialSolver : public PolynomialSolverBase<_Scalar,_Deg>
       assert( Scalar(0) != poly[poly.size()-1] );
       ei_companion<Scalar,_Deg> companion( poly );
       companion.balance();
-      m_eigenSolver.compute( companion.denseMatrix() );
+      m_eigenSolver.compute( companion.denseMatrix(), false );
       m_roots = m_eigenSolver.eigenvalues();
     }
 
@@ -73,6 +73,173 @@ T poly_eval( const Polynomials& poly, const T& x )
   }
 }
 
+/** \internal
+ * \brief Functor evaluating a polynomial, used by poly_eval_array().
+ *
+ * The polynomial is evaluated by the second order Horner scheme: the coefficients of
+ * even and odd degrees are accumulated in two independent Horner recurrences in
+ * \f$ x^2 \f$, which halves the length of the dependency chain of the packet path.
+ * The scalar path uses the same scheme so that both give the same results.
+ */
+template<typename Scalar>
+struct ei_scalar_poly_eval_op {
+  typedef typename ei_packet_traits<Scalar>::type PacketScalar;
+  template<typename Polynomial>
+  ei_scalar_poly_eval_op(const Polynomial& poly) : m_coeffs(poly) { ei_assert(poly.size() > 0); }
+  EIGEN_STRONG_INLINE Scalar operator() (const Scalar& x) const
+  {
+    const int n = m_coeffs.size();
+    if( 1 == n ){
+      return m_coeffs[0]; }
+    const Scalar x2 = x*x;
+    Scalar hi = m_coeffs[n-1], lo = m_coeffs[n-2];
+    int k = n-3;
+    for( ; k>=1; k-=2 )
+    {
+      hi = hi*x2 + m_coeffs[k];
+      lo = lo*x2 + m_coeffs[k-1];
+    }
+    const Scalar val = hi*x + lo;
+    return (0 == k) ? val*x + m_coeffs[0] : val;
+  }
+  EIGEN_STRONG_INLINE const PacketScalar packetOp(const PacketScalar& x) const
+  {
+    const int n = m_coeffs.size();
+    if( 1 == n ){
+      return ei_pset1(m_coeffs[0]); }
+    const PacketScalar x2 = ei_pmul(x,x);
+    PacketScalar hi = ei_pset1(m_coeffs[n-1]), lo = ei_pset1(m_coeffs[n-2]);
+    int k = n-3;
+    for( ; k>=1; k-=2 )
+    {
+      hi = ei_pmadd(hi, x2, ei_pset1(m_coeffs[k]));
+      lo = ei_pmadd(lo, x2, ei_pset1(m_coeffs[k-1]));
+    }
+    const PacketScalar val = ei_pmadd(hi, x, lo);
+    return (0 == k) ? ei_pmadd(val, x, ei_pset1(m_coeffs[0])) : val;
+  }
+  Matrix<Scalar,Dynamic,1> m_coeffs;
+};
+template<typename Scalar>
+struct ei_functor_traits<ei_scalar_poly_eval_op<Scalar> >
+{ enum { Cost = 8 * (NumTraits<Scalar>::AddCost + NumTraits<Scalar>::MulCost), PacketAccess = ei_packet_traits<Scalar>::size>1 }; };
+
+/** \ingroup Polynomials_Module
+ * \returns an expression of the polynomial evaluated at each coefficient of the array \a x.
+ *
+ * \param[in] poly : the vector of coefficients of the polynomial ordered
+ *  by degrees i.e. poly[i] is the coefficient of degree i of the polynomial
+ *  e.g. \f$ 1 + 3x^2 \f$ is stored as a vector \f$ [ 1, 0, 3 ] \f$.
+ * \param[in] x : the array of values to evaluate the polynomial at.
+ *
+ * The evaluation is vectorized, and the expression stores a copy of \a poly.
+ * As for poly_eval_horner(), the evaluation is stable for \f$ |x| \le 1 \f$.
+ *
+ * \sa poly_eval_array(const Polynomial&, const ArrayBase<Derived>&, ArrayBase<OtherDerived>&)
+ */
+template <typename Polynomial, typename Derived>
+inline const CwiseUnaryOp<ei_scalar_poly_eval_op<typename Derived::Scalar>, Derived>
+poly_eval_array( const Polynomial& poly, const ArrayBase<Derived>& x )
+{
+  typedef ei_scalar_poly_eval_op<typename Derived::Scalar> Op;
+  return CwiseUnaryOp<Op, Derived>( x.derived(), Op(poly) );
+}
+
+/** \ingroup Polynomials_Module
+ * Evaluates the polynomial at each coefficient of the one-dimensional array \a x,
+ * and stores the values in \a result. This is the same as
+ * \code result = poly_eval_array( poly, x ); \endcode
+ * except that the evaluation is split among the threads when OpenMP is enabled and
+ * the input is large enough.
+ */
+template <typename Polynomial, typename Derived, typename OtherDerived>
+void poly_eval_array( const Polynomial& poly, const ArrayBase<Derived>& x, ArrayBase<OtherDerived>& result )
+{
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(OtherDerived)
+  typedef ei_scalar_poly_eval_op<typename Derived::Scalar> Op;
+  enum { ParallelThreshold = 1<<16,
+         PacketSize = ei_packet_traits<typename Derived::Scalar>::size };
+
+  const int n = x.size();
+  result.derived().resize( n );
+  const Op op( poly );
+
+#ifdef EIGEN_HAS_OPENMP
+  const int threads = std::min( omp_get_max_threads(), n/PacketSize );
+  if( threads>1 && omp_get_num_threads()==1 && n*poly.size()>=ParallelThreshold )
+  {
+    #pragma omp parallel num_threads(threads)
+    {
+      // the chunks start on packet boundaries to keep the alignment of the input
+      const int t = omp_get_thread_num();
+      const int begin = ((n*t)/threads) & ~(PacketSize-1);
+      const int end = (t+1==threads) ? n : ((n*(t+1))/threads) & ~(PacketSize-1);
+      result.derived().segment( begin, end-begin )
+        = CwiseUnaryOp<Op, Derived>( x.derived(), op ).segment( begin, end-begin );
+    }
+    return;
+  }
+#endif
+  result.derived() = CwiseUnaryOp<Op, Derived>( x.derived(), op );
+}
+
+/** \ingroup Polynomials_Module
+ * Evaluates many polynomials at the same point.
+ *
+ * \param[in] polys : the matrix whose columns are the coefficients of the polynomials,
+ *  ordered by degrees as for poly_eval().
+ * \param[in] x : the value to evaluate the polynomials at.
+ * \param[out] result : the vector of the values of the polynomials, result[k] being the value
+ *  of the k-th column of \a polys.
+ *
+ * The powers of \a x, or of \f$ 1/x \f$ when \f$ |x| > 1 \f$ as in poly_eval(), are computed
+ * once, so that the evaluation is a vectorized matrix-vector product. The columns are split
+ * among the threads when OpenMP is enabled and there are enough of them.
+ */
+template <typename Polynomials, typename ResultType>
+void poly_eval_batch( const Polynomials& polys, const typename Polynomials::Scalar& x, ResultType& result )
+{
+  typedef typename Polynomials::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real Real;
+  enum { ParallelThreshold = 1<<16 };
+
+  const int size = polys.rows(), count = polys.cols();
+  result.resize( count );
+  if( 0 == count ){
+    return; }
+
+  // powers of x in increasing degree order, or of 1/x in decreasing degree order
+  const bool reversed = ei_abs2( x ) > Real(1);
+  const Scalar y = reversed ? Scalar(1)/x : x;
+  Matrix<Scalar,Polynomials::RowsAtCompileTime,1,0,Polynomials::MaxRowsAtCompileTime,1> powers( size );
+  Scalar yk(1);
+  for( int k=0; k<size; ++k )
+  {
+    powers[reversed ? size-1-k : k] = yk;
+    yk *= y;
+  }
+
+#ifdef EIGEN_HAS_OPENMP
+  const int threads = std::min( omp_get_max_threads(), count );
+  if( threads>1 && omp_get_num_threads()==1 && size*count>=ParallelThreshold )
+  {
+    #pragma omp parallel num_threads(threads)
+    {
+      const int t = omp_get_thread_num();
+      const int begin = (count*t)/threads;
+      const int end = (count*(t+1))/threads;
+      result.segment( begin, end-begin ).noalias() = polys.block( 0, begin, size, end-begin ).transpose() * powers;
+    }
+  }
+  else
+#endif
+  result.noalias() = polys.transpose() * powers;
+
+  if( reversed ){
+    result *= std::pow( x, Scalar(size-1) ); }
+}
+
 /** \ingroup Polynomials_Module
  * \returns a maximum bound for the absolute value of any root of the polynomial.
  *
@@ -0,0 +1,506 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_BINARY_SERIALIZATION_H
+#define EIGEN_BINARY_SERIALIZATION_H
+
+/** \internal
+  * Identifies the scalar type of a record. Scalar types which are not listed here
+  * are identified by their size only.
+  */
+template<typename Scalar> struct ei_binary_scalar_code { enum { ret = 0 }; };
+template<> struct ei_binary_scalar_code<float>                      { enum { ret = 1 }; };
+template<> struct ei_binary_scalar_code<double>                     { enum { ret = 2 }; };
+template<> struct ei_binary_scalar_code<long double>                { enum { ret = 3 }; };
+template<> struct ei_binary_scalar_code<std::complex<float> >       { enum { ret = 4 }; };
+template<> struct ei_binary_scalar_code<std::complex<double> >      { enum { ret = 5 }; };
+template<> struct ei_binary_scalar_code<std::complex<long double> > { enum { ret = 6 }; };
+template<> struct ei_binary_scalar_code<int>                        { enum { ret = 7 }; };
+
+/** \internal
+  * The header of a record, 32 bytes long:
+  *  - the magic bytes "EIGB", the version of the format and the kind of object,
+  *  - the code of the scalar type, the size of a scalar and the size of its real components,
+  *  - the flags giving the storage order and the byte order of the record,
+  *  - 6 reserved bytes,
+  *  - the rows, the columns and a value depending on the kind of object, as 32 bits integers.
+  *
+  * The indices of the sparse matrices and of the permutations are also stored as 32 bits integers.
+  */
+struct ei_binary_header
+{
+  enum { Version = 1, Size = 32 };
+  enum { DenseRecord = 1, SparseRecord = 2, LLTRecord = 3, PartialPivLURecord = 4, SparseLLTRecord = 5 };
+  enum { RowMajorFlag = 0x1, BigEndianFlag = 0x2 };
+
+  ei_binary_header() : kind(0), scalarCode(0), scalarSize(0), realSize(0), flags(0), rows(0), cols(0), extra(0) {}
+
+  template<typename Scalar>
+  void setScalar()
+  {
+    scalarCode = ei_binary_scalar_code<Scalar>::ret;
+    scalarSize = sizeof(Scalar);
+    realSize = sizeof(typename NumTraits<Scalar>::Real);
+  }
+
+  template<typename Scalar>
+  bool hasScalar() const
+  {
+    return scalarCode == int(ei_binary_scalar_code<Scalar>::ret)
+        && scalarSize == int(sizeof(Scalar))
+        && realSize == int(sizeof(typename NumTraits<Scalar>::Real));
+  }
+
+  bool isRowMajor() const { return flags & RowMajorFlag; }
+  /** \returns whether the rows x cols coefficients of a dense record can be indexed by an int */
+  bool hasDenseSizes() const
+  { return rows >= 0 && cols >= 0 && (cols == 0 || rows <= std::numeric_limits<int>::max() / cols); }
+  /** \returns whether the record has to be byte swapped to be read on this machine */
+  bool needsSwap() const { return bool(flags & BigEndianFlag) != isBigEndian(); }
+
+  static bool isBigEndian()
+  {
+    const int one = 1;
+    return *reinterpret_cast<const unsigned char*>(&one) == 0;
+  }
+
+  bool write(std::ostream& os) const
+  {
+    unsigned char bytes[Size] = { 'E', 'I', 'G', 'B', Version, (unsigned char)kind,
+                                  (unsigned char)scalarCode, (unsigned char)scalarSize, (unsigned char)realSize,
+                                  (unsigned char)(flags | (isBigEndian() ? BigEndianFlag : 0)) };
+    const int values[3] = { rows, cols, extra };
+    std::memcpy(bytes + 16, values, sizeof(values));
+    os.write(reinterpret_cast<const char*>(bytes), Size);
+    return !os.fail();
+  }
+
+  bool read(std::istream& is)
+  {
+    unsigned char bytes[Size];
+    if (!is.read(reinterpret_cast<char*>(bytes), Size))
+      return false;
+    if (bytes[0]!='E' || bytes[1]!='I' || bytes[2]!='G' || bytes[3]!='B' || bytes[4]!=Version)
+      return false;
+    kind = bytes[5];
+    scalarCode = bytes[6];
+    scalarSize = bytes[7];
+    realSize = bytes[8];
+    flags = bytes[9];
+    int values[3];
+    if (needsSwap())
+      swapBytes(bytes + 16, 3, sizeof(int));
+    std::memcpy(values, bytes + 16, sizeof(values));
+    rows = values[0];
+    cols = values[1];
+    extra = values[2];
+    return rows >= 0 && cols >= 0;
+  }
+
+  /** Reverses the bytes of each of the \a count words of \a wordSize bytes starting at \a data */
+  static void swapBytes(void* data, std::size_t count, std::size_t wordSize)
+  {
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    for (std::size_t i = 0; i < count; ++i, bytes += wordSize)
+      std::reverse(bytes, bytes + wordSize);
+  }
+
+  int kind, scalarCode, scalarSize, realSize, flags;
+  int rows, cols, extra;
+};
+
+/** \internal
+  * \returns false if the stream \a is is known to hold less than \a bytes more bytes, so that
+  * a corrupted record announcing more data than available is rejected before anything is allocated.
+  * Nothing is known of streams which cannot be positioned, whose reads will fail instead.
+  */
+inline bool ei_binary_available(std::istream& is, double bytes)
+{
+  const std::streampos pos = is.tellg();
+  if (pos == std::streampos(-1))
+    return true;
+  if (!is.seekg(0, std::ios::end))
+  {
+    is.clear();
+    is.seekg(pos);
+    return true;
+  }
+  const std::streampos end = is.tellg();
+  is.seekg(pos);
+  return double(end - pos) >= bytes;
+}
+
+/** \internal Writes the \a count scalars starting at \a data in one block */
+template<typename Scalar>
+bool ei_binary_write_array(std::ostream& os, const Scalar* data, std::size_t count)
+{
+  if (count)
+    os.write(reinterpret_cast<const char*>(data), std::streamsize(count * sizeof(Scalar)));
+  return !os.fail();
+}
+
+/** \internal Reads \a count scalars to \a data in one block, reversing the bytes of their real components if \a swap is true */
+template<typename Scalar>
+bool ei_binary_read_array(std::istream& is, Scalar* data, std::size_t count, bool swap)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  if (count==0)
+    return !is.fail();
+  if (!is.read(reinterpret_cast<char*>(data), std::streamsize(count * sizeof(Scalar))))
+    return false;
+  if (swap)
+    ei_binary_header::swapBytes(data, count * (sizeof(Scalar)/sizeof(RealScalar)), sizeof(RealScalar));
+  return true;
+}
+
+/** \internal Writes the plain dense matrix or array \a m */
+template<typename Derived>
+bool ei_binary_write_dense(std::ostream& os, const DenseStorageBase<Derived>& m)
+{
+  typedef typename Derived::Scalar Scalar;
+  ei_binary_header header;
+  header.kind = ei_binary_header::DenseRecord;
+  header.setScalar<Scalar>();
+  header.flags = Derived::IsRowMajor ? ei_binary_header::RowMajorFlag : 0;
+  header.rows = m.rows();
+  header.cols = m.cols();
+  return header.write(os) && ei_binary_write_array(os, m.data(), std::size_t(m.size()));
+}
+
+/** \ingroup Serialization_Module
+  *
+  * Writes the dense matrix or array \a m to the binary stream \a os. Expressions are evaluated first,
+  * while the storage of plain matrices and arrays is written in a single block.
+  *
+  * \returns true if the record was written successfully
+  *
+  * \sa readBinary(std::istream&, DenseStorageBase<Derived>&)
+  */
+template<typename Derived>
+bool writeBinary(std::ostream& os, const DenseBase<Derived>& m)
+{
+  // no copy for plain objects
+  const typename Derived::PlainObject& plain = m.derived();
+  return ei_binary_write_dense(os, plain);
+}
+
+/** \ingroup Serialization_Module
+  *
+  * Reads a dense record written by writeBinary() from \a is to the matrix or array \a m, which is resized.
+  * A record of the other storage order is transposed in memory, and a record of the other byte order is
+  * converted.
+  *
+  * \returns false, leaving \a m in an unspecified state, if the stream failed, if the record has not the
+  * scalar type of \a m, or if its sizes do not match the fixed sizes of \a m
+  */
+template<typename Derived>
+bool readBinary(std::istream& is, DenseStorageBase<Derived>& m)
+{
+  typedef typename Derived::Scalar Scalar;
+  ei_binary_header header;
+  if (!header.read(is) || header.kind != ei_binary_header::DenseRecord || !header.hasScalar<Scalar>())
+    return false;
+  const int rows = header.rows, cols = header.cols;
+  if ((Derived::RowsAtCompileTime!=Dynamic && rows!=Derived::RowsAtCompileTime)
+   || (Derived::ColsAtCompileTime!=Dynamic && cols!=Derived::ColsAtCompileTime)
+   || (Derived::MaxRowsAtCompileTime!=Dynamic && rows>Derived::MaxRowsAtCompileTime)
+   || (Derived::MaxColsAtCompileTime!=Dynamic && cols>Derived::MaxColsAtCompileTime))
+    return false;
+  if (!header.hasDenseSizes() || !ei_binary_available(is, double(rows) * double(cols) * sizeof(Scalar)))
+    return false;
+
+  m.resize(rows, cols);
+  // the storage orders only differ in memory for actual matrices
+  if (header.isRowMajor() == bool(Derived::IsRowMajor) || rows==1 || cols==1)
+    return ei_binary_read_array(is, m.data(), std::size_t(m.size()), header.needsSwap());
+
+  Matrix<Scalar,Dynamic,1> buffer;
+  buffer.resize(m.size());
+  if (!ei_binary_read_array(is, buffer.data(), std::size_t(m.size()), header.needsSwap()))
+    return false;
+  for (int j = 0; j < cols; ++j)
+    for (int i = 0; i < rows; ++i)
+      m.coeffRef(i,j) = header.isRowMajor() ? buffer.coeff(i*cols+j) : buffer.coeff(j*rows+i);
+  return true;
+}
+
+/** \ingroup Serialization_Module
+  *
+  * Writes the sparse matrix \a m to the binary stream \a os: the outer index, inner index and value
+  * arrays of its compressed storage are written in three blocks.
+  *
+  * \returns true if the record was written successfully
+  */
+template<typename Scalar, int Options>
+bool writeBinary(std::ostream& os, const SparseMatrix<Scalar,Options>& m)
+{
+  ei_binary_header header;
+  header.kind = ei_binary_header::SparseRecord;
+  header.setScalar<Scalar>();
+  header.flags = (Options & RowMajorBit) ? ei_binary_header::RowMajorFlag : 0;
+  header.rows = m.rows();
+  header.cols = m.cols();
+  header.extra = m.nonZeros();
+  const std::size_t nnz = std::size_t(m.nonZeros());
+  return header.write(os)
+      && ei_binary_write_array(os, m._outerIndexPtr(), std::size_t(m.outerSize()+1))
+      && (nnz==0 || (ei_binary_write_array(os, m._innerIndexPtr(), nnz) && ei_binary_write_array(os, m._valuePtr(), nnz)));
+}
+
+/** \internal
+  * Reads the arrays of the sparse record of header \a header, which has the storage order of \a m.
+  * The indices are read and checked first: the outer starts must be non decreasing from 0 to the
+  * number of non zeros, and the inner indices of each inner vector must be in range and sorted.
+  */
+template<typename Scalar, int Options>
+bool ei_binary_read_sparse(std::istream& is, const ei_binary_header& header, SparseMatrix<Scalar,Options>& m)
+{
+  const bool rowMajor = Options & RowMajorBit;
+  const int nnz = header.extra;
+  const int outerSize = rowMajor ? header.rows : header.cols;
+  const int innerSize = rowMajor ? header.cols : header.rows;
+  if (outerSize == std::numeric_limits<int>::max() || double(nnz) > double(outerSize) * double(innerSize)
+      || !ei_binary_available(is, double(outerSize+1) * sizeof(int) + double(nnz) * (sizeof(int) + sizeof(Scalar))))
+    return false;
+
+  // resize() as the constructors reject empty vectors
+  VectorXi outerIndex, innerIndex;
+  outerIndex.resize(outerSize+1);
+  innerIndex.resize(nnz);
+  if (!ei_binary_read_array(is, outerIndex.data(), std::size_t(outerSize+1), header.needsSwap())
+      || !ei_binary_read_array(is, innerIndex.data(), std::size_t(nnz), header.needsSwap()))
+    return false;
+  if (outerIndex.coeff(0) != 0 || outerIndex.coeff(outerSize) != nnz)
+    return false;
+  for (int j = 0; j < outerSize; ++j)
+  {
+    if (outerIndex.coeff(j+1) < outerIndex.coeff(j))
+      return false;
+    for (int k = outerIndex.coeff(j); k < outerIndex.coeff(j+1); ++k)
+      if (innerIndex.coeff(k) < 0 || innerIndex.coeff(k) >= innerSize
+          || (k > outerIndex.coeff(j) && innerIndex.coeff(k) <= innerIndex.coeff(k-1)))
+        return false;
+  }
+
+  m.resize(header.rows, header.cols);
+  m.resizeNonZeros(nnz);
+  std::copy(outerIndex.data(), outerIndex.data() + outerSize + 1, m._outerIndexPtr());
+  std::copy(innerIndex.data(), innerIndex.data() + nnz, m._innerIndexPtr());
+  if (!ei_binary_read_array(is, m._valuePtr(), std::size_t(nnz), header.needsSwap()))
+  {
+    m.setZero();
+    return false;
+  }
+  return true;
+}
+
+/** \ingroup Serialization_Module
+  *
+  * Reads a sparse record written by writeBinary() from \a is to \a m. A record of the other storage
+  * order is read to a temporary and converted.
+  *
+  * \returns false if the stream failed, if the record has not the scalar type of \a m, or if its sizes or
+  * its indices are not consistent. \a m is then either left untouched or empty.
+  */
+template<typename Scalar, int Options>
+bool readBinary(std::istream& is, SparseMatrix<Scalar,Options>& m)
+{
+  ei_binary_header header;
+  if (!header.read(is) || header.kind != ei_binary_header::SparseRecord || !header.hasScalar<Scalar>() || header.extra < 0)
+    return false;
+  if (header.isRowMajor() != bool(Options & RowMajorBit))
+  {
+    SparseMatrix<Scalar,Options ^ RowMajorBit> other;
+    if (!ei_binary_read_sparse(is, header, other))
+      return false;
+    m = other;
+    return true;
+  }
+  return ei_binary_read_sparse(is, header, m);
+}
+
+/** \internal
+  * Writes and reads the decompositions, which declare it as a friend. The record of a decomposition
+  * is a header followed by the records of its members.
+  */
+template<typename MatrixType, int UpLo>
+struct ei_binary_serializer<LLT<MatrixType,UpLo> >
+{
+  typedef LLT<MatrixType,UpLo> LLTType;
+
+  static bool write(std::ostream& os, const LLTType& llt)
+  {
+    ei_binary_header header;
+    header.kind = ei_binary_header::LLTRecord;
+    header.setScalar<typename MatrixType::Scalar>();
+    header.rows = llt.rows();
+    header.cols = llt.cols();
+    header.extra = UpLo;
+    return header.write(os) && writeBinary(os, llt.matrixLLT());
+  }
+
+  static bool read(std::istream& is, LLTType& llt)
+  {
+    ei_binary_header header;
+    llt.m_isInitialized = false;
+    if (!header.read(is) || header.kind != ei_binary_header::LLTRecord
+        || !header.hasScalar<typename MatrixType::Scalar>() || header.extra != UpLo)
+      return false;
+    if (!readBinary(is, llt.m_matrix) || llt.m_matrix.rows() != header.rows || llt.m_matrix.cols() != header.cols)
+      return false;
+    llt.m_isInitialized = true;
+    return true;
+  }
+};
+
+template<typename MatrixType>
+struct ei_binary_serializer<PartialPivLU<MatrixType> >
+{
+  typedef PartialPivLU<MatrixType> LUType;
+
+  static bool write(std::ostream& os, const LUType& lu)
+  {
+    ei_binary_header header;
+    header.kind = ei_binary_header::PartialPivLURecord;
+    header.setScalar<typename MatrixType::Scalar>();
+    header.rows = lu.rows();
+    header.cols = lu.cols();
+    header.extra = lu.m_det_p;
+    return header.write(os)
+        && writeBinary(os, lu.matrixLU())
+        && writeBinary(os, lu.permutationP().indices())
+        && writeBinary(os, lu.m_rowsTranspositions);
+  }
+
+  static bool read(std::istream& is, LUType& lu)
+  {
+    ei_binary_header header;
+    lu.m_isInitialized = false;
+    if (!header.read(is) || header.kind != ei_binary_header::PartialPivLURecord
+        || !header.hasScalar<typename MatrixType::Scalar>())
+      return false;
+    if (!readBinary(is, lu.m_lu) || !readBinary(is, lu.m_p.indices()) || !readBinary(is, lu.m_rowsTranspositions))
+      return false;
+    const int size = lu.m_lu.rows();
+    if (size != header.rows || lu.m_lu.cols() != header.cols
+        || lu.m_p.indices().size() != size || lu.m_rowsTranspositions.size() != size)
+      return false;
+    lu.m_det_p = header.extra;
+    lu.m_isInitialized = true;
+    return true;
+  }
+};
+
+template<typename MatrixType>
+struct ei_binary_serializer<SparseLLT<MatrixType> >
+{
+  typedef SparseLLT<MatrixType> LLTType;
+  typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
+
+  static bool write(std::ostream& os, const LLTType& llt)
+  {
+    ei_binary_header header;
+    header.kind = ei_binary_header::SparseLLTRecord;
+    header.setScalar<typename MatrixType::Scalar>();
+    header.rows = llt.matrixL().rows();
+    header.cols = llt.matrixL().cols();
+    header.extra = llt.flags();
+    const Matrix<RealScalar,2,1> parameters(llt.precision(), llt.succeeded() ? RealScalar(1) : RealScalar(0));
+    return header.write(os) && writeBinary(os, parameters) && writeBinary(os, llt.matrixL());
+  }
+
+  static bool read(std::istream& is, LLTType& llt)
+  {
+    ei_binary_header header;
+    Matrix<RealScalar,2,1> parameters;
+    llt.m_succeeded = false;
+    if (!header.read(is) || header.kind != ei_binary_header::SparseLLTRecord
+        || !header.hasScalar<typename MatrixType::Scalar>())
+      return false;
+    if (!readBinary(is, parameters) || !readBinary(is, llt.m_matrix)
+        || llt.m_matrix.rows() != header.rows || llt.m_matrix.cols() != header.cols)
+      return false;
+    llt.m_flags = header.extra;
+    llt.m_precision = parameters.coeff(0);
+    llt.m_status = 0;
+    llt.m_succeeded = parameters.coeff(1) != RealScalar(0);
+    return true;
+  }
+};
+
+/** \ingroup Serialization_Module
+  *
+  * Writes the Cholesky factorization \a llt to \a os, so that it can be restored by readBinary()
+  * without being recomputed.
+  */
+template<typename MatrixType, int UpLo>
+bool writeBinary(std::ostream& os, const LLT<MatrixType,UpLo>& llt)
+{ return ei_binary_serializer<LLT<MatrixType,UpLo> >::write(os, llt); }
+
+/** \ingroup Serialization_Module
+  *
+  * Restores in \a llt the Cholesky factorization written by writeBinary().
+  *
+  * \returns false, leaving \a llt uninitialized, if the record could not be read
+  */
+template<typename MatrixType, int UpLo>
+bool readBinary(std::istream& is, LLT<MatrixType,UpLo>& llt)
+{ return ei_binary_serializer<LLT<MatrixType,UpLo> >::read(is, llt); }
+
+/** \ingroup Serialization_Module
+  *
+  * Writes the LU factorization \a lu, including its permutation, to \a os.
+  */
+template<typename MatrixType>
+bool writeBinary(std::ostream& os, const PartialPivLU<MatrixType>& lu)
+{ return ei_binary_serializer<PartialPivLU<MatrixType> >::write(os, lu); }
+
+/** \ingroup Serialization_Module
+  *
+  * Restores in \a lu the LU factorization written by writeBinary().
+  *
+  * \returns false, leaving \a lu uninitialized, if the record could not be read
+  */
+template<typename MatrixType>
+bool readBinary(std::istream& is, PartialPivLU<MatrixType>& lu)
+{ return ei_binary_serializer<PartialPivLU<MatrixType> >::read(is, lu); }
+
+/** \ingroup Serialization_Module
+  *
+  * Writes the sparse Cholesky factor of \a llt, with its flags and precision, to \a os.
+  * Only the default backend is supported.
+  */
+template<typename MatrixType>
+bool writeBinary(std::ostream& os, const SparseLLT<MatrixType>& llt)
+{ return ei_binary_serializer<SparseLLT<MatrixType> >::write(os, llt); }
+
+/** \ingroup Serialization_Module
+  *
+  * Restores in \a llt the sparse Cholesky factorization written by writeBinary().
+  *
+  * \returns false, leaving \a llt in a failed state, if the record could not be read
+  */
+template<typename MatrixType>
+bool readBinary(std::istream& is, SparseLLT<MatrixType>& llt)
+{ return ei_binary_serializer<SparseLLT<MatrixType> >::read(is, llt); }
+
+#endif // EIGEN_BINARY_SERIALIZATION_H
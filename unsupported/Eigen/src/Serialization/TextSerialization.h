@@ -0,0 +1,592 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_TEXT_SERIALIZATION_H
+#define EIGEN_TEXT_SERIALIZATION_H
+
+/** \internal */
+inline bool ei_text_is_space(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+/** \internal */
+inline std::string ei_text_lower(const char* begin, const char* end)
+{
+  std::string str(begin, end);
+  for (std::size_t i = 0; i < str.size(); ++i)
+    if (str[i] >= 'A' && str[i] <= 'Z')
+      str[i] = char(str[i] - 'A' + 'a');
+  return str;
+}
+
+/** \internal
+  * Conversions between a scalar and its text representation which do not depend on the global locale.
+  * format() writes at most 63 characters to \a buf and returns their number, a \a precision of 0 asking
+  * for a representation which reads back exactly. parse() converts the whole range [begin,end).
+  *
+  * This generic version goes through streams imbued with the classic locale.
+  */
+template<typename Scalar> struct ei_text_scalar
+{
+  static int format(char* buf, const Scalar& x, int precision, char)
+  {
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    std::ostringstream ss;
+    ss.imbue(std::locale::classic());
+    ss.precision(precision > 0 ? precision : std::numeric_limits<RealScalar>::digits10 + 3);
+    ss << x;
+    const std::string str = ss.str();
+    const int length = std::min(int(str.size()), 63);
+    std::memcpy(buf, str.data(), length);
+    return length;
+  }
+
+  static bool parse(const char* begin, const char* end, Scalar& x, char)
+  {
+    std::istringstream ss(std::string(begin, end));
+    ss.imbue(std::locale::classic());
+    return (ss >> x) && (ss >> std::ws).eof();
+  }
+};
+
+/** \internal exact powers of ten representable by a double */
+inline double ei_text_pow10(int e)
+{
+  static const double powers[23] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  return powers[e];
+}
+
+/** \internal
+  * Writes the number 0.d_1...d_n 10^(exponent+1), where d_1 is not zero, to \a buf as printf() does with
+  * the conversion %.ng, and returns the number of characters written.
+  */
+inline int ei_text_format_decimal(char* buf, bool negative, const char* digits, int n, int exponent)
+{
+  int length = 0;
+  if (negative)
+    buf[length++] = '-';
+  int count = n;
+  while (count > 1 && digits[count-1] == '0') --count;
+  if (exponent < -4 || exponent >= n)
+  {
+    buf[length++] = digits[0];
+    if (count > 1)
+    {
+      buf[length++] = '.';
+      for (int k = 1; k < count; ++k) buf[length++] = digits[k];
+    }
+    buf[length++] = 'e';
+    buf[length++] = exponent < 0 ? '-' : '+';
+    const int e = std::abs(exponent);
+    if (e >= 100) buf[length++] = char('0' + e / 100);
+    buf[length++] = char('0' + e / 10 % 10);
+    buf[length++] = char('0' + e % 10);
+  }
+  else if (exponent >= 0)
+  {
+    for (int k = 0; k <= exponent; ++k) buf[length++] = k < count ? digits[k] : '0';
+    if (count > exponent + 1)
+    {
+      buf[length++] = '.';
+      for (int k = exponent + 1; k < count; ++k) buf[length++] = digits[k];
+    }
+  }
+  else
+  {
+    buf[length++] = '0';
+    buf[length++] = '.';
+    for (int k = -1; k > exponent; --k) buf[length++] = '0';
+    for (int k = 0; k < count; ++k) buf[length++] = digits[k];
+  }
+  return length;
+}
+
+/** \internal
+  * Floating point conversions.
+  *
+  * The shortest representation reading back exactly is searched among the roundings to digits10,
+  * digits10+1, ... significant digits of the digits produced by a single %e conversion, the test being
+  * done by strtod() on the digits and the exponent only, which does not depend on the locale. The
+  * conversion gives ExtraDigits more digits than needed so that rounding its result again only differs
+  * from rounding x itself when x is extremely close to the middle of two shorter representations.
+  *
+  * The parser computes numbers of at most 15 significant digits and small exponents exactly with a
+  * product or a quotient of doubles, and hands the other ones to strtod() after translating the decimal
+  * point to the one of the current locale.
+  */
+template<typename Scalar> struct ei_text_floating_scalar
+{
+  enum {
+    Digits10 = std::numeric_limits<Scalar>::digits10,
+    MaxDigits10 = 2 + std::numeric_limits<Scalar>::digits * 30103 / 100000,
+    ExtraDigits = 8
+  };
+
+  static int format(char* buf, Scalar x, int precision, char point)
+  {
+    int length;
+    if (precision > 0 || x != x || x - x != Scalar(0))
+      length = std::sprintf(buf, "%.*g", precision > 0 ? std::min(precision, 40) : int(MaxDigits10), double(x));
+    else
+      return formatShortest(buf, x);
+    if (point != '.')
+      std::replace(buf, buf + length, point, '.');
+    return length;
+  }
+
+  static int formatShortest(char* buf, Scalar x)
+  {
+    // digits of x, the decimal point and the exponent are at fixed places
+    char str[48];
+    std::sprintf(str, "%.*e", int(MaxDigits10 + ExtraDigits) - 1, double(x));
+    const bool negative = str[0] == '-';
+    const char* mantissa = str + (negative ? 1 : 0);
+    char digits[MaxDigits10 + ExtraDigits];
+    digits[0] = mantissa[0];
+    std::memcpy(digits + 1, mantissa + 2, MaxDigits10 + ExtraDigits - 1);
+    const int exponent = std::atoi(mantissa + MaxDigits10 + ExtraDigits + 2);
+
+    char rounded[MaxDigits10], candidate[48];
+    for (int n = Digits10; ; ++n)
+    {
+      std::memcpy(rounded, digits, n);
+      int roundedExponent = exponent;
+      if (roundsUp(digits, n))
+      {
+        int k = n - 1;
+        while (k >= 0 && rounded[k] == '9')
+          rounded[k--] = '0';
+        if (k >= 0)
+          ++rounded[k];
+        else
+        {
+          rounded[0] = '1';
+          ++roundedExponent;
+        }
+      }
+      if (n == MaxDigits10)
+        return ei_text_format_decimal(buf, negative, rounded, n, roundedExponent);
+      int length = 0;
+      if (negative)
+        candidate[length++] = '-';
+      std::memcpy(candidate + length, rounded, n);
+      length += n;
+      std::sprintf(candidate + length, "e%d", roundedExponent - n + 1);
+      if (Scalar(std::strtod(candidate, 0)) == x)
+        return ei_text_format_decimal(buf, negative, rounded, n, roundedExponent);
+    }
+  }
+
+  /** \internal \returns whether digits rounded to n digits are rounded up, the ties going to even as with printf() */
+  static bool roundsUp(const char* digits, int n)
+  {
+    if (digits[n] != '5')
+      return digits[n] > '5';
+    for (int k = n + 1; k < MaxDigits10 + ExtraDigits; ++k)
+      if (digits[k] != '0')
+        return true;
+    return (digits[n-1] - '0') % 2 == 1;
+  }
+
+  static bool parse(const char* begin, const char* end, Scalar& x, char point)
+  {
+    const char* p = begin;
+    const bool negative = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+'))
+      ++p;
+
+    double mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool any = false;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p, any = true)
+      if (mantissa != 0 || *p != '0')
+      {
+        mantissa = 10 * mantissa + (*p - '0');
+        ++digits;
+      }
+    if (p != end && *p == '.')
+      for (++p; p != end && *p >= '0' && *p <= '9'; ++p, any = true)
+      {
+        --exponent;
+        if (mantissa != 0 || *p != '0')
+        {
+          mantissa = 10 * mantissa + (*p - '0');
+          ++digits;
+        }
+      }
+    if (!any)
+      return parseSpecial(p, end, negative, x);
+    if (p != end && (*p == 'e' || *p == 'E'))
+    {
+      ++p;
+      const bool negativeExponent = p != end && *p == '-';
+      if (p != end && (*p == '-' || *p == '+'))
+        ++p;
+      if (p == end || *p < '0' || *p > '9')
+        return false;
+      int e = 0;
+      for (; p != end && *p >= '0' && *p <= '9'; ++p)
+        if (e < 100000)
+          e = 10 * e + (*p - '0');
+      exponent += negativeExponent ? -e : e;
+    }
+    if (p != end)
+      return false;
+
+    if (digits <= 15 && exponent >= -22 && exponent <= 22)
+    {
+      const double value = exponent < 0 ? mantissa / ei_text_pow10(-exponent) : mantissa * ei_text_pow10(exponent);
+      x = Scalar(negative ? -value : value);
+      return true;
+    }
+    return parseSlow(begin, end, x, point);
+  }
+
+  static bool parseSpecial(const char* p, const char* end, bool negative, Scalar& x)
+  {
+    const std::string word = ei_text_lower(p, end);
+    if (word == "inf" || word == "infinity")
+      x = negative ? -std::numeric_limits<Scalar>::infinity() : std::numeric_limits<Scalar>::infinity();
+    else if (word == "nan")
+      x = std::numeric_limits<Scalar>::quiet_NaN();
+    else
+      return false;
+    return true;
+  }
+
+  static bool parseSlow(const char* begin, const char* end, Scalar& x, char point)
+  {
+    std::string str(begin, end);
+    std::replace(str.begin(), str.end(), '.', point);
+    char* last;
+    x = Scalar(std::strtod(str.c_str(), &last));
+    return last == str.c_str() + str.size();
+  }
+};
+
+template<> struct ei_text_scalar<float> : ei_text_floating_scalar<float> {};
+template<> struct ei_text_scalar<double> : ei_text_floating_scalar<double> {};
+
+template<> struct ei_text_scalar<int>
+{
+  static int format(char* buf, int x, int, char)
+  {
+    char digits[16];
+    int count = 0;
+    unsigned int value = x < 0 ? 0u - unsigned(x) : unsigned(x);
+    do { digits[count++] = char('0' + value % 10); value /= 10; } while (value);
+    int length = 0;
+    if (x < 0)
+      buf[length++] = '-';
+    while (count)
+      buf[length++] = digits[--count];
+    return length;
+  }
+
+  static bool parse(const char* begin, const char* end, int& x, char)
+  {
+    const char* p = begin;
+    const bool negative = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+'))
+      ++p;
+    if (p == end)
+      return false;
+    const unsigned int limit = negative ? 0u - unsigned(std::numeric_limits<int>::min()) : unsigned(std::numeric_limits<int>::max());
+    unsigned int value = 0;
+    for (; p != end; ++p)
+    {
+      const unsigned int digit = unsigned(*p - '0');
+      if (digit > 9 || value > (limit - digit) / 10)
+        return false;
+      value = 10 * value + digit;
+    }
+    x = negative ? int(0u - value) : int(value);
+    return true;
+  }
+};
+
+/** \internal removes the white spaces at both ends of [begin,end) */
+inline void ei_text_trim(const char*& begin, const char*& end)
+{
+  while (begin != end && ei_text_is_space(*begin)) ++begin;
+  while (end != begin && ei_text_is_space(end[-1])) --end;
+}
+
+inline std::string ei_text_trim(const std::string& str)
+{
+  const char* begin = str.data();
+  const char* end = begin + str.size();
+  ei_text_trim(begin, end);
+  return std::string(begin, end);
+}
+
+/** \internal removes \a prefix and \a suffix from the trimmed range [begin,end), \returns false if one of them is missing */
+inline bool ei_text_strip(const char*& begin, const char*& end, const std::string& prefix, const std::string& suffix)
+{
+  if (std::size_t(end - begin) < prefix.size() + suffix.size()
+   || !std::equal(prefix.begin(), prefix.end(), begin)
+   || !std::equal(suffix.begin(), suffix.end(), end - suffix.size()))
+    return false;
+  begin += prefix.size();
+  end -= suffix.size();
+  ei_text_trim(begin, end);
+  return true;
+}
+
+/** \internal
+  * Splits a range of text at the occurrences of a separator, the tokens being trimmed. An empty separator
+  * stands for runs of white spaces.
+  */
+class ei_text_tokenizer
+{
+  public:
+    ei_text_tokenizer(const char* begin, const char* end, const std::string& separator)
+      : m_pos(begin), m_end(end), m_separator(separator), m_done(false)
+    {}
+
+    bool next(const char*& begin, const char*& end)
+    {
+      if (m_separator.empty())
+      {
+        while (m_pos != m_end && ei_text_is_space(*m_pos)) ++m_pos;
+        if (m_pos == m_end)
+          return false;
+        begin = m_pos;
+        while (m_pos != m_end && !ei_text_is_space(*m_pos)) ++m_pos;
+        end = m_pos;
+        return true;
+      }
+      if (m_done)
+        return false;
+      begin = m_pos;
+      end = std::search(m_pos, m_end, m_separator.begin(), m_separator.end());
+      if (end == m_end)
+        m_done = true;
+      else
+        m_pos = end + m_separator.size();
+      ei_text_trim(begin, end);
+      return true;
+    }
+
+  protected:
+    const char* m_pos;
+    const char* m_end;
+    const std::string& m_separator;
+    bool m_done;
+};
+
+/** \internal the parts of an IOFormat which delimit the coefficients, without their white spaces */
+struct ei_text_layout
+{
+  ei_text_layout(const IOFormat& fmt)
+    : matPrefix(ei_text_trim(fmt.matPrefix)), matSuffix(ei_text_trim(fmt.matSuffix)),
+      rowPrefix(ei_text_trim(fmt.rowPrefix)), rowSuffix(ei_text_trim(fmt.rowSuffix)),
+      rowSeparator(ei_text_trim(fmt.rowSeparator)), coeffSeparator(ei_text_trim(fmt.coeffSeparator))
+  {
+    if (rowSeparator.empty())
+      rowSeparator = "\n";
+  }
+  std::string matPrefix, matSuffix, rowPrefix, rowSuffix, rowSeparator, coeffSeparator;
+};
+
+/** \internal parses the row \a i of \a m from [begin,end), \returns false unless it has exactly m.cols() valid coefficients */
+template<typename Derived>
+bool ei_text_read_row(const char* begin, const char* end, const ei_text_layout& layout,
+                      DenseStorageBase<Derived>& m, int i, char point)
+{
+  typedef typename Derived::Scalar Scalar;
+  if (!ei_text_strip(begin, end, layout.rowPrefix, layout.rowSuffix))
+    return false;
+  ei_text_tokenizer tokens(begin, end, layout.coeffSeparator);
+  const char *tokenBegin, *tokenEnd;
+  int j = 0;
+  for (; tokens.next(tokenBegin, tokenEnd); ++j)
+    if (j == m.cols() || !ei_text_scalar<Scalar>::parse(tokenBegin, tokenEnd, m.coeffRef(i,j), point))
+      return false;
+  return j == m.cols();
+}
+
+/** \ingroup Serialization_Module
+  *
+  * Writes the matrix or array \a m to \a os as text laid out by \a fmt, like
+  * \code os << m.format(fmt) \endcode does, but without going through the formatting of the stream for
+  * each coefficient: the output is built in large chunks, and the conversions do not depend on the locale.
+  *
+  * \c FullPrecision gives the shortest representation of each floating point coefficient which reads
+  * back exactly, so that readText() restores \a m exactly.
+  *
+  * \returns true if the text was written successfully
+  *
+  * \sa readText(), writeBinary()
+  */
+template<typename Derived>
+bool writeText(std::ostream& os, const DenseBase<Derived>& m, const IOFormat& fmt = IOFormat())
+{
+  typedef typename Derived::Scalar Scalar;
+  enum { ChunkSize = 1<<16 };
+  // no copy for plain objects
+  const typename Derived::PlainObject& plain = m.derived();
+  const int rows = plain.rows(), cols = plain.cols();
+  const int precision = fmt.precision == StreamPrecision ? int(os.precision())
+                      : fmt.precision == FullPrecision ? 0 : fmt.precision;
+  const char point = *std::localeconv()->decimal_point;
+  char buf[64];
+
+  // to align the columns, the coefficients are formatted once in a row major buffer
+  const bool align = !(fmt.flags & DontAlignCols);
+  std::string formatted;
+  std::vector<std::size_t> offsets;
+  int width = 0;
+  if (align)
+  {
+    offsets.resize(std::size_t(rows) * cols + 1);
+    offsets[0] = 0;
+    for (int i = 0; i < rows; ++i)
+      for (int j = 0; j < cols; ++j)
+      {
+        const int length = ei_text_scalar<Scalar>::format(buf, plain.coeff(i,j), precision, point);
+        width = std::max(width, length);
+        formatted.append(buf, length);
+        offsets[std::size_t(i) * cols + j + 1] = formatted.size();
+      }
+  }
+
+  std::string out;
+  out.reserve(ChunkSize + 1024);
+  out += fmt.matPrefix;
+  for (int i = 0; i < rows; ++i)
+  {
+    if (i)
+      out += fmt.rowSpacer;
+    out += fmt.rowPrefix;
+    for (int j = 0; j < cols; ++j)
+    {
+      if (j)
+        out += fmt.coeffSeparator;
+      if (align)
+      {
+        const std::size_t k = std::size_t(i) * cols + j;
+        const int length = int(offsets[k+1] - offsets[k]);
+        out.append(width - length, ' ');
+        out.append(formatted, offsets[k], length);
+      }
+      else
+        out.append(buf, ei_text_scalar<Scalar>::format(buf, plain.coeff(i,j), precision, point));
+    }
+    out += fmt.rowSuffix;
+    if (i < rows - 1)
+      out += fmt.rowSeparator;
+    if (out.size() >= std::size_t(ChunkSize))
+    {
+      os.write(out.data(), out.size());
+      out.clear();
+    }
+  }
+  out += fmt.matSuffix;
+  os.write(out.data(), out.size());
+  return bool(os);
+}
+
+/** \ingroup Serialization_Module
+  *
+  * Parses the text [\a begin, \a end) laid out by \a fmt to the matrix or array \a m, which is resized. The
+  * white spaces of the prefixes, suffixes and separators of \a fmt are ignored, and an empty coefficient
+  * separator (as in the default IOFormat) stands for any sequence of white spaces. When the row separator
+  * of \a fmt is only made of white spaces, the rows are the non blank lines of the text. For instance,
+  * comma separated values are read with
+  * \code readText(begin, end, m, IOFormat(FullPrecision, DontAlignCols, ",")); \endcode
+  *
+  * The floating point numbers are read independently of the locale. The text only has to be in memory,
+  * so that a memory mapped file can be parsed in place. When OpenMP is enabled, large matrices are parsed
+  * by several threads, each one taking a chunk of rows.
+  *
+  * \returns false, leaving \a m in an unspecified state, if the rows do not have the same number of
+  * coefficients, if the sizes do not match the fixed sizes of \a m, or if a coefficient cannot be parsed
+  *
+  * \sa writeText(), readBinary()
+  */
+template<typename Derived>
+bool readText(const char* begin, const char* end, DenseStorageBase<Derived>& m, const IOFormat& fmt = IOFormat())
+{
+  enum { ParallelThreshold = 1<<15 };
+  const ei_text_layout layout(fmt);
+  ei_text_trim(begin, end);
+  if (!ei_text_strip(begin, end, layout.matPrefix, layout.matSuffix))
+    return false;
+
+  std::vector<std::pair<const char*, const char*> > lines;
+  ei_text_tokenizer rowTokens(begin, end, layout.rowSeparator);
+  const char *rowBegin, *rowEnd;
+  while (rowTokens.next(rowBegin, rowEnd))
+    if (rowBegin != rowEnd)
+      lines.push_back(std::make_pair(rowBegin, rowEnd));
+
+  const int rows = int(lines.size());
+  int cols = 0;
+  if (rows > 0)
+  {
+    rowBegin = lines[0].first;
+    rowEnd = lines[0].second;
+    if (!ei_text_strip(rowBegin, rowEnd, layout.rowPrefix, layout.rowSuffix))
+      return false;
+    ei_text_tokenizer tokens(rowBegin, rowEnd, layout.coeffSeparator);
+    const char *tokenBegin, *tokenEnd;
+    while (tokens.next(tokenBegin, tokenEnd))
+      ++cols;
+  }
+  if ((Derived::RowsAtCompileTime!=Dynamic && rows!=Derived::RowsAtCompileTime)
+   || (Derived::ColsAtCompileTime!=Dynamic && cols!=Derived::ColsAtCompileTime)
+   || (Derived::MaxRowsAtCompileTime!=Dynamic && rows>Derived::MaxRowsAtCompileTime)
+   || (Derived::MaxColsAtCompileTime!=Dynamic && cols>Derived::MaxColsAtCompileTime))
+    return false;
+  m.resize(rows, cols);
+
+  const char point = *std::localeconv()->decimal_point;
+  int failures = 0;
+#ifdef EIGEN_HAS_OPENMP
+  const bool parallel = rows > 1 && omp_get_max_threads() > 1 && omp_get_num_threads() == 1
+                     && m.size() >= ParallelThreshold;
+  #pragma omp parallel for reduction(+:failures) schedule(static) if(parallel)
+#endif
+  for (int i = 0; i < rows; ++i)
+    if (!ei_text_read_row(lines[i].first, lines[i].second, layout, m, i, point))
+      ++failures;
+  return failures == 0;
+}
+
+/** \ingroup Serialization_Module
+  *
+  * Reads the remaining content of \a is and parses it to \a m as readText(const char*, const char*, DenseStorageBase<Derived>&, const IOFormat&) does.
+  */
+template<typename Derived>
+bool readText(std::istream& is, DenseStorageBase<Derived>& m, const IOFormat& fmt = IOFormat())
+{
+  std::ostringstream content;
+  if (is.peek() != std::istream::traits_type::eof() && !(content << is.rdbuf()))
+    return false;
+  const std::string text = content.str();
+  return readText(text.data(), text.data() + text.size(), m, fmt);
+}
+
+#endif // EIGEN_TEXT_SERIALIZATION_H
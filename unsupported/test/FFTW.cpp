@@ -195,7 +195,6 @@ void test_complex(int nfft)
   test_complex_generic<StdVectorContainer,T>(nfft);
   test_complex_generic<EigenVectorContainer,T>(nfft);
 }
-/*
 template <typename T,int nrows,int ncols>
 void test_complex2d()
 {
@@ -223,7 +222,103 @@ void test_complex2d()
     VERIFY( (src-src2).norm() < test_precision<T>() );
     VERIFY( (dst-dst2).norm() < test_precision<T>() );
 }
-*/
+
+template <typename T>
+void test_batch(int nrows,int ncols)
+{
+    typedef typename FFT<T>::Complex Complex;
+    typedef Matrix<Complex,Dynamic,Dynamic> ComplexMatrix;
+    typedef Matrix<T,Dynamic,Dynamic> RealMatrix;
+    FFT<T> fft;
+
+    // columns and rows, including strided blocks
+    ComplexMatrix src = ComplexMatrix::Random(nrows,ncols), dst, dst2(nrows,ncols), back;
+    for (int k=0;k<ncols;++k) {
+        Matrix<Complex,Dynamic,1> tmp;
+        fft.fwd( tmp, src.col(k) );
+        dst2.col(k) = tmp;
+    }
+    fft.fwdCols( dst, src );
+    VERIFY( (dst-dst2).norm() <= test_precision<T>()*dst2.norm() );
+    fft.invCols( back, dst );
+    VERIFY( (back-src).norm() <= test_precision<T>()*src.norm() );
+
+    Matrix<Complex,Dynamic,Dynamic,RowMajor> rowsrc = src.transpose(), rowdst;
+    fft.fwdRows( rowdst, rowsrc );
+    VERIFY( (rowdst-dst2.transpose()).norm() <= test_precision<T>()*dst2.norm() );
+    ComplexMatrix block = src.block(1,1,nrows-2,ncols-1), blockdst;
+    fft.fwdCols( blockdst, src.block(1,1,nrows-2,ncols-1) );
+    ComplexMatrix blockdst2;
+    fft.fwdCols( blockdst2, block );
+    VERIFY( (blockdst-blockdst2).norm() <= test_precision<T>()*blockdst2.norm() );
+
+    // 2-d transforms
+    ComplexMatrix spec, spec2;
+    fft.fwd2( spec, src );
+    fft.fwdRows( spec2, dst2 );
+    VERIFY( (spec-spec2).norm() <= test_precision<T>()*spec2.norm() );
+    fft.inv2( back, spec );
+    VERIFY( (back-src).norm() <= test_precision<T>()*src.norm() );
+
+    // real 2-d transforms, full and half spectrum
+    RealMatrix rsrc = RealMatrix::Random(nrows,ncols), rback;
+    ComplexMatrix csrc = rsrc.template cast<Complex>(), rspec, hspec;
+    fft.fwd2( spec, csrc );
+    fft.fwd2( rspec, rsrc );
+    VERIFY( (rspec-spec).norm() <= test_precision<T>()*spec.norm() );
+    fft.inv2( rback, rspec );
+    VERIFY( (rback-rsrc).norm() <= test_precision<T>()*rsrc.norm() );
+    fft.SetFlag(fft.HalfSpectrum);
+    fft.fwd2( hspec, rsrc );
+    VERIFY( hspec.rows()==nrows/2+1 && hspec.cols()==ncols );
+    VERIFY( (hspec-spec.topRows(nrows/2+1)).norm() <= test_precision<T>()*spec.norm() );
+    fft.inv2( rback, hspec, nrows );
+    VERIFY( rback.rows()==nrows && (rback-rsrc).norm() <= test_precision<T>()*rsrc.norm() );
+}
+
+template <typename T>
+void test_complex3d(int n0,int n1,int n2)
+{
+    typedef typename FFT<T>::Complex Complex;
+    typedef Matrix<Complex,Dynamic,1> ComplexVector;
+    typedef Matrix<T,Dynamic,1> RealVector;
+    const int n = n0*n1*n2;
+    const int nbins = n2/2+1;
+    FFT<T> fft;
+
+    ComplexVector src = ComplexVector::Random(n), dst(n), ref(n), back(n);
+    fft.fwd3( dst.data(), src.data(), n0,n1,n2 );
+    // direct DFT, the last dimension being contiguous
+    T pi = acos( T(-1) );
+    for (int k0=0;k0<n0;++k0) for (int k1=0;k1<n1;++k1) for (int k2=0;k2<n2;++k2) {
+        Complex acc(0);
+        for (int j0=0;j0<n0;++j0) for (int j1=0;j1<n1;++j1) for (int j2=0;j2<n2;++j2) {
+            T phase = -2*pi*( T(k0*j0)/n0 + T(k1*j1)/n1 + T(k2*j2)/n2 );
+            acc += src[(j0*n1+j1)*n2+j2] * Complex(cos(phase),sin(phase));
+        }
+        ref[(k0*n1+k1)*n2+k2] = acc;
+    }
+    VERIFY( (dst-ref).norm() <= test_precision<T>()*ref.norm() );
+    fft.inv3( back.data(), dst.data(), n0,n1,n2 );
+    VERIFY( (back-src).norm() <= test_precision<T>()*src.norm() );
+
+    // real input
+    RealVector rsrc = RealVector::Random(n), rback(n);
+    ComplexVector csrc = rsrc.template cast<Complex>(), cspec(n), rspec(n), hspec(n0*n1*nbins);
+    fft.fwd3( cspec.data(), csrc.data(), n0,n1,n2 );
+    fft.fwd3( rspec.data(), rsrc.data(), n0,n1,n2 );
+    VERIFY( (rspec-cspec).norm() <= test_precision<T>()*cspec.norm() );
+    fft.inv3( rback.data(), rspec.data(), n0,n1,n2 );
+    VERIFY( (rback-rsrc).norm() <= test_precision<T>()*rsrc.norm() );
+
+    fft.SetFlag(fft.HalfSpectrum);
+    fft.fwd3( hspec.data(), rsrc.data(), n0,n1,n2 );
+    for (int k=0;k<n0*n1;++k)
+        VERIFY( (hspec.segment(k*nbins,nbins)-cspec.segment(k*n2,nbins)).norm() <= test_precision<T>()*cspec.norm() );
+    rback.setZero();
+    fft.inv3( rback.data(), hspec.data(), n0,n1,n2 );
+    VERIFY( (rback-rsrc).norm() <= test_precision<T>()*rsrc.norm() );
+}
 
 
 void test_return_by_value(int len)
@@ -243,13 +338,34 @@ void test_return_by_value(int len)
     VERIFY( (in1-in).norm() < test_precision<float>() );
 }
 
+template <typename T>
+void test_plan_direction(int nfft)
+{
+    // the inverse plan is computed first, and the forward one is derived from it
+    typedef typename FFT<T>::Complex Complex;
+    FFT<T> fft;
+    vector<Complex> inbuf(nfft), outbuf, buf2;
+    for (int k=0;k<nfft;++k)
+        inbuf[k]= Complex( (T)(rand()/(double)RAND_MAX - .5), (T)(rand()/(double)RAND_MAX - .5) );
+    fft.inv( outbuf , inbuf);
+    fft.fwd( buf2 , outbuf);
+    VERIFY( dif_rmse(inbuf,buf2) < test_precision<T>()  );// gross check
+    fft.fwd( outbuf , inbuf);
+    VERIFY( fft_rmse(outbuf,inbuf) < test_precision<T>()  );// gross check
+
+    // plans must survive copies of the fft object
+    FFT<T> fft2(fft);
+    fft2.fwd( buf2 , inbuf);
+    VERIFY( dif_rmse(outbuf,buf2) < test_precision<T>()  );// gross check
+}
+
 void test_FFTW()
 {
     cout << "testing return-by-value\n";
     CALL_SUBTEST( test_return_by_value(32) );
     cout << "testing complex\n";
-  //CALL_SUBTEST( ( test_complex2d<float,4,8> () ) ); CALL_SUBTEST( ( test_complex2d<double,4,8> () ) );
-  //CALL_SUBTEST( ( test_complex2d<long double,4,8> () ) );
+  CALL_SUBTEST( ( test_complex2d<float,4,8> () ) ); CALL_SUBTEST( ( test_complex2d<double,4,8> () ) );
+  CALL_SUBTEST( ( test_complex2d<long double,4,8> () ) );
   CALL_SUBTEST( test_complex<float>(32) ); CALL_SUBTEST( test_complex<double>(32) ); CALL_SUBTEST( test_complex<long double>(32) );
   CALL_SUBTEST( test_complex<float>(256) ); CALL_SUBTEST( test_complex<double>(256) ); CALL_SUBTEST( test_complex<long double>(256) );
   CALL_SUBTEST( test_complex<float>(3*8) ); CALL_SUBTEST( test_complex<double>(3*8) ); CALL_SUBTEST( test_complex<long double>(3*8) );
@@ -257,6 +373,18 @@ void test_FFTW()
   CALL_SUBTEST( test_complex<float>(2*3*4) ); CALL_SUBTEST( test_complex<double>(2*3*4) ); CALL_SUBTEST( test_complex<long double>(2*3*4) );
   CALL_SUBTEST( test_complex<float>(2*3*4*5) ); CALL_SUBTEST( test_complex<double>(2*3*4*5) ); CALL_SUBTEST( test_complex<long double>(2*3*4*5) );
   CALL_SUBTEST( test_complex<float>(2*3*4*5*7) ); CALL_SUBTEST( test_complex<double>(2*3*4*5*7) ); CALL_SUBTEST( test_complex<long double>(2*3*4*5*7) );
+  CALL_SUBTEST( test_complex<float>(8*67) ); CALL_SUBTEST( test_complex<double>(8*67) ); CALL_SUBTEST( test_complex<long double>(8*67) );
+  CALL_SUBTEST( test_complex<float>(1031) ); CALL_SUBTEST( test_complex<double>(1031) ); CALL_SUBTEST( test_complex<long double>(1031) );
+
+    cout << "testing plan directions\n";
+  CALL_SUBTEST( test_plan_direction<float>(4*97) ); CALL_SUBTEST( test_plan_direction<double>(4*97) );
+
+    cout << "testing batched and multi-dimensional\n";
+  CALL_SUBTEST( test_batch<float>(16,12) ); CALL_SUBTEST( test_batch<double>(16,12) );
+  CALL_SUBTEST( test_batch<float>(15,7) ); CALL_SUBTEST( test_batch<double>(15,7) );
+  CALL_SUBTEST( test_batch<double>(64,300) );
+  CALL_SUBTEST( test_complex3d<float>(3,4,6) ); CALL_SUBTEST( test_complex3d<double>(3,4,6) );
+  CALL_SUBTEST( test_complex3d<double>(2,5,7) );
 
     cout << "testing scalar\n";
   CALL_SUBTEST( test_scalar<float>(32) ); CALL_SUBTEST( test_scalar<double>(32) ); CALL_SUBTEST( test_scalar<long double>(32) );
@@ -264,4 +392,6 @@ void test_FFTW()
   CALL_SUBTEST( test_scalar<float>(50) ); CALL_SUBTEST( test_scalar<double>(50) ); CALL_SUBTEST( test_scalar<long double>(50) );
   CALL_SUBTEST( test_scalar<float>(256) ); CALL_SUBTEST( test_scalar<double>(256) ); CALL_SUBTEST( test_scalar<long double>(256) );
   CALL_SUBTEST( test_scalar<float>(2*3*4*5*7) ); CALL_SUBTEST( test_scalar<double>(2*3*4*5*7) ); CALL_SUBTEST( test_scalar<long double>(2*3*4*5*7) );
+  CALL_SUBTEST( test_scalar<float>(2*3*5*7) ); CALL_SUBTEST( test_scalar<double>(2*3*5*7) ); CALL_SUBTEST( test_scalar<long double>(2*3*5*7) );
+  CALL_SUBTEST( test_scalar<float>(2*67) ); CALL_SUBTEST( test_scalar<double>(2*67) ); CALL_SUBTEST( test_scalar<long double>(2*67) );
 }
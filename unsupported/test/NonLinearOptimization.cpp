@@ -1797,6 +1797,239 @@ void testNistEckerle4(void)
   VERIFY_IS_APPROX(x[2], 4.5154121844E+02);
 }
 
+// extended rosenbrock function, whose jacobian has two non zeros per row
+struct sparse_rosenbrock_functor : Functor<double>
+{
+    sparse_rosenbrock_functor(int n): Functor<double>(n,2*n-1) {}
+    int operator()(const VectorXd &x, VectorXd &fvec) const
+    {
+        const int n = inputs();
+        for (int i = 0; i < n-1; i++)
+            fvec[i] = 10.*(x[i+1] - x[i]*x[i]);
+        for (int i = 0; i < n; i++)
+            fvec[n-1+i] = 1. - x[i];
+        return 0;
+    }
+
+    int df(const VectorXd &x, SparseMatrix<double> &fjac) const
+    {
+        const int n = inputs();
+        fjac.resize(values(), n);
+        fjac.reserve(3*n);
+        for (int j = 0; j < n; j++)
+        {
+            if (j > 0)
+                fjac.insert(j-1,j) = 10.;
+            if (j < n-1)
+                fjac.insert(j,j) = -20.*x[j];
+            fjac.insert(n-1+j,j) = -1.;
+        }
+        fjac.finalize();
+        return 0;
+    }
+};
+
+// the dense lmder problem, with its jacobian stored in a sparse matrix
+struct sparse_lmder_functor : lmder_functor
+{
+    int df(const VectorXd &x, SparseMatrix<double> &fjac) const
+    {
+        MatrixXd dense(values(), inputs());
+        lmder_functor::df(x, dense);
+        fjac.resize(values(), inputs());
+        for (int j = 0; j < inputs(); j++)
+            for (int i = 0; i < values(); i++)
+                fjac.insert(i,j) = dense(i,j);
+        fjac.finalize();
+        return 0;
+    }
+};
+
+void testSparseLmder(int n)
+{
+  VectorXd x(n);
+  for (int i = 0; i < n; i++)
+    x[i] = (i%2) ? 1. : -1.2;
+
+  // sparse cholesky
+  sparse_rosenbrock_functor functor(n);
+  SparseLevenbergMarquardt<sparse_rosenbrock_functor> lm(functor);
+  lm.parameters.maxfev = 1000;
+  int info = lm.minimize(x);
+  VERIFY(info>=1 && info<=3);
+  VERIFY(lm.nfev < 1000);
+  VERIFY(lm.fnorm < 1e-8);
+  VERIFY_IS_APPROX(x, VectorXd::Ones(n));
+
+  // matrix free conjugate gradient
+  for (int i = 0; i < n; i++)
+    x[i] = (i%2) ? 1. : -1.2;
+  SparseLevenbergMarquardt<sparse_rosenbrock_functor> lmcg(functor);
+  lmcg.parameters.maxfev = 1000;
+  lmcg.parameters.solver = SparseLevenbergMarquardt<sparse_rosenbrock_functor>::ConjugateGradient;
+  lmcg.parameters.cgtol = 1e-10;
+  info = lmcg.minimize(x);
+  VERIFY(info>=1 && info<=3);
+  VERIFY(lmcg.fnorm < 1e-8);
+  VERIFY(lmcg.cgiter > 0);
+  VERIFY_IS_APPROX(x, VectorXd::Ones(n));
+
+  // same minimum as the dense solver for a non zero residual problem
+  VectorXd xs(3), xd(3);
+  xs << 1., 1., 1.;
+  xd = xs;
+  lmder_functor dense_functor;
+  LevenbergMarquardt<lmder_functor> dense_lm(dense_functor);
+  dense_lm.minimize(xd);
+  sparse_lmder_functor sparse_functor;
+  SparseLevenbergMarquardt<sparse_lmder_functor> sparse_lm(sparse_functor);
+  sparse_lm.minimize(xs);
+  VERIFY_IS_APPROX(sparse_lm.fnorm, dense_lm.fnorm);
+  VERIFY_IS_APPROX(xs, xd);
+}
+
+// batch of exponential fits y = b1*(1-exp(-b2*t)), problem k having its own exact data
+struct batch_exp_functor : Functor<double,2,8>
+{
+    batch_exp_functor(const Matrix<double,2,Dynamic> &b) : beta(b) {}
+    double model(const Vector2d &b, int i) const { return b[0]*(1.-std::exp(-b[1]*0.25*(i+1))); }
+    int operator()(int k, const InputType &x, ValueType &fvec) const
+    {
+        for (int i = 0; i < values(); i++)
+            fvec[i] = model(x, i) - model(beta.col(k), i);
+        return 0;
+    }
+    int df(int, const InputType &x, JacobianType &fjac) const
+    {
+        for (int i = 0; i < values(); i++)
+        {
+            double t = 0.25*(i+1), e = std::exp(-x[1]*t);
+            fjac(i,0) = 1.-e;
+            fjac(i,1) = x[0]*t*e;
+        }
+        return 0;
+    }
+    Matrix<double,2,Dynamic> beta;
+};
+
+// the hybrj problem with a fixed size and a right hand side shifted by k/count
+struct batch_hybrj_functor : Functor<double,9,9>
+{
+    batch_hybrj_functor(int count) : m_count(count) {}
+    int operator()(int k, const InputType &x, ValueType &fvec) const
+    {
+        for (int j = 0; j < 9; j++)
+        {
+            fvec[j] = (3. - 2.*x[j])*x[j] + 1. - double(k)/m_count;
+            if (j) fvec[j] -= x[j-1];
+            if (j != 8) fvec[j] -= 2.*x[j+1];
+        }
+        return 0;
+    }
+    int df(int, const InputType &x, JacobianType &fjac) const
+    {
+        fjac.setZero();
+        for (int j = 0; j < 9; j++)
+        {
+            fjac(j,j) = 3.- 4.*x[j];
+            if (j) fjac(j,j-1) = -1.;
+            if (j != 8) fjac(j,j+1) = -2.;
+        }
+        return 0;
+    }
+    int m_count;
+};
+
+// x0+x1+x2 = k+1 measured three times: J^T J is singular, and with a tiny initial damping
+// the Cholesky factorization of the damped normal equations fails
+struct batch_rankdef_functor : Functor<double,3,3>
+{
+    int operator()(int k, const InputType &x, ValueType &fvec) const
+    {
+        fvec.setConstant(x.sum() - (k+1));
+        return 0;
+    }
+    int df(int, const InputType &, JacobianType &fjac) const
+    {
+        fjac.setOnes();
+        return 0;
+    }
+};
+
+// shifted dynamic functor, used as a reference for the batched hybrid solver
+struct shifted_hybrj_functor : hybrj_functor
+{
+    shifted_hybrj_functor(double shift) : m_shift(shift) {}
+    int operator()(const VectorXd &x, VectorXd &fvec)
+    {
+        hybrj_functor::operator()(x, fvec);
+        fvec.array() -= m_shift;
+        return 0;
+    }
+    double m_shift;
+};
+
+void testBatch(int count)
+{
+  // levenberg marquardt, from several starting points per problem
+  Matrix<double,2,Dynamic> beta(2,count), x(2,count);
+  for (int k = 0; k < count; k++)
+  {
+    beta.col(k) << 1.+ei_random<double>(0.,1.), 0.5+ei_random<double>(0.,1.);
+    x.col(k) << 1., (k%2) ? 2. : 0.3;
+  }
+  batch_exp_functor lm_functor(beta);
+  BatchLevenbergMarquardt<batch_exp_functor> lm(lm_functor);
+  lm.minimize(x);
+  VERIFY_IS_EQUAL(int(lm.status.size()), count);
+  for (int k = 0; k < count; k++)
+  {
+    VERIFY(lm.status[k]>=1 && lm.status[k]<=3);
+    VERIFY(lm.fnorm[k] < 1e-8);
+    VERIFY(lm.nfev[k] > 1 && lm.njev[k] > 0);
+    VERIFY_IS_APPROX(Vector2d(x.col(k)), Vector2d(beta.col(k)));
+  }
+
+  // the single problem interface gives the same result, in serial
+  Vector2d x0(1., 0.3);
+  lm.parameters.parallel = false;
+  VERIFY(lm.minimize(0, x0)>=1);
+  VERIFY_IS_APPROX(x0, Vector2d(beta.col(0)));
+
+  // singular normal equations, the damping increases until they can be factorized
+  Matrix<double,3,Dynamic> xr(3,count);
+  xr.setZero();
+  batch_rankdef_functor rankdef_functor;
+  BatchLevenbergMarquardt<batch_rankdef_functor> lmr(rankdef_functor);
+  lmr.parameters.tau = 1e-30;
+  lmr.minimize(xr);
+  for (int k = 0; k < count; k++)
+  {
+    VERIFY(lmr.status[k]>=1 && lmr.status[k]<=3);
+    VERIFY(lmr.fnorm[k] < 1e-8);
+    VERIFY_IS_APPROX(xr.col(k).sum(), k + 1.);
+  }
+
+  // powell's hybrid method, compared to HybridNonLinearSolver
+  Matrix<double,9,Dynamic> xh(9,count);
+  xh.setConstant(-1.);
+  batch_hybrj_functor hybrid_functor(count);
+  BatchHybridNonLinearSolver<batch_hybrj_functor> hybrid(hybrid_functor);
+  hybrid.solve(xh);
+  for (int k = 0; k < count; k++)
+  {
+    VERIFY(hybrid.status[k]==HybridNonLinearSolverSpace::RelativeErrorTooSmall);
+    VERIFY(hybrid.fnorm[k] < 1e-7);
+
+    VectorXd xref(9);
+    xref.setConstant(-1.);
+    shifted_hybrj_functor ref_functor(double(k)/count);
+    HybridNonLinearSolver<shifted_hybrj_functor> ref(ref_functor);
+    VERIFY(ref.solve(xref)==HybridNonLinearSolverSpace::RelativeErrorTooSmall);
+    VERIFY_IS_APPROX(VectorXd(xh.col(k)), xref);
+  }
+}
+
 void test_NonLinearOptimization()
 {
     // Tests using the examples provided by (c)minpack
@@ -1831,6 +2064,14 @@ void test_NonLinearOptimization()
     CALL_SUBTEST_14(testNistThurber());
     CALL_SUBTEST_15(testNistRat43());
     CALL_SUBTEST_16(testNistEckerle4());
+
+    // sparse jacobian
+    CALL_SUBTEST_1(testSparseLmder(10));
+    CALL_SUBTEST_1(testSparseLmder(500));
+
+    // batches of small problems
+    CALL_SUBTEST_2(testBatch(1));
+    CALL_SUBTEST_2(testBatch(100));
 }
 
 /*
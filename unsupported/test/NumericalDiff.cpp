@@ -107,8 +107,104 @@ void test_central()
     VERIFY_IS_APPROX(jac, actual_jac);
 }
 
+// Broyden tridiagonal function, whose jacobian is tridiagonal
+struct tridiagonal_functor : Functor<double>
+{
+    tridiagonal_functor(int n): Functor<double>(n,n), nevals(0) {}
+    int operator()(const VectorXd &x, VectorXd &fvec) const
+    {
+        const int n = x.size();
+        for (int i = 0; i < n; i++)
+        {
+            double temp = (3. - 2.*x[i])*x[i] + 1.;
+            if (i > 0) temp -= x[i-1];
+            if (i < n-1) temp -= 2.*x[i+1];
+            fvec[i] = temp;
+        }
+        ++nevals;
+        return 0;
+    }
+
+    void actual_df(const VectorXd &x, MatrixXd &fjac) const
+    {
+        const int n = x.size();
+        fjac.setZero(n,n);
+        for (int i = 0; i < n; i++)
+        {
+            fjac(i,i) = 3. - 4.*x[i];
+            if (i > 0) fjac(i,i-1) = -1.;
+            if (i < n-1) fjac(i,i+1) = -2.;
+        }
+    }
+
+    void pattern(SparseMatrix<double> &p) const
+    {
+        const int n = values();
+        p.resize(n,n);
+        p.reserve(3*n);
+        for (int j = 0; j < n; j++)
+        {
+            if (j > 0) p.insert(j-1,j) = 1.;
+            p.insert(j,j) = 1.;
+            if (j < n-1) p.insert(j+1,j) = 1.;
+        }
+        p.finalize();
+    }
+
+    // not thread safe, only used to check the number of evaluations
+    mutable int nevals;
+};
+
+template<NumericalDiffMode mode>
+void test_colored(int n)
+{
+    VectorXd x = VectorXd::Random(n);
+    MatrixXd jac(n,n), colored_jac(n,n), actual_jac(n,n);
+    SparseMatrix<double> pattern, sparse_jac;
+
+    NumericalDiff<tridiagonal_functor,mode> numDiff(n);
+    numDiff.actual_df(x, actual_jac);
+
+    // one evaluation per column
+    numDiff.nevals = 0;
+    int nfev = numDiff.df(x, jac);
+    VERIFY_IS_EQUAL(nfev, (mode==Forward ? 1 : 0) + (mode==Central ? 2 : 1)*n);
+    VERIFY_IS_EQUAL(numDiff.nevals, nfev);
+    VERIFY_IS_APPROX(jac, actual_jac);
+
+    // the columns j, j+3, j+6... are structurally orthogonal
+    numDiff.pattern(pattern);
+    numDiff.setSparsityPattern(pattern);
+    VERIFY_IS_EQUAL(numDiff.colors(), std::min(n,3));
+    for (int j = 0; j < n; j++)
+        VERIFY_IS_EQUAL(numDiff.columnColors()[j], j%3);
+
+    numDiff.nevals = 0;
+    nfev = numDiff.df(x, colored_jac);
+    VERIFY_IS_EQUAL(nfev, (mode==Forward ? 1 : 0) + (mode==Central ? 2 : 1)*numDiff.colors());
+    VERIFY_IS_EQUAL(numDiff.nevals, nfev);
+    VERIFY_IS_APPROX(colored_jac, jac);
+
+    numDiff.df(x, sparse_jac);
+    VERIFY_IS_EQUAL(sparse_jac.nonZeros(), pattern.nonZeros());
+    VERIFY_IS_APPROX(MatrixXd(sparse_jac), colored_jac);
+
+    // parallel evaluation gives the same results
+    numDiff.setParallel(true);
+    MatrixXd parallel_jac(n,n);
+    numDiff.df(x, parallel_jac);
+    VERIFY_IS_APPROX(parallel_jac, colored_jac);
+    numDiff.clearSparsityPattern();
+    VERIFY_IS_EQUAL(numDiff.colors(), 0);
+    numDiff.df(x, parallel_jac);
+    VERIFY_IS_APPROX(parallel_jac, jac);
+}
+
 void test_NumericalDiff()
 {
     CALL_SUBTEST(test_forward());
     CALL_SUBTEST(test_central());
+    CALL_SUBTEST(test_colored<Forward>(2));
+    CALL_SUBTEST(test_colored<Forward>(100));
+    CALL_SUBTEST(test_colored<Central>(100));
 }
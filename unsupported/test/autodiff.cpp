@@ -145,6 +145,187 @@ void test_autodiff_scalar()
             << foo<AD>(ax,ay).derivatives().transpose() << "\n\n";
 }
 
+template<typename Scalar>
+EIGEN_DONT_INLINE Scalar bar(const Scalar& x, const Scalar& y, const Scalar& z)
+{
+  Scalar r = x / y - 3 * z + std::pow(x,3) / (x*x + 1) - std::abs(y) * ei_sqrt(z*z + 1);
+  r += 2 / (x + 3) - ei_exp(-y) * ei_log(z*z + 2);
+  r *= ei_cos(x) - ei_sin(z) * 0.5;
+  r -= -z;
+  r = r / (y*y + 1);
+  r += -1;
+  return r;
+}
+
+// compares the fixed size specialization with the generic version
+template<int Size> void autodiff_fixed()
+{
+  typedef Matrix<double,Size,1> Der;
+  typedef AutoDiffScalar<Der> ADFixed;
+  typedef AutoDiffScalar<VectorXd> ADDynamic;
+  VERIFY((ei_auto_diff_is_fixed<Der>::ret));
+  VERIFY(!(ei_auto_diff_is_fixed<VectorXd>::ret));
+
+  Der dx = Der::Random(), dy = Der::Random(), dz = Der::Random();
+  double x = ei_random<double>(0.5,1.), y = ei_random<double>(-1.,-0.5), z = ei_random<double>(-1.,1.);
+
+  ADFixed rf = bar(ADFixed(x,dx), ADFixed(y,dy), ADFixed(z,dz));
+  ADDynamic rd = bar(ADDynamic(x,VectorXd(dx)), ADDynamic(y,VectorXd(dy)), ADDynamic(z,VectorXd(dz)));
+
+  VERIFY_IS_APPROX(rf.value(), bar(x,y,z));
+  VERIFY_IS_APPROX(rf.value(), rd.value());
+  VERIFY_IS_APPROX(VectorXd(rf.derivatives()), rd.derivatives());
+
+  // a pure variable
+  ADFixed v(x, Size, Size-1);
+  VERIFY_IS_EQUAL(v.derivatives(), Der::Unit(Size-1));
+}
+
+// compares the gradients computed in reverse mode to the forward mode ones
+void autodiff_reverse_scalar()
+{
+  typedef AutoDiffReverseScalar<double> AD;
+  typedef AutoDiffScalar<Vector3d> ADF;
+  AutoDiffTape<double> tape;
+
+  Vector3d v(ei_random<double>(0.5,1.), ei_random<double>(-1.,-0.5), ei_random<double>(-1.,1.));
+  AD x(tape,v[0]), y(tape,v[1]), z(tape,v[2]);
+  AD r = bar(x,y,z);
+  ADF rf = bar(ADF(v[0],3,0), ADF(v[1],3,1), ADF(v[2],3,2));
+
+  tape.gradient(r);
+  VERIFY_IS_APPROX(r.value(), rf.value());
+  VERIFY_IS_APPROX(Vector3d(x.adjoint(), y.adjoint(), z.adjoint()), rf.derivatives());
+
+  // the adjoints of intermediate results are available too
+  AD c(2.);
+  VERIFY(!c.isActive());
+  VERIFY(!(c*c+1.).isActive());
+  tape.clear();
+  x = AD(tape,v[0]);
+  AD x2 = x*x;
+  AD s = c*ei_sin(x2);
+  tape.gradient(s);
+  VERIFY_IS_APPROX(x2.adjoint(), 2.*std::cos(v[0]*v[0]));
+  VERIFY_IS_APPROX(x.adjoint(), 4.*v[0]*std::cos(v[0]*v[0]));
+  VERIFY(c.adjoint()==0.);
+}
+
+// matrices of AutoDiffReverseScalar, and the specialized adjoint rules
+template<int Dummy> void autodiff_reverse_matrix(int n)
+{
+  typedef AutoDiffReverseScalar<double> AD;
+  typedef Matrix<AD,Dynamic,Dynamic> ADMatrix;
+  typedef Matrix<AD,Dynamic,1> ADVector;
+  AutoDiffTape<double> tape;
+
+  MatrixXd a = MatrixXd::Random(n,n+1), b = MatrixXd::Random(n+1,n), w = MatrixXd::Random(n,n);
+  VectorXd u = VectorXd::Random(n), v = VectorXd::Random(n);
+  ADMatrix ad_a(n,n+1), ad_b(n+1,n);
+  ADVector ad_u(n), ad_v(n);
+  for(int j=0; j<n+1; ++j)
+    for(int i=0; i<n; ++i)
+    {
+      ad_a(i,j) = AD(tape, a(i,j));
+      ad_b(j,i) = AD(tape, b(j,i));
+    }
+  for(int i=0; i<n; ++i)
+  {
+    ad_u[i] = AD(tape, u[i]);
+    ad_v[i] = AD(tape, v[i]);
+  }
+  VERIFY_IS_EQUAL(tape.size(), 2*n*(n+1)+2*n);
+
+  // plain Eigen expressions: f = |u|^2 + sum(v.*u)
+  AD f = ad_u.squaredNorm() + ad_u.cwiseProduct(ad_v).sum();
+  tape.gradient(f);
+  VERIFY_IS_APPROX(f.value(), u.squaredNorm() + u.dot(v));
+  VERIFY_IS_APPROX(tape.adjoints(ad_u), VectorXd(2*u + v));
+  VERIFY_IS_APPROX(tape.adjoints(ad_v), u);
+
+  // dot product recorded as a single node
+  int size = tape.size();
+  f = reverseDot(ad_u, ad_v);
+  VERIFY_IS_EQUAL(tape.size(), size+1);
+  tape.gradient(f);
+  VERIFY_IS_APPROX(f.value(), u.dot(v));
+  VERIFY_IS_APPROX(tape.adjoints(ad_u), v);
+  VERIFY_IS_APPROX(tape.adjoints(ad_v), u);
+
+  // matrix product: f = sum(w.*(a*b))
+  size = tape.size();
+  int operands = tape.operands();
+  ADMatrix ad_c = reverseProduct(ad_a, ad_b);
+  VERIFY_IS_EQUAL(tape.size(), size+n*n);
+  VERIFY_IS_EQUAL(tape.operands(), operands);
+  f = 0;
+  for(int j=0; j<n; ++j)
+    for(int i=0; i<n; ++i)
+      f += w(i,j) * ad_c(i,j);
+  tape.gradient(f);
+  VERIFY_IS_APPROX(tape.adjoints(ad_a), MatrixXd(w * b.transpose()));
+  VERIFY_IS_APPROX(tape.adjoints(ad_b), MatrixXd(a.transpose() * w));
+
+  // same thing using the generic product of matrices of AutoDiffReverseScalar
+  size = tape.size();
+  ADMatrix ad_c2 = ad_a * ad_b;
+  VERIFY(tape.size()-size >= n*n*(n+1));
+  f = 0;
+  for(int j=0; j<n; ++j)
+    for(int i=0; i<n; ++i)
+    {
+      VERIFY_IS_APPROX(ad_c2(i,j).value(), ad_c(i,j).value());
+      f += w(i,j) * ad_c2(i,j);
+    }
+  tape.gradient(f);
+  VERIFY_IS_APPROX(tape.adjoints(ad_a), MatrixXd(w * b.transpose()));
+  VERIFY_IS_APPROX(tape.adjoints(ad_b), MatrixXd(a.transpose() * w));
+
+  // solve of a selfadjoint system: f = sum(w.*(A^-1 B)) with A = a a^T + I and B = b^T
+  tape.clear();
+  MatrixXd spd = a * a.transpose() + MatrixXd::Identity(n,n);
+  ADMatrix ad_spd(n,n), ad_rhs(n,n+1);
+  for(int j=0; j<n; ++j)
+    for(int i=0; i<n; ++i)
+      ad_spd(i,j) = AD(tape, spd(i,j));
+  for(int j=0; j<n+1; ++j)
+    for(int i=0; i<n; ++i)
+      ad_rhs(i,j) = AD(tape, b(j,i));
+  MatrixXd wx = MatrixXd::Random(n,n+1);
+  ADMatrix ad_x = reverseLltSolve(ad_spd, ad_rhs);
+  f = 0;
+  for(int j=0; j<n+1; ++j)
+    for(int i=0; i<n; ++i)
+      f += wx(i,j) * ad_x(i,j);
+  tape.gradient(f);
+  MatrixXd x = spd.llt().solve(b.transpose());
+  MatrixXd g = spd.llt().solve(wx);
+  MatrixXd gx = g * x.transpose();
+  MatrixXd dspd = tape.adjoints(ad_spd);
+  VERIFY_IS_APPROX(tape.adjoints(ad_rhs), g);
+  for(int j=0; j<n; ++j)
+    for(int i=0; i<n; ++i)
+    {
+      double ref = i<j ? 0. : i==j ? -gx(i,i) : -gx(i,j)-gx(j,i);
+      VERIFY(ei_isApprox(dspd(i,j), ref, 1e-8) || ei_abs(dspd(i,j)-ref) < 1e-10);
+    }
+
+  // the same recorded through the generic LLT
+  size = tape.size();
+  ADMatrix ad_x2 = ad_spd.llt().solve(ad_rhs);
+  VERIFY(tape.size()-size > n*n*n/3);
+  AD f2 = 0;
+  for(int j=0; j<n+1; ++j)
+    for(int i=0; i<n; ++i)
+      f2 += wx(i,j) * ad_x2(i,j);
+  VERIFY_IS_APPROX(f2.value(), f.value());
+  tape.gradient(f2);
+  VERIFY_IS_APPROX(tape.adjoints(ad_rhs), g);
+  MatrixXd dspd2 = tape.adjoints(ad_spd);
+  VERIFY_IS_APPROX(MatrixXd(dspd2.triangularView<Lower>()), MatrixXd(dspd.triangularView<Lower>()));
+  VERIFY_IS_APPROX(MatrixXd(dspd2.triangularView<StrictlyUpper>()), MatrixXd(dspd.triangularView<StrictlyUpper>()));
+}
+
 void test_autodiff_jacobian()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -153,6 +334,11 @@ void test_autodiff_jacobian()
     CALL_SUBTEST(( forward_jacobian(TestFunc1<double,3,2>()) ));
     CALL_SUBTEST(( forward_jacobian(TestFunc1<double,3,3>()) ));
     CALL_SUBTEST(( forward_jacobian(TestFunc1<double>(3,3)) ));
+    CALL_SUBTEST(( autodiff_fixed<1>() ));
+    CALL_SUBTEST(( autodiff_fixed<4>() ));
+    CALL_SUBTEST(( autodiff_fixed<7>() ));
+    CALL_SUBTEST(( autodiff_reverse_scalar() ));
+    CALL_SUBTEST(( autodiff_reverse_matrix<0>(ei_random<int>(1,20)) ));
   }
 }
 
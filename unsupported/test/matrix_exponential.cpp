@@ -142,6 +142,93 @@ void randomTest(const MatrixType& m, double tol)
   }
 }
 
+// matrix-free operator of the 1D laplacian with Dirichlet boundary conditions
+template <typename T>
+struct LaplacianOperator
+{
+  typedef T Scalar;
+  typedef T RealScalar;
+  typedef Matrix<T,Dynamic,1> VectorType;
+
+  LaplacianOperator(int n) : m_n(n) {}
+  int rows() const { return m_n; }
+  Scalar trace() const { return -2 * m_n; }
+  RealScalar norm1(const Scalar& mu) const { return 2 + ei_abs(2 + mu); }
+  void apply(const VectorType& x, VectorType& y) const
+  {
+    y = -2 * x;
+    y.head(m_n-1) += x.tail(m_n-1);
+    y.tail(m_n-1) += x.head(m_n-1);
+  }
+  int m_n;
+};
+
+template<typename MatrixType>
+void testExponentialAction(const MatrixType& m, double tol)
+{
+  typedef typename ei_traits<MatrixType>::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  const int size = m.rows();
+
+  for(int i = 0; i < g_repeat; i++) {
+    // dense matrix, compared to the full exponential
+    MatrixType A = MatrixType::Random(size, size);
+    VectorType v = VectorType::Random(size), w;
+    for (int k = -1; k <= 2; k++) {
+      RealScalar t = static_cast<RealScalar>(std::pow(4., k));
+      matrixExponentialAction(A, v, t, w);
+      MatrixType E = (t*A).exp();
+      VectorType ref = E * v;
+      std::cout << "testExponentialAction: t = " << t << "   error = " << relerr(w, ref) << "\n";
+      VERIFY(w.isApprox(ref, static_cast<RealScalar>(tol)));
+    }
+
+    // sparse matrix at several time points
+    SparseMatrix<Scalar> S(size, size);
+    MatrixType D = MatrixType::Zero(size, size);
+    for (int j = 0; j < size; j++) {
+      for (int k = std::max(0,j-1); k <= std::min(size-1,j+1); k++) {
+        Scalar value = ei_random<Scalar>();
+        S.insert(k,j) = value;
+        D(k,j) = value;
+      }
+    }
+    S.finalize();
+    Matrix<RealScalar,Dynamic,1> times(4);
+    times << 0, 0.5, 1, 3;
+    Matrix<Scalar,Dynamic,Dynamic> W;
+    matrixExponentialAction(S, v, times, W);
+    VERIFY_IS_EQUAL(W.cols(), 4);
+    VERIFY_IS_APPROX(VectorType(W.col(0)), v);
+    for (int k = 1; k < 4; k++) {
+      MatrixType E = (times[k]*D).exp();
+      VectorType ref = E * v;
+      VERIFY(VectorType(W.col(k)).isApprox(ref, static_cast<RealScalar>(tol)));
+    }
+  }
+}
+
+template <typename T>
+void testExponentialActionMatrixFree(int size, double tol)
+{
+  typedef Matrix<T,Dynamic,1> VectorType;
+  typedef Matrix<T,Dynamic,Dynamic> MatrixType;
+  LaplacianOperator<T> op(size);
+  MatrixType D = MatrixType::Zero(size, size);
+  VectorType v = VectorType::Random(size), w;
+  for (int j = 0; j < size; j++) {
+    D(j,j) = -2;
+    if (j > 0) D(j-1,j) = D(j,j-1) = 1;
+  }
+  MatrixExponentialAction<LaplacianOperator<T> > action(op);
+  action.compute(v, T(2), w);
+  VERIFY(action.products() > 0);
+  MatrixType E = (T(2)*D).exp();
+  VectorType ref = E * v;
+  VERIFY(w.isApprox(ref, static_cast<T>(tol)));
+}
+
 void test_matrix_exponential()
 {
   CALL_SUBTEST_2(test2dRotation<double>(1e-13));
@@ -158,4 +245,9 @@ void test_matrix_exponential()
   CALL_SUBTEST_5(randomTest(Matrix3cf(), 1e-4));
   CALL_SUBTEST_1(randomTest(Matrix4f(), 1e-4));
   CALL_SUBTEST_6(randomTest(MatrixXf(8,8), 1e-4));
+  CALL_SUBTEST_4(testExponentialAction(MatrixXd(8,8), 1e-12));
+  CALL_SUBTEST_4(testExponentialAction(MatrixXd(40,40), 1e-12));
+  CALL_SUBTEST_3(testExponentialAction(MatrixXcd(12,12), 1e-12));
+  CALL_SUBTEST_6(testExponentialAction(MatrixXf(8,8), 1e-4));
+  CALL_SUBTEST_4(testExponentialActionMatrixFree<double>(200, 1e-12));
 }
@@ -150,12 +150,25 @@ void testGonioFunctions(const MatrixType& A)
   VERIFY_IS_APPROX_ABS(cosAc, (exp_iA + exp_miA) / 2);
 }
 
+template<typename MatrixType>
+void testSquareRootAndLogarithm(const MatrixType& A)
+{
+  // the eigenvalues of exp(A) are not on the negative real axis, and
+  // A is its principal logarithm as long as they are not too large
+  MatrixType expA = A.exp();
+  MatrixType sqrtExpA = expA.sqrt();
+  VERIFY_IS_APPROX(sqrtExpA * sqrtExpA, expA);
+  VERIFY_IS_APPROX(sqrtExpA, (A / 2).exp());
+  VERIFY_IS_APPROX_ABS(expA.log(), A);
+}
+
 template<typename MatrixType>
 void testMatrix(const MatrixType& A)
 {
   testMatrixExponential(A);
   testHyperbolicFunctions(A);
   testGonioFunctions(A);
+  testSquareRootAndLogarithm(A);
 }
 
 template<typename MatrixType>
@@ -181,4 +194,9 @@ void test_matrix_function()
   CALL_SUBTEST_5(testMatrixType(Matrix<double,5,5,RowMajor>()));
   CALL_SUBTEST_6(testMatrixType(Matrix4cd()));
   CALL_SUBTEST_7(testMatrixType(MatrixXd(13,13)));
+
+  // large enough for the blocked recurrences
+  CALL_SUBTEST_8(testMatrixExponential(randomMatrixWithRealEivals<MatrixXd>(100)));
+  CALL_SUBTEST_8(testSquareRootAndLogarithm(randomMatrixWithRealEivals<MatrixXd>(100)));
+  CALL_SUBTEST_8(testSquareRootAndLogarithm(MatrixXcd(MatrixXcd::Random(70,70) / 4)));
 }
@@ -131,6 +131,43 @@ void evalSolver( const POLYNOMIAL& pols )
 
 
 
+// The roots computed by the Aberth iteration are not exactly conjugate for real
+// polynomials, so their moduli are distinct: check the backward error instead.
+template<typename POLYNOMIAL, typename ROOTS>
+bool aux_evalBackwardError( const POLYNOMIAL& pols, const ROOTS& roots )
+{
+  typedef typename POLYNOMIAL::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real Real;
+
+  const Matrix<Real,Dynamic,1> absPols = pols.cwiseAbs();
+  for( int i=0; i<roots.size(); ++i )
+  {
+    const Real bound = poly_eval( absPols, std::abs( roots[i] ) );
+    if( !( std::abs( poly_eval( pols, roots[i] ) ) <= test_precision<Scalar>() * bound ) )
+    {
+      cerr << "WRONG root: " << endl;
+      cerr << "Polynomial: " << pols.transpose() << endl;
+      cerr << "Roots found: " << roots.transpose() << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+
+template<int Deg, typename POLYNOMIAL>
+void evalAberthSolver( const POLYNOMIAL& pols )
+{
+  typedef typename POLYNOMIAL::Scalar Scalar;
+
+  AberthPolynomialSolver<Scalar, Deg > psolve( pols );
+  VERIFY( psolve.converged() );
+  VERIFY( aux_evalBackwardError( pols, psolve.roots() ) );
+}
+
+
+
+
 template< int Deg, typename POLYNOMIAL, typename ROOTS, typename REAL_ROOTS >
 void evalSolverSugarFunction( const POLYNOMIAL& pols, const ROOTS& roots, const REAL_ROOTS& real_roots )
 {
@@ -216,12 +253,16 @@ void polynomialsolver(int deg)
   cout << "Standard cases" << endl;
   PolynomialType pols = PolynomialType::Random(deg+1);
   evalSolver<_Deg,PolynomialType>( pols );
+  evalAberthSolver<_Deg,PolynomialType>( pols );
 
   cout << "Hard cases" << endl;
   _Scalar multipleRoot = ei_random<_Scalar>();
   EvalRootsType allRoots = EvalRootsType::Constant(deg,multipleRoot);
   roots_to_monicPolynomial( allRoots, pols );
   evalSolver<_Deg,PolynomialType>( pols );
+  // the evaluation near the multiple root must not underflow
+  if( ei_abs( pols[0] ) > std::numeric_limits<_Scalar>::min() / NumTraits<_Scalar>::epsilon() ){
+    evalAberthSolver<_Deg,PolynomialType>( pols ); }
 
   cout << "Test sugar" << endl;
   EvalRootsType realRoots = EvalRootsType::Random(deg);
@@ -237,6 +278,61 @@ void polynomialsolver(int deg)
 }
 
 
+template<typename _Scalar, int _Deg>
+void batchPolynomialSolver(int deg, int count)
+{
+  typedef ei_increment_if_fixed_size<_Deg>            Dim;
+  typedef Matrix<_Scalar,Dim::ret,Dynamic>            PolynomialsType;
+  typedef BatchPolynomialSolver<_Scalar,_Deg>         BatchSolverType;
+  typedef typename BatchSolverType::RootsType         RootsType;
+
+  PolynomialsType pols = PolynomialsType::Random(deg+1, count);
+  // some roots at zero
+  pols.col(0).head(2).setZero();
+
+  BatchSolverType bsolve;
+  bsolve.compute( pols );
+  const RootsType& roots = bsolve.roots();
+  VERIFY( roots.rows() == deg && roots.cols() == count );
+  VERIFY( bsolve.converged() );
+
+  AberthPolynomialSolver<_Scalar,_Deg> psolve;
+  for( int k=0; k<count; ++k )
+  {
+    VERIFY( bsolve.converged(k) );
+    psolve.compute( pols.col(k) );
+    VERIFY( psolve.roots() == roots.col(k) );
+    VERIFY( aux_evalBackwardError( pols.col(k), roots.col(k) ) );
+  }
+  VERIFY( roots(0,0) == std::complex<_Scalar>(0) && roots(1,0) == std::complex<_Scalar>(0) );
+
+  // sequential and parallel solves give the same roots
+  bsolve.setParallel( false );
+  bsolve.compute( pols );
+  VERIFY( bsolve.roots() == roots );
+}
+
+
+template<typename _Scalar>
+void aberthHighDegree(int deg)
+{
+  typedef Matrix<_Scalar,Dynamic,1>                   PolynomialType;
+
+  PolynomialType pols = PolynomialType::Random(deg+1);
+  AberthPolynomialSolver<_Scalar,Dynamic> psolve( pols );
+  VERIFY( psolve.converged() );
+  VERIFY( aux_evalBackwardError( pols, psolve.roots() ) );
+
+  // roots of unity: all the roots have the same modulus
+  pols.setZero();
+  pols[0] = _Scalar(-1); pols[deg] = _Scalar(1);
+  psolve.compute( pols );
+  VERIFY( psolve.converged() );
+  for( int i=0; i<deg; ++i ){
+    VERIFY_IS_APPROX( std::abs( psolve.roots()[i] ), _Scalar(1) ); }
+}
+
+
 template<typename _Scalar> void polynomialsolver_scalar()
 {
   CALL_SUBTEST_1( (polynomialsolver<_Scalar,1>(1)) );
@@ -251,6 +347,10 @@ template<typename _Scalar> void polynomialsolver_scalar()
   CALL_SUBTEST_9( (polynomialsolver<_Scalar,Dynamic>(
           ei_random<int>(9,45)
           )) );
+
+  CALL_SUBTEST_10( (batchPolynomialSolver<_Scalar,3>(3, 200)) );
+  CALL_SUBTEST_10( (batchPolynomialSolver<_Scalar,8>(8, 200)) );
+  CALL_SUBTEST_10( (batchPolynomialSolver<_Scalar,Dynamic>(ei_random<int>(3,20), 50)) );
 }
 
 void test_polynomialsolver()
@@ -259,5 +359,6 @@ void test_polynomialsolver()
   {
     polynomialsolver_scalar<double>();
     polynomialsolver_scalar<float>();
+    CALL_SUBTEST_11( aberthHighDegree<double>(ei_random<int>(100,500)) );
   }
 }
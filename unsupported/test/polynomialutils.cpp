@@ -112,6 +112,59 @@ template<typename _Scalar> void CauchyBounds_scalar()
           ei_random<int>(18,26) )) );
 }
 
+template<typename _Scalar>
+void polyEvalArray(int deg, int size)
+{
+  typedef Matrix<_Scalar,Dynamic,1>                   PolynomialType;
+  typedef Array<_Scalar,Dynamic,1>                    ArrayType;
+
+  PolynomialType pols = PolynomialType::Random(deg+1);
+  ArrayType x = ArrayType::Random(size);
+
+  ArrayType values = poly_eval_array( pols, x );
+  for( int i=0; i<size; ++i ){
+    VERIFY( ei_abs( values[i] - poly_eval( pols, x[i] ) )
+        <= test_precision<_Scalar>() * poly_eval( pols.cwiseAbs(), ei_abs( x[i] ) ) ); }
+
+  // the threaded evaluation gives the same values
+  ArrayType tvalues;
+  poly_eval_array( pols, x, tvalues );
+  VERIFY( (tvalues == values).all() );
+
+  // in an expression
+  ArrayType y = ArrayType::Random(size);
+  VERIFY_IS_APPROX( ArrayType(poly_eval_array( pols, x+y ) * 2), ArrayType(2 * poly_eval_array( pols, ArrayType(x+y) )) );
+}
+
+template<typename _Scalar>
+void polyEvalBatch(int deg, int count)
+{
+  typedef Matrix<_Scalar,Dynamic,Dynamic>             PolynomialsType;
+  typedef Matrix<_Scalar,Dynamic,1>                   VectorType;
+
+  PolynomialsType pols = PolynomialsType::Random(deg+1, count);
+  for( int j=0; j<3; ++j )
+  {
+    // the values of |x| smaller and greater than 1 are evaluated differently
+    const _Scalar x = ei_random<_Scalar>(-2,2);
+    VectorType values;
+    poly_eval_batch( pols, x, values );
+    VERIFY( values.size() == count );
+    for( int k=0; k<count; ++k ){
+      VERIFY( ei_abs( values[k] - poly_eval( pols.col(k), x ) )
+          <= test_precision<_Scalar>() * poly_eval( pols.col(k).cwiseAbs(), ei_abs( x ) ) ); }
+  }
+}
+
+template<typename _Scalar> void polyEval_scalar()
+{
+  CALL_SUBTEST_1( (polyEvalArray<_Scalar>(ei_random<int>(0,3), ei_random<int>(1,100))) );
+  CALL_SUBTEST_1( (polyEvalArray<_Scalar>(ei_random<int>(4,30), ei_random<int>(100,5000))) );
+  CALL_SUBTEST_10( (polyEvalArray<_Scalar>(ei_random<int>(4,10), ei_random<int>(20000,40000))) );
+  CALL_SUBTEST_10( (polyEvalBatch<_Scalar>(ei_random<int>(0,10), ei_random<int>(1,5000))) );
+  CALL_SUBTEST_10( (polyEvalBatch<_Scalar>(ei_random<int>(11,30), ei_random<int>(5000,10000))) );
+}
+
 void test_polynomialutils()
 {
   for(int i = 0; i < g_repeat; i++)
@@ -120,5 +173,7 @@ void test_polynomialutils()
     realRoots_to_monicPolynomial_scalar<float>();
     CauchyBounds_scalar<double>();
     CauchyBounds_scalar<float>();
+    polyEval_scalar<double>();
+    polyEval_scalar<float>();
   }
 }
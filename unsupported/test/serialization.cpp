@@ -0,0 +1,331 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "sparse.h"
+#include <unsupported/Eigen/Serialization>
+#include <sstream>
+#include <clocale>
+
+// reverses the byte order of the dense record at the start of str, as if it was written on a machine of the other byte order
+template<typename Scalar>
+std::string swapDenseRecord(const std::string& str)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  std::string swapped = str;
+  swapped[9] = char(swapped[9] ^ ei_binary_header::BigEndianFlag);
+  ei_binary_header::swapBytes(&swapped[16], 3, sizeof(int));
+  ei_binary_header::swapBytes(&swapped[ei_binary_header::Size], (str.size()-ei_binary_header::Size)/sizeof(RealScalar), sizeof(RealScalar));
+  return swapped;
+}
+
+template<typename MatrixType> void serialization_dense(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  int rows = m.rows();
+  int cols = m.cols();
+  enum { OtherOrder = MatrixType::ColsAtCompileTime==1 ? ColMajor : MatrixType::IsRowMajor ? ColMajor : RowMajor };
+  typedef Matrix<Scalar, MatrixType::RowsAtCompileTime, MatrixType::ColsAtCompileTime, OtherOrder> OtherMatrixType;
+
+  MatrixType m1 = MatrixType::Random(rows, cols), m2(rows, cols);
+
+  // round trip, also through an expression and to the other storage order
+  std::stringstream stream;
+  VERIFY(writeBinary(stream, m1));
+  VERIFY(writeBinary(stream, m1.transpose().transpose() * Scalar(2)));
+  VERIFY(writeBinary(stream, m1.array()));
+  VERIFY(readBinary(stream, m2));
+  VERIFY(m2 == m1);
+  VERIFY(readBinary(stream, m2));
+  VERIFY(m2 == m1 * Scalar(2));
+  OtherMatrixType m3;
+  VERIFY(readBinary(stream, m3));
+  VERIFY(m3 == m1);
+
+  // record written on a machine of the other byte order
+  std::stringstream single;
+  writeBinary(single, m1);
+  std::stringstream swapped(swapDenseRecord<Scalar>(single.str()));
+  m2.setZero();
+  VERIFY(readBinary(swapped, m2));
+  VERIFY(m2 == m1);
+
+  // wrong scalar type, wrong fixed sizes, truncated record
+  std::stringstream other(single.str());
+  Matrix<long double, Dynamic, Dynamic> ml;
+  VERIFY(!readBinary(other, ml));
+  other.clear();
+  other.str(single.str());
+  Matrix<Scalar, 5, 7> m5;
+  VERIFY(!readBinary(other, m5));
+  std::string truncated = single.str();
+  truncated.resize(truncated.size()-1);
+  std::stringstream truncatedStream(truncated);
+  VERIFY(rows*cols==0 || !readBinary(truncatedStream, m2));
+
+  // corrupted sizes: negative, overflowing an int, and more coefficients than the stream holds
+  Matrix<Scalar, Dynamic, Dynamic> md;
+  const int corruptedSizes[3][2] = { { -1, 3 }, { 1<<20, 1<<12 }, { 1<<14, 1<<14 } };
+  for (int k = 0; k < 3; ++k)
+  {
+    std::string corrupted = single.str();
+    std::memcpy(&corrupted[16], corruptedSizes[k], sizeof(corruptedSizes[k]));
+    std::stringstream corruptedStream(corrupted);
+    VERIFY(!readBinary(corruptedStream, md));
+  }
+}
+
+// writes the record of the sparse matrix with columns {0,2}, {1}, {2} and 3 rows, with its
+// outer starts, inner indices or number of non zeros replaced if given
+template<typename Scalar>
+std::string sparseRecord(const int* outer = 0, const int* inner = 0, int nnz = 4)
+{
+  SparseMatrix<Scalar> m(3,3);
+  m.insert(0,0) = 1; m.insert(2,0) = 2; m.insert(1,1) = 3; m.insert(2,2) = 4;
+  m.finalize();
+  std::stringstream stream;
+  writeBinary(stream, m);
+  std::string record = stream.str();
+  if (outer) std::memcpy(&record[ei_binary_header::Size], outer, 4*sizeof(int));
+  if (inner) std::memcpy(&record[ei_binary_header::Size + 4*sizeof(int)], inner, 4*sizeof(int));
+  std::memcpy(&record[24], &nnz, sizeof(int));
+  return record;
+}
+
+template<typename Scalar> void serialization_sparse_corrupted()
+{
+  SparseMatrix<Scalar> m;
+  std::stringstream valid(sparseRecord<Scalar>());
+  VERIFY(readBinary(valid, m));
+  VERIFY(m.nonZeros() == 4 && m.coeff(2,0) == Scalar(2));
+
+  const int decreasingOuter[4] = { 0, 3, 2, 4 };
+  const int unsortedInner[4] = { 2, 0, 1, 2 };
+  const int repeatedInner[4] = { 0, 0, 1, 2 };
+  const int outOfRangeInner[4] = { 0, 2, 1, 3 };
+  std::stringstream s1(sparseRecord<Scalar>(decreasingOuter)), s2(sparseRecord<Scalar>(0, unsortedInner)),
+                    s3(sparseRecord<Scalar>(0, repeatedInner)), s4(sparseRecord<Scalar>(0, outOfRangeInner)),
+                    s5(sparseRecord<Scalar>(0, 0, 1<<30)), s6(sparseRecord<Scalar>(0, 0, -1));
+  VERIFY(!readBinary(s1, m));
+  VERIFY(!readBinary(s2, m));
+  VERIFY(!readBinary(s3, m));
+  VERIFY(!readBinary(s4, m));
+  VERIFY(!readBinary(s5, m));
+  VERIFY(!readBinary(s6, m));
+  // the other storage order goes through the same checks
+  SparseMatrix<Scalar,RowMajor> mr;
+  std::stringstream s7(sparseRecord<Scalar>(0, unsortedInner));
+  VERIFY(!readBinary(s7, mr));
+}
+
+template<typename Scalar> void serialization_sparse(int rows, int cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  double density = std::max(8./(rows*cols), 0.01);
+
+  DenseMatrix refMat(rows, cols);
+  SparseMatrix<Scalar> m(rows, cols), m2;
+  initSparse<Scalar>(density, refMat, m);
+
+  std::stringstream stream;
+  VERIFY(writeBinary(stream, m));
+  VERIFY(writeBinary(stream, m));
+  VERIFY(readBinary(stream, m2));
+  VERIFY_IS_APPROX(refMat, m2.toDense());
+  VERIFY(m2.nonZeros() == m.nonZeros());
+  SparseMatrix<Scalar,RowMajor> m3;
+  VERIFY(readBinary(stream, m3));
+  VERIFY_IS_APPROX(refMat, m3.toDense());
+
+  // corrupted inner indices
+  std::string corrupted = stream.str();
+  if (m.nonZeros() > 0)
+  {
+    const int bad = rows;
+    std::memcpy(&corrupted[ei_binary_header::Size + (m.outerSize()+1)*sizeof(int)], &bad, sizeof(int));
+    std::stringstream corruptedStream(corrupted);
+    VERIFY(!readBinary(corruptedStream, m2));
+  }
+}
+
+template<typename MatrixType> void serialization_decompositions(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, MatrixType::RowsAtCompileTime, 1> VectorType;
+  int size = m.rows();
+
+  MatrixType a = MatrixType::Random(size, size);
+  MatrixType spd = a * a.adjoint() + MatrixType::Identity(size, size);
+  VectorType b = VectorType::Random(size);
+
+  std::stringstream stream;
+  LLT<MatrixType> llt(spd), llt2;
+  LLT<MatrixType,Upper> lltUpper(spd), lltUpper2;
+  PartialPivLU<MatrixType> lu(a), lu2;
+  VERIFY(writeBinary(stream, llt));
+  VERIFY(writeBinary(stream, lltUpper));
+  VERIFY(writeBinary(stream, lu));
+
+  VERIFY(readBinary(stream, llt2));
+  VERIFY(llt2.solve(b) == llt.solve(b));
+  VERIFY(readBinary(stream, lltUpper2));
+  VERIFY(lltUpper2.solve(b) == lltUpper.solve(b));
+  VERIFY(readBinary(stream, lu2));
+  VERIFY(lu2.solve(b) == lu.solve(b));
+  VERIFY(lu2.determinant() == lu.determinant());
+
+  // a record of another kind is rejected
+  std::stringstream wrongKind;
+  writeBinary(wrongKind, lu);
+  VERIFY(!readBinary(wrongKind, llt2));
+}
+
+template<typename Scalar> void serialization_sparse_llt(int size)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  double density = std::max(8./(size*size), 0.01);
+
+  DenseMatrix refMat(size, size), aux(size, size);
+  SparseMatrix<Scalar> m(size, size);
+  initSparse<Scalar>(density, aux, m, ForceNonZeroDiag);
+  refMat = aux * aux.adjoint() + DenseMatrix::Identity(size, size);
+  m.setZero();
+  for (int j=0; j<size; ++j)
+    for (int i=j; i<size; ++i)
+      if (refMat(i,j)!=Scalar(0))
+        m.insert(i,j) = refMat(i,j);
+  m.finalize();
+
+  SparseLLT<SparseMatrix<Scalar> > llt(m), llt2;
+  std::stringstream stream;
+  VERIFY(writeBinary(stream, llt));
+  VERIFY(readBinary(stream, llt2));
+  VERIFY(llt2.succeeded());
+  DenseVector b = DenseVector::Random(size), x = b, x2 = b;
+  llt.solveInPlace(x);
+  llt2.solveInPlace(x2);
+  VERIFY(x == x2);
+
+  // a failed factorization remains failed
+  SparseMatrix<Scalar> negative = m * Scalar(-1);
+  SparseLLT<SparseMatrix<Scalar> > failed(negative), failed2;
+  VERIFY(!failed.succeeded());
+  std::stringstream failedStream;
+  VERIFY(writeBinary(failedStream, failed));
+  VERIFY(readBinary(failedStream, failed2));
+  VERIFY(!failed2.succeeded());
+}
+
+template<typename MatrixType> void serialization_text(const MatrixType& m)
+{
+  int rows = m.rows();
+  int cols = m.cols();
+
+  MatrixType m1 = MatrixType::Random(rows, cols), m2;
+  const IOFormat formats[] = { IOFormat(FullPrecision),
+                               IOFormat(FullPrecision, DontAlignCols, ",", "\n"),
+                               IOFormat(FullPrecision, 0, ", ", ";\n", "[", "]", "[", "]") };
+
+  // exact round trips
+  for (int k = 0; k < 3; ++k)
+  {
+    std::stringstream stream;
+    VERIFY(writeText(stream, m1, formats[k]));
+    VERIFY(readText(stream, m2, formats[k]));
+    VERIFY((m2.array() == m1.array()).all());
+  }
+
+  // same output as the stream operators when the precision is given
+  const IOFormat fmt(4, 0, ", ", "\n", "[", "]");
+  std::stringstream formatted, reference;
+  writeText(formatted, m1, fmt);
+  reference << m1.format(fmt);
+  VERIFY(formatted.str() == reference.str());
+
+  // ragged rows and invalid coefficients
+  std::string text = formatted.str();
+  std::stringstream ragged(text + "\n[]");
+  VERIFY(!readText(ragged, m2, fmt));
+  text[text.find_last_of("0123456789")] = 'x';
+  std::stringstream invalid(text);
+  VERIFY(!readText(invalid, m2, fmt));
+}
+
+void serialization_text_parse()
+{
+  const char csv[] = "1.5, -2e3,0.1\r\n 1e-30 ,+7, -0\n\n-inf,nan,12345678901234567890.5\n";
+  MatrixXd m;
+  VERIFY(readText(csv, csv + sizeof(csv) - 1, m, IOFormat(FullPrecision, DontAlignCols, ",")));
+  VERIFY(m.rows() == 3 && m.cols() == 3);
+  VERIFY(m(0,0) == 1.5 && m(0,1) == -2e3 && m(0,2) == 0.1);
+  VERIFY(m(1,0) == 1e-30 && m(1,1) == 7 && m(1,2) == 0);
+  VERIFY(m(2,0) == -std::numeric_limits<double>::infinity() && m(2,1) != m(2,1));
+  VERIFY(m(2,2) == 12345678901234567890.5);
+
+  Matrix<int,2,3> mi;
+  const char ints[] = "1 -2 3\n 2147483647 -2147483648 0";
+  VERIFY(readText(ints, ints + sizeof(ints) - 1, mi));
+  VERIFY(mi(1,0) == 2147483647 && mi(1,1) == -2147483647-1);
+  const char overflow[] = "1 -2 3\n 2147483648 0 0";
+  VERIFY(!readText(overflow, overflow + sizeof(overflow) - 1, mi));
+  Matrix3d m3;
+  VERIFY(!readText(ints, ints + sizeof(ints) - 1, m3));
+
+  // the text does not depend on the locale
+  if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8") || std::setlocale(LC_NUMERIC, "fr_FR.UTF-8"))
+  {
+    MatrixXd m1 = MatrixXd::Random(5, 7), m2;
+    std::stringstream stream;
+    writeText(stream, m1, IOFormat(FullPrecision, DontAlignCols, ",", "\n"));
+    VERIFY(stream.str().find('.') != std::string::npos);
+    VERIFY(readText(stream, m2, IOFormat(FullPrecision, DontAlignCols, ",", "\n")));
+    VERIFY(m2 == m1);
+    std::setlocale(LC_NUMERIC, "C");
+  }
+}
+
+void test_serialization()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( serialization_dense(MatrixXd(ei_random<int>(1,50), ei_random<int>(1,50))) );
+    CALL_SUBTEST_2( serialization_dense(Matrix<float,Dynamic,Dynamic,RowMajor>(ei_random<int>(1,50), ei_random<int>(1,50))) );
+    CALL_SUBTEST_3( serialization_dense(MatrixXcd(ei_random<int>(1,50), ei_random<int>(1,50))) );
+    CALL_SUBTEST_4( serialization_dense(Matrix4f()) );
+    CALL_SUBTEST_4( serialization_dense(VectorXi(ei_random<int>(1,50))) );
+
+    CALL_SUBTEST_5( serialization_sparse<double>(ei_random<int>(1,60), ei_random<int>(1,60)) );
+    CALL_SUBTEST_5( serialization_sparse<std::complex<float> >(ei_random<int>(1,60), ei_random<int>(1,60)) );
+    CALL_SUBTEST_5( serialization_sparse_corrupted<double>() );
+
+    CALL_SUBTEST_6( serialization_decompositions(MatrixXd(ei_random<int>(1,50), 1)) );
+    CALL_SUBTEST_6( serialization_decompositions(Matrix3f()) );
+    CALL_SUBTEST_7( serialization_decompositions(MatrixXcf(ei_random<int>(1,50), 1)) );
+
+    CALL_SUBTEST_8( serialization_sparse_llt<double>(ei_random<int>(1,60)) );
+
+    CALL_SUBTEST_9( serialization_text(MatrixXd(ei_random<int>(1,50), ei_random<int>(1,50))) );
+    CALL_SUBTEST_9( serialization_text(ArrayXXf(ei_random<int>(1,50), ei_random<int>(1,50))) );
+    CALL_SUBTEST_10( serialization_text(Matrix<int,4,3>()) );
+    CALL_SUBTEST_10( serialization_text(MatrixXd(300, 200)) );
+  }
+  CALL_SUBTEST_11( serialization_text_parse() );
+}